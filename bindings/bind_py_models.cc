@@ -49,21 +49,28 @@ namespace rascal {
   void bind_kernel_compute_function(CalculatorBind & kernel) {
     kernel.def("compute",
                py::overload_cast<const Calculator &, const StructureManagers &,
-                                 const StructureManagers &>(
+                                 const StructureManagers &, const size_t>(
                    &Kernel::template compute<Calculator, StructureManagers>),
+               py::arg("calculator"), py::arg("managers_a"),
+               py::arg("managers_b"), py::arg("n_threads") = 1,
                py::call_guard<py::gil_scoped_release>(),
                R"(Compute the kernel between two sets of atomic structures,
               i.e. StructureManagerCollections. The representation of the
               atomic structures computed with calculator should have already
-              been computed.)");
+              been computed. Structure kernels are computed with n_threads
+              threads, 0 for as many as the hardware supports.)");
     kernel.def("compute",
-               py::overload_cast<const Calculator &, const StructureManagers &>(
+               py::overload_cast<const Calculator &, const StructureManagers &,
+                                 const size_t>(
                    &Kernel::template compute<Calculator, StructureManagers>),
+               py::arg("calculator"), py::arg("managers"),
+               py::arg("n_threads") = 1,
                py::call_guard<py::gil_scoped_release>(),
                R"(Compute the kernel between a set of atomic structures,
               i.e. StructureManagerCollections, and itself. The representation
               of the atomic structures computed with calculator should have
-              already been computed.)");
+              already been computed. Structure kernels are computed with
+              n_threads threads, 0 for as many as the hardware supports.)");
   }
 
   //! Register compute functions of the SparseKernel class
@@ -92,13 +99,40 @@ namespace rascal {
         "compute_derivative",
         &SparseKernel::template compute_derivative<
             Calculator, StructureManagers, SparsePoints>,
+        py::arg("calculator"), py::arg("managers"), py::arg("sparse_points"),
+        py::arg("compute_neg_stress"), py::arg("n_threads") = 1,
         py::call_guard<py::gil_scoped_release>(),
         R"(Compute the sparse kernel between the gradient of representation of a
             set of atomic structures w.r.t. the atomic positions,
             i.e. StructureManagerCollections, and a set of SparsePoints, i.e.
             the basis used by the sparse method. The gradients of the
             representation of the atomic structures computed with Calculator
-            should have already been computed.)");
+            should have already been computed. The structures are handled
+            with n_threads threads, 0 for as many as the hardware supports.)");
+    kernel.def(
+        "get_derivative_shape",
+        [](const SparseKernel & kernel, const StructureManagers & managers,
+           const SparsePoints & sparse_points, const bool compute_neg_stress) {
+          return kernel.get_derivative_shape(managers, sparse_points.size(),
+                                             compute_neg_stress);
+        },
+        py::arg("managers"), py::arg("sparse_points"),
+        py::arg("compute_neg_stress"),
+        R"(Shape of the matrix returned by compute_derivative.)");
+    kernel.def(
+        "fill_derivative",
+        [](SparseKernel & kernel, const Calculator & calculator,
+           const StructureManagers & managers,
+           const SparsePoints & sparse_points, const bool compute_neg_stress,
+           Eigen::Ref<math::Matrix_t> out, const size_t n_threads) {
+          kernel.fill_derivative(calculator, managers, sparse_points,
+                                 compute_neg_stress, out, n_threads);
+        },
+        py::arg("calculator"), py::arg("managers"), py::arg("sparse_points"),
+        py::arg("compute_neg_stress"), py::arg("out").noconvert(),
+        py::arg("n_threads") = 1, py::call_guard<py::gil_scoped_release>(),
+        R"(Same as compute_derivative but fills out, a C contiguous float64
+            array of shape get_derivative_shape(...) such as a numpy.memmap.)");
   }
 
   //! Register a pseudo points class
@@ -111,6 +145,18 @@ namespace rascal {
     sparse_points.def(py::init());
     sparse_points.def("size", &SparsePoints::size);
     sparse_points.def("get_features", &SparsePoints::get_features);
+    sparse_points.def(
+        "get_keys",
+        [](const SparsePoints & sparse_points) {
+          std::vector<std::vector<int>> keys{};
+          for (const auto & key : sparse_points.keys) {
+            keys.emplace_back(key.begin(), key.end());
+          }
+          return keys;
+        },
+        R"(Keys associated with the columns of get_features.)");
+    sparse_points.def("species_by_points", &SparsePoints::species_by_points,
+                      R"(Central atom species of each pseudo point.)");
     return sparse_points;
   }
 
@@ -140,9 +186,131 @@ namespace rascal {
     mod.def("compute_numerical_kernel_gradients",
             &compute_numerical_kernel_gradients<KernelImpl, Calculator,
                                                 Managers, SparsePoints>,
+            py::arg("kernel"), py::arg("calculator"), py::arg("managers"),
+            py::arg("sparse_points"), py::arg("h_disp") = 1e-5,
+            py::arg("compute_stress") = false, py::arg("n_threads") = 1,
             py::call_guard<py::gil_scoped_release>());
   }
 
+  //! Register the streaming accumulator of the sparse GPR normal equations
+  template <class ManagerCollection, class Calculator, class SparsePoints>
+  void bind_sparse_gpr_accumulator(py::module & mod) {
+    using Accumulator_t = SparseGPRAccumulator;
+    py::class_<Accumulator_t> accumulator(mod, "SparseGPRAccumulator");
+    accumulator.def(py::init<const size_t, const size_t>(),
+                    py::arg("nb_sparse_points"), py::arg("nb_targets") = 1);
+    accumulator.def("reset", &Accumulator_t::reset);
+    accumulator.def("accumulate", &Accumulator_t::accumulate, py::arg("KNM"),
+                    py::arg("Y"), py::arg("weights"),
+                    py::call_guard<py::gil_scoped_release>(),
+                    R"(Fold a block of rows of K_NM, the associated targets
+            and the diagonal of Lambda^-1 for these rows.)");
+    accumulator.def(
+        "accumulate_properties",
+        &Accumulator_t::template accumulate_properties<
+            Calculator, ManagerCollection, SparsePoints>,
+        py::arg("kernel"), py::arg("calculator"), py::arg("managers"),
+        py::arg("sparse_points"), py::arg("Y"), py::arg("weights"),
+        py::call_guard<py::gil_scoped_release>(),
+        R"(Compute the rows of K_NM associated with the properties of the
+            structures in managers and fold them with the targets Y and the
+            diagonal of Lambda^-1 weights.)");
+    accumulator.def(
+        "accumulate_gradients",
+        &Accumulator_t::template accumulate_gradients<
+            Calculator, ManagerCollection, SparsePoints>,
+        py::arg("kernel"), py::arg("calculator"), py::arg("managers"),
+        py::arg("sparse_points"), py::arg("Y"), py::arg("weights"),
+        py::arg("n_threads") = 1, py::call_guard<py::gil_scoped_release>(),
+        R"(Compute the rows of K_NM associated with the gradients of the
+            properties w.r.t. the atomic positions of the structures in
+            managers and fold them with the targets Y and the diagonal of
+            Lambda^-1 weights.)");
+    accumulator.def("get_KtK", &Accumulator_t::get_KtK,
+                    R"(K_MN Lambda^-2 K_NM)");
+    accumulator.def("get_KtY", &Accumulator_t::get_KtY,
+                    R"(K_MN Lambda^-2 Y)");
+    accumulator.def("get_nb_rows", &Accumulator_t::get_nb_rows);
+  }
+
+  //! Register the farthest point sampling of atomic environments
+  template <class ManagerCollection, class Calculator>
+  void bind_farthest_point_sampling(py::module & mod) {
+    mod.def(
+        "select_farthest_points",
+        [](const Calculator & calculator, const ManagerCollection & managers,
+           const size_t n_select, const std::vector<int> & species,
+           const size_t initial, const size_t n_threads) {
+          auto selection{select_farthest_points(
+              calculator, managers, n_select, species, initial, n_threads)};
+          return std::make_tuple(selection.selected_ids,
+                                 selection.distances);
+        },
+        py::arg("calculator"), py::arg("managers"), py::arg("n_select"),
+        py::arg("species") = std::vector<int>{}, py::arg("initial") = 0,
+        py::arg("n_threads") = 1, py::call_guard<py::gil_scoped_release>(),
+        R"(Farthest point sampling of the centers of managers whose atomic
+            type is in species (all of them if empty) using the block
+            sparse representation computed with calculator. Returns the
+            selected indices, among these centers, and the squared
+            Hausdorff distance at each selection.)");
+  }
+
+  //! Register the randomized CUR selection of samples or features
+  template <class ManagerCollection, class Calculator>
+  void bind_cur_selection(py::module & mod) {
+    mod.def(
+        "select_cur",
+        [](const Calculator & calculator, ManagerCollection & managers,
+           const py::dict & hyper, const size_t n_threads) {
+          json hypers = hyper;
+          py::gil_scoped_release release{};
+          return select_cur(calculator, managers, hypers, n_threads);
+        },
+        py::arg("calculator"), py::arg("managers"), py::arg("hypers"),
+        py::arg("n_threads") = 1,
+        R"(CUR selection of the centers or of the features of managers
+            using a randomized range finder over the representation computed
+            with calculator. hypers contains selection_type ('sample' or
+            'feature'), n_select and optionally species, k, n_oversampling,
+            n_power_iterations and seed. Returns the selected indices in
+            the order of selection.)");
+  }
+
+  //! Register the fused potential used for molecular dynamics
+  template <class ManagerCollection, class Calculator>
+  void bind_potential(py::module & mod) {
+    using Potential_t = Potential<Calculator, ManagerCollection>;
+    py::class_<Potential_t> potential(mod, "Potential");
+    potential.def(py::init([](const py::dict & hyper) {
+                    json hypers = hyper;
+                    return std::make_unique<Potential_t>(hypers);
+                  }),
+                  R"(Build the potential from a dictionary with the fields
+            representation, kernel, sparse_points, weights,
+            self_contributions and adaptors, see KRR.get_potential.)");
+    potential.def(
+        "compute",
+        [](Potential_t & potential,
+           const py::EigenDRef<const Eigen::MatrixXd> & positions,
+           const py::EigenDRef<const Eigen::VectorXi> & atom_types,
+           const py::EigenDRef<const Eigen::MatrixXd> & cell,
+           const py::EigenDRef<const Eigen::VectorXi> & pbc) {
+          // ASE convention: positions and cell vectors as rows
+          potential.compute(positions.transpose(), atom_types,
+                            cell.transpose(), pbc);
+          return std::make_tuple(potential.get_energy(),
+                                 potential.get_forces(),
+                                 potential.get_stress());
+        },
+        py::arg("positions"), py::arg("atom_types"), py::arg("cell"),
+        py::arg("pbc"), py::call_guard<py::gil_scoped_release>(),
+        R"(Compute the energy, the Nx3 forces and the 3x3 stress of the
+            structure given by the Nx3 positions, the atomic numbers, the
+            cell vectors as rows and the periodic boundary conditions. The
+            atoms should keep their order between the calls.)");
+  }
+
   template <class ManagerCollection, class Calculator, class SparsePoints>
   void bind_compute_gradients(py::module & mod, py::module & /*m_internal*/) {
     using Manager_t = typename ManagerCollection::Manager_t;
@@ -243,5 +411,10 @@ namespace rascal {
         mod, m_internal);
     bind_compute_numerical_kernel_gradients<
         SparseKernel, Calc1_t, ManagerCollection_2_t, SparsePoints_1_t>(mod);
+    bind_sparse_gpr_accumulator<ManagerCollection_2_t, Calc1_t,
+                                SparsePoints_1_t>(mod);
+    bind_potential<ManagerCollection_2_t, Calc1_t>(mod);
+    bind_farthest_point_sampling<ManagerCollection_2_t, Calc1_t>(mod);
+    bind_cur_selection<ManagerCollection_2_t, Calc1_t>(mod);
   }
 }  // namespace rascal
@@ -31,8 +31,12 @@
 #include "bind_py_representation_calculator.hh"
 #include "bind_py_structure_manager.hh"
 
+#include "rascal/models/cur_selection.hh"
+#include "rascal/models/farthest_point_sampling.hh"
 #include "rascal/models/kernels.hh"
 #include "rascal/models/numerical_kernel_gradients.hh"
+#include "rascal/models/potential.hh"
+#include "rascal/models/sparse_gpr_accumulator.hh"
 #include "rascal/models/sparse_kernel_predict.hh"
 #include "rascal/models/sparse_kernels.hh"
 #include "rascal/models/sparse_points.hh"
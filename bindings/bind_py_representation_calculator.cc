@@ -146,9 +146,25 @@ namespace rascal {
    */
   void add_representation_calculators(py::module & mod,
                                       py::module & m_internal) {
+    py::class_<FeatureCache, std::shared_ptr<FeatureCache>> feature_cache(
+        mod, "FeatureCache");
+    feature_cache.def(py::init<const std::string &, size_t>(),
+                      py::arg("directory"), py::arg("max_size") = 0);
+    feature_cache.def("clear", &FeatureCache::clear);
+    feature_cache.def("evict", &FeatureCache::evict);
+    feature_cache.def_property("max_size", &FeatureCache::get_max_size,
+                               &FeatureCache::set_max_size);
+    feature_cache.def_property_readonly("size", &FeatureCache::get_size);
+    feature_cache.def_property_readonly("directory",
+                                        &FeatureCache::get_directory);
+    feature_cache.def_property_readonly("hits", &FeatureCache::get_hits);
+    feature_cache.def_property_readonly("misses", &FeatureCache::get_misses);
+
     auto base = py::class_<CalculatorBase>(m_internal, "CalculatorBase");
     base.def_readwrite("name", &CalculatorBase::name);
     base.def_readonly("default_prefix", &CalculatorBase::default_prefix);
+    base.def("set_feature_cache", &CalculatorBase::set_feature_cache,
+             py::arg("feature_cache"));
     /*-------------------- rep-bind-start --------------------*/
     // Defines a particular structure manager type
     using TypeHolder_t =
@@ -490,6 +490,22 @@ namespace rascal {
                                                                 m_adaptor);
   }
 
+  //! map to a row major numpy array, e.g. the out argument of fill_features
+  template <typename T>
+  using RowMatrixRef_t = Eigen::Ref<
+      Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>;
+
+  //! convert a list of keys from python to Keys_t
+  template <class Keys_t>
+  Keys_t convert_keys(const py::list & all_keys_l) {
+    Keys_t all_keys{};
+    for (py::handle key_l : all_keys_l) {
+      auto key = py::cast<std::vector<int>>(key_l);
+      all_keys.insert(key);
+    }
+    return all_keys;
+  }
+
   template <class Calculator, class ManagerCollection_t,
             class ManagerCollectionBinder>
   void
@@ -497,6 +513,32 @@ namespace rascal {
     manager_collection.def(
         "get_features", &ManagerCollection_t::template get_features<Calculator>,
         py::call_guard<py::gil_scoped_release>());
+    manager_collection.def(
+        "get_features_shape",
+        &ManagerCollection_t::template get_features_shape<Calculator>,
+        R"(Shape of the feature matrix returned by get_features.)");
+    // pybind11 only binds a non const Eigen::Ref to a numpy array when it can
+    // be mapped without copy, i.e. the array has to be writeable, C
+    // contiguous and of the matching dtype.
+    manager_collection.def(
+        "fill_features",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           RowMatrixRef_t<double> out) {
+          managers.fill_features(calculator, out);
+        },
+        R"(Write the feature matrix returned by get_features into out, a
+        preallocated (possibly memory mapped) C contiguous numpy array of
+        float64 or float32 with the shape given by get_features_shape.)",
+        py::arg("calculator"), py::arg("out").noconvert(),
+        py::call_guard<py::gil_scoped_release>());
+    manager_collection.def(
+        "fill_features",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           RowMatrixRef_t<float> out) {
+          managers.fill_features(calculator, out);
+        },
+        py::arg("calculator"), py::arg("out").noconvert(),
+        py::call_guard<py::gil_scoped_release>());
   }
 
   template <class ManagerCollection_t, class ManagerCollectionBinder,
@@ -584,6 +626,68 @@ namespace rascal {
   void
   bind_get_direction_vector(ManagerCollectionBinder & /*manager_collection*/) {}
 
+  /**
+   * Keys used to build the gradients of the features, an empty list means
+   * that the keys present in the managers are used.
+   */
+  template <class Keys_t, class ManagerCollection_t, class Calculator>
+  Keys_t get_gradient_keys(ManagerCollection_t & managers,
+                           const Calculator & calculator,
+                           const py::list & all_keys_l) {
+    if (all_keys_l.size() > 0) {
+      return convert_keys<Keys_t>(all_keys_l);
+    }
+    Keys_t all_keys{};
+    for (auto key_l : managers.get_keys(calculator)) {
+      all_keys.insert(key_l);
+    }
+    return all_keys;
+  }
+
+  /**
+   * Bind fill_features and fill_features_gradient that write the dense
+   * features (gradients) built with a list of keys into a preallocated numpy
+   * array of dtype T.
+   */
+  template <class Calculator, class ManagerCollection_t, typename T,
+            class ManagerCollectionBinder>
+  void
+  bind_fill_sparse_features(ManagerCollectionBinder & manager_collection) {
+    manager_collection.def(
+        "fill_features",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           py::list & all_keys_l, RowMatrixRef_t<T> out) {
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          using Prop_t = typename Calculator::template Property_t<Manager_t>;
+          using Keys_t = typename Prop_t::Keys_t;
+          auto all_keys{convert_keys<Keys_t>(all_keys_l)};
+          py::gil_scoped_release release{};
+          managers.fill_features(calculator, all_keys, out);
+        },
+        R"(Write the feature matrix built with the list of keys provided into
+        out, a preallocated (possibly memory mapped) C contiguous numpy array
+        of float64 or float32 with the shape given by get_features_shape.)",
+        py::arg("calculator"), py::arg("keys"), py::arg("out").noconvert());
+    manager_collection.def(
+        "fill_features_gradient",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           py::list & all_keys_l, RowMatrixRef_t<T> out) {
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          using Prop_t =
+              typename Calculator::template PropertyGradient_t<Manager_t>;
+          using Keys_t = typename Prop_t::Keys_t;
+          auto all_keys{
+              get_gradient_keys<Keys_t>(managers, calculator, all_keys_l)};
+          py::gil_scoped_release release{};
+          managers.fill_features_gradient(calculator, all_keys, out);
+        },
+        R"(Write the feature gradient matrix built with the list of keys
+        provided into out, a preallocated (possibly memory mapped) C
+        contiguous numpy array of float64 or float32 with the shape given by
+        get_features_gradient_shape.)",
+        py::arg("calculator"), py::arg("keys"), py::arg("out").noconvert());
+  }
+
   /**
    * Bind getters for the feature matrix comming from BlockSparseProperty.
    *
@@ -687,43 +791,31 @@ namespace rascal {
             throw std::runtime_error(
                 R"(There are no structure to get features from)");
           }
-          Keys_t all_keys;
-          // convert the list of keys from python in to the proper type
-          for (py::handle key_l : all_keys_l) {
-            auto key = py::cast<std::vector<int>>(key_l);
-            all_keys.insert(key);
-          }
-
-          auto property_name{managers.get_calculator_name(calculator, false)};
-
-          const auto & property_ =
-              *managers[0]->template get_property<Prop_t>(property_name);
-          // assume inner_size is consistent for all managers
-          int inner_size{property_.get_nb_comp()};
-
-          math::Matrix_t features{};
-
-          auto n_rows{
-              managers.template get_number_of_elements<Prop_t>(property_name)};
-          size_t n_cols{all_keys.size() * inner_size};
-          features.resize(n_rows, n_cols);
-          features.setZero();
-
-          int i_row{0};
-          for (auto & manager : managers) {
-            const auto & property =
-                *manager->template get_property<Prop_t>(property_name);
-            auto n_rows_manager = property.size();
-            property.fill_dense_feature_matrix(
-                features.block(i_row, 0, n_rows_manager, n_cols), all_keys);
-            i_row += n_rows_manager;
-          }
-
+          auto all_keys{convert_keys<Keys_t>(all_keys_l)};
+          auto shape{managers.get_features_shape(calculator, all_keys)};
+          math::Matrix_t features(shape[0], shape[1]);
+          managers.fill_features(calculator, all_keys, features);
           return features;
         },
         R"(Get the dense feature matrix associated with the calculator and
         the collection of structures (managers) using the list of keys
         provided. Only applicable when Calculator uses BlockSparseProperty.)");
+    manager_collection.def(
+        "get_features_shape",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           py::list & all_keys_l) {
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          using Prop_t = typename Calculator::template Property_t<Manager_t>;
+          using Keys_t = typename Prop_t::Keys_t;
+          return managers.get_features_shape(
+              calculator, convert_keys<Keys_t>(all_keys_l));
+        },
+        R"(Shape of the feature matrix built with the list of keys
+        provided.)");
+    bind_fill_sparse_features<Calculator, ManagerCollection_t, double>(
+        manager_collection);
+    bind_fill_sparse_features<Calculator, ManagerCollection_t, float>(
+        manager_collection);
     manager_collection.def(
         "get_features_gradient",
         [](ManagerCollection_t & managers, const Calculator & calculator,
@@ -736,49 +828,90 @@ namespace rascal {
             throw std::runtime_error(
                 R"(There are no structure to get features from)");
           }
-          Keys_t all_keys;
-          if (all_keys_l.size() > 0) {
-            // convert the list of keys from python in to the proper type
-            for (py::handle key_l : all_keys_l) {
-              auto key = py::cast<std::vector<int>>(key_l);
-              all_keys.insert(key);
-            }
-          } else {
-            // empty all_keys_l means that we use the keys from the managers
-            for (auto key_l : managers.get_keys(calculator)) {
-              all_keys.insert(key_l);
-            }
+          auto all_keys{get_gradient_keys<Keys_t>(managers, calculator,
+                                                  all_keys_l)};
+          auto shape{
+              managers.get_features_gradient_shape(calculator, all_keys)};
+          math::Matrix_t features(shape[0], shape[1]);
+          managers.fill_features_gradient(calculator, all_keys, features);
+          return features;
+        },
+        R"(Get the dense feature matrix associated with the calculator and
+        the collection of structures (managers) using the list of keys
+        provided. Only applicable when Calculator uses BlockSparseProperty.)");
+    manager_collection.def(
+        "get_features_gradient_sparse",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           py::list & all_keys_l) {
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          using Prop_t =
+              typename Calculator::template PropertyGradient_t<Manager_t>;
+          using Keys_t = typename Prop_t::Keys_t;
+          if (managers.size() == 0) {
+            throw std::runtime_error(
+                R"(There are no structure to get features from)");
           }
-
-          auto property_name{managers.get_calculator_name(calculator, true)};
-
-          const auto & property_ =
-              *managers[0]->template get_property<Prop_t>(property_name);
-          // assume inner_size is consistent for all managers
-          int inner_size{property_.get_nb_comp() / ThreeD};
-
-          math::Matrix_t features{};
-          auto n_rows{ThreeD * managers.template get_number_of_elements<Prop_t>(
-                                   property_name)};
-          size_t n_cols{all_keys.size() * inner_size};
-          features.resize(n_rows, n_cols);
-          features.setZero();
-
-          int i_row{0};
+          auto all_keys{
+              get_gradient_keys<Keys_t>(managers, calculator, all_keys_l)};
+          py::gil_scoped_release release{};
+          return managers.get_features_gradient_sparse(calculator, all_keys);
+        },
+        R"(Get the gradients of the features associated with the calculator
+        as a scipy.sparse.csr_matrix. It has the same layout as the dense
+        matrix returned by get_features_gradient with the same list of keys
+        (an empty list means the keys present in the managers) but only the
+        blocks of the keys stored for each neighbor are kept.)");
+    manager_collection.def(
+        "get_features_gradient_shape",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           py::list & all_keys_l) {
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          using Prop_t =
+              typename Calculator::template PropertyGradient_t<Manager_t>;
+          using Keys_t = typename Prop_t::Keys_t;
+          return managers.get_features_gradient_shape(
+              calculator,
+              get_gradient_keys<Keys_t>(managers, calculator, all_keys_l));
+        },
+        R"(Shape of the feature gradient matrix built with the list of keys
+        provided.)");
+    manager_collection.def(
+        "get_features_views",
+        [](ManagerCollection_t & managers, const Calculator & calculator) {
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          using Prop_t = typename Calculator::template Property_t<Manager_t>;
+          auto property_name{managers.get_calculator_name(calculator, false)};
+          py::list views{};
           for (auto & manager : managers) {
             const auto & property =
                 *manager->template get_property<Prop_t>(property_name);
-            auto n_rows_manager = property.size() * ThreeD;
-            property.fill_dense_feature_matrix_gradient(
-                features.block(i_row, 0, n_rows_manager, n_cols), all_keys);
-            i_row += n_rows_manager;
+            if (not property.are_keys_uniform() or property.size() == 0) {
+              views.append(py::none());
+              continue;
+            }
+            py::list keys_list{};
+            for (const auto & key : property.get_keys()) {
+              keys_list.append(py::tuple(py::cast(key)));
+            }
+            auto data{property.get_raw_data_view()};
+            py::ssize_t item_size{sizeof(double)};
+            // the array does not own the data, it keeps the manager alive
+            py::array view{py::dtype::of<double>(),
+                           {data.rows(), data.cols()},
+                           {item_size * data.cols(), item_size},
+                           data.data(),
+                           py::cast(manager)};
+            view.attr("flags").attr("writeable") = false;
+            views.append(py::make_tuple(keys_list, view));
           }
-
-          return features;
+          return views;
         },
-        R"(Get the dense feature matrix associated with the calculator and
-        the collection of structures (managers) using the list of keys
-        provided. Only applicable when Calculator uses BlockSparseProperty.)");
+        R"(Get a read only view on the features of each structure without
+        copying them. It is only possible when every center of the structure
+        has the same keys, e.g. with expand_by_gradient or
+        global_species, otherwise the entry is None. Each entry is a tuple
+        with the list of keys, in the order of the columns, and a numpy array
+        of shape (n_centers, n_keys*inner_size).)");
     manager_collection.def(
         "get_representation_info",
         [](ManagerCollection_t & managers) {
@@ -862,6 +995,18 @@ namespace rascal {
         py::keep_alive<0, 1>());
     manager_collection.def("__len__", &ManagerCollection_t::size,
                            "Get number of structures in the collection.");
+    manager_collection.def(
+        "get_atom_types",
+        [](ManagerCollection_t & v) {
+          std::vector<Eigen::VectorXi> atom_types{};
+          for (auto & manager : v) {
+            auto manager_root = extract_underlying_manager<0>(manager);
+            atom_types.emplace_back(manager_root->get_atom_types());
+          }
+          return atom_types;
+        },
+        R"(Get the atomic numbers of all the atoms of each structure, not only
+        of the centers.)");
     /**
      * Binds the `add_structures`. Instead of invoking the targeted function to
      * bind within a lambda function, a pointer-to-member-function is used here.
@@ -889,6 +1034,16 @@ namespace rascal {
         R"(Read a file and extract the structures from start to start + length.)",
         py::arg("filename"), py::arg("start") = 0, py::arg("length") = -1);
 
+    manager_collection.def(
+        "add_structures",
+        [](ManagerCollection_t & v,
+           const std::shared_ptr<StructureStore> & store, int start,
+           int length) { v.add_structures(store, start, length); },
+        R"(Add the structures from start to start + length of a
+        StructureStore. The positions are read from the memory mapping.)",
+        py::arg("store"), py::arg("start") = 0, py::arg("length") = -1,
+        py::call_guard<py::gil_scoped_release>());
+
     manager_collection.def("get_parameters", [](ManagerCollection_t & v) {
       return std::string(v.get_adaptors_parameters().dump(2));
     });
@@ -1095,6 +1250,34 @@ namespace rascal {
             py::keep_alive<0, 1>());
   }
 
+  /**
+   * bind the memory-mapped StructureStore so that large datasets can be
+   * given to the ManagerCollection without parsing them.
+   */
+  void bind_structure_store(py::module & mod) {
+    py::class_<StructureStore, std::shared_ptr<StructureStore>>(
+        mod, "StructureStore")
+        .def(py::init<const std::string &>(), py::arg("filename"))
+        .def("__len__", &StructureStore::size)
+        .def("get_number_of_atoms",
+             py::overload_cast<size_t>(&StructureStore::get_number_of_atoms,
+                                       py::const_))
+        .def("get_structure", &StructureStore::get_atomic_structure,
+             R"(Copy the structure at index into an AtomicStructure.)")
+        .def_property_readonly("filename", &StructureStore::get_filename);
+
+    mod.def("convert_to_structure_store", &convert_to_structure_store,
+            R"(Convert the structures of an ASE json (or ubjson) file to a
+            memory-mapped StructureStore file. Returns the number of
+            structures.)",
+            py::arg("filename"), py::arg("store_filename"),
+            py::call_guard<py::gil_scoped_release>());
+    mod.def("write_structure_store", &write_structure_store,
+            R"(Write a list of AtomicStructure to a StructureStore file.)",
+            py::arg("store_filename"), py::arg("structures"),
+            py::call_guard<py::gil_scoped_release>());
+  }
+
   //! Main function to add StructureManagers and their Adaptors
   void add_structure_managers(py::module & m_nl, py::module & m_internal) {
     // Bind StructureManagerBase (needed for virtual inheritance)
@@ -1105,6 +1288,7 @@ namespace rascal {
     bind_cluster_refs(m_internal);
 
     bind_atomic_structure(m_nl);
+    bind_structure_store(m_nl);
 
     py::module m_strc_mng = m_nl.def_submodule("StructureManager");
     m_strc_mng.doc() = "Structure Manager Classes";
@@ -4,4 +4,8 @@ from ._rascal.models import (
     kernels,
     compute_sparse_kernel_gradients,
     compute_sparse_kernel_neg_stress,
+    SparseGPRAccumulator,
+    Potential,
+    select_farthest_points,
+    select_cur,
 )
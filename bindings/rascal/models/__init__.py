@@ -1,2 +1,2 @@
-from .krr import train_gap_model, KRR, compute_KNM
+from .krr import train_gap_model, train_gap_model_streaming, KRR, compute_KNM
 from .kernels import Kernel
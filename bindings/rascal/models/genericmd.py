@@ -56,6 +56,12 @@ class GenericMDCalculator:
         self.model = load_obj(model_json)
         self.representation = self.model.get_representation_calculator()
         self.manager = None
+        # evaluates the model in a single call with persistent managers, the
+        # models without a potential go through the predict methods
+        try:
+            self.potential = self.model.get_potential()
+        except NotImplementedError:
+            self.potential = None
         # Structure initialization
         self.is_periodic = is_periodic
         if structure_template is not None:
@@ -107,6 +113,15 @@ class GenericMDCalculator:
         self.atoms.set_cell(cell_matrix)
         self.atoms.set_positions(positions)
 
+        if self.potential is not None:
+            # the wrapping of the atoms is done by the potential
+            return self.potential.compute(
+                positions,
+                self.atoms.get_atomic_numbers().astype(np.int32),
+                np.asarray(cell_matrix, dtype=float),
+                self.atoms.get_pbc().astype(np.int32),
+            )
+
         # Convert from ASE to librascal
         if self.manager is None:
             #  happens at the begining of the MD run
@@ -123,7 +123,15 @@ class Kernel(BaseIO):
         data.update(cpp_kernel=self._kernel.to_dict())
         return data
 
-    def __call__(self, X, Y=None, grad=(False, False), compute_neg_stress=False):
+    def __call__(
+        self,
+        X,
+        Y=None,
+        grad=(False, False),
+        compute_neg_stress=False,
+        n_threads=1,
+        out=None,
+    ):
         """
         Compute the kernel.
 
@@ -143,6 +151,15 @@ class Kernel(BaseIO):
             compute_neg_stress : if gradients are computed and True then compute
                 also the kernel associated with the stress in Voigt format.
 
+            n_threads : number of threads used to compute the kernel gradients
+                and the full structure kernels, 0 for as many as the hardware
+                supports.
+
+            out : optional C contiguous float64 array, e.g. a numpy.memmap,
+                filled with the kernel gradients instead of allocating a new
+                array. Its shape is given by
+                self._kernel.get_derivative_shape(X, Y, compute_neg_stress).
+
         Returns
         -------
             kernel_matrix: ndarray
@@ -152,7 +169,7 @@ class Kernel(BaseIO):
         if Y is None and grad == (False, False):
             # compute a kernel between features and themselves
             if self.kernel_type == "Full":
-                return self._kernel.compute(self._representation, X)
+                return self._kernel.compute(self._representation, X, n_threads)
             elif self.kernel_type == "Sparse":
                 if isinstance(X, SparsePoints):
                     X = X._sparse_points
@@ -162,8 +179,13 @@ class Kernel(BaseIO):
             if isinstance(Y, SparsePoints):
                 Y = Y._sparse_points
             # compute the block of the KNM matrix corresponding to forces
+            if out is not None:
+                self._kernel.fill_derivative(
+                    self._representation, X, Y, compute_neg_stress, out, n_threads
+                )
+                return out
             return self._kernel.compute_derivative(
-                self._representation, X, Y, compute_neg_stress
+                self._representation, X, Y, compute_neg_stress, n_threads
             )
         elif grad == (False, False):
             # compute the kernel between two sets of features
@@ -173,6 +195,8 @@ class Kernel(BaseIO):
             elif isinstance(Y, SparsePoints):
                 # to make predictions with a sparse kernel method
                 Y = Y._sparse_points
+            if self.kernel_type == "Full":
+                return self._kernel.compute(self._representation, X, Y, n_threads)
             return self._kernel.compute(self._representation, X, Y)
         else:
             raise NotImplementedError(
@@ -183,9 +207,19 @@ class Kernel(BaseIO):
 
 
 def compute_numerical_kernel_gradients(
-    kernel, calculator, managers, sparse_points, h_disp, compute_neg_stress=True
+    kernel,
+    calculator,
+    managers,
+    sparse_points,
+    h_disp,
+    compute_neg_stress=True,
+    n_threads=1,
 ):
-    """This function is used for testing the numerical kernel gradient"""
+    """This function is used for testing the numerical kernel gradient
+
+    The displacements are evaluated with n_threads threads (0 for as many as
+    the hardware supports).
+    """
     return _compute_numerical_kernel_gradients(
         kernel._kernel,
         calculator._representation,
@@ -193,4 +227,5 @@ def compute_numerical_kernel_gradients(
         sparse_points._sparse_points,
         h_disp,
         compute_neg_stress,
+        n_threads,
     )
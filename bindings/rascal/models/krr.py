@@ -6,9 +6,18 @@ Public classes:
 Public functions:
     compute_KNM             Compute GAP kernel of a set of structures
     train_gap_model         Train a GAP model given a kernel matrix and sparse points
+    train_gap_model_streaming
+                            Train a GAP model from chunks of structures without
+                            storing the kernel matrix
 """
 from ..utils import BaseIO
-from ..lib import compute_sparse_kernel_gradients, compute_sparse_kernel_neg_stress
+from ..lib import (
+    compute_sparse_kernel_gradients,
+    compute_sparse_kernel_neg_stress,
+    SparseGPRAccumulator,
+    Potential,
+)
+from ..neighbourlist import AtomsList
 
 import scipy
 import numpy as np
@@ -126,28 +135,54 @@ class SparseGPRSolver:
 
         # do actual fit if called with empty array or if asked
         if len(Y) == 0 or (not accumulate_only):
-            if self.solver == "RKHS":
-                self._weights = self._PKPhi @ scipy.linalg.solve(
-                    self._Cov + np.eye(self._nM) * self.regularizer,
-                    self._KY,
-                    assume_a="pos",
-                )
-            elif self.solver == "solve":
-                self._weights = scipy.linalg.solve(
-                    self._Cov
-                    + self.regularizer * self.KMM
-                    + np.eye(self.KMM.shape[0]) * self.jitter * self._jitter_scale,
-                    self._KY,
-                    assume_a="pos",
-                )
-            elif self.solver == "lstsq":
-                self._weights = np.linalg.lstsq(
-                    self._Cov
-                    + self.regularizer * self.KMM
-                    + np.eye(self.KMM.shape[0]) * self.jitter * self._jitter_scale,
-                    self._KY,
-                    rcond=rcond,
-                )[0]
+            self._solve_normal_equations(rcond)
+
+    def partial_fit_normal_equations(self, KtK, KtY, accumulate_only=False, rcond=None):
+        """Same as partial_fit but takes the already contracted normal
+        equations `KNM.T@KNM` and `KNM.T@Y`, e.g. from a
+        `SparseGPRAccumulator`, instead of the rows of KNM."""
+        if len(KtY.shape) == 1:
+            KtY = KtY[:, np.newaxis]
+        if self.solver == "RKHS":
+            Cov = self._PKPhi.T @ KtK @ self._PKPhi
+            KY = self._PKPhi.T @ KtY
+        elif self.solver == "solve" or self.solver == "lstsq":
+            Cov, KY = KtK, KtY
+        else:
+            raise ValueError(
+                "Partial fit can only be realized with solver = 'RKHS' or 'solve'"
+            )
+        if self._KY is None:
+            self._KY = np.zeros((self._nM, KtY.shape[1]))
+        self._Cov += Cov
+        self._KY += KY
+
+        if not accumulate_only:
+            self._solve_normal_equations(rcond)
+
+    def _solve_normal_equations(self, rcond=None):
+        if self.solver == "RKHS":
+            self._weights = self._PKPhi @ scipy.linalg.solve(
+                self._Cov + np.eye(self._nM) * self.regularizer,
+                self._KY,
+                assume_a="pos",
+            )
+        elif self.solver == "solve":
+            self._weights = scipy.linalg.solve(
+                self._Cov
+                + self.regularizer * self.KMM
+                + np.eye(self.KMM.shape[0]) * self.jitter * self._jitter_scale,
+                self._KY,
+                assume_a="pos",
+            )
+        elif self.solver == "lstsq":
+            self._weights = np.linalg.lstsq(
+                self._Cov
+                + self.regularizer * self.KMM
+                + np.eye(self.KMM.shape[0]) * self.jitter * self._jitter_scale,
+                self._KY,
+                rcond=rcond,
+            )[0]
 
     def fit(self, KNM, Y, rcond=None):
 
@@ -396,6 +431,45 @@ class KRR(BaseIO):
 
         return -neg_stress
 
+    def get_potential(self, precontract=None):
+        """Build a `Potential` that computes the energy, forces and stress of
+        a structure in a single call, e.g. at each step of a molecular
+        dynamics run (see `GenericMDCalculator`).
+
+        Parameters
+        ----------
+        precontract : bool or None
+            contract the weights with the sparse points at load time so that
+            the cost of a prediction does not depend on the number of sparse
+            points (only for zeta 1 and 2). None lets the potential decide.
+
+        Returns
+        -------
+        Potential
+            C++ object whose compute(positions, atom_types, cell, pbc) method
+            returns the energy, the forces and the stress
+        """
+        if self.kernel.kernel_type != "Sparse" or self.kernel.name != "GAP":
+            raise NotImplementedError(
+                "potential only implemented for GAP kernels with kernel_type=='Sparse'"
+            )
+        self_contributions = self.self_contributions
+        if self_contributions is None:
+            self_contributions = dict()
+        hypers = dict(
+            representation=self.kernel._representation.to_dict(),
+            kernel=self.kernel._kernel.to_dict(),
+            sparse_points=self.X_train._sparse_points.to_dict(),
+            weights=self.weights.tolist(),
+            self_contributions={
+                str(sp): float(value) for sp, value in self_contributions.items()
+            },
+            adaptors=self.kernel._rep.nl_options,
+        )
+        if precontract is not None:
+            hypers["precontract"] = bool(precontract)
+        return Potential(hypers)
+
     @property
     def weights(self):
         return self._weights
@@ -486,7 +560,68 @@ def _compute_kernel_single(i_frame, frame, representation, X_sparse, kernel):
     return en_row, grad_rows
 
 
-def compute_KNM(frames, X_sparse, kernel, soap):
+def _compute_kernel_single_sparse_gradients(
+    frame, representation, zeta, T, T_keys, T_species
+):
+    r"""Compute GAP kernel of the (new) structure against the sparse points
+    using the sparse (CSR) export of the representation gradients
+
+    For the GAP kernel :math:`k(X_i, T_m) = (X_i \cdot T_m)^\zeta` the
+    gradient with respect to the position of atom :math:`j` is
+
+    .. math::
+        \vec{\nabla}_j k(X_i, T_m) = \zeta (X_i \cdot T_m)^{\zeta-1}
+            \vec{\nabla}_j X_i \cdot T_m,
+
+    and :math:`\vec{\nabla}_j X_i` is only non zero for the species keys
+    that contain the species of :math:`j`, which is what the CSR export
+    stores.
+
+    Parameters
+    ----------
+    frame
+        New structure to compute kernel for
+    representation
+        RepresentationCalculator to use for the structures
+    zeta
+        exponent of the GAP kernel
+    T
+        dense features of the sparse points
+    T_keys
+        keys associated with the columns of T
+    T_species
+        central atom species of the sparse points
+
+    Returns
+    -------
+    en_row
+        Energy kernel row
+    grad_rows
+        Gradient of the kernel
+    """
+    managers = representation.transform([frame]).managers
+    X = managers.get_features(representation._representation, T_keys)
+    dX = managers.get_features_gradient_sparse(representation._representation, T_keys)
+    info = managers.get_gradients_info()
+    center_species = managers.get_representation_info()[:, 2]
+    n_pairs = info.shape[0]
+    n_sparse = T.shape[0]
+
+    XT = X @ T.T
+    mask = center_species[:, None] == T_species[None, :]
+    en_row = np.sum(np.where(mask, XT**zeta, 0.0), axis=0)
+    dkdX = np.where(mask, zeta * XT ** (zeta - 1), 0.0)
+
+    # pairs are grouped by center, the first one being the self pair
+    pair_center = np.cumsum(np.r_[True, info[1:, 1] != info[:-1, 1]]) - 1
+    dXT = (dX @ T.T).reshape(n_pairs, 3, n_sparse)
+    dXT *= dkdX[pair_center][:, None, :]
+    grad_rows = np.zeros((len(frame), 3, n_sparse))
+    np.add.at(grad_rows, info[:, 2], dXT)
+    return en_row, grad_rows.reshape(-1, n_sparse)
+
+
+def compute_KNM(frames, X_sparse, kernel, soap, sparse_gradients=False):
     """Compute GAP kernel of the (new) structures against the sparse points
 
     Parameters
@@ -499,6 +634,10 @@ def compute_KNM(frames, X_sparse, kernel, soap):
         Sparse points to compute kernels against
     kernel
         Kernel object to use
+    sparse_gradients
+        compute the gradient of the kernel from the sparse (CSR) export of
+        the gradients of the representation instead of the c++ kernel. Only
+        available for the GAP kernel.
 
     Returns
     -------
@@ -529,11 +668,22 @@ def compute_KNM(frames, X_sparse, kernel, soap):
         Nstructures, Ngrads, Ngrad_stride = _get_kernel_strides(frames.iterable)
     else:
         Nstructures, Ngrads, Ngrad_stride = _get_kernel_strides(frames)
+    if sparse_gradients:
+        if kernel.name != "GAP":
+            raise ValueError("sparse_gradients is only available for GAP kernels")
+        T = X_sparse.get_features()
+        T_keys = X_sparse.get_keys()
+        T_species = X_sparse.species_by_points()
     KNM = np.zeros((Nstructures + Ngrads, X_sparse.size()))
     for i_frame, frame in enumerate(frames):
-        en_row, grad_rows = _compute_kernel_single(
-            i_frame, frame, soap, X_sparse, kernel
-        )
+        if sparse_gradients:
+            en_row, grad_rows = _compute_kernel_single_sparse_gradients(
+                frame, soap, kernel._kwargs["zeta"], T, T_keys, T_species
+            )
+        else:
+            en_row, grad_rows = _compute_kernel_single(
+                i_frame, frame, soap, X_sparse, kernel
+            )
         KNM[Ngrad_stride[i_frame] : Ngrad_stride[i_frame + 1]] = grad_rows
         KNM[i_frame] = en_row
     return KNM
@@ -692,3 +842,108 @@ def train_gap_model(
     del KNM, KMM
 
     return model
+
+
+def train_gap_model_streaming(
+    kernel,
+    chunks,
+    X_sparse,
+    self_contributions,
+    delta,
+    lambdas,
+    jitter=1e-8,
+    solver="solve",
+    rcond=None,
+    n_threads=1,
+):
+    r"""Train a GAP model like `train_gap_model` but without ever storing the
+    full KNM matrix.
+
+    The rows of KNM associated with each chunk of structures are computed and
+    immediately folded into the normal equations :math:`K_{MN} \Lambda^{-2}
+    K_{NM}` and :math:`K_{MN} \Lambda^{-2} \bm{y}` by a `SparseGPRAccumulator`
+    so only :math:`O(M^2)` memory is needed whatever the number of training
+    structures and force components.
+
+    Parameters
+    ----------
+    kernel : Kernel
+        SparseKernel with target_type == 'Structure'
+    chunks : iterable
+        yields tuples `(managers, y, grad)` where managers is an AtomsList with
+        the representation of kernel already computed (with gradients when
+        grad is not None), y the reference properties of the structures and
+        grad their derivatives w.r.t. the atomic positions, e.g. minus the
+        interatomic forces, or None. It can be a generator so that only one
+        chunk lives in memory at a time.
+    X_sparse : SparsePoints
+        basis samples to use in the model's interpolation
+    self_contributions : dictionary
+        map atomic number to the property baseline, see `train_gap_model`
+    delta : float
+        scale of the property, `train_gap_model` uses the standard deviation
+        of the baselined properties of the whole training set which is not
+        known when streaming
+    lambdas : list/tuple
+        regularisation parameter for the training, i.e. lambdas[0] -> property
+        and lambdas[1] -> gradients of the property
+    jitter : double, optional
+        small jitter for the numerical stability of solving the linear system,
+        by default 1e-8
+    solver : {'RKHS', 'solve', 'lstsq'}
+        Method to solve the sparse KRR equations, see `SparseGPRSolver`
+    rcond : condition parameter for numpy.linalg.solve, ignored if solver != 'lstsq'
+    n_threads : int
+        number of threads used to compute the gradient rows of KNM, 0 for as
+        many as the hardware supports
+
+    Returns
+    -------
+    KRR
+        a trained model that can predict the property and its gradients
+    """
+    if kernel.target_type != "Structure":
+        raise ValueError("The kernel should have target_type == 'Structure'")
+    KMM = kernel(X_sparse)
+    accumulator = SparseGPRAccumulator(X_sparse.size(), 1)
+    sparse_points = X_sparse._sparse_points
+    for managers, y, grad in chunks:
+        if isinstance(managers, AtomsList):
+            managers = managers.managers
+        # all the atoms of the structures count, as in train_gap_model, not
+        # only the centers
+        atom_types = managers.get_atom_types()
+        Natoms = np.array([len(types) for types in atom_types])
+        Y0 = np.array(
+            [sum(self_contributions[sp] for sp in types) for types in atom_types]
+        )
+        Y = np.asarray(y, dtype=float).reshape(-1) - Y0
+        accumulator.accumulate_properties(
+            kernel._kernel,
+            kernel._representation,
+            managers,
+            sparse_points,
+            Y.reshape((-1, 1)),
+            delta / (lambdas[0] * np.sqrt(Natoms)),
+        )
+        if grad is not None:
+            F = np.asarray(grad, dtype=float).reshape((-1, 1))
+            accumulator.accumulate_gradients(
+                kernel._kernel,
+                kernel._representation,
+                managers,
+                sparse_points,
+                F,
+                np.full(len(F), delta / lambdas[1]),
+                n_threads,
+            )
+
+    # in current implementation KMM incorporates regularization so it is
+    # better to use an absolute jitter value
+    ssolver = SparseGPRSolver(
+        KMM, regularizer=1, jitter=jitter, solver=solver, relative_jitter=False
+    )
+    ssolver.partial_fit_normal_equations(
+        accumulator.get_KtK(), accumulator.get_KtY(), rcond=rcond
+    )
+    return KRR(ssolver._weights, kernel, X_sparse, self_contributions)
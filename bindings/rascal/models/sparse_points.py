@@ -2,6 +2,8 @@ from ..utils import BaseIO
 from ..lib._rascal.models import kernels
 from ..neighbourlist import AtomsList
 
+import numpy as np
+
 # names of existing pseudo points implementation on the pybinding side.
 _sparse_points = {}
 for k, v in kernels.__dict__.items():
@@ -88,3 +90,11 @@ class SparsePoints(BaseIO):
 
     def get_features(self):
         return self._sparse_points.get_features()
+
+    def get_keys(self):
+        """list of the keys associated with the columns of `get_features`"""
+        return self._sparse_points.get_keys()
+
+    def species_by_points(self):
+        """array of the central atom species of each pseudo point"""
+        return np.array(self._sparse_points.species_by_points())
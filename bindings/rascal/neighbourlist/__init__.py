@@ -2,4 +2,6 @@ from .structure_manager import (
     AtomsList,
     get_neighbourlist,
     convert_to_structure_list,
+    StructureStore,
+    convert_to_structure_store,
 )
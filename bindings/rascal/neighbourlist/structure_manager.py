@@ -15,6 +15,10 @@ from .base import (
     StructureCollectionFactory,
 )
 
+# memory-mapped storage of atomic structures
+StructureStore = neighbour_list.StructureStore
+convert_to_structure_store = neighbour_list.convert_to_structure_store
+
 
 class AtomsList(object):
     """
@@ -39,7 +43,9 @@ class AtomsList(object):
         Parameters
         -------
         frames :
-            list of atomic structures.
+            list of atomic structures, filename in the ASE json format or
+            memory-mapped `StructureStore` (see
+            `rascal.neighbourlist.convert_to_structure_store`).
         nl_options : dict
             Parameters for each layer of the wrapped structure manager. For
             example to initialize a neighbourlist for computing `SphericalInvariants` representation using a linked cell algorithm
@@ -60,6 +66,15 @@ class AtomsList(object):
 
         if managers is not None:
             self.managers = managers
+        elif isinstance(frames, StructureStore):
+            # if memory-mapped structure store
+            managers = StructureCollectionFactory(nl_options)
+            managers.add_structures(
+                frames,
+                start=0 if start is None else start,
+                length=-1 if length is None else length,
+            )
+            self.managers = managers
         elif isinstance(frames, str):
             # if filename
             managers = StructureCollectionFactory(nl_options)
@@ -107,14 +122,18 @@ class AtomsList(object):
         """
         selected_ids = list(map(int, selected_ids))
         new_managers = self.managers.get_subset(selected_ids)
+        if isinstance(self._frames, StructureStore):
+            frames = self._frames
+        else:
+            frames = [self._frames[idx] for idx in selected_ids]
         new_atom_list = AtomsList(
-            [self._frames[idx] for idx in selected_ids],
+            frames,
             self.nl_options,
             managers=new_managers,
         )
         return new_atom_list
 
-    def get_features(self, calculator, species=None):
+    def get_features(self, calculator, species=None, out=None, dtype=None):
         """
         Parameters
         -------
@@ -123,21 +142,53 @@ class AtomsList(object):
         species :  list of atomic number to use for building the dense feature
         matrix computed with calculators of name Spherical*
 
+        out : ndarray, optional
+            preallocated C contiguous array of float64 or float32, e.g. a
+            np.memmap, in which the features are written without any
+            intermediate copy. Its shape has to be the one of the feature
+            matrix, see `get_features_shape`.
+
+        dtype : np.float64 or np.float32, optional
+            type of the array to allocate when out is None. Defaults to
+            np.float64.
+
         Returns
         -------
         represenation_matrix : ndarray
             returns the representation bound to the calculator as dense matrix.
         """
-
         if species is None:
-            X = self.managers.get_features(calculator._representation)
+            args = (calculator._representation,)
         else:
             keys_list = calculator.get_keys(species)
-            X = self.managers.get_features(calculator._representation, keys_list)
+            args = (calculator._representation, keys_list)
+
+        if out is None and dtype is None:
+            return self.managers.get_features(*args)
 
-        return X
+        if out is None:
+            out = np.empty(self.managers.get_features_shape(*args), dtype=dtype)
+        self.managers.fill_features(*args, out)
+        return out
+
+    def get_features_shape(self, calculator, species=None):
+        """
+        Returns
+        -------
+        shape : tuple
+            shape of the feature matrix returned by `get_features` with the
+            same arguments
+        """
+        if species is None:
+            shape = self.managers.get_features_shape(calculator._representation)
+        else:
+            keys_list = calculator.get_keys(species)
+            shape = self.managers.get_features_shape(
+                calculator._representation, keys_list
+            )
+        return tuple(shape)
 
-    def get_features_gradient(self, calculator, species=None):
+    def get_features_gradient(self, calculator, species=None, out=None, dtype=None):
         """
         Parameters
         -------
@@ -146,6 +197,13 @@ class AtomsList(object):
         species :  list of atomic number to use for building the dense feature
         matrix computed with calculators of name Spherical*
 
+        out : ndarray, optional
+            preallocated C contiguous array of float64 or float32 in which
+            the gradients are written, see `get_features`.
+
+        dtype : np.float64 or np.float32, optional
+            type of the array to allocate when out is None.
+
         Returns
         -------
         dX_dr : ndarray of size (3*(n_neighbor+n_atom), n_features)
@@ -154,16 +212,65 @@ class AtomsList(object):
             matrix. The method `get_gradients_info` provides the
             necessary information for operating on the dX_dr matrix.
         """
-
         if species is None:
-            X = self.managers.get_features_gradient(calculator._representation, [])
+            keys_list = []
         else:
             keys_list = calculator.get_keys(species)
-            X = self.managers.get_features_gradient(
+
+        if out is None and dtype is None:
+            return self.managers.get_features_gradient(
+                calculator._representation, keys_list
+            )
+
+        if out is None:
+            shape = self.managers.get_features_gradient_shape(
                 calculator._representation, keys_list
             )
+            out = np.empty(shape, dtype=dtype)
+        self.managers.fill_features_gradient(calculator._representation, keys_list, out)
+        return out
+
+    def get_features_gradient_sparse(self, calculator, species=None):
+        """
+        Parameters
+        -------
+        calculator : one of the representation calculators named Spherical*
+
+        species :  list of atomic number to use for building the feature
+        matrix
+
+        Returns
+        -------
+        dX_dr : scipy.sparse.csr_matrix of size (3*(n_neighbor+n_atom), n_features)
+            same as `get_features_gradient` but only the entries of the
+            species keys that contain the neighbor species are stored, so it
+            is much smaller for multi-species systems.
+        """
+        if species is None:
+            keys_list = []
+        else:
+            keys_list = calculator.get_keys(species)
+        return self.managers.get_features_gradient_sparse(
+            calculator._representation, keys_list
+        )
+
+    def get_features_views(self, calculator):
+        """
+        Parameters
+        -------
+        calculator : one of the representation calculators named Spherical*
 
-        return X
+        Returns
+        -------
+        views : list
+            for each structure, a tuple with the list of keys and a read only
+            array of shape (n_centers, n_features) that references the
+            features computed by the calculator without copying them, or None
+            when the keys are not the same for all the centers of the
+            structure. The arrays are only valid until the features are
+            recomputed.
+        """
+        return self.managers.get_features_views(calculator._representation)
 
     def get_features_by_species(self, calculator):
         """
@@ -1,3 +1,4 @@
+from .base import FeatureCache
 from .coulomb_matrix import SortedCoulombMatrix
 from .spherical_expansion import SphericalExpansion
 from .spherical_invariants import SphericalInvariants
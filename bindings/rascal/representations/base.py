@@ -17,6 +17,7 @@ _representations_list = [
     "sphericalcovariants",
 ]
 _representations = {}
+FeatureCache = representation_calculators.FeatureCache
 for k, v in representation_calculators.__dict__.items():
     if "pybind11_builtins.pybind11_type" in str(type(v)):
         kl = k.lower()
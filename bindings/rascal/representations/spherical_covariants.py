@@ -114,6 +114,29 @@ class SphericalCovariants(BaseIO):
             accuracy : float
                 accuracy of the cubic spline
 
+            include_cutoff_function : bool, default False
+                spline the product of the radial basis functions with the
+                cutoff function so that the cutoff function is not evaluated
+                for each neighbor. Not available with the RadialScaling cutoff
+                function when rate == 0.
+
+            cache : bool, default False
+                reuse the splines computed with the same hypers within the
+                process instead of computing them again
+
+            cache_directory : str, optional
+                also store the splines in this directory and reuse them
+                across runs and processes, implies cache
+
+            n_threads : int, default 1
+                number of threads evaluating the radial contribution while
+                the splines are refined, 0 for as many as available
+            n_segments : int, default 1
+                number of segments of the same width the radial range is
+                split in, the grid of each segment is refined separately so
+                the tables are smaller when the radial contribution varies
+                quickly only in part of the range
+
         RadialDimReduction: Projection matrices to optimize radial basis,
                             requires Spline to be set
 
@@ -131,6 +154,13 @@ class SphericalCovariants(BaseIO):
 
             dict(Spline=dict(accuracy=1e-8))
 
+    spherical_harmonics_method : string, default "Legendre"
+        Algorithm used to compute the spherical harmonics of the neighbour
+        directions. 'Legendre' goes through the associated Legendre
+        polynomials and the multiples of the azimuthal angle. 'Solid' uses the
+        recursion of the real solid harmonics in the Cartesian components of
+        the directions, which only needs multiplications and additions and is
+        faster. Both give the same representation within numerical precision.
 
     Methods
     -------
@@ -162,6 +192,7 @@ class SphericalCovariants(BaseIO):
         inversion_symmetry=True,
         covariant_lambda=0,
         cutoff_function_parameters=dict(),
+        spherical_harmonics_method="Legendre",
     ):
         """Construct a SphericalExpansion representation
 
@@ -206,6 +237,7 @@ class SphericalCovariants(BaseIO):
             cutoff_function=cutoff_function,
             gaussian_density=gaussian_density,
             radial_contribution=radial_contribution,
+            spherical_harmonics_method=spherical_harmonics_method,
         )
 
         self.nl_options = [
@@ -240,6 +272,7 @@ class SphericalCovariants(BaseIO):
             "gaussian_density",
             "radial_contribution",
             "cutoff_function_parameters",
+            "spherical_harmonics_method",
         }
         hypers_clean = {key: hypers[key] for key in hypers if key in allowed_keys}
         self.hypers.update(hypers_clean)
@@ -372,6 +405,9 @@ class SphericalCovariants(BaseIO):
             radial_basis=radial_contribution["type"],
             optimization=radial_contribution["optimization"],
             cutoff_function_parameters=self.cutoff_function_parameters,
+            spherical_harmonics_method=self.hypers.get(
+                "spherical_harmonics_method", "Legendre"
+            ),
         )
         return init_params
 
@@ -88,6 +88,29 @@ class SphericalExpansion(BaseIO):
             accuracy : float
                 accuracy of the cubic spline
 
+            include_cutoff_function : bool, default False
+                spline the product of the radial basis functions with the
+                cutoff function so that the cutoff function is not evaluated
+                for each neighbor. Not available with the RadialScaling cutoff
+                function when rate == 0.
+
+            cache : bool, default False
+                reuse the splines computed with the same hypers within the
+                process instead of computing them again
+
+            cache_directory : str, optional
+                also store the splines in this directory and reuse them
+                across runs and processes, implies cache
+
+            n_threads : int, default 1
+                number of threads evaluating the radial contribution while
+                the splines are refined, 0 for as many as available
+            n_segments : int, default 1
+                number of segments of the same width the radial range is
+                split in, the grid of each segment is refined separately so
+                the tables are smaller when the radial contribution varies
+                quickly only in part of the range
+
         RadialDimReduction: Projection matrices to optimize radial basis,
                             requires Spline to be set
 
@@ -152,6 +175,14 @@ class SphericalExpansion(BaseIO):
 
         where :code:`...` should be replaced by the desired positive float.
 
+    spherical_harmonics_method : string, default "Legendre"
+        Algorithm used to compute the spherical harmonics of the neighbour
+        directions. 'Legendre' goes through the associated Legendre
+        polynomials and the multiples of the azimuthal angle. 'Solid' uses the
+        recursion of the real solid harmonics in the Cartesian components of
+        the directions, which only needs multiplications and additions and is
+        faster. Both give the same representation within numerical precision.
+
     Methods
     -------
     transform(frames)
@@ -180,6 +211,7 @@ class SphericalExpansion(BaseIO):
         global_species=None,
         compute_gradients=False,
         cutoff_function_parameters=dict(),
+        spherical_harmonics_method="Legendre",
     ):
         """Construct a SphericalExpansion representation
 
@@ -225,6 +257,7 @@ class SphericalExpansion(BaseIO):
             cutoff_function=cutoff_function,
             gaussian_density=gaussian_density,
             radial_contribution=radial_contribution,
+            spherical_harmonics_method=spherical_harmonics_method,
         )
 
         self.nl_options = [
@@ -256,6 +289,7 @@ class SphericalExpansion(BaseIO):
             "radial_contribution",
             "compute_gradients",
             "cutoff_function_parameters",
+            "spherical_harmonics_method",
             "expansion_by_species_method",
             "global_species",
         }
@@ -317,6 +351,9 @@ class SphericalExpansion(BaseIO):
             radial_basis=radial_contribution["type"],
             optimization=radial_contribution["optimization"],
             cutoff_function_parameters=self.cutoff_function_parameters,
+            spherical_harmonics_method=self.hypers.get(
+                "spherical_harmonics_method", "Legendre"
+            ),
         )
         return init_params
 
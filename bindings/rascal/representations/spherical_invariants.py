@@ -3,6 +3,7 @@ from itertools import product
 import ase
 
 from .base import (
+    FeatureCache,
     CalculatorFactory,
     cutoff_function_dict_switch,
     check_optimization_for_spherical_representations,
@@ -117,6 +118,29 @@ class SphericalInvariants(BaseIO):
             accuracy : float
                 accuracy of the cubic spline
 
+            include_cutoff_function : bool, default False
+                spline the product of the radial basis functions with the
+                cutoff function so that the cutoff function is not evaluated
+                for each neighbor. Not available with the RadialScaling cutoff
+                function when rate == 0.
+
+            cache : bool, default False
+                reuse the splines computed with the same hypers within the
+                process instead of computing them again
+
+            cache_directory : str, optional
+                also store the splines in this directory and reuse them
+                across runs and processes, implies cache
+
+            n_threads : int, default 1
+                number of threads evaluating the radial contribution while
+                the splines are refined, 0 for as many as available
+            n_segments : int, default 1
+                number of segments of the same width the radial range is
+                split in, the grid of each segment is refined separately so
+                the tables are smaller when the radial contribution varies
+                quickly only in part of the range
+
         RadialDimReduction: Projection matrices to optimize radial basis,
                             requires Spline to be set
 
@@ -193,6 +217,14 @@ class SphericalInvariants(BaseIO):
         :class:`..utils.FPSFilter` and :class:`..utils.CURFilter` with
         `act_on` set to `feature` output such dictionary.
 
+    spherical_harmonics_method : string, default "Legendre"
+        Algorithm used to compute the spherical harmonics of the neighbour
+        directions. 'Legendre' goes through the associated Legendre
+        polynomials and the multiples of the azimuthal angle. 'Solid' uses the
+        recursion of the real solid harmonics in the Cartesian components of
+        the directions, which only needs multiplications and additions and is
+        faster. Both give the same representation within numerical precision.
+
     Methods
     -------
     transform(frames)
@@ -225,6 +257,7 @@ class SphericalInvariants(BaseIO):
         compute_gradients=False,
         cutoff_function_parameters=dict(),
         coefficient_subselection=None,
+        spherical_harmonics_method="Legendre",
     ):
         """Construct a SphericalExpansion representation
 
@@ -276,6 +309,7 @@ class SphericalInvariants(BaseIO):
             cutoff_function=cutoff_function,
             gaussian_density=gaussian_density,
             radial_contribution=radial_contribution,
+            spherical_harmonics_method=spherical_harmonics_method,
         )
 
         if soap_type == "RadialSpectrum":
@@ -312,6 +346,7 @@ class SphericalInvariants(BaseIO):
             "gaussian_density",
             "radial_contribution",
             "cutoff_function_parameters",
+            "spherical_harmonics_method",
             "expansion_by_species_method",
             "compute_gradients",
             "global_species",
@@ -342,6 +377,25 @@ class SphericalInvariants(BaseIO):
 
         return frames
 
+    def set_feature_cache(self, feature_cache):
+        """Persist the computed features on disk.
+
+        The features (and gradients) of each structure are stored in the
+        cache, keyed by the hyperparameters and the atomic structure, and are
+        loaded from it instead of being recomputed when the same structure is
+        transformed again with the same hyperparameters, e.g. across the runs
+        of a hyperparameter search.
+
+        Parameters
+        ----------
+        feature_cache : FeatureCache, str or None
+            cache to use. A path creates a cache without size limit in this
+            directory and None disables the cache.
+        """
+        if isinstance(feature_cache, str):
+            feature_cache = FeatureCache(feature_cache)
+        self._representation.set_feature_cache(feature_cache)
+
     def get_num_coefficients(self, n_species=1):
         """Return the number of coefficients in the spherical invariants
 
@@ -430,6 +484,9 @@ class SphericalInvariants(BaseIO):
             radial_basis=radial_contribution["type"],
             optimization=radial_contribution["optimization"],
             cutoff_function_parameters=self.cutoff_function_parameters,
+            spherical_harmonics_method=self.hypers.get(
+                "spherical_harmonics_method", "Legendre"
+            ),
         )
         if "coefficient_subselection" in self.hypers:
             init_params["coefficient_subselection"] = self.hypers[
@@ -1,6 +1,7 @@
 import logging
 import numpy as np
 from .io import BaseIO
+from ..lib import select_farthest_points, select_cur
 from ..models.sparse_points import SparsePoints
 from ..representations.spherical_invariants import SphericalInvariants
 
@@ -313,6 +314,23 @@ class Filter(BaseIO):
                 )
             return self
 
+    def _check_n_samples(self, managers, n_select, species):
+        """Check that there are n_select samples of the given species (of
+        any species if empty) to select from, before a native selection.
+
+        Only the center types are read so the features are never densified.
+        """
+        n_samples = 0
+        for structure in managers:
+            for atom in structure:
+                if len(species) == 0 or atom.atom_type in species:
+                    n_samples += 1
+        if n_select > n_samples:
+            species_str = f" of species {species}" if len(species) > 0 else ""
+            raise ValueError(
+                f"Cannot select {n_select} samples{species_str} out of {n_samples}"
+            )
+
     def filter(self, managers, n_select=None):
         """Apply the fitted selection to a new set of managers
 
@@ -431,17 +449,49 @@ class Filter(BaseIO):
 
 
 class CURFilter(Filter):
+    """CUR selection of samples or features
+
+    By default (`method="exact"`) the selection uses skmatter on the dense
+    feature matrix. With `method="randomized"`, only available for the
+    SphericalInvariants representation, the selection is done in C++ (see
+    `select_cur`): the dominant subspace of the features is found with a
+    randomized range finder that streams the features one structure at a time,
+    so the feature matrix is never densified as a whole. The selection is then
+    exact only up to the accuracy of the range finder.
+
+    `selector_args` can contain `k`, the number of singular vectors used for
+    the leverage scores (1 by default), and for the randomized selection
+    `n_oversampling`, `n_power_iterations` and `seed` of the range finder.
+    """
+
+    _native_args = ["k", "n_oversampling", "n_power_iterations", "seed"]
+
     def __init__(
         self,
         representation,
         Nselect,
         act_on="sample per species",
         selector_args={},
+        n_threads=1,
+        method="exact",
         **kwargs,
     ):
         modes = ["sample", "sample per species", "feature"]
         self._check_set_mode(act_on, modes)
-        if act_on == "sample":
+        self.n_threads = n_threads
+        self._selector_args = selector_args
+        if method not in ["exact", "randomized"]:
+            raise ValueError('"method" should be either "exact" or "randomized"')
+        self.method = method
+        if method == "randomized":
+            if not isinstance(representation, SphericalInvariants):
+                raise ValueError(
+                    "The randomized CUR selection is only available for "
+                    "SphericalInvariants"
+                )
+            # native selection, see select()
+            selector = None
+        elif act_on == "sample":
             selector = _CUR(
                 selection_type="sample", n_to_select=Nselect, **selector_args
             )
@@ -469,19 +519,90 @@ class CURFilter(Filter):
             **kwargs,
         )
 
+    def select(self, managers):
+        if self._selector is not None:
+            return super().select(managers)
+
+        def cur(selection_type, n_select, species):
+            hypers = {
+                key: val
+                for key, val in self._selector_args.items()
+                if key in self._native_args
+            }
+            hypers.update(
+                selection_type=selection_type, n_select=n_select, species=species
+            )
+            if selection_type == "sample":
+                self._check_n_samples(managers, n_select, species)
+            try:
+                selected_ids = select_cur(
+                    self._representation._representation,
+                    managers.managers,
+                    hypers,
+                    self.n_threads,
+                )
+            except RuntimeError as error:
+                raise ValueError(str(error)) from error
+            return np.array(selected_ids, dtype=int)
+
+        if self.act_on == "sample per species":
+            LOGGER.info(
+                f"The number of pseudo points selected by central atom species is: {self.Nselect}"
+            )
+            self.selected_sample_ids_by_sp = {}
+            for sp, n_select in self.Nselect.items():
+                LOGGER.info(f"Selecting species: {sp}")
+                if n_select > 0:
+                    self.selected_sample_ids_by_sp[sp] = cur("sample", n_select, [sp])
+                else:
+                    self.selected_sample_ids_by_sp[sp] = []
+        elif self.act_on == "sample":
+            self.selected_sample_ids = cur("sample", self.Nselect, [])
+        else:
+            self.selected_feature_ids_global = cur("feature", self.Nselect, [])
+        return self
+
+    def _get_init_params(self):
+        init_params = super()._get_init_params()
+        init_params.update(
+            selector_args=self._selector_args,
+            n_threads=self.n_threads,
+            method=self.method,
+        )
+        return init_params
+
 
 class FPSFilter(Filter):
+    """Farthest point sampling (FPS) of samples or features
+
+    In the "sample" and "sample per species" modes with the SphericalInvariants
+    representation the selection is done in C++ directly on the block sparse
+    features (see `select_farthest_points`), so the feature matrix is never
+    densified and the distances are updated with `n_threads` threads. The other
+    cases use skmatter.
+
+    `selector_args` can contain `initialize`, the index of the first selected
+    sample, which defaults to 0.
+    """
+
     def __init__(
         self,
         representation,
         Nselect,
         act_on="sample per species",
         selector_args={},
+        n_threads=1,
         **kwargs,
     ):
         modes = ["sample", "sample per species", "feature"]
         self._check_set_mode(act_on, modes)
-        if act_on == "sample":
+        self.n_threads = n_threads
+        self._selector_args = selector_args
+        self._fps_distances = None
+        if act_on != "feature" and isinstance(representation, SphericalInvariants):
+            # native selection, see select()
+            selector = None
+        elif act_on == "sample":
             selector = _FPS(
                 selection_type="sample", n_to_select=Nselect, **selector_args
             )
@@ -509,6 +630,46 @@ class FPSFilter(Filter):
             **kwargs,
         )
 
+    def select(self, managers):
+        if self._selector is not None:
+            return super().select(managers)
+        initialize = self._selector_args.get("initialize", 0)
+        if not isinstance(initialize, (int, np.integer)):
+            raise ValueError("initialize should be the index of the first sample")
+
+        def fps(n_select, species):
+            self._check_n_samples(managers, n_select, species)
+            try:
+                selected_ids, distances = select_farthest_points(
+                    self._representation._representation,
+                    managers.managers,
+                    n_select,
+                    species,
+                    initialize,
+                    self.n_threads,
+                )
+            except RuntimeError as error:
+                raise ValueError(str(error)) from error
+            return np.array(selected_ids, dtype=int), np.array(distances)
+
+        if self.act_on == "sample per species":
+            LOGGER.info(
+                f"The number of pseudo points selected by central atom species is: {self.Nselect}"
+            )
+            self.selected_sample_ids_by_sp = {}
+            self._fps_distances = {}
+            for sp, n_select in self.Nselect.items():
+                LOGGER.info(f"Selecting species: {sp}")
+                if n_select > 0:
+                    ids, distances = fps(n_select, [sp])
+                else:
+                    ids, distances = [], np.zeros(0)
+                self.selected_sample_ids_by_sp[sp] = ids
+                self._fps_distances[sp] = distances
+        else:
+            self.selected_sample_ids, self._fps_distances = fps(self.Nselect, [])
+        return self
+
     def get_fps_distances(self):
         """Return the Hausdorff distances over the course of selection
 
@@ -520,9 +681,16 @@ class FPSFilter(Filter):
         Returns either an array of Hausdorff distances, or a species-indexed
         dict of arrays (for the "sample per species" mode).
         """
-        if self.act_on == "sample per species":
+        if self._selector is None:
+            return self._fps_distances
+        elif self.act_on == "sample per species":
             return {
                 sp: self._selector[sp].get_select_distance() for sp in self._selector
             }
         else:
             return self._selector.get_select_distance()
+
+    def _get_init_params(self):
+        init_params = super()._get_init_params()
+        init_params.update(selector_args=self._selector_args, n_threads=self.n_threads)
+        return init_params
@@ -0,0 +1,115 @@
+/**
+ * @file  performance/benchmarks/benchmark_bessel.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief benchmarks for the modified spherical Bessel functions of the DVR
+ *        radial contribution, one neighbour at a time or all at once
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/math/bessel.hh"
+#include "rascal/math/gauss_legendre.hh"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace rascal {
+  /**
+   * Modified spherical Bessel functions on the Gauss-Legendre points of a
+   * DVR basis (cutoff 5, sigma 0.5) for the neighbours of one center.
+   *
+   * The arguments of the benchmarks are max_radial, max_angular, the number
+   * of neighbours and whether the gradients are computed.
+   */
+  struct BesselBFixture {
+    explicit BesselBFixture(const benchmark::State & state)
+        : max_radial{static_cast<int>(state.range(0))},
+          max_angular{static_cast<size_t>(state.range(1))},
+          nb_neighbours{static_cast<int>(state.range(2))},
+          compute_gradients{state.range(3) != 0} {
+      const double cutoff{5.}, sigma{0.5};
+      this->fac_a = 0.5 / (sigma * sigma);
+      auto point_weight{math::compute_gauss_legendre_points_weights(
+          0., cutoff + 3 * sigma, this->max_radial)};
+      this->bessel.precompute(this->max_angular, point_weight.col(0),
+                              this->compute_gradients);
+      std::mt19937 generator{1};
+      std::uniform_real_distribution<double> distribution{0.5, cutoff};
+      this->distances.resize(this->nb_neighbours);
+      for (int i_neigh{0}; i_neigh < this->nb_neighbours; ++i_neigh) {
+        this->distances(i_neigh) = distribution(generator);
+      }
+    }
+
+    int max_radial;
+    size_t max_angular;
+    int nb_neighbours;
+    bool compute_gradients;
+    double fac_a{};
+    Eigen::VectorXd distances{};
+    math::ModifiedSphericalBessel bessel{};
+  };
+
+  // Benchmark for the evaluation of one neighbour at a time
+  void bm_bessel_per_pair(benchmark::State & state) {
+    BesselBFixture fix{state};
+    for (auto _ : state) {
+      for (int i_neigh{0}; i_neigh < fix.nb_neighbours; ++i_neigh) {
+        fix.bessel.calc(fix.distances(i_neigh), fix.fac_a);
+        benchmark::DoNotOptimize(fix.bessel.get_values().data());
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * fix.nb_neighbours);
+  }
+
+  // Benchmark for the evaluation of all the neighbours at once
+  void bm_bessel_batch(benchmark::State & state) {
+    BesselBFixture fix{state};
+    for (auto _ : state) {
+      fix.bessel.calc(fix.distances, fix.fac_a);
+      for (int i_neigh{0}; i_neigh < fix.nb_neighbours; ++i_neigh) {
+        fix.bessel.set_from_batch(i_neigh);
+        benchmark::DoNotOptimize(fix.bessel.get_values().data());
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * fix.nb_neighbours);
+  }
+
+  void bessel_arguments(benchmark::internal::Benchmark * benchmark) {
+    for (int64_t max_radial : {6, 12}) {
+      for (int64_t max_angular : {0, 6, 9}) {
+        for (int64_t nb_neighbours : {16, 64}) {
+          for (int64_t compute_gradients : {0, 1}) {
+            benchmark->Args(
+                {max_radial, max_angular, nb_neighbours, compute_gradients});
+          }
+        }
+      }
+    }
+  }
+
+  BENCHMARK(bm_bessel_per_pair)->Apply(bessel_arguments);
+  BENCHMARK(bm_bessel_batch)->Apply(bessel_arguments);
+
+}  // namespace rascal
+
+BENCHMARK_MAIN();
@@ -134,6 +134,54 @@ namespace rascal {
          {"grid_size", grid_size}});
   }
 
+  /**
+   * Benchmark for the value and the derivative of the RadialContribution
+   * interpolated one after the other, as done when computing gradients
+   * without fused evaluation
+   */
+  template <class BFixture>
+  void bm_radial_contr_intp_separate(benchmark::State & state,
+                                     BFixture & fix) {
+    fix.setup(state);
+    Matrix_t value = Matrix_t::Zero(fix.max_radial, fix.max_angular + 1);
+    Matrix_t derivative = Matrix_t::Zero(fix.max_radial, fix.max_angular + 1);
+    for (auto _ : state) {
+      for (size_t i{0}; i < fix.nb_iterations; i++) {
+        const double x{fix.ref_points(i % fix.ref_points.size())};
+        fix.intp->interpolate_into(x, value);
+        fix.intp->interpolate_derivative_into(x, derivative);
+        benchmark::DoNotOptimize(value.data());
+        benchmark::DoNotOptimize(derivative.data());
+      }
+    }
+    state.SetComplexityN(fix.nb_iterations);
+    state.counters.insert({{"nb_iterations", fix.nb_iterations},
+                           {"max_radial", fix.max_radial},
+                           {"max_angular", fix.max_angular},
+                           {"grid_size", fix.intp->get_grid_size()}});
+  }
+
+  //! Same as bm_radial_contr_intp_separate with the fused evaluation
+  template <class BFixture>
+  void bm_radial_contr_intp_fused(benchmark::State & state, BFixture & fix) {
+    fix.setup(state);
+    Matrix_t value = Matrix_t::Zero(fix.max_radial, fix.max_angular + 1);
+    Matrix_t derivative = Matrix_t::Zero(fix.max_radial, fix.max_angular + 1);
+    for (auto _ : state) {
+      for (size_t i{0}; i < fix.nb_iterations; i++) {
+        fix.intp->interpolate_with_derivative(
+            fix.ref_points(i % fix.ref_points.size()), value, derivative);
+        benchmark::DoNotOptimize(value.data());
+        benchmark::DoNotOptimize(derivative.data());
+      }
+    }
+    state.SetComplexityN(fix.nb_iterations);
+    state.counters.insert({{"nb_iterations", fix.nb_iterations},
+                           {"max_radial", fix.max_radial},
+                           {"max_angular", fix.max_angular},
+                           {"grid_size", fix.intp->get_grid_size()}});
+  }
+
   // Benchmark for SphericalExpansion with or without the interpolator
   template <class BFixture>
   void bm_spherical(benchmark::State & state, BFixture & fix) {
@@ -170,6 +218,12 @@ namespace rascal {
   BENCHMARK_CAPTURE(bm_radial_contr_intp, /* name */, intp_mat_fix)
       ->Apply(all_combinations_of_arguments<RadialContributionDataset>)
       ->Complexity();
+  BENCHMARK_CAPTURE(bm_radial_contr_intp_separate, /* name */, intp_mat_fix)
+      ->Apply(all_combinations_of_arguments<RadialContributionDataset>)
+      ->Complexity();
+  BENCHMARK_CAPTURE(bm_radial_contr_intp_fused, /* name */, intp_mat_fix)
+      ->Apply(all_combinations_of_arguments<RadialContributionDataset>)
+      ->Complexity();
 
   /**
    * Spherical Expansion without gradient benchmarks
@@ -27,8 +27,27 @@
 
 #include "rascal/math/bessel.hh"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace rascal::math;  // NOLINT
 
+namespace {
+  /**
+   * The recursions lose accuracy below 1e-100 so these values are set to 0,
+   * see ModifiedSphericalBessel::set_small_bessel_values_to_zero
+   */
+  void set_small_values_to_zero(Eigen::ArrayXXd & values) {
+    values = values.unaryExpr([](double d) {
+      if (d < 1e-100) {
+        return 0.;
+      } else {
+        return d;
+      }
+    });
+  }
+}  // namespace
+
 void ModifiedSphericalBessel::precompute(
     size_t l_max, const Eigen::Ref<const Eigen::VectorXd> & x_v,
     bool compute_gradients) {
@@ -180,11 +199,185 @@ void ModifiedSphericalBessel::calc(double distance, double fac_a) {
 }
 
 void ModifiedSphericalBessel::set_small_bessel_values_to_zero() {
-  this->bessel_values = this->bessel_values.unaryExpr([](double d) {
-    if (d < 1e-100) {
-      return 0.;
-    } else {
-      return d;
+  set_small_values_to_zero(this->bessel_values);
+}
+
+void ModifiedSphericalBessel::upward_recursion_batch(double fac_a,
+                                                     int first_row,
+                                                     int n_rows) {
+  auto vals = this->batch_values.middleRows(first_row, n_rows);
+  auto r = this->batch_r.segment(first_row, n_rows);
+  auto x = this->batch_x.segment(first_row, n_rows);
+  Eigen::ArrayXd arg_i{this->batch_arg.segment(first_row, n_rows).inverse()};
+  Eigen::ArrayXd exp_minus{Eigen::exp(-fac_a * (x - r).square())};
+  Eigen::ArrayXd exp_plus{Eigen::exp(-fac_a * (x + r).square())};
+  // i_0(z) = sinh(z) / z
+  vals.col(0) = (exp_minus - exp_plus) * 0.5 * arg_i;
+  if (this->order_max == 1) {
+    return;
+  }
+  // i_1(z) = cosh(z)/z - i_0(z)/z
+  vals.col(1) = (exp_minus + exp_plus) * 0.5 * arg_i - vals.col(0) * arg_i;
+  for (int order{2}; order < this->order_max; ++order) {
+    vals.col(order) =
+        vals.col(order - 2) - vals.col(order - 1) * (2. * order - 1.) * arg_i;
+  }
+}
+
+void ModifiedSphericalBessel::downward_recursion_batch(double fac_a,
+                                                       int first_row,
+                                                       int n_rows) {
+  auto vals = this->batch_values.middleRows(first_row, n_rows);
+  auto arg = this->batch_arg.segment(first_row, n_rows);
+  Eigen::ArrayXd arg_i{arg.inverse()};
+  Eigen::ArrayXd efac{
+      Eigen::exp(-fac_a * this->batch_r.segment(first_row, n_rows).square()) *
+      Eigen::exp(-fac_a * this->batch_x.segment(first_row, n_rows).square())};
+  // the hyp1f1s compute G(a, b, z) = Gamma(a) / Gamma(b) exp(z2) 1F1(a, b, z)
+  // with z = 2x, z2 = -x so with the duplication formula of the Gamma
+  // function the initial values are i_l(x) = G(l+1, 2l+2, 2x) (2x)^l
+  Eigen::ArrayXd z{2. * arg};
+  Eigen::ArrayXd z2{-arg};
+  Eigen::ArrayXd ez2{Eigen::exp(z2)};
+  Eigen::ArrayXd hyp1f1_values(n_rows);
+  for (int i_order{0}; i_order < 2; ++i_order) {
+    int order{this->order_max - 2 + i_order};
+    // the arguments are sorted within each run
+    int first_run_row{0};
+    for (const int & n_run_rows : this->batch_down_runs) {
+      this->hyp1f1s[i_order].calc(
+          z.segment(first_run_row, n_run_rows),
+          z2.segment(first_run_row, n_run_rows),
+          ez2.segment(first_run_row, n_run_rows), false,
+          hyp1f1_values.segment(first_run_row, n_run_rows));
+      first_run_row += n_run_rows;
+    }
+    vals.col(order) =
+        hyp1f1_values * efac *
+        z.unaryExpr([order](double z_i) { return math::pow(z_i, order); });
+  }
+
+  for (int order{this->order_max - 3}; order >= 0; --order) {
+    vals.col(order) =
+        vals.col(order + 2) + vals.col(order + 1) * (2. * order + 3.) * arg_i;
+  }
+}
+
+void ModifiedSphericalBessel::gradient_recursion_batch(double fac_a) {
+  // compute 1st part
+  this->batch_gradients =
+      this->batch_values.leftCols(this->l_max + 1).colwise() *
+      (-2. * fac_a * this->batch_r);
+  // add 2nd part
+  Eigen::ArrayXd efac{2. * fac_a * this->batch_x};
+  this->batch_gradients.col(0) += efac * this->batch_values.col(1);
+  // use recurrence relationship
+  for (int i_order{1}; i_order < this->order_max - 1; i_order++) {
+    this->batch_gradients.col(i_order) +=
+        efac *
+        (i_order * this->batch_values.col(i_order - 1) +
+         (i_order + 1) * this->batch_values.col(i_order + 1)) /
+        (2. * i_order + 1.);
+  }
+}
+
+void ModifiedSphericalBessel::calc(
+    const Eigen::Ref<const Eigen::VectorXd> & distances, double fac_a) {
+  const int n_distances{static_cast<int>(distances.size())};
+  const int n_rows{n_distances * this->n_max};
+  // for a given x-value the argument increases with the distance
+  std::vector<int> distance_order(n_distances);
+  std::iota(distance_order.begin(), distance_order.end(), 0);
+  std::sort(distance_order.begin(), distance_order.end(),
+            [&distances](int i_distance, int j_distance) {
+              return distances(i_distance) < distances(j_distance);
+            });
+  const int n_small{static_cast<int>(
+      std::partition_point(distance_order.begin(), distance_order.end(),
+                           [&distances](int i_distance) {
+                             return distances(i_distance) <
+                                    SPHERICAL_BESSEL_FUNCTION_FTOL;
+                           }) -
+      distance_order.begin())};
+
+  this->batch_rows.resize(n_rows);
+  this->batch_r.resize(n_rows);
+  this->batch_x.resize(n_rows);
+  this->batch_arg.resize(n_rows);
+  this->batch_down_runs.clear();
+  int i_sorted{0};
+  auto add_row = [&](int i_distance, int i_x) {
+    this->batch_rows[i_distance * this->n_max + i_x] = i_sorted;
+    this->batch_r(i_sorted) = distances(i_distance);
+    this->batch_x(i_sorted) = this->x_v(i_x);
+    this->batch_arg(i_sorted) =
+        (2. * fac_a * distances(i_distance)) * this->x_v(i_x);
+    ++i_sorted;
+  };
+  // the rows of the distances too small for the recursions come first
+  for (int i_small{0}; i_small < n_small; ++i_small) {
+    for (int i_x{0}; i_x < this->n_max; ++i_x) {
+      add_row(distance_order[i_small], i_x);
+    }
+  }
+  // then for each x-value the rows where bessel_arg <= 50 use the downward
+  // recursion, recursions are not valid for order_max==1 so the direct
+  // computation of the upward recursion is used for all the rows
+  if (this->order_max > 1) {
+    for (int i_x{0}; i_x < this->n_max; ++i_x) {
+      int i_order{n_small};
+      for (; i_order < n_distances; ++i_order) {
+        const int i_distance{distance_order[i_order]};
+        if ((2. * fac_a * distances(i_distance)) * this->x_v(i_x) > 50) {
+          break;
+        }
+        add_row(i_distance, i_x);
+      }
+      this->batch_down_runs.push_back(i_order - n_small);
+    }
+  }
+  const int n_down{i_sorted - n_small * this->n_max};
+  // and the rows of the upward recursion
+  for (int i_x{0}; i_x < this->n_max; ++i_x) {
+    int i_order{n_small};
+    if (this->order_max > 1) {
+      i_order += this->batch_down_runs[i_x];
+    }
+    for (; i_order < n_distances; ++i_order) {
+      add_row(distance_order[i_order], i_x);
     }
-  });
+  }
+
+  this->batch_values.resize(n_rows, this->order_max);
+  // 0th order approximation
+  const int n_small_rows{n_small * this->n_max};
+  this->batch_values.topRows(n_small_rows).setZero();
+  this->batch_values.col(0).head(n_small_rows) =
+      Eigen::exp(-this->batch_x.head(n_small_rows).square() * fac_a);
+  if (n_down > 0) {
+    this->downward_recursion_batch(fac_a, n_small_rows, n_down);
+  }
+  const int n_up{n_rows - n_small_rows - n_down};
+  if (n_up > 0) {
+    this->upward_recursion_batch(fac_a, n_small_rows + n_down, n_up);
+  }
+  assert(this->batch_values.isFinite().all());
+  set_small_values_to_zero(this->batch_values);
+
+  // compute gradients
+  if (this->compute_gradients) {
+    this->gradient_recursion_batch(fac_a);
+    this->batch_gradients.topRows(n_small_rows).setZero();
+    assert(this->batch_gradients.isFinite().all());
+  }
+}
+
+void ModifiedSphericalBessel::set_from_batch(int i_distance) {
+  for (int i_x{0}; i_x < this->n_max; ++i_x) {
+    const int i_row{this->batch_rows[i_distance * this->n_max + i_x]};
+    this->bessel_values.row(i_x) = this->batch_values.row(i_row);
+    if (this->compute_gradients) {
+      this->bessel_gradients.row(i_x) = this->batch_gradients.row(i_row);
+    }
+  }
 }
@@ -81,6 +81,20 @@ namespace rascal {
        */
       void calc(double distance, double fac_a);
 
+      /**
+       * Compute the MBSFs of all the distances at once, see calc(double,
+       * double). The (distance, x-value) pairs are the rows of a single
+       * array grouped by recursion so that the recursions, and the 1F1 that
+       * initialize the downward recursion, are vectorized over all the
+       * distances. Then set_from_batch() makes the values of one of the
+       * distances available through get_values() and get_gradients().
+       */
+      void calc(const Eigen::Ref<const Eigen::VectorXd> & distances,
+                double fac_a);
+
+      //! Load the values of distances(i_distance) from the last batch
+      void set_from_batch(int i_distance);
+
       /**
        * Initialize arrays for the computation of
        * @param x_v      Eigen::Array of x-values (part of the argument of the
@@ -186,6 +200,18 @@ namespace rascal {
        */
       void set_small_bessel_values_to_zero();
 
+      /**
+       * Batch versions of the recursions on the n_rows rows of
+       * batch_values starting at first_row, using the distance (batch_r),
+       * x-value (batch_x) and argument (batch_arg) of each row.
+       */
+      void upward_recursion_batch(double fac_a, int first_row, int n_rows);
+
+      //! the 1F1 are evaluated on each of the batch_down_runs
+      void downward_recursion_batch(double fac_a, int first_row, int n_rows);
+
+      void gradient_recursion_batch(double fac_a);
+
       Eigen::ArrayXXd bessel_values{};
       Eigen::ArrayXXd bessel_gradients{};
 
@@ -197,6 +223,22 @@ namespace rascal {
       std::vector<Hyp1f1> hyp1f1s{};
       Eigen::ArrayXd igammas{};
 
+      //! values and gradients of the last batch, one row per
+      //! (distance, x-value) pair: the distances below
+      //! SPHERICAL_BESSEL_FUNCTION_FTOL, then the rows of the downward
+      //! recursion and of the upward recursion, both by x-value and
+      //! increasing distance
+      Eigen::ArrayXXd batch_values{};
+      Eigen::ArrayXXd batch_gradients{};
+      Eigen::ArrayXd batch_r{};
+      Eigen::ArrayXd batch_x{};
+      Eigen::ArrayXd batch_arg{};
+      //! row of batch_values of the x-value i_x of the distance i_distance
+      //! is batch_rows[i_distance * n_max + i_x]
+      std::vector<int> batch_rows{};
+      //! number of rows of the downward recursion of each x-value
+      std::vector<int> batch_down_runs{};
+
       bool compute_gradients{false};
       int order_max{};
       size_t l_max{};
@@ -26,6 +26,9 @@
 
 #include "rascal/math/hyp1f1.hh"
 
+#include <algorithm>
+#include <numeric>
+
 using namespace rascal::math;            // NOLINT
 using namespace rascal::math::internal;  // NOLINT
 
@@ -47,6 +50,25 @@ static double recurence_G_to_der_downward(double, double b, double z,
   return z * M2p3p + M1p2p * (b + 1);
 }
 
+/**
+ * Fill result with sum(z_block) for the consecutive blocks of
+ * Hyp1f1BlockSize elements of z, the last one is padded with its last
+ * element.
+ */
+template <class Sum>
+static void sum_by_block(const Array_Ref & z, Eigen::Ref<Eigen::ArrayXd> result,
+                         Sum && sum) {
+  const Eigen::Index n_z{z.size()};
+  Hyp1f1Block_t z_block{};
+  for (Eigen::Index start{0}; start < n_z; start += Hyp1f1BlockSize) {
+    const Eigen::Index size{
+        std::min(static_cast<Eigen::Index>(Hyp1f1BlockSize), n_z - start)};
+    z_block.head(size) = z.segment(start, size);
+    z_block.tail(Hyp1f1BlockSize - size).setConstant(z(start + size - 1));
+    result.segment(start, size) = sum(z_block).head(size);
+  }
+}
+
 Hyp1f1Series::Hyp1f1Series(double a, double b, size_t mmax, double tolerance)
     : a{a}, b{b}, mmax{mmax}, prefac{std::tgamma(a) / std::tgamma(b)},
       tolerance{tolerance} {
@@ -152,6 +174,54 @@ double Hyp1f1Series::sum(double z, const Eigen::VectorXd & coefficient,
   return res;
 }
 
+void Hyp1f1Series::calc(const Array_Ref & z, const Array_Ref & z2,
+                        const Array_Ref & ez2, bool derivative,
+                        Eigen::Ref<Eigen::ArrayXd> result) {
+  if (this->is_exp) {
+    result = this->prefac * (z + z2).exp();
+    return;
+  }
+  const auto & coefficient{derivative ? this->coeff_derivative : this->coeff};
+  sum_by_block(z, result, [&](const Hyp1f1Block_t & z_block) {
+    return this->sum(z_block, coefficient);
+  });
+  if (derivative) {
+    result *= this->a / this->b;
+  }
+  result *= this->prefac * ez2;
+}
+
+Hyp1f1Block_t Hyp1f1Series::sum(const Hyp1f1Block_t & z,
+                                const Eigen::VectorXd & coefficient) {
+  // same sum as the adaptive scalar one but the bailout test has to pass
+  // for the whole block. The elements that converged first only add terms
+  // below the tolerance, they are not masked since it would prevent the
+  // vectorization.
+  Hyp1f1Block_t res{Hyp1f1Block_t::Ones()};
+  Hyp1f1Block_t zpow{z};
+  Hyp1f1Block_t z4{z.square().square()};
+  Hyp1f1Block_t a1{};
+  for (size_t i{0}; i < this->mmax - 3; i += 4) {
+    a1 = zpow * (coefficient(i) +
+                 z * (coefficient(i + 1) +
+                      z * (coefficient(i + 2) + z * coefficient(i + 3))));
+    bool converged{(a1 < this->tolerance * res).all()};
+    res += a1;
+    if (converged) {
+      break;
+    }
+    zpow *= z4;
+  }
+  if ((res > DOVERFLOW).any()) {
+    std::stringstream error{};
+    error << "Hyp1f1Series series expansion: a=" << std::to_string(this->a)
+          << " b=" << std::to_string(this->b)
+          << " z=" << std::to_string(z.maxCoeff()) << std::endl;
+    throw std::overflow_error(error.str());
+  }
+  return res;
+}
+
 Hyp1f1Asymptotic::Hyp1f1Asymptotic(double a, double b, size_t mmax,
                                    double tolerance)
     : a{a}, b{b}, prefac{std::tgamma(b) / std::tgamma(a)}, tolerance{tolerance},
@@ -269,6 +339,56 @@ double Hyp1f1Asymptotic::sum(double z, const Eigen::VectorXd & coefficient,
   return res;
 }
 
+void Hyp1f1Asymptotic::calc(const Array_Ref & z, const Array_Ref & z2,
+                            bool derivative,
+                            Eigen::Ref<Eigen::ArrayXd> result) {
+  if (this->is_exp) {
+    result = (z + z2).exp() / this->prefac;
+    return;
+  }
+  const auto & coefficient{derivative ? this->coeff_derivative : this->coeff};
+  sum_by_block(z, result, [&](const Hyp1f1Block_t & z_block) {
+    return this->sum(z_block, coefficient);
+  });
+  if (this->is_n_and_l) {
+    const int power{static_cast<int>(2 * (this->a - this->b))};
+    result *= z.unaryExpr([power](double z_i) { return math::pow(z_i, power); })
+                  .sqrt();
+  } else {
+    result *= z.pow(this->a - this->b);
+  }
+  result *= (z + z2).exp();
+}
+
+Hyp1f1Block_t Hyp1f1Asymptotic::sum(const Hyp1f1Block_t & z,
+                                    const Eigen::VectorXd & coefficient) {
+  // see the vectorized Hyp1f1Series::sum. The expansion is asymptotic so
+  // the terms grow again after some point but the elements of a block have
+  // similar z when z is sorted so the first to converge only add a few terms
+  // that are still decreasing.
+  Hyp1f1Block_t iz{z.inverse()};
+  Hyp1f1Block_t res{Hyp1f1Block_t::Ones()};
+  Hyp1f1Block_t izpow{Hyp1f1Block_t::Ones()};
+  Hyp1f1Block_t s_i{};
+  for (size_t i{0}; i < this->mmax; ++i) {
+    izpow *= iz;
+    s_i = coefficient(i) * izpow;
+    if ((res > 0 and s_i.abs() < this->tolerance * res).all()) {
+      break;
+    }
+    res += s_i;
+  }
+
+  if ((res > DOVERFLOW).any()) {
+    std::stringstream error{};
+    error << "Hyp1f1Asymptotic expansion: a=" << std::to_string(this->a)
+          << " b=" << std::to_string(this->b)
+          << " z=" << std::to_string(z.minCoeff()) << std::endl;
+    throw std::overflow_error(error.str());
+  }
+  return res;
+}
+
 Hyp1f1::Hyp1f1(double a, double b, size_t mmax, double tolerance)
     : hyp1f1_series{a, b, mmax, tolerance},
       hyp1f1_asymptotic{a, b, mmax, tolerance}, a{a}, b{b}, tolerance{
@@ -354,6 +474,40 @@ double Hyp1f1::calc(double z, double z2, double ez2, bool derivative) {
   return res;
 }
 
+void Hyp1f1::calc(const Array_Ref & z, const Array_Ref & z2,
+                  const Array_Ref & ez2, bool derivative,
+                  Eigen::Ref<Eigen::ArrayXd> result) {
+  const Eigen::Index n_z{z.size()};
+  const double * z_begin{z.data()};
+  if (not std::is_sorted(z_begin, z_begin + n_z)) {
+    std::vector<int> order(n_z);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&z](int i_z, int j_z) { return z(i_z) < z(j_z); });
+    Eigen::ArrayXd z_sorted(n_z), z2_sorted(n_z), ez2_sorted(n_z);
+    for (Eigen::Index i_sorted{0}; i_sorted < n_z; ++i_sorted) {
+      z_sorted(i_sorted) = z(order[i_sorted]);
+      z2_sorted(i_sorted) = z2(order[i_sorted]);
+      ez2_sorted(i_sorted) = ez2(order[i_sorted]);
+    }
+    Eigen::ArrayXd result_sorted(n_z);
+    this->calc(z_sorted, z2_sorted, ez2_sorted, derivative, result_sorted);
+    for (Eigen::Index i_sorted{0}; i_sorted < n_z; ++i_sorted) {
+      result(order[i_sorted]) = result_sorted(i_sorted);
+    }
+    return;
+  }
+  // the elements above the switching point are at the back
+  const Eigen::Index n_series{
+      std::upper_bound(z_begin, z_begin + n_z, this->z_asympt) - z_begin};
+  const Eigen::Index n_asymptotic{n_z - n_series};
+  this->hyp1f1_series.calc(z.head(n_series), z2.head(n_series),
+                           ez2.head(n_series), derivative,
+                           result.head(n_series));
+  this->hyp1f1_asymptotic.calc(z.tail(n_asymptotic), z2.tail(n_asymptotic),
+                               derivative, result.tail(n_asymptotic));
+}
+
 void Hyp1f1SphericalExpansion::precompute(size_t max_radial,
                                           size_t max_angular) {
   this->max_angular = max_angular;
@@ -489,3 +643,115 @@ void Hyp1f1SphericalExpansion::calc_direct(double r_ij, double alpha,
     this->derivatives -= (2 * alpha * r_ij) * this->values;
   }
 }
+
+void Hyp1f1SphericalExpansion::calc(const Vector_Ref & distances, double alpha,
+                                    const Vector_Ref & fac_b, bool derivative) {
+  // z is proportional to the squared distance so the sorted distances give
+  // sorted z for all n
+  const int n_distances{static_cast<int>(distances.size())};
+  std::vector<int> order(n_distances);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&distances](int i_r, int j_r) {
+    return distances(i_r) < distances(j_r);
+  });
+  this->batch_rows.resize(n_distances);
+  this->sorted_distances.resize(n_distances);
+  for (int i_sorted{0}; i_sorted < n_distances; ++i_sorted) {
+    this->batch_rows[order[i_sorted]] = i_sorted;
+    this->sorted_distances(i_sorted) = distances(order[i_sorted]);
+  }
+
+  const Eigen::Index n_cols{this->values.size()};
+  this->batch_values.resize(n_distances, n_cols);
+  if (not this->recursion or this->max_angular < 3) {
+    // see the scalar version
+    this->batch_has_derivatives = derivative;
+    if (derivative) {
+      this->batch_derivatives.resize(n_distances, n_cols);
+    }
+    this->calc_direct_batch(alpha, fac_b, derivative);
+  } else {
+    this->batch_has_derivatives = true;
+    this->batch_derivatives.resize(n_distances, n_cols);
+    this->calc_recursion_batch(alpha, fac_b);
+  }
+}
+
+void Hyp1f1SphericalExpansion::calc_recursion_batch(double alpha,
+                                                    const Vector_Ref & fac_b) {
+  auto & values{this->batch_values};
+  auto & derivatives{this->batch_derivatives};
+  const auto & r_ij{this->sorted_distances};
+  Eigen::ArrayXd alpha_rij{alpha * r_ij};
+  Eigen::ArrayXd z2{-r_ij * alpha_rij};
+  Eigen::ArrayXd ez2{z2.exp()};
+  Eigen::ArrayXd z(r_ij.size());
+  Eigen::ArrayXd dz_dr(r_ij.size());
+
+  const int max_angular{static_cast<int>(this->max_angular)};
+  for (int n_radial{0}; n_radial < static_cast<int>(this->max_radial);
+       ++n_radial) {
+    z = (alpha_rij * alpha) / (alpha + fac_b(n_radial));
+    dz_dr = 2 * z;
+    z *= r_ij;
+
+    // get the starting points for the recursion
+    for (int l_angular{max_angular - 1}; l_angular < max_angular + 1;
+         ++l_angular) {
+      int ipos{this->get_pos(n_radial, l_angular)};
+      this->hyp1f1[ipos].calc(z, z2, ez2, false, values.col(ipos));
+      this->hyp1f1[ipos].calc(z, z2, ez2, true, derivatives.col(ipos));
+    }
+    // each step uses the values at l + 2, i.e. M1p2p and M2p3p in the
+    // scalar version
+    for (int l_angular{max_angular - 2}; l_angular >= 0; --l_angular) {
+      auto a{this->get_a(n_radial, l_angular)};
+      auto b{this->get_b(l_angular)};
+      int ipos{this->get_pos(n_radial, l_angular)};
+      derivatives.col(ipos) =
+          z * derivatives.col(ipos + 2) + values.col(ipos + 2) * (b + 1);
+      values.col(ipos) =
+          (z * (a - b) * values.col(ipos + 2) + derivatives.col(ipos) * b) / a;
+    }
+
+    derivatives.middleCols(this->get_pos(n_radial, 0), max_angular + 1)
+        .colwise() *= dz_dr;
+  }
+  // here is where dG/dz*dz/dr is computed
+  derivatives -= values.colwise() * (2 * alpha_rij);
+}
+
+void Hyp1f1SphericalExpansion::calc_direct_batch(double alpha,
+                                                 const Vector_Ref & fac_b,
+                                                 bool derivative) {
+  auto & values{this->batch_values};
+  auto & derivatives{this->batch_derivatives};
+  const auto & r_ij{this->sorted_distances};
+  Eigen::ArrayXd alpha_rij{alpha * r_ij};
+  Eigen::ArrayXd z2{-r_ij * alpha_rij};
+  Eigen::ArrayXd ez2{z2.exp()};
+  Eigen::ArrayXd z(r_ij.size());
+  Eigen::ArrayXd dz_dr(r_ij.size());
+
+  const int max_angular{static_cast<int>(this->max_angular)};
+  for (int n_radial{0}; n_radial < static_cast<int>(this->max_radial);
+       ++n_radial) {
+    z = (alpha_rij * alpha) / (alpha + fac_b(n_radial));
+    dz_dr = 2 * z;
+    z *= r_ij;
+    for (int l_angular{0}; l_angular < max_angular + 1; ++l_angular) {
+      int ipos{this->get_pos(n_radial, l_angular)};
+      this->hyp1f1[ipos].calc(z, z2, ez2, false, values.col(ipos));
+      if (derivative) {
+        this->hyp1f1[ipos].calc(z, z2, ez2, true, derivatives.col(ipos));
+      }
+    }
+    if (derivative) {
+      derivatives.middleCols(this->get_pos(n_radial, 0), max_angular + 1)
+          .colwise() *= dz_dr;
+    }
+  }
+  if (derivative) {
+    derivatives -= values.colwise() * (2 * alpha_rij);
+  }
+}
@@ -34,6 +34,12 @@
 namespace rascal {
   namespace math {
     namespace internal {
+      using Array_Ref = Eigen::Ref<const Eigen::ArrayXd>;
+
+      //! number of arguments the vectorized sums evaluate together
+      constexpr int Hyp1f1BlockSize{8};
+      using Hyp1f1Block_t = Eigen::Array<double, Hyp1f1BlockSize, 1>;
+
       /**
        * Computes the 1F1 with the direct sum
        *  @f[
@@ -80,11 +86,26 @@ namespace rascal {
 
         double calc(double z, bool derivative = false, int n_terms = -1);
 
+        /**
+         * Computes G(a,b,z) for each element of z into result with the
+         * adaptive sum. The elements are summed by blocks of
+         * Hyp1f1BlockSize: the terms are computed for the whole block until
+         * all its elements converged so the loop vectorizes, but each
+         * element only sums the terms the scalar version would. Sorting z
+         * keeps the number of terms similar within the blocks.
+         */
+        void calc(const Array_Ref & z, const Array_Ref & z2,
+                  const Array_Ref & ez2, bool derivative,
+                  Eigen::Ref<Eigen::ArrayXd> result);
+
         //! Computes 1F1
         double hyp1f1(double z, bool derivative, int n_terms);
 
         double sum(double z, const Eigen::VectorXd & coefficient, size_t mmax,
                    int n_terms);
+
+        Hyp1f1Block_t sum(const Hyp1f1Block_t & z,
+                          const Eigen::VectorXd & coefficient);
       };
 
       /**
@@ -135,11 +156,18 @@ namespace rascal {
         //! Computes 1F1
         double calc(double z, bool derivative = false, int n_terms = -1);
 
+        //! Computes G(a,b,z) for each element of z, see Hyp1f1Series
+        void calc(const Array_Ref & z, const Array_Ref & z2, bool derivative,
+                  Eigen::Ref<Eigen::ArrayXd> result);
+
         //! computes hyp2f0 with arg1 = b-a and arg2 = 1-a arg3 = 1 / z
         double hyp2f0(double z, bool derivative, int n_terms);
 
         double sum(double z, const Eigen::VectorXd & coefficient, size_t mmax,
                    int n_terms);
+
+        Hyp1f1Block_t sum(const Hyp1f1Block_t & z,
+                          const Eigen::VectorXd & coefficient);
       };
     }  // namespace internal
 
@@ -209,6 +237,15 @@ namespace rascal {
        * Hyp1f1SphericalExpansion.
        */
       double calc(double z, double z2, double ez2, bool derivative = false);
+
+      /**
+       * Computes G(a,b,z) for each element of z into result, see above and
+       * Hyp1f1Series for the vectorization. It is faster when z is sorted in
+       * increasing order, otherwise the elements are sorted first.
+       */
+      void calc(const internal::Array_Ref & z, const internal::Array_Ref & z2,
+                const internal::Array_Ref & ez2, bool derivative,
+                Eigen::Ref<Eigen::ArrayXd> result);
     };
 
     /**
@@ -225,6 +262,13 @@ namespace rascal {
      *
      * It can use the recurence relationships of the 1F1 to speed things up.
      *
+     * G can also be computed for a batch of distances, e.g. all the
+     * neighbours of a center, in which case the 1F1 and the recurrence
+     * relationships are evaluated for the whole batch at once. The batch is
+     * stored sorted by distance with one distance per row and one (n, l) per
+     * column so each step of the recurrence is a loop over contiguous
+     * distances.
+     *
      * This class is tailored to work with the GTO basis in
      * CalculatorSphericalExpansion.
      */
@@ -244,6 +288,13 @@ namespace rascal {
       bool recursion;
       Eigen::ArrayXd z{};
       Eigen::ArrayXd dz_dr{};
+      // G and dG/dz*dz/dr of the last batch of distances, sorted
+      Eigen::ArrayXXd batch_values{};
+      Eigen::ArrayXXd batch_derivatives{};
+      bool batch_has_derivatives{false};
+      // row of each distance of the batch in batch_values
+      std::vector<int> batch_rows{};
+      Eigen::ArrayXd sorted_distances{};
 
       int get_pos(int n_radial, int l_angular) {
         return l_angular + (this->max_angular + 1) * n_radial;
@@ -255,6 +306,13 @@ namespace rascal {
 
       double get_b(int l_angular) { return l_angular + 1.5; }
 
+      //! batch version of calc_recursion on the sorted distances
+      void calc_recursion_batch(double alpha, const Vector_Ref & fac_b);
+
+      //! batch version of calc_direct on the sorted distances
+      void calc_direct_batch(double alpha, const Vector_Ref & fac_b,
+                             bool derivative);
+
      public:
       Hyp1f1SphericalExpansion(bool recursion = false, double tolerance = 1e-14,
                                size_t precomputation_size = 200)
@@ -288,6 +346,30 @@ namespace rascal {
       void calc_direct(double r_ij, double alpha, const Vector_Ref & fac_b,
                        bool derivative);
 
+      /**
+       * Computes G for all possible n, l values and each of the distances,
+       * and dG/dz*dz/dr if derivative is true or the recursion is used. The
+       * results of each distance are then loaded with set_from_batch.
+       */
+      void calc(const Vector_Ref & distances, double alpha,
+                const Vector_Ref & fac_b, bool derivative = false);
+
+      /**
+       * Set the values, and derivatives if they were computed, returned by
+       * get_values and get_derivatives to the ones of the distance
+       * i_distance of the last batch.
+       */
+      void set_from_batch(int i_distance) {
+        const int size{static_cast<int>(this->values.size())};
+        const int row{this->batch_rows[i_distance]};
+        Eigen::Map<Eigen::RowVectorXd>(this->values.data(), size) =
+            this->batch_values.row(row);
+        if (this->batch_has_derivatives) {
+          Eigen::Map<Eigen::RowVectorXd>(this->derivatives.data(), size) =
+              this->batch_derivatives.row(row);
+        }
+      }
+
       //! get a reference to the computed G values
       Matrix_Ref get_values() { return Matrix_Ref(this->values); }
 
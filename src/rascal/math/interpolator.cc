@@ -31,15 +31,15 @@ using namespace rascal::math;  // NOLINT
 
 bool rascal::math::is_grid_uniform(const Vector_Ref & grid) {
   // checks if the grid is in ascending order
-  for (int i = 0; i < grid.size() - 2; i++) {
-    if (grid(i + 1) > grid(i)) {
+  for (int i = 0; i < grid.size() - 1; i++) {
+    if (grid(i + 1) <= grid(i)) {
       return false;
     }
   }
 
   // checks if the cell/step size is the same everywhere
   const double step_size = grid(1) - grid(0);
-  for (int i = 0; i < grid.size() - 2; i++) {
+  for (int i = 0; i < grid.size() - 1; i++) {
     // h_i - h_0 > ε
     if (std::abs((grid(i + 1) - grid(i)) - step_size) > DBL_FTOL) {
       return false;
@@ -145,14 +145,16 @@ using CubicSplineVectorUniformInterpolation =
     InterpolationMethod<InterpolationMethod_t::CubicSplineVectorUniform>;
 
 void CubicSplineVectorUniformInterpolation::compute_second_derivative(
-    const Matrix_Ref & yv) {
+    const Matrix_Ref & yv, const Vector_Ref & d2y_begin,
+    const Vector_Ref & d2y_end) {
   int n{static_cast<int>(yv.rows())};
   Matrix_t y2 = Matrix_t::Zero(n, yv.cols());
   Matrix_t u = Matrix_t::Zero(n, yv.cols());
   double sig = 0.5;
   Vector_t p = Vector_t::Zero(n);
+  // y2(0) = 0 * y2(1) + u(0) with u(0) the known second derivative
   y2.row(0) = Vector_t::Zero(yv.cols());
-  u.row(0) = Vector_t::Zero(yv.cols());
+  u.row(0) = d2y_begin;
   for (int i{1}; i < n - 1; i++) {
     p = sig * y2.row(i - 1).array() + 2.0;
     y2.row(i) = (sig - 1.0) / p.array();
@@ -165,16 +167,18 @@ void CubicSplineVectorUniformInterpolation::compute_second_derivative(
     u.row(i).array() -= sig * u.row(i - 1).array();
     u.row(i).array() /= p.array();
   }
-  y2.row(n - 1) = Vector_t::Zero(y2.cols());
+  y2.row(n - 1) = d2y_end;
   for (int k{n - 2}; k > 0; k--) {
     y2.row(k) = y2.row(k).array() * y2.row(k + 1).array() + u.row(k).array();
   }
-  y2.row(0) = Vector_t::Zero(y2.cols());
+  y2.row(0) = d2y_begin;
   this->second_derivative_h_sq_6 = y2 * this->h_sq_6;
 }
 
-Vector_t CubicSplineVectorUniformInterpolation::interpolate_for_one_point(
-    const Vector_Ref & xx, const Matrix_Ref & yy, int j1, double x) const {
+void CubicSplineVectorUniformInterpolation::interpolate_into(
+    const Vector_Ref & xx, const Matrix_Ref & yy, double x, int j1,
+    Eigen::Ref<Vector_t> out) const {
+  assert(this->initialized);
   int klo{j1};
   int khi{j1 + 1};
   // Bad xa input to routine splint
@@ -182,16 +186,16 @@ Vector_t CubicSplineVectorUniformInterpolation::interpolate_for_one_point(
   double a{(xx(khi) - x) / this->h};
   // Because we can assume a+b=1, we simplify the calculation of b
   double b{1 - a};
-  return (a * (yy.row(klo).array() +
-               (a * a - 1) * this->second_derivative_h_sq_6.row(klo).array()) +
-          b * (yy.row(khi).array() +
-               (b * b - 1) * this->second_derivative_h_sq_6.row(khi).array()))
-      .matrix();
+  // a * (y_lo + (a^2 - 1) * y2_lo) + b * (y_hi + (b^2 - 1) * y2_hi)
+  out.noalias() = a * yy.row(klo) + b * yy.row(khi) +
+                  (a * (a * a - 1)) * this->second_derivative_h_sq_6.row(klo) +
+                  (b * (b * b - 1)) * this->second_derivative_h_sq_6.row(khi);
 }
 
-Vector_t
-CubicSplineVectorUniformInterpolation::interpolate_derivative_for_one_point(
-    const Vector_Ref & xx, const Matrix_Ref & yy, int j1, double x) const {
+void CubicSplineVectorUniformInterpolation::interpolate_derivative_into(
+    const Vector_Ref & xx, const Matrix_Ref & yy, double x, int j1,
+    Eigen::Ref<Vector_t> out) const {
+  assert(this->initialized);
   int klo{j1};
   int khi{j1 + 1};
   // Bad xa input to routine splint
@@ -199,11 +203,41 @@ CubicSplineVectorUniformInterpolation::interpolate_derivative_for_one_point(
   double a{(xx(khi) - x) / this->h};
   // Because we can assume a+b=1, we simplify the calculation of b
   double b{1 - a};
-  return ((yy.row(khi).array() - yy.row(klo).array() -
-           (3 * a * a - 1) * this->second_derivative_h_sq_6.row(klo).array() +
-           (3 * b * b - 1) * this->second_derivative_h_sq_6.row(khi).array()) /
-          this->h)
-      .matrix();
+  const double inv_h{1 / this->h};
+  out.noalias() =
+      inv_h * (yy.row(khi) - yy.row(klo)) -
+      ((3 * a * a - 1) * inv_h) * this->second_derivative_h_sq_6.row(klo) +
+      ((3 * b * b - 1) * inv_h) * this->second_derivative_h_sq_6.row(khi);
+}
+
+void CubicSplineVectorUniformInterpolation::interpolate_with_derivative(
+    const Vector_Ref & xx, const Matrix_Ref & yy, double x, int j1,
+    Eigen::Ref<Vector_t> value, Eigen::Ref<Vector_t> derivative) const {
+  assert(this->initialized);
+  int klo{j1};
+  int khi{j1 + 1};
+  // Bad xa input to routine splint
+  assert(h > DBL_FTOL);
+  double a{(xx(khi) - x) / this->h};
+  // Because we can assume a+b=1, we simplify the calculation of b
+  double b{1 - a};
+  const double inv_h{1 / this->h};
+  const double a3{a * (a * a - 1)};
+  const double b3{b * (b * b - 1)};
+  const double da{(3 * a * a - 1) * inv_h};
+  const double db{(3 * b * b - 1) * inv_h};
+  const double * y_lo{yy.row(klo).data()};
+  const double * y_hi{yy.row(khi).data()};
+  const double * y2_lo{this->second_derivative_h_sq_6.row(klo).data()};
+  const double * y2_hi{this->second_derivative_h_sq_6.row(khi).data()};
+  // single pass over the coefficients so that each of them is loaded once
+  const Eigen::Index n_entries{value.size()};
+  for (Eigen::Index i_entry{0}; i_entry < n_entries; ++i_entry) {
+    value(i_entry) = a * y_lo[i_entry] + b * y_hi[i_entry] +
+                     a3 * y2_lo[i_entry] + b3 * y2_hi[i_entry];
+    derivative(i_entry) = inv_h * (y_hi[i_entry] - y_lo[i_entry]) -
+                          da * y2_lo[i_entry] + db * y2_hi[i_entry];
+  }
 }
 
 /*****************************************************************************/
@@ -227,3 +261,11 @@ int UniformSearchMethod::search(double x, const Vector_Ref &) const {
                                                this->nb_grid_points_per_unit) -
                                   1));
 }
+
+// the constants are bound to references in the refinement so they need a
+// definition until C++17
+using SecantGridRational = UniformGridRational<RefinementMethod_t::Secant>;
+constexpr double SecantGridRational::AsymptoticOrder;
+constexpr double SecantGridRational::TargetFraction;
+constexpr double SecantGridRational::MinGrowth;
+constexpr double SecantGridRational::MaxGrowth;
@@ -29,6 +29,13 @@
 #define SRC_RASCAL_MATH_INTERPOLATOR_HH_
 
 #include "rascal/math/utils.hh"
+#include "rascal/utils/parallel.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
 
 /*
  * To allow flexibility of the interpolator for experimenting while giving
@@ -80,7 +87,7 @@ namespace rascal {
   namespace math {
     bool is_grid_uniform(const Vector_Ref & grid);
 
-    enum class RefinementMethod_t { Exponential, Linear };
+    enum class RefinementMethod_t { Exponential, Linear, Secant };
 
     /**
      * UniformGridRational creates the grid and test grid. The test grid is used
@@ -112,6 +119,16 @@ namespace rascal {
        *        be greater than 1.
        */
       Vector_t compute_test_grid(double x1, double x2, int degree_of_fineness);
+
+      /**
+       * Degree of fineness of the next grid to try when the error of the
+       * grid with degree_of_fineness is above the error bound.
+       *
+       * @param error error of the interpolator on the test grid
+       * @param max_grid_points the next grid should not have more points
+       */
+      int get_next_degree_of_fineness(int degree_of_fineness, double error,
+                                      double error_bound, int max_grid_points);
     };
 
     /**
@@ -149,6 +166,11 @@ namespace rascal {
                                    x2 - offset);
       }
 
+      int get_next_degree_of_fineness(int degree_of_fineness, double, double,
+                                      int) const {
+        return degree_of_fineness + 1;
+      }
+
      private:
       int slope_;
     };
@@ -182,6 +204,88 @@ namespace rascal {
         return Vector_t::LinSpaced(nb_grid_points - 1, x1 + offset,
                                    x2 - offset);
       }
+
+      int get_next_degree_of_fineness(int degree_of_fineness, double, double,
+                                      int) const {
+        return degree_of_fineness + 1;
+      }
+    };
+
+    /**
+     * Secant UniformGridRational predicts the number of points needed to
+     * reach the error bound from the errors of the previous grids instead of
+     * refining the grid by a fixed amount. The error of the cubic spline
+     * decays as a power of the number of grid intervals n, error ~ n^-p, so
+     * the root of log(error(n)) - log(error_bound) is searched with secant
+     * steps in log-log scale. The order p is estimated from the last two
+     * grids, the asymptotic order 4 of the cubic spline is used for the first
+     * step. The steps aim below the error bound so that it is usually reached
+     * in one or two steps after the first grid, which saves most of the
+     * function evaluations of the Exponential and Linear refinements for
+     * tight error bounds, and their growth is limited so that a poor estimate
+     * on a coarse grid does not overshoot.
+     *
+     * The degree of fineness is the number of intervals of the grid and the
+     * test grid is made of the midpoints of the grid.
+     *
+     *              x1                  x2
+     * grid         [   |   |   |   |   ]        degree_of_fineness = 5
+     * test grid      x   x   x   x   x
+     */
+    template <>
+    class UniformGridRational<RefinementMethod_t::Secant> {
+     public:
+      //! asymptotic order of the error of the cubic spline
+      static constexpr double AsymptoticOrder{4.};
+      //! fraction of the error bound aimed at
+      static constexpr double TargetFraction{0.5};
+      //! bounds of the growth of the number of intervals in one step
+      static constexpr double MinGrowth{1.25};
+      static constexpr double MaxGrowth{16.};
+
+      Vector_t compute_grid(double x1, double x2,
+                            int degree_of_fineness) const {
+        return Vector_t::LinSpaced(degree_of_fineness + 1, x1, x2);
+      }
+
+      Vector_t compute_test_grid(double x1, double x2,
+                                 int degree_of_fineness) const {
+        double offset{(x2 - x1) / (2 * degree_of_fineness)};
+        return Vector_t::LinSpaced(degree_of_fineness, x1 + offset,
+                                   x2 - offset);
+      }
+
+      int get_next_degree_of_fineness(int degree_of_fineness, double error,
+                                      double error_bound,
+                                      int max_grid_points) {
+        double order{AsymptoticOrder};
+        if (this->previous_degree_of_fineness > 0) {
+          order = std::log(this->previous_error / error) /
+                  std::log(static_cast<double>(degree_of_fineness) /
+                           this->previous_degree_of_fineness);
+          // the error is not yet in the asymptotic regime on coarse grids
+          if (not std::isfinite(order)) {
+            order = AsymptoticOrder;
+          }
+          order = std::min(std::max(order, 1.), 2 * AsymptoticOrder);
+        }
+        this->previous_degree_of_fineness = degree_of_fineness;
+        this->previous_error = error;
+
+        double growth{
+            std::pow(error / (TargetFraction * error_bound), 1. / order)};
+        if (not std::isfinite(growth)) {
+          growth = MaxGrowth;
+        }
+        growth = std::min(std::max(growth, MinGrowth), MaxGrowth);
+        double next{std::ceil(growth * degree_of_fineness)};
+        return static_cast<int>(
+            std::min(next, static_cast<double>(max_grid_points - 1)));
+      }
+
+     private:
+      int previous_degree_of_fineness{0};
+      double previous_error{0.};
     };
 
     enum class InterpolationMethod_t {
@@ -367,9 +471,22 @@ namespace rascal {
 
       void initialize(const Vector_Ref & grid,
                       const Matrix_Ref & evaluated_grid) {
+        Vector_t zero{Vector_t::Zero(evaluated_grid.cols())};
+        this->initialize(grid, evaluated_grid, zero, zero);
+      }
+
+      /**
+       * Initialization with the second derivative of the function at both
+       * ends of the grid, s''(x_0) = f''(x_0) and s''(x_n) = f''(x_n), instead
+       * of the natural boundary conditions s''(x_0) = s''(x_n) = 0.
+       */
+      void initialize(const Vector_Ref & grid,
+                      const Matrix_Ref & evaluated_grid,
+                      const Vector_Ref & d2y_begin,
+                      const Vector_Ref & d2y_end) {
         this->h = grid(1) - grid(0);
         this->h_sq_6 = this->h * this->h / 6.0;
-        this->compute_second_derivative(evaluated_grid);
+        this->compute_second_derivative(evaluated_grid, d2y_begin, d2y_end);
         this->initialized = true;
       }
 
@@ -379,9 +496,10 @@ namespace rascal {
       Vector_t interpolate(const Vector_Ref & grid,
                            const Matrix_Ref & evaluated_grid, double x,
                            int nearest_grid_index_to_x) const {
-        assert(this->initialized);
-        return this->interpolate_for_one_point(grid, evaluated_grid,
-                                               nearest_grid_index_to_x, x);
+        Vector_t result(evaluated_grid.cols());
+        this->interpolate_into(grid, evaluated_grid, x,
+                               nearest_grid_index_to_x, result);
+        return result;
       }
 
       /**
@@ -391,21 +509,57 @@ namespace rascal {
                                       const Matrix_Ref & evaluated_grid,
                                       double x,
                                       int nearest_grid_index_to_x) const {
-        assert(this->initialized);
-        return this->interpolate_derivative_for_one_point(
-            grid, evaluated_grid, nearest_grid_index_to_x, x);
+        Vector_t result(evaluated_grid.cols());
+        this->interpolate_derivative_into(grid, evaluated_grid, x,
+                                          nearest_grid_index_to_x, result);
+        return result;
       }
 
-     private:
-      void compute_second_derivative(const Matrix_Ref & yv);
+      /**
+       * Same as interpolate but the result is written into out, which has
+       * evaluated_grid.cols() entries, so nothing is allocated. The cubic
+       * polynomial is evaluated for all the entries at once.
+       *
+       * @pre interpolation method is initialized
+       */
+      void interpolate_into(const Vector_Ref & grid,
+                            const Matrix_Ref & evaluated_grid, double x,
+                            int nearest_grid_index_to_x,
+                            Eigen::Ref<Vector_t> out) const;
+
+      /**
+       * Same as interpolate_derivative but the result is written into out,
+       * see interpolate_into.
+       *
+       * @pre interpolation method is initialized
+       */
+      void interpolate_derivative_into(const Vector_Ref & grid,
+                                       const Matrix_Ref & evaluated_grid,
+                                       double x, int nearest_grid_index_to_x,
+                                       Eigen::Ref<Vector_t> out) const;
 
-      Vector_t interpolate_for_one_point(const Vector_Ref & xx,
-                                         const Matrix_Ref & yy, int j1,
-                                         double x) const;
+      /**
+       * Interpolation of the function and of its derivative at once. The
+       * coefficients of the grid cell containing x are read only once for
+       * both results.
+       *
+       * @pre interpolation method is initialized
+       */
+      void interpolate_with_derivative(const Vector_Ref & grid,
+                                       const Matrix_Ref & evaluated_grid,
+                                       double x, int nearest_grid_index_to_x,
+                                       Eigen::Ref<Vector_t> value,
+                                       Eigen::Ref<Vector_t> derivative) const;
 
-      Vector_t interpolate_derivative_for_one_point(const Vector_Ref & xx,
-                                                    const Matrix_Ref & yy,
-                                                    int j1, double x) const;
+     private:
+      /**
+       * Solves the tridiagonal system of the cubic spline with the second
+       * derivative fixed to d2y_begin and d2y_end at the ends of the grid,
+       * zeros give the natural boundary conditions.
+       */
+      void compute_second_derivative(const Matrix_Ref & yv,
+                                     const Vector_Ref & d2y_begin,
+                                     const Vector_Ref & d2y_end);
 
       bool initialized{false};
       // The gap between two grid points
@@ -554,6 +708,20 @@ namespace rascal {
                 values, references)};
         return (absolute_error < error_bound || relative_error < error_bound);
       }
+
+      /**
+       * The smaller of the absolute and the relative error, so that it is
+       * below the error bound when is_error_below_bound is true.
+       */
+      template <class Eigen_Ref>
+      static double compute_global_error(const Eigen_Ref & values,
+                                         const Eigen_Ref & references) {
+        return std::min(
+            ErrorMethod<ErrorMetric_t::Absolute>::compute_global_error(
+                values, references),
+            ErrorMethod<ErrorMetric_t::Relative>::compute_global_error(
+                values, references));
+      }
     };
 
     /**
@@ -693,7 +861,12 @@ namespace rascal {
       };
 
       Interpolator(Vector_t grid, bool /*dummy_for_overloading*/)
-          : grid{std::move(grid)} {}
+          : grid{std::move(grid)} {
+        if (this->grid.size() > 0) {
+          this->x1 = this->grid(0);
+          this->x2 = this->grid(this->grid.size() - 1);
+        }
+      }
 
       /**
        * The general procedure of the interpolatorar is to initialize the
@@ -705,17 +878,26 @@ namespace rascal {
         this->compute_grid_error();
         while (not(this->error_below_bound) &&
                this->grid.size() < this->max_grid_points) {
-          this->degree_of_fineness++;
+          this->degree_of_fineness =
+              this->grid_rational.get_next_degree_of_fineness(
+                  this->degree_of_fineness, this->grid_error,
+                  this->error_bound, this->max_grid_points);
           this->compute_grid_error();
         }
       }
 
+      /**
+       * Computes the grid for the current degree of fineness, initializes the
+       * interpolation method on it and sets grid_error and
+       * error_below_bound from the error on the test grid.
+       */
       virtual void compute_grid_error() = 0;
 
       // The boundary points of the range of interpolation
       // grid in the range [x1,x2]
       Vector_t grid{};
       double error_bound{1e-5};
+      // error of the interpolator on the test grid
       double grid_error{0.};
 
       int max_grid_points{10'000'000};
@@ -931,9 +1113,10 @@ namespace rascal {
             this->interpolate(Vector_Ref(test_grid))};
         Vector_t test_grid_evaluated{this->eval(Vector_Ref(test_grid))};
 
-        this->error_below_bound = ErrorMethod_t::is_error_below_bound(
-            Matrix_Ref(test_grid_interpolated), Matrix_Ref(test_grid_evaluated),
-            this->error_bound);
+        this->grid_error = ErrorMethod_t::compute_global_error(
+            Matrix_Ref(test_grid_interpolated),
+            Matrix_Ref(test_grid_evaluated));
+        this->error_below_bound = this->grid_error < this->error_bound;
       }
 
       /**
@@ -1013,19 +1196,22 @@ namespace rascal {
        *        increase the accuracy of the interpolation.
        * @param dfx1 referring to f'(x1)
        * @param dfx2 referring to f'(x2)
+       * @param n_threads number of threads evaluating the function on the
+       *        grids, 0 for as many as the hardware supports. The function
+       *        has to be safe to call concurrently when it is not 1.
        */
       InterpolatorMatrixUniformCubicSpline(
           std::function<Matrix_t(double)> function, double x1, double x2,
           double error_bound, int cols, int rows, int max_grid_points = 100000,
           int initial_degree_of_fineness = 5,
           bool clamped_boundary_conditions = false, double dfx1 = 0,
-          double dfx2 = 0)
+          double dfx2 = 0, size_t n_threads = 1)
           : Parent{x1, x2, error_bound, max_grid_points,
                    initial_degree_of_fineness},
             function{function}, cols{cols}, rows{rows}, matrix_size{cols *
                                                                     rows},
             clamped_boundary_conditions{clamped_boundary_conditions},
-            dfx1{dfx1}, dfx2{dfx2} {
+            dfx1{dfx1}, dfx2{dfx2}, n_threads{n_threads} {
         if (clamped_boundary_conditions) {
           throw std::logic_error("InterpolatorMatrixUniformCubicSpline has "
                                  "not been implemented for "
@@ -1034,6 +1220,28 @@ namespace rascal {
         this->initialize_iteratively();
       }
 
+      /**
+       * Same as above but the spline uses the second derivatives of the
+       * function at x1 and x2, d2fx1 and d2fx2 of shape (rows, cols), as
+       * boundary conditions instead of the natural ones. It is useful when
+       * the function is not smooth beyond [x1, x2], e.g. at the boundary of
+       * two splines joined together, since s''(x1) = s''(x2) = 0 spoils the
+       * accuracy of the derivative close to x1 and x2 otherwise.
+       */
+      InterpolatorMatrixUniformCubicSpline(
+          std::function<Matrix_t(double)> function, double x1, double x2,
+          double error_bound, int cols, int rows, const Matrix_Ref & d2fx1,
+          const Matrix_Ref & d2fx2, int max_grid_points = 100000,
+          int initial_degree_of_fineness = 5, size_t n_threads = 1)
+          : Parent{x1, x2, error_bound, max_grid_points,
+                   initial_degree_of_fineness},
+            function{function}, cols{cols}, rows{rows}, matrix_size{cols *
+                                                                    rows},
+            curvature_boundary_conditions{true}, n_threads{n_threads} {
+        this->set_second_derivatives(d2fx1, d2fx2);
+        this->initialize_iteratively();
+      }
+
       /**
        * Allows initialization of interpolator with scalar function
        * interpreting it as matrix of shape (1,1)
@@ -1096,6 +1304,36 @@ namespace rascal {
         this->initialize_from_computed_grid();
       }
 
+      /**
+       * Same as above but the spline uses the second derivatives d2fx1 and
+       * d2fx2 at the boundaries of the grid, see the constructor from a
+       * function with d2fx1 and d2fx2.
+       *
+       * @throw std::logic_error d2fx1 or d2fx2 does not have cols*rows
+       *        entries
+       */
+      InterpolatorMatrixUniformCubicSpline(Vector_t grid,
+                                           Matrix_t evaluated_grid, int cols,
+                                           int rows, const Matrix_Ref & d2fx1,
+                                           const Matrix_Ref & d2fx2)
+          : Parent(grid), evaluated_grid{evaluated_grid}, cols{cols},
+            rows{rows}, matrix_size{cols * rows},
+            curvature_boundary_conditions{true} {
+        if (grid.size() != evaluated_grid.rows()) {
+          throw std::logic_error(
+              "The grid size and evaluated grid rows must match");
+        }
+        if (not(is_grid_uniform(Vector_Ref(this->grid)))) {
+          throw std::logic_error("The grid has to be uniform.");
+        }
+        if (not(evaluated_grid.cols() == cols * rows)) {
+          throw std::logic_error(
+              "The evaluated grid number of cols must match cols*rows");
+        }
+        this->set_second_derivatives(d2fx1, d2fx2);
+        this->initialize_from_computed_grid();
+      }
+
       /**
        * Interpolation at point x for a function of the form f:ℝ->ℝ^{n,m}.
        *
@@ -1105,8 +1343,9 @@ namespace rascal {
        * @pre x is in range [x1,x2]
        */
       Matrix_t interpolate(double x) {
-        return Eigen::Map<Matrix_t>(this->interpolate_to_vector(x).data(),
-                                    this->rows, this->cols);
+        Matrix_t result{};
+        this->interpolate_into(x, result);
+        return result;
       }
 
       /**
@@ -1119,9 +1358,108 @@ namespace rascal {
        * @pre x is in range [x1,x2]
        */
       Matrix_t interpolate_derivative(double x) {
-        return Eigen::Map<Matrix_t>(
-            this->interpolate_to_vector_derivative(x).data(), this->rows,
-            this->cols);
+        Matrix_t result{};
+        this->interpolate_derivative_into(x, result);
+        return result;
+      }
+
+      /**
+       * Interpolation at point x written into out. out is only resized when
+       * its shape is not (rows, cols) so that evaluating many points with
+       * the same output does not allocate.
+       *
+       * @pre x is in range [x1,x2]
+       */
+      void interpolate_into(double x, Matrix_t & out) {
+        out.resize(this->rows, this->cols);
+        Eigen::Map<Vector_t> out_flat(out.data(), this->matrix_size);
+        this->interpolate_to_vector_into(x, out_flat);
+      }
+
+      /**
+       * Interpolation of the derivative at point x written into out, see
+       * interpolate_into.
+       *
+       * @pre x is in range [x1,x2]
+       */
+      void interpolate_derivative_into(double x, Matrix_t & out) {
+        out.resize(this->rows, this->cols);
+        Eigen::Map<Vector_t> out_flat(out.data(), this->matrix_size);
+        this->interpolate_to_vector_derivative_into(x, out_flat);
+      }
+
+      /**
+       * Interpolation of the function and of its derivative at point x
+       * written into value and derivative, see interpolate_into. The grid
+       * search and the loads of the spline coefficients are shared by both.
+       *
+       * @pre x is in range [x1,x2]
+       */
+      void interpolate_with_derivative(double x, Matrix_t & value,
+                                       Matrix_t & derivative) {
+        assert(x >= this->x1 && x <= this->x2);
+        value.resize(this->rows, this->cols);
+        derivative.resize(this->rows, this->cols);
+        Eigen::Map<Vector_t> value_flat(value.data(), this->matrix_size);
+        Eigen::Map<Vector_t> derivative_flat(derivative.data(),
+                                             this->matrix_size);
+        int nearest_grid_index_to_x{this->search_method.search(x, this->grid)};
+        this->intp_method.interpolate_with_derivative(
+            this->grid, this->evaluated_grid, x, nearest_grid_index_to_x,
+            value_flat, derivative_flat);
+      }
+
+      /**
+       * Interpolates the point x into out
+       *
+       * @param out intp(x) in the vector shape (rows*cols)
+       *
+       * @pre x is in range [x1,x2]
+       */
+      inline void interpolate_to_vector_into(double x,
+                                             Eigen::Ref<Vector_t> out) {
+        assert(x >= this->x1 && x <= this->x2);
+        int nearest_grid_index_to_x{this->search_method.search(x, this->grid)};
+        this->intp_method.interpolate_into(this->grid, this->evaluated_grid, x,
+                                           nearest_grid_index_to_x, out);
+      }
+
+      /**
+       * Interpolates the derivative of point x into out
+       *
+       * @param out intp'(x) in the vector shape (rows*cols)
+       *
+       * @pre x is in range [x1,x2]
+       */
+      inline void interpolate_to_vector_derivative_into(
+          double x, Eigen::Ref<Vector_t> out) {
+        assert(x >= this->x1 && x <= this->x2);
+        int nearest_grid_index_to_x{this->search_method.search(x, this->grid)};
+        this->intp_method.interpolate_derivative_into(
+            this->grid, this->evaluated_grid, x, nearest_grid_index_to_x, out);
+      }
+
+      /**
+       * Interpolates each x in points into the rows of out, which is resized
+       * to (points.size(), rows*cols) only if its shape differs.
+       */
+      void interpolate_batch(const Vector_Ref & points, Matrix_t & out) {
+        out.resize(points.size(), this->matrix_size);
+        for (int i{0}; i < points.size(); i++) {
+          this->interpolate_to_vector_into(points(i), out.row(i));
+        }
+      }
+
+      /**
+       * Interpolates the derivative of each x in points into the rows of
+       * out, see interpolate_batch.
+       */
+      void interpolate_derivative_batch(const Vector_Ref & points,
+                                        Matrix_t & out) {
+        out.resize(points.size(), this->matrix_size);
+        for (int i{0}; i < points.size(); i++) {
+          this->interpolate_to_vector_derivative_into(points(i), out.row(i));
+        }
       }
 
       /**
@@ -1132,10 +1470,9 @@ namespace rascal {
        * @pre x is in range [x1,x2]
        */
       inline Vector_t interpolate_to_vector(double x) {
-        assert(x >= this->x1 && x <= this->x2);
-        int nearest_grid_index_to_x{this->search_method.search(x, this->grid)};
-        return this->intp_method.interpolate(this->grid, this->evaluated_grid,
-                                             x, nearest_grid_index_to_x);
+        Vector_t result(this->matrix_size);
+        this->interpolate_to_vector_into(x, result);
+        return result;
       }
 
       /**
@@ -1144,11 +1481,8 @@ namespace rascal {
        * @return intp(x) in the vector shape (rows*cols)
        */
       inline Matrix_t interpolate_to_vector(const Vector_Ref & points) {
-        Matrix_t interpolated_points =
-            Matrix_t::Zero(points.size(), this->matrix_size);
-        for (int i{0}; i < points.size(); i++) {
-          interpolated_points.row(i) = this->interpolate_to_vector(points(i));
-        }
+        Matrix_t interpolated_points{};
+        this->interpolate_batch(points, interpolated_points);
         return interpolated_points;
       }
 
@@ -1159,10 +1493,9 @@ namespace rascal {
        * @pre x is in range [x1,x2]
        */
       inline Vector_t interpolate_to_vector_derivative(const double x) {
-        assert(x >= this->x1 && x <= this->x2);
-        int nearest_grid_index_to_x{this->search_method.search(x, this->grid)};
-        return this->intp_method.interpolate_derivative(
-            this->grid, this->evaluated_grid, x, nearest_grid_index_to_x);
+        Vector_t result(this->matrix_size);
+        this->interpolate_to_vector_derivative_into(x, result);
+        return result;
       }
 
       /**
@@ -1171,12 +1504,8 @@ namespace rascal {
        */
       inline Matrix_t
       interpolate_to_vector_derivative(const Vector_Ref & points) {
-        Matrix_t interpolated_points =
-            Matrix_t::Zero(points.size(), this->matrix_size);
-        for (int i{0}; i < points.size(); i++) {
-          interpolated_points.row(i) =
-              this->interpolate_to_vector_derivative(points(i));
-        }
+        Matrix_t interpolated_points{};
+        this->interpolate_derivative_batch(points, interpolated_points);
         return interpolated_points;
       }
 
@@ -1200,6 +1529,21 @@ namespace rascal {
 
       int get_matrix_size() { return this->matrix_size; }
 
+      int get_cols() const { return this->cols; }
+
+      int get_rows() const { return this->rows; }
+
+      //! are the second derivatives used as boundary conditions
+      bool has_curvature_boundary_conditions() const {
+        return this->curvature_boundary_conditions;
+      }
+
+      //! f''(x1) reshaped to (1, n*m), empty with natural conditions
+      Vector_Ref get_d2fx1_ref() const { return Vector_Ref(this->d2fx1); }
+
+      //! f''(x2) reshaped to (1, n*m), empty with natural conditions
+      Vector_Ref get_d2fx2_ref() const { return Vector_Ref(this->d2fx2); }
+
       /**
        * @param x
        * @return evaluation of f on x, f(x)
@@ -1212,15 +1556,18 @@ namespace rascal {
       // OPT(alex) container for Matrix_t, then reshape one time to prevent
       // check overflow
       /**
+       * The points are distributed over n_threads threads, the function is
+       * the expensive part of the refinement of the grid.
+       *
        * @param grid
        * @return evaluation of f on each point of the grid, f(grid)
        */
       Matrix_t eval(const Vector_Ref & grid) {
         Matrix_t evaluated_grid =
             Matrix_t::Zero(grid.size(), this->matrix_size);
-        for (int i{0}; i < grid.size(); i++) {
-          evaluated_grid.row(i) = this->eval(grid(i));
-        }
+        rascal::internal::parallel_for(
+            grid.size(), this->n_threads,
+            [&](size_t i) { evaluated_grid.row(i) = this->eval(grid(i)); });
         return evaluated_grid;
       }
 
@@ -1241,9 +1588,10 @@ namespace rascal {
         Matrix_t test_grid_interpolated{
             this->interpolate_to_vector(Vector_Ref(test_grid))};
         Matrix_t test_grid_evaluated{this->eval(Vector_Ref(test_grid))};
-        this->error_below_bound = ErrorMethod_t::is_error_below_bound(
-            Matrix_Ref(test_grid_interpolated), Matrix_Ref(test_grid_evaluated),
-            this->error_bound);
+        this->grid_error = ErrorMethod_t::compute_global_error(
+            Matrix_Ref(test_grid_interpolated),
+            Matrix_Ref(test_grid_evaluated));
+        this->error_below_bound = this->grid_error < this->error_bound;
       }
 
       void initialize_from_computed_grid() {
@@ -1251,6 +1599,10 @@ namespace rascal {
           // OPT(alex) implement for clamped_boundary_conditions
           throw std::logic_error("Clamped boundary condition has yet not been "
                                  "implemented for CubicSplineVectorUniform.");
+        } else if (this->curvature_boundary_conditions) {
+          this->intp_method.initialize(
+              Vector_Ref(this->grid), Matrix_Ref(this->evaluated_grid),
+              Vector_Ref(this->d2fx1), Vector_Ref(this->d2fx2));
         } else {
           this->intp_method.initialize(Vector_Ref(this->grid),
                                        Matrix_Ref(this->evaluated_grid));
@@ -1258,6 +1610,20 @@ namespace rascal {
         this->search_method.initialize(Vector_Ref(this->grid), 2);
       }
 
+      void set_second_derivatives(const Matrix_Ref & d2fx1,
+                                  const Matrix_Ref & d2fx2) {
+        if (d2fx1.size() != this->matrix_size or
+            d2fx2.size() != this->matrix_size) {
+          throw std::logic_error("The second derivatives at the boundaries "
+                                 "must have cols*rows entries");
+        }
+        // Matrix_t is row major so it is flattened like evaluated_grid
+        this->d2fx1 = Eigen::Map<const Vector_t>(Matrix_t(d2fx1).data(),
+                                                 this->matrix_size);
+        this->d2fx2 = Eigen::Map<const Vector_t>(Matrix_t(d2fx2).data(),
+                                                 this->matrix_size);
+      }
+
       // f:[x1,x2]->ℝ^{rows,cols}
       std::function<Matrix_t(double)> function{};
       // f(grid) reshaped to (grid_size, n*m)
@@ -1278,6 +1644,244 @@ namespace rascal {
       double dfx1{0.};
       // f'(x2)
       double dfx2{0.};
+      //! use d2fx1 and d2fx2 as boundary conditions
+      bool curvature_boundary_conditions{false};
+      // f''(x1) reshaped to (1, n*m)
+      Vector_t d2fx1{};
+      // f''(x2) reshaped to (1, n*m)
+      Vector_t d2fx2{};
+      //! number of threads evaluating the function, see eval
+      size_t n_threads{1};
+    };
+
+    /**
+     * Second derivative of func at x using the five points central finite
+     * difference with the given step.
+     */
+    template <class Func>
+    Matrix_t second_derivative_central_difference(Func & func, const double x,
+                                                  const double step) {
+      Matrix_t d2f{-30. * func(x)};
+      d2f += 16. * (func(x + step) + func(x - step));
+      d2f -= func(x + 2. * step) + func(x - 2. * step);
+      return d2f / (12. * step * step);
+    }
+
+    /**
+     * Cubic spline of a function of the form f:[x1,x2]->ℝ^{n,m} on a
+     * piecewise uniform grid. [x1,x2] is split in segments of the same width
+     * and each of them is interpolated by its own
+     * InterpolatorMatrixUniformCubicSpline refined until it reaches the error
+     * bound on its own, so the spacing of the grid is small only where the
+     * function varies quickly. Since the segments have the same width the
+     * segment containing x is found in O(1) like the grid point in a segment.
+     *
+     *              x1                                  x2
+     * segments     [                 |                 ]
+     * grid         [ | | | | | | | | |    |    |    |  ]
+     *
+     * The splines of two neighbouring segments use the second derivative of
+     * the function at their common boundary, estimated with finite
+     * differences, as boundary conditions so the joint does not degrade the
+     * accuracy like the natural boundary conditions would.
+     */
+    template <RefinementMethod_t RefinementMethod,
+              class ErrorMethod_t = ErrorMethod<ErrorMetric_t::Absolute>>
+    class InterpolatorMatrixPiecewiseUniformCubicSpline {
+     public:
+      using Segment_t =
+          InterpolatorMatrixUniformCubicSpline<RefinementMethod, ErrorMethod_t>;
+
+      /**
+       * Constructor using the function to refine the grid of each segment,
+       * see the constructor of InterpolatorMatrixUniformCubicSpline with
+       * d2fx1 and d2fx2 for the other parameters.
+       *
+       * @param d2fx1 f''(x1) used as boundary condition, zero for the
+       *        natural boundary conditions
+       * @param d2fx2 f''(x2) used as boundary condition, zero for the
+       *        natural boundary conditions
+       * @param nb_segments number of segments of the same width [x1,x2] is
+       *        split in
+       * @param max_grid_points maximal number of grid points of each segment
+       *
+       * @throw std::logic_error nb_segments is not positive
+       */
+      InterpolatorMatrixPiecewiseUniformCubicSpline(
+          std::function<Matrix_t(double)> function, double x1, double x2,
+          double error_bound, int cols, int rows, const Matrix_Ref & d2fx1,
+          const Matrix_Ref & d2fx2, int nb_segments = 1,
+          int max_grid_points = 100000, int initial_degree_of_fineness = 5,
+          size_t n_threads = 1)
+          : x1{x1}, x2{x2} {
+        if (nb_segments < 1) {
+          throw std::logic_error("The number of segments must be at least 1.");
+        }
+        Vector_t boundaries{Vector_t::LinSpaced(nb_segments + 1, x1, x2)};
+        // the finite differences stay well within the segments
+        double step{1e-3 * (x2 - x1) / nb_segments};
+        Matrix_t d2f_begin{d2fx1};
+        for (int i_segment{0}; i_segment < nb_segments; ++i_segment) {
+          Matrix_t d2f_end{d2fx2};
+          if (i_segment < nb_segments - 1) {
+            d2f_end = second_derivative_central_difference(
+                function, boundaries(i_segment + 1), step);
+          }
+          this->segments.push_back(std::make_unique<Segment_t>(
+              function, boundaries(i_segment), boundaries(i_segment + 1),
+              error_bound, cols, rows, d2f_begin, d2f_end, max_grid_points,
+              initial_degree_of_fineness, n_threads));
+          d2f_begin = d2f_end;
+        }
+        this->initialize_segment_search();
+      }
+
+      /**
+       * Same as above with the natural boundary conditions at x1 and x2
+       */
+      InterpolatorMatrixPiecewiseUniformCubicSpline(
+          std::function<Matrix_t(double)> function, double x1, double x2,
+          double error_bound, int cols, int rows, int nb_segments = 1,
+          int max_grid_points = 100000, int initial_degree_of_fineness = 5,
+          size_t n_threads = 1)
+          : InterpolatorMatrixPiecewiseUniformCubicSpline(
+                function, x1, x2, error_bound, cols, rows,
+                Matrix_t::Zero(rows, cols), Matrix_t::Zero(rows, cols),
+                nb_segments, max_grid_points, initial_degree_of_fineness,
+                n_threads) {}
+
+      /**
+       * Constructor from the splines of the segments, e.g. read back from
+       * the ones of another piecewise spline.
+       *
+       * @throw std::logic_error the segments do not have the same width or
+       *        do not follow each other
+       */
+      explicit InterpolatorMatrixPiecewiseUniformCubicSpline(
+          std::vector<std::unique_ptr<Segment_t>> segments)
+          : segments{std::move(segments)} {
+        if (this->segments.empty()) {
+          throw std::logic_error("The number of segments must be at least 1.");
+        }
+        this->x1 = this->segments.front()->x1;
+        this->x2 = this->segments.back()->x2;
+        double width{(this->x2 - this->x1) / this->segments.size()};
+        for (size_t i_segment{0}; i_segment < this->segments.size();
+             ++i_segment) {
+          auto & segment{*this->segments[i_segment]};
+          if (std::abs(segment.x1 - (this->x1 + i_segment * width)) >
+                  DBL_FTOL or
+              std::abs(segment.x2 - segment.x1 - width) > DBL_FTOL) {
+            throw std::logic_error(
+                "The segments must have the same width and follow each "
+                "other.");
+          }
+        }
+        this->initialize_segment_search();
+      }
+
+      //! @pre x is in range [x1,x2]
+      Matrix_t interpolate(double x) {
+        return this->get_segment_at(x).interpolate(x);
+      }
+
+      //! @pre x is in range [x1,x2]
+      Matrix_t interpolate_derivative(double x) {
+        return this->get_segment_at(x).interpolate_derivative(x);
+      }
+
+      //! see InterpolatorMatrixUniformCubicSpline::interpolate_into
+      void interpolate_into(double x, Matrix_t & out) {
+        this->get_segment_at(x).interpolate_into(x, out);
+      }
+
+      //! see InterpolatorMatrixUniformCubicSpline::interpolate_derivative_into
+      void interpolate_derivative_into(double x, Matrix_t & out) {
+        this->get_segment_at(x).interpolate_derivative_into(x, out);
+      }
+
+      //! see InterpolatorMatrixUniformCubicSpline::interpolate_with_derivative
+      void interpolate_with_derivative(double x, Matrix_t & value,
+                                       Matrix_t & derivative) {
+        this->get_segment_at(x).interpolate_with_derivative(x, value,
+                                                            derivative);
+      }
+
+      /**
+       * Interpolates each x in points
+       *
+       * @return intp(x) in the shape (points.size(), rows*cols)
+       */
+      Matrix_t interpolate_to_vector(const Vector_Ref & points) {
+        Matrix_t interpolated_points(points.size(), this->get_matrix_size());
+        for (int i{0}; i < points.size(); i++) {
+          this->get_segment_at(points(i))
+              .interpolate_to_vector_into(points(i),
+                                          interpolated_points.row(i));
+        }
+        return interpolated_points;
+      }
+
+      /**
+       * Interpolates the derivative of each x in points
+       *
+       * @return intp'(x) in the shape (points.size(), rows*cols)
+       */
+      Matrix_t interpolate_to_vector_derivative(const Vector_Ref & points) {
+        Matrix_t interpolated_points(points.size(), this->get_matrix_size());
+        for (int i{0}; i < points.size(); i++) {
+          this->get_segment_at(points(i))
+              .interpolate_to_vector_derivative_into(
+                  points(i), interpolated_points.row(i));
+        }
+        return interpolated_points;
+      }
+
+      //! the spline of the segment containing x
+      Segment_t & get_segment_at(double x) {
+        int i_segment{static_cast<int>((x - this->x1) *
+                                       this->nb_segments_per_unit)};
+        i_segment =
+            std::max(0, std::min(i_segment, this->get_nb_segments() - 1));
+        return *this->segments[i_segment];
+      }
+
+      Segment_t & get_segment(int i_segment) {
+        return *this->segments.at(i_segment);
+      }
+
+      int get_nb_segments() const {
+        return static_cast<int>(this->segments.size());
+      }
+
+      //! total number of grid points of the segments
+      int get_grid_size() const {
+        int grid_size{0};
+        for (const auto & segment : this->segments) {
+          grid_size += segment->get_grid_size();
+        }
+        return grid_size;
+      }
+
+      int get_matrix_size() const {
+        return this->segments.front()->get_matrix_size();
+      }
+
+      int get_cols() const { return this->segments.front()->get_cols(); }
+
+      int get_rows() const { return this->segments.front()->get_rows(); }
+
+      double x1{0.};
+      double x2{0.};
+
+     protected:
+      void initialize_segment_search() {
+        this->nb_segments_per_unit =
+            this->segments.size() / (this->x2 - this->x1);
+      }
+
+      std::vector<std::unique_ptr<Segment_t>> segments{};
+      double nb_segments_per_unit{0.};
     };
 
   }  // namespace math
@@ -68,6 +68,37 @@ void SphericalHarmonics::precompute(size_t max_angular,
     angular_coeffs2(angular_l) = -std::sqrt(1.0 + 0.5 / angular_l);
   }
 
+  // solid harmonics, the extra row of solid_q stays zero for Q_l^(l+1)
+  this->solid_q = Matrix_t::Zero(this->max_angular + 2, this->max_angular + 1);
+  this->solid_coeff_a =
+      Matrix_t::Zero(this->max_angular + 1, this->max_angular + 1);
+  this->solid_coeff_b =
+      Matrix_t::Zero(this->max_angular + 1, this->max_angular + 1);
+  this->solid_factors =
+      Matrix_t::Zero(this->max_angular + 1, this->max_angular + 1);
+  this->xy_powers = MatrixX2_t::Zero(this->max_angular + 1, 2);
+  for (size_t angular_l{0}; angular_l < this->max_angular + 1; angular_l++) {
+    const double l_value{static_cast<double>(angular_l)};
+    this->solid_factors(0, angular_l) =
+        std::sqrt((2 * l_value + 1) / (4 * PI));
+    // (l - m)! / (l + m)!
+    double factorial_ratio{1.};
+    for (size_t m_count{1}; m_count < angular_l + 1; m_count++) {
+      const double m_value{static_cast<double>(m_count)};
+      factorial_ratio /= (l_value - m_value + 1) * (l_value + m_value);
+      this->solid_factors(m_count, angular_l) =
+          math::pow(-1., m_count) *
+          std::sqrt((2 * l_value + 1) / (2 * PI) * factorial_ratio);
+    }
+    for (size_t m_count{0}; m_count + 1 < angular_l; m_count++) {
+      const double m_value{static_cast<double>(m_count)};
+      this->solid_coeff_a(m_count, angular_l) =
+          (2 * l_value - 1) / (l_value - m_value);
+      this->solid_coeff_b(m_count, angular_l) =
+          (l_value + m_value - 1) / (l_value - m_value);
+    }
+  }
+
   // We want to precompute derivative information in almost any case
   if (calculate_derivatives or this->calculate_derivatives) {
     if (not this->calculate_derivatives) {
@@ -146,6 +177,26 @@ void SphericalHarmonics::calc(
     direction_normed = direction;
   }
 
+  if (calculate_derivatives and not this->derivatives_precomputed) {
+    // TODO(max) do we just precompute here instead of throwing a rude
+    // error?
+    std::stringstream err_str{};
+    err_str << "Resources for computation of dervatives have not been "
+               "initialized. Please set calculate_derivatives flag on "
+               "construction of the SphericalHarmonics object or during "
+               "precomputation.";
+    throw std::runtime_error(err_str.str());
+  }
+
+  if (this->method == SphericalHarmonicsMethod::Solid) {
+    if (conjugate) {
+      // (Y^m_l)* is Y^m_l of the direction mirrored by the xz plane
+      direction_normed[1] *= -1;
+    }
+    this->compute_solid_harmonics(direction_normed, calculate_derivatives);
+    return;
+  }
+
   // The cosine against the z-axis is just the z-component of the
   // direction vector
   double cos_theta = direction_normed[2];
@@ -168,22 +219,92 @@ void SphericalHarmonics::calc(
 
   this->compute_spherical_harmonics();
   if (calculate_derivatives) {
-    if (this->derivatives_precomputed) {
-      // A rose, by any other name, would have the same exact value
-      // double sin_theta = std::sqrt(1.0 - cos_theta*cos_theta);
-      double sin_theta{sqrt_xy};
-      this->compute_spherical_harmonics_derivatives(sin_theta, cos_theta,
-                                                    sin_phi, cos_phi);
-    } else {
-      // TODO(max) do we just precompute here instead of throwing a rude
-      // error?
-      std::stringstream err_str{};
-      err_str << "Resources for computation of dervatives have not been "
-                 "initialized. Please set calculate_derivatives flag on "
-                 "construction of the SphericalHarmonics object or during "
-                 "precomputation.";
-      throw std::runtime_error(err_str.str());
+    // A rose, by any other name, would have the same exact value
+    // double sin_theta = std::sqrt(1.0 - cos_theta*cos_theta);
+    double sin_theta{sqrt_xy};
+    this->compute_spherical_harmonics_derivatives(sin_theta, cos_theta,
+                                                  sin_phi, cos_phi);
+  }
+}
+
+void SphericalHarmonics::compute_solid_harmonics(
+    const Eigen::Vector3d & direction, bool calculate_derivatives) {
+  const double x{direction[0]}, y{direction[1]}, z{direction[2]};
+  auto & q = this->solid_q;
+  auto & xy = this->xy_powers;
+
+  // c_m + i s_m = (x + iy)^m
+  xy.row(0) << 1.0, 0.0;
+  for (size_t m_count{1}; m_count < this->max_angular + 1; m_count++) {
+    xy(m_count, 0) = x * xy(m_count - 1, 0) - y * xy(m_count - 1, 1);
+    xy(m_count, 1) = x * xy(m_count - 1, 1) + y * xy(m_count - 1, 0);
+  }
+
+  // Q_l^m with r = 1
+  q(0, 0) = 1.0;
+  for (size_t angular_l{1}; angular_l < this->max_angular + 1; angular_l++) {
+    const double two_l_m1{2. * angular_l - 1.};
+    q(angular_l, angular_l) = -two_l_m1 * q(angular_l - 1, angular_l - 1);
+    q(angular_l - 1, angular_l) =
+        two_l_m1 * z * q(angular_l - 1, angular_l - 1);
+    if (angular_l > 1) {
+      q.col(angular_l).head(angular_l - 1).array() =
+          this->solid_coeff_a.col(angular_l).head(angular_l - 1).array() * z *
+              q.col(angular_l - 1).head(angular_l - 1).array() -
+          this->solid_coeff_b.col(angular_l).head(angular_l - 1).array() *
+              q.col(angular_l - 2).head(angular_l - 1).array();
+    }
+  }
+
+  // the harmonics of l are stored around the m = 0 component at l(l+1)
+  for (size_t angular_l{0}; angular_l < this->max_angular + 1; angular_l++) {
+    const size_t l_center{angular_l * (angular_l + 1)};
+    auto factors = this->solid_factors.col(angular_l).segment(1, angular_l);
+    auto q_l = q.col(angular_l).segment(1, angular_l);
+    this->harmonics(l_center) =
+        this->solid_factors(0, angular_l) * q(0, angular_l);
+    this->harmonics.segment(l_center + 1, angular_l).array() =
+        factors.array() * q_l.array() * xy.col(0).segment(1, angular_l).array();
+    this->harmonics.segment(l_center - angular_l, angular_l).reverse() =
+        factors.array() * q_l.array() * xy.col(1).segment(1, angular_l).array();
+  }
+
+  if (not calculate_derivatives) {
+    return;
+  }
+
+  this->harmonics_derivatives.col(0).setZero();
+  for (size_t angular_l{1}; angular_l < this->max_angular + 1; angular_l++) {
+    const size_t l_center{angular_l * (angular_l + 1)};
+    const double l_value{static_cast<double>(angular_l)};
+    double factor{this->solid_factors(0, angular_l)};
+    this->harmonics_derivatives.col(l_center)
+        << factor * x * q(1, angular_l - 1),
+        factor * y * q(1, angular_l - 1),
+        factor * l_value * q(0, angular_l - 1);
+    for (size_t m_count{1}; m_count < angular_l + 1; m_count++) {
+      const double m_value{static_cast<double>(m_count)};
+      factor = this->solid_factors(m_count, angular_l);
+      const double q_lm{factor * q(m_count, angular_l)};
+      const double dq_xy{factor * q(m_count + 1, angular_l - 1)};
+      const double dq_z{factor * (l_value + m_value) *
+                        q(m_count, angular_l - 1)};
+      const double c_m{xy(m_count, 0)}, s_m{xy(m_count, 1)};
+      const double c_m1{m_value * xy(m_count - 1, 0)};
+      const double s_m1{m_value * xy(m_count - 1, 1)};
+      this->harmonics_derivatives.col(l_center + m_count)
+          << x * dq_xy * c_m + q_lm * c_m1,
+          y * dq_xy * c_m - q_lm * s_m1, dq_z * c_m;
+      this->harmonics_derivatives.col(l_center - m_count)
+          << x * dq_xy * s_m + q_lm * s_m1,
+          y * dq_xy * s_m + q_lm * c_m1, dq_z * s_m;
     }
+    // remove the radial component of the gradients of the solid harmonics
+    auto block_derivatives = this->harmonics_derivatives.middleCols(
+        angular_l * angular_l, 2 * angular_l + 1);
+    block_derivatives -=
+        l_value * direction *
+        this->harmonics.segment(angular_l * angular_l, 2 * angular_l + 1);
   }
 }
 
@@ -33,6 +33,14 @@
 
 namespace rascal {
   namespace math {
+    /**
+     * Algorithm used by SphericalHarmonics: Legendre goes through the
+     * associated Legendre polynomials of \f$\cos\theta\f$ and the multiples
+     * of \f$\phi\f$, Solid through the real solid harmonics computed from
+     * the Cartesian components of the direction.
+     */
+    enum class SphericalHarmonicsMethod { Legendre, Solid };
+
     /**
      * Compute a full set of spherical harmonics (optimized version)
      *
@@ -78,6 +86,21 @@ namespace rascal {
      *
      * Cartesian gradients can optionally be computed in addition.
      *
+     * With SphericalHarmonicsMethod::Solid the same harmonics are computed
+     * as the real solid harmonics \f$r^\ell Y_\ell^m\f$ of the unit
+     * direction \f$(x, y, z)\f$. They are written as
+     * \f$F_\ell^m Q_\ell^m(z) c_m(x, y)\f$ (and \f$s_m\f$ for \f$m < 0\f$)
+     * where \f$c_m + i s_m = (x + iy)^m\f$ and
+     * \f$Q_\ell^m\f$ follows the recursions
+     * \f{eqnarray}{
+     * Q_m^m &=& -(2m - 1) Q_{m-1}^{m-1}\\
+     * Q_{m+1}^m &=& (2m + 1) z Q_m^m\\
+     * (\ell - m) Q_\ell^m &=& (2\ell - 1) z Q_{\ell-1}^m
+     *                        - (\ell + m - 1) r^2 Q_{\ell-2}^m
+     * \f}
+     * so the values and the gradients only need multiplications and
+     * additions, and there is no special case along the z-axis.
+     *
      * Part of the efficiency derives from moving the direction-independent
      * calculations into a separate precompute() method; you must therefore call
      * precompute() (which also sets \f$\ell_\text{max}\f$) before any call to
@@ -121,6 +144,13 @@ namespace rascal {
        */
       void precompute(size_t max_angular, bool calculate_derivatives = false);
 
+      //! Select the algorithm used by calc(), Legendre by default
+      void set_method(SphericalHarmonicsMethod method) {
+        this->method = method;
+      }
+
+      SphericalHarmonicsMethod get_method() const { return this->method; }
+
       /**
        * Compute a full set of spherical harmonics given a direction vector.
        * If calculate_derivatives flag is on, the derivatives are additionally
@@ -148,6 +178,7 @@ namespace rascal {
         this->calc(direction, this->calculate_derivatives, conjugate);
       }
 
+      //! Only computed by the Legendre method
       const Matrix_Ref get_assoc_legendre_polynom() {
         // Since for calculation purposes assoc_legendre_polynom has one column
         // more than it would have in standard libaries, we return only the
@@ -268,6 +299,24 @@ namespace rascal {
                                                    double sin_phi,
                                                    double cos_phi);
 
+      /**
+       * Compute the harmonics, and their gradients if calculate_derivatives,
+       * with the recursion of the real solid harmonics (see the class
+       * documentation).
+       *
+       * The gradients of \f$Y_\ell^m(\hat{r})\f$ follow from the ones of
+       * the solid harmonics, \f$\partial_x Q_\ell^m = x Q_{\ell-1}^{m+1}\f$,
+       * \f$\partial_y Q_\ell^m = y Q_{\ell-1}^{m+1}\f$,
+       * \f$\partial_z Q_\ell^m = (\ell + m) Q_{\ell-1}^m\f$,
+       * \f$\partial_x c_m = m c_{m-1}\f$, \f$\partial_y c_m = -m s_{m-1}\f$,
+       * \f$\partial_x s_m = m s_{m-1}\f$, \f$\partial_y s_m = m c_{m-1}\f$,
+       * minus their radial component \f$\ell Y_\ell^m \hat{r}\f$.
+       *
+       * @param direction unit vector
+       */
+      void compute_solid_harmonics(const Eigen::Vector3d & direction,
+                                   bool calculate_derivatives);
+
       const MatrixX2_Ref get_cos_sin_m_phi() {
         return MatrixX2_Ref(this->cos_sin_m_phi);
       }
@@ -287,6 +336,15 @@ namespace rascal {
       Matrix_t plm_factors{};
       Vector_t legendre_polynom_differences{};
       Vector_t phi_derivative_factors{};
+      // solid harmonics related member variables, indexed by (m, l)
+      SphericalHarmonicsMethod method{SphericalHarmonicsMethod::Legendre};
+      Matrix_t solid_q{};
+      Matrix_t solid_coeff_a{};
+      Matrix_t solid_coeff_b{};
+      //! normalization, including the (-1)^m phase of the Legendre method
+      Matrix_t solid_factors{};
+      //! c_m and s_m in the first and second column
+      MatrixX2_t xy_powers{};
     };
 
   }  // namespace math
@@ -0,0 +1,345 @@
+/**
+ * @file   rascal/models/cur_selection.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief CUR selection of samples or features with a randomized range finder
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_MODELS_CUR_SELECTION_HH_
+#define SRC_RASCAL_MODELS_CUR_SELECTION_HH_
+
+#include "rascal/math/utils.hh"
+#include "rascal/utils/json_io.hh"
+#include "rascal/utils/parallel.hh"
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/QR>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace rascal {
+
+  namespace internal {
+    enum class CURSelectionType { Sample, Feature };
+
+    /**
+     * Dense features of the centers of a collection of structures, provided
+     * one structure at a time so that the full feature matrix is never
+     * stored. The columns follow the keys present in the collection, like
+     * StructureManagerCollection::get_features, and only the centers whose
+     * atomic type is in species are considered (all if empty).
+     */
+    template <class Property_t>
+    class StreamedFeatures {
+     public:
+      using Keys_t = typename Property_t::Keys_t;
+
+      template <class StructureManagers>
+      StreamedFeatures(StructureManagers & managers,
+                       const std::string & representation_name,
+                       const std::vector<int> & species) {
+        for (auto & manager : managers) {
+          auto prop{manager->template get_property<Property_t>(
+              representation_name, true)};
+          auto prop_keys{prop->get_keys()};
+          this->keys.insert(prop_keys.begin(), prop_keys.end());
+          std::vector<Eigen::Index> rows{};
+          Eigen::Index i_center{0};
+          for (auto center : manager) {
+            if (species.empty() or
+                std::find(species.begin(), species.end(),
+                          center.get_atom_type()) != species.end()) {
+              rows.push_back(i_center);
+            }
+            ++i_center;
+          }
+          this->nb_samples += rows.size();
+          this->props.push_back(prop);
+          this->rows.push_back(std::move(rows));
+        }
+        if (not this->props.empty()) {
+          this->nb_features =
+              this->keys.size() * this->props[0]->get_nb_comp();
+        }
+      }
+
+      size_t size() const { return this->props.size(); }
+
+      //! features of the selected centers of structure i_structure
+      math::Matrix_t get(const size_t i_structure) const {
+        const auto & prop{*this->props[i_structure]};
+        math::Matrix_t all(prop.size(), this->nb_features);
+        prop.fill_dense_feature_matrix(all, this->keys);
+        const auto & rows_{this->rows[i_structure]};
+        if (static_cast<size_t>(all.rows()) == rows_.size()) {
+          return all;
+        }
+        math::Matrix_t selected(rows_.size(), this->nb_features);
+        for (size_t i_row{0}; i_row < rows_.size(); ++i_row) {
+          selected.row(i_row) = all.row(rows_[i_row]);
+        }
+        return selected;
+      }
+
+      //! number of selected centers of structure i_structure
+      size_t get_nb_samples(const size_t i_structure) const {
+        return this->rows[i_structure].size();
+      }
+
+      size_t nb_samples{0};
+      size_t nb_features{0};
+
+     protected:
+      std::vector<std::shared_ptr<Property_t>> props{};
+      std::vector<std::vector<Eigen::Index>> rows{};
+      Keys_t keys{};
+    };
+  }  // namespace internal
+
+  /**
+   * CUR selection of samples (centers) or features of the representation
+   * computed with calculator on managers.
+   *
+   * Like skmatter's CUR, the item with the largest leverage score, i.e. the
+   * squared norm of its components in the top k singular vectors, is
+   * selected and the remaining items are orthogonalized with respect to it
+   * before the next selection.
+   *
+   * Instead of the exact SVD of the dense feature matrix X, the dominant
+   * row space of X is found with a randomized range finder
+   *
+   * @f[
+   *      Q = \mathrm{orth}\left((X^T X)^{q+1} \Omega\right),
+   * @f]
+   *
+   * with \f$\Omega\f$ a Gaussian matrix with n_select + n_oversampling
+   * columns. This takes n_power_iterations + 2 passes over the features,
+   * which are densified one structure at a time. The selection then runs
+   * on the coordinates of the samples, \f$XQ\f$, or of the features,
+   * \f$Q W \Lambda^{1/2}\f$ with \f$Q^T X^T X Q = W \Lambda W^T\f$, in this
+   * subspace so it is exact when the subspace covers the row space of X.
+   *
+   * The size of the sketch is d = min(n_select + n_oversampling, n_features,
+   * n_samples), independent of the number of items, and the only dense
+   * matrices kept besides the features of one structure per thread are
+   *   - the coordinates of the items, n_items x d,
+   *   - the basis Q and one accumulator of X^T X Q per thread,
+   *     (1 + n_threads) x n_features x d,
+   *   - the projectors and Gram matrices of the selection, 3 x d x d,
+   * with n_items the number of samples or of features.
+   *
+   * Hypers:
+   *   - selection_type: "sample" or "feature"
+   *   - n_select: number of items to select
+   *   - species (optional): atomic types of the centers to consider, all of
+   *     them by default
+   *   - k (optional, 1): number of singular vectors of the leverage scores
+   *   - n_oversampling (optional, 10)
+   *   - n_power_iterations (optional, 2)
+   *   - seed (optional, 0): seed of the random number generator
+   *
+   * @param n_threads number of threads used for the passes over the
+   *        features and the leverage scores, 0 for as many as the hardware
+   *        supports
+   * @return the selected indices in the order of selection. Samples are
+   *         indexed among the centers considered, in the order of managers,
+   *         and features follow the columns of
+   *         StructureManagerCollection::get_features.
+   */
+  template <class Calculator, class StructureManagers>
+  std::vector<size_t> select_cur(const Calculator & calculator,
+                                 StructureManagers & managers,
+                                 const json & hypers,
+                                 const size_t n_threads = 1) {
+    using ManagerPtr_t = typename StructureManagers::value_type;
+    using Manager_t = typename ManagerPtr_t::element_type;
+    using Property_t = typename Calculator::template Property_t<Manager_t>;
+    using internal::CURSelectionType;
+    using ColVector_t = Eigen::VectorXd;
+
+    CURSelectionType selection_type{};
+    const auto selection_type_str{
+        hypers.at("selection_type").get<std::string>()};
+    if (selection_type_str == "sample") {
+      selection_type = CURSelectionType::Sample;
+    } else if (selection_type_str == "feature") {
+      selection_type = CURSelectionType::Feature;
+    } else {
+      throw std::runtime_error("selection_type should be either 'sample' or "
+                               "'feature' but is '" +
+                               selection_type_str + "'.");
+    }
+    const auto n_select{hypers.at("n_select").get<size_t>()};
+    std::vector<int> species{};
+    if (hypers.count("species") == 1) {
+      species = hypers.at("species").get<std::vector<int>>();
+    }
+    const size_t k{hypers.value("k", size_t{1})};
+    const size_t n_oversampling{hypers.value("n_oversampling", size_t{10})};
+    const size_t n_power_iterations{
+        hypers.value("n_power_iterations", size_t{2})};
+    const auto seed{hypers.value("seed", size_t{0})};
+
+    internal::StreamedFeatures<Property_t> features{
+        managers, calculator.get_name(), species};
+    const size_t n_items{selection_type == CURSelectionType::Sample
+                             ? features.nb_samples
+                             : features.nb_features};
+    if (n_select > n_items or k == 0) {
+      std::stringstream err_str{};
+      err_str << "Cannot select " << n_select << " " << selection_type_str
+              << "s out of " << n_items << " with k=" << k << ".";
+      throw std::runtime_error(err_str.str());
+    }
+    std::vector<size_t> selected_ids{};
+    if (n_select == 0) {
+      return selected_ids;
+    }
+    const size_t n_features{features.nb_features};
+    // size of the sketch, which bounds the memory used by the selection
+    const auto n_dim{static_cast<Eigen::Index>(std::min(
+        {n_select + n_oversampling, n_features, features.nb_samples}))};
+
+    // X^T X Z in one pass over the features
+    std::vector<math::Matrix_t> chunk_sums{};
+    auto gram_product = [&](const math::Matrix_t & Z) {
+      const auto n_chunks{
+          std::min(internal::get_nb_threads(n_threads), features.size())};
+      chunk_sums.assign(std::max(n_chunks, size_t{1}),
+                        math::Matrix_t::Zero(n_features, Z.cols()));
+      const auto n_used{internal::parallel_for_chunks(
+          features.size(), n_threads, [&](size_t i_structure, size_t i_chunk) {
+            const math::Matrix_t X{features.get(i_structure)};
+            chunk_sums[i_chunk].noalias() += X.transpose() * (X * Z);
+          })};
+      for (size_t i_chunk{1}; i_chunk < n_used; ++i_chunk) {
+        chunk_sums[0] += chunk_sums[i_chunk];
+      }
+      return chunk_sums[0];
+    };
+    auto orthonormalize = [](const math::Matrix_t & Z) {
+      Eigen::HouseholderQR<math::Matrix_t> qr{Z};
+      return math::Matrix_t{
+          qr.householderQ() * math::Matrix_t::Identity(Z.rows(), Z.cols())};
+    };
+
+    // randomized range finder
+    std::mt19937 generator{static_cast<std::mt19937::result_type>(seed)};
+    std::normal_distribution<double> distribution{};
+    math::Matrix_t Q{math::Matrix_t::NullaryExpr(
+        n_features, n_dim, [&]() { return distribution(generator); })};
+    for (size_t i_iter{0}; i_iter < n_power_iterations + 1; ++i_iter) {
+      Q = orthonormalize(gram_product(Q));
+    }
+
+    // coordinates of the items in the dominant subspace, one per row
+    math::Matrix_t R{};
+    if (selection_type == CURSelectionType::Sample) {
+      std::vector<size_t> first_rows{};
+      size_t i_row{0};
+      for (size_t i_structure{0}; i_structure < features.size();
+           ++i_structure) {
+        first_rows.push_back(i_row);
+        i_row += features.get_nb_samples(i_structure);
+      }
+      // n_samples x d, the samples are never stored with all their features
+      R.resize(features.nb_samples, n_dim);
+      internal::parallel_for_chunks(
+          features.size(), n_threads, [&](size_t i_structure, size_t) {
+            R.middleRows(first_rows[i_structure],
+                         features.get_nb_samples(i_structure))
+                .noalias() = features.get(i_structure) * Q;
+          });
+    } else {
+      math::Matrix_t QtXtXQ{Q.transpose() * gram_product(Q)};
+      Eigen::SelfAdjointEigenSolver<math::Matrix_t> eigen{QtXtXQ};
+      R = Q * eigen.eigenvectors() *
+          eigen.eigenvalues().cwiseMax(0.).cwiseSqrt().asDiagonal();
+    }
+
+    /*
+     * The items are orthogonalized by projecting out the direction r_s of
+     * the last selection from all the rows, R <- R (I - r_s^T r_s / |r_s|^2),
+     * so the current coordinates are R M with M accumulating the projectors
+     * and the Gram matrix (R M)^T R M is updated in place.
+     */
+    const math::Matrix_t RtR{R.transpose() * R};
+    math::Matrix_t M{math::Matrix_t::Identity(n_dim, n_dim)};
+    math::Matrix_t C{RtR};
+    const auto n_vectors{static_cast<Eigen::Index>(
+        std::min(k, static_cast<size_t>(n_dim)))};
+    std::vector<bool> is_selected(n_items, false);
+    ColVector_t leverage(n_items);
+    ColVector_t projection(n_items);
+    selected_ids.reserve(n_select);
+    for (size_t i_select{0}; i_select < n_select; ++i_select) {
+      Eigen::SelfAdjointEigenSolver<math::Matrix_t> eigen{C};
+      const auto & eigenvalues{eigen.eigenvalues()};
+      const double threshold{std::max(eigenvalues(n_dim - 1), 0.) * 1e-12};
+      // leverage of item i: sum_c ((R M)_i v_c)^2 / lambda_c
+      leverage.setZero();
+      for (Eigen::Index i_vec{n_dim - n_vectors}; i_vec < n_dim; ++i_vec) {
+        if (eigenvalues(i_vec) <= threshold) {
+          continue;
+        }
+        const ColVector_t direction{M * eigen.eigenvectors().col(i_vec)};
+        internal::parallel_for_chunks(
+            n_items, n_threads, [&](size_t i_item, size_t) {
+              projection(i_item) = R.row(i_item).dot(direction);
+            });
+        leverage += projection.cwiseAbs2() / eigenvalues(i_vec);
+      }
+
+      size_t selected{n_items};
+      for (size_t i_item{0}; i_item < n_items; ++i_item) {
+        if (not is_selected[i_item] and
+            (selected == n_items or leverage(i_item) > leverage(selected))) {
+          selected = i_item;
+        }
+      }
+      selected_ids.push_back(selected);
+      is_selected[selected] = true;
+
+      // orthogonalize with respect to the selected item
+      const ColVector_t r_s{(R.row(selected) * M).transpose()};
+      const double norm2{r_s.squaredNorm()};
+      if (norm2 == 0.) {
+        continue;
+      }
+      const ColVector_t v{r_s / std::sqrt(norm2)};
+      // M <- M (I - v v^T) and C <- (I - v v^T) C (I - v v^T)
+      M -= (M * v) * v.transpose();
+      const ColVector_t Cv{C * v};
+      const double vCv{v.dot(Cv)};
+      C -= Cv * v.transpose() + v * Cv.transpose();
+      C += vCv * v * v.transpose();
+    }
+    return selected_ids;
+  }
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_MODELS_CUR_SELECTION_HH_
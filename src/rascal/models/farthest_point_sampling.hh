@@ -0,0 +1,185 @@
+/**
+ * @file   rascal/models/farthest_point_sampling.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Farthest point sampling of atomic environments
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_MODELS_FARTHEST_POINT_SAMPLING_HH_
+#define SRC_RASCAL_MODELS_FARTHEST_POINT_SAMPLING_HH_
+
+#include "rascal/math/utils.hh"
+#include "rascal/utils/parallel.hh"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rascal {
+
+  //! Result of a farthest point sampling
+  struct FPSSelection {
+    //! indices of the selected samples in the order of selection
+    std::vector<size_t> selected_ids{};
+    /**
+     * squared distance between each selected sample and the samples
+     * selected before it, i.e. the Hausdorff distance at selection. It is
+     * infinite for the first one.
+     */
+    std::vector<double> distances{};
+  };
+
+  /**
+   * Farthest point sampling (FPS) of the atomic environments of managers
+   * using the representation computed with calculator.
+   *
+   * The samples are the centers of the structures, in order, whose atomic
+   * type is in species (all the centers if species is empty), so the
+   * selected indices follow the same convention as the rows of the feature
+   * matrix of these centers. The features are used directly from the
+   * block sparse storage and their norms are computed once. At each step
+   * the distances to the last selected sample are updated using n_threads
+   * threads (0 for as many as the hardware supports), which are created
+   * once for the whole selection.
+   *
+   * @param n_select number of samples to select
+   * @param initial index of the first selected sample
+   * @throw std::runtime_error if there are fewer than n_select samples
+   */
+  template <class Calculator, class StructureManagers>
+  FPSSelection
+  select_farthest_points(const Calculator & calculator,
+                         const StructureManagers & managers,
+                         const size_t n_select,
+                         const std::vector<int> & species = {},
+                         const size_t initial = 0,
+                         const size_t n_threads = 1) {
+    using ManagerPtr_t = typename StructureManagers::value_type;
+    using Manager_t = typename ManagerPtr_t::element_type;
+    using Property_t = typename Calculator::template Property_t<Manager_t>;
+    using KeyMap_t = typename Property_t::InputData_t;
+
+    // features of the samples
+    std::vector<const KeyMap_t *> samples{};
+    for (const auto & manager : managers) {
+      auto && prop{*manager->template get_property<Property_t>(
+          calculator.get_name(), true)};
+      for (auto center : manager) {
+        if (species.empty() or
+            std::find(species.begin(), species.end(),
+                      center.get_atom_type()) != species.end()) {
+          samples.push_back(&prop[center]);
+        }
+      }
+    }
+    const size_t n_samples{samples.size()};
+    if (n_select > n_samples or (n_select > 0 and initial >= n_samples)) {
+      std::stringstream err_str{};
+      err_str << "Cannot select " << n_select << " samples starting from "
+              << initial << " out of " << n_samples << " samples.";
+      throw std::runtime_error(err_str.str());
+    }
+
+    FPSSelection selection{};
+    if (n_select == 0) {
+      return selection;
+    }
+
+    // contiguous ranges of samples handled by each thread
+    const size_t n_threads_used{
+        std::min(internal::get_nb_threads(n_threads), n_samples)};
+    const size_t chunk_size{(n_samples + n_threads_used - 1) /
+                            n_threads_used};
+    const size_t n_chunks{(n_samples + chunk_size - 1) / chunk_size};
+
+    math::Vector_t norms(n_samples);
+    // squared distance of each sample to the selected ones
+    math::Vector_t min_distances{math::Vector_t::Constant(
+        n_samples, std::numeric_limits<double>::infinity())};
+    // farthest sample of each chunk and its distance. The two buffers
+    // alternate between the steps so that a chunk can start the next step
+    // while the others still reduce the current one.
+    using ChunkBest_t = std::pair<size_t, double>;
+    std::array<std::vector<ChunkBest_t>, 2> chunk_best{
+        {std::vector<ChunkBest_t>(n_chunks),
+         std::vector<ChunkBest_t>(n_chunks)}};
+    selection.selected_ids.resize(n_select);
+    selection.distances.resize(n_select);
+    selection.selected_ids[0] = initial;
+    selection.distances[0] = std::numeric_limits<double>::infinity();
+
+    // one thread per chunk for the whole selection, synchronised between
+    // the steps
+    internal::parallel_team(n_chunks, [&](size_t i_chunk,
+                                          internal::TeamBarrier & barrier) {
+      const size_t start{i_chunk * chunk_size};
+      const size_t end{std::min(start + chunk_size, n_samples)};
+      for (size_t i_sample{start}; i_sample < end; ++i_sample) {
+        norms(i_sample) = samples[i_sample]->dot(*samples[i_sample]);
+      }
+      barrier.wait();
+
+      size_t selected{initial};
+      for (size_t i_select{1}; i_select < n_select; ++i_select) {
+        const auto & feature{*samples[selected]};
+        const double norm{norms(selected)};
+        ChunkBest_t best{start, -1.};
+        for (size_t i_sample{start}; i_sample < end; ++i_sample) {
+          // clip the round off errors of the expanded form
+          const double distance{std::max(
+              norms(i_sample) + norm - 2. * samples[i_sample]->dot(feature),
+              0.)};
+          if (distance < min_distances(i_sample)) {
+            min_distances(i_sample) = distance;
+          }
+          if (min_distances(i_sample) > best.second) {
+            best = {i_sample, min_distances(i_sample)};
+          }
+        }
+        auto & step_best{chunk_best[i_select % 2]};
+        step_best[i_chunk] = best;
+        barrier.wait();
+        // every chunk finds the same sample, the first of the farthest like
+        // np.argmax
+        ChunkBest_t farthest{step_best[0]};
+        for (size_t j_chunk{1}; j_chunk < n_chunks; ++j_chunk) {
+          if (step_best[j_chunk].second > farthest.second) {
+            farthest = step_best[j_chunk];
+          }
+        }
+        selected = farthest.first;
+        if (i_chunk == 0) {
+          selection.selected_ids[i_select] = farthest.first;
+          selection.distances[i_select] = farthest.second;
+        }
+      }
+    });
+    return selection;
+  }
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_MODELS_FARTHEST_POINT_SAMPLING_HH_
@@ -30,6 +30,14 @@
 #include "rascal/math/utils.hh"
 #include "rascal/structure_managers/structure_manager_collection.hh"
 #include "rascal/utils/json_io.hh"
+#include "rascal/utils/parallel.hh"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace rascal {
 
@@ -72,6 +80,8 @@ namespace rascal {
 
       //! exponent of the cosine kernel
       size_t zeta{1};
+      //! approximate number of centers in the tiles of the structure kernels
+      size_t tile_size{512};
 
       KernelImpl() = default;
 
@@ -86,11 +96,22 @@ namespace rascal {
           throw std::runtime_error(
               R"(zeta should be specified for the cosine kernel)");
         }
+        if (hypers.count("tile_size") == 1) {
+          tile_size = std::max(hypers["tile_size"].get<size_t>(), size_t{1});
+        }
       }
 
       /**
        * Compute the kernel between 2 set of structure(s), structure wise.
        *
+       * The structures are grouped in tiles of about tile_size centers. The
+       * features of the centers of a pair of tiles are packed in dense
+       * matrices over the keys present in both tiles, the only ones that
+       * contribute to the dot products, so that the atom-atom dot products
+       * are computed with a single GEMM before being reduced to the
+       * structure kernels. The pairs of tiles are distributed over n_threads
+       * threads (0 for as many as the hardware supports).
+       *
        * @tparam StructureManagers should be an iterable over shared pointer
        *          of structure managers like ManagerCollection
        * @param managers_a a ManagerCollection or similar collection of
@@ -107,28 +128,40 @@ namespace rascal {
           class StructureManagers>
       math::Matrix_t compute(StructureManagers & managers_a,
                              StructureManagers & managers_b,
-                             const std::string & representation_name) {
-        math::Matrix_t kernel(managers_a.size(), managers_b.size());
-        size_t ii_A{0};
-        for (auto & manager_a : managers_a) {
-          size_t ii_B{0};
-          auto && propA{*manager_a->template get_property<Property_t>(
-              representation_name, true)};
-          for (auto & manager_b : managers_b) {
-            auto && propB{*manager_b->template get_property<Property_t>(
-                representation_name, true)};
+                             const std::string & representation_name,
+                             const size_t n_threads = 1) {
+        auto props_a{get_properties<Property_t>(managers_a,
+                                                representation_name)};
+        auto props_b{get_properties<Property_t>(managers_b,
+                                                representation_name)};
+        const auto tiles_a{this->make_tiles(props_a)};
+        const auto tiles_b{this->make_tiles(props_b)};
+        const auto tile_keys_a{get_tile_keys(props_a, tiles_a)};
+        const auto tile_keys_b{get_tile_keys(props_b, tiles_b)};
 
-            kernel(ii_A, ii_B) = pow_zeta(propA.dot(propB), this->zeta).mean();
-            ++ii_B;
-          }
-          ++ii_A;
-        }
+        math::Matrix_t kernel(managers_a.size(), managers_b.size());
+        internal::parallel_for(
+            tiles_a.size() * tiles_b.size(), n_threads, [&](size_t i_pair) {
+              const size_t i_tile_a{i_pair / tiles_b.size()};
+              const size_t i_tile_b{i_pair % tiles_b.size()};
+              const auto & tile_a{tiles_a[i_tile_a]};
+              const auto & tile_b{tiles_b[i_tile_b]};
+              const auto keys{get_common_keys(tile_keys_a[i_tile_a],
+                                              tile_keys_b[i_tile_b])};
+              math::Matrix_t features_a{pack_tile(props_a, tile_a, keys)};
+              math::Matrix_t features_b{pack_tile(props_b, tile_b, keys)};
+              math::Matrix_t atom_kernel{features_a *
+                                         features_b.transpose()};
+              this->reduce_tile(std::move(atom_kernel), props_a, tile_a,
+                                props_b, tile_b, false, kernel);
+            });
         return kernel;
       }
 
       /**
        * Compute the kernel between 1 set of structure(s) with itself,
-       * structure wise.
+       * structure wise. Same as above but only the pairs of tiles of the
+       * upper triangle are computed.
        *
        * @tparam StructureManagers should be an iterable over shared pointer
        *          of structure managers like ManagerCollection
@@ -143,25 +176,44 @@ namespace rascal {
           std::enable_if_t<Type == internal::TargetType::Structure, int> = 0,
           class StructureManagers>
       math::Matrix_t compute(StructureManagers & managers_a,
-                             const std::string & representation_name) {
-        math::Matrix_t kernel(managers_a.size(), managers_a.size());
-        auto manager_a_it = managers_a.begin();
-        for (size_t ii_A{0}; ii_A < managers_a.size(); ii_A++) {
-          const auto & manager_a = *manager_a_it;
-          auto && propA{*manager_a->template get_property<Property_t>(
-              representation_name)};
-          kernel(ii_A, ii_A) = pow_zeta(propA.dot(), this->zeta).mean();
-          auto manager_b_it = managers_a.begin() + ii_A + 1;
-          for (size_t ii_B{ii_A + 1}; ii_B < managers_a.size(); ii_B++) {
-            const auto & manager_b = *manager_b_it;
-            auto && propB{*manager_b->template get_property<Property_t>(
-                representation_name)};
-            kernel(ii_A, ii_B) = pow_zeta(propA.dot(propB), this->zeta).mean();
-            kernel(ii_B, ii_A) = kernel(ii_A, ii_B);
-            ++manager_b_it;
+                             const std::string & representation_name,
+                             const size_t n_threads = 1) {
+        auto props{get_properties<Property_t>(managers_a,
+                                              representation_name)};
+        const auto tiles{this->make_tiles(props)};
+        const auto tile_keys{get_tile_keys(props, tiles)};
+        // pairs of tiles of the upper triangle
+        std::vector<std::array<size_t, 2>> pairs{};
+        for (size_t i_tile{0}; i_tile < tiles.size(); ++i_tile) {
+          for (size_t j_tile{i_tile}; j_tile < tiles.size(); ++j_tile) {
+            pairs.push_back({{i_tile, j_tile}});
           }
-          ++manager_a_it;
         }
+
+        math::Matrix_t kernel(managers_a.size(), managers_a.size());
+        internal::parallel_for(pairs.size(), n_threads, [&](size_t i_pair) {
+          const auto & tile_a{tiles[pairs[i_pair][0]]};
+          const auto & tile_b{tiles[pairs[i_pair][1]]};
+          const auto & keys_a{tile_keys[pairs[i_pair][0]]};
+          math::Matrix_t atom_kernel{};
+          if (pairs[i_pair][0] == pairs[i_pair][1]) {
+            math::Matrix_t features_a{pack_tile(props, tile_a, keys_a)};
+            // syrk instead of gemm, see PropertyBlockSparse::dot
+            atom_kernel.setZero(features_a.rows(), features_a.rows());
+            atom_kernel.selfadjointView<Eigen::Upper>().rankUpdate(
+                features_a);
+            atom_kernel.triangularView<Eigen::StrictlyLower>() =
+                atom_kernel.transpose();
+          } else {
+            const auto keys{
+                get_common_keys(keys_a, tile_keys[pairs[i_pair][1]])};
+            math::Matrix_t features_a{pack_tile(props, tile_a, keys)};
+            math::Matrix_t features_b{pack_tile(props, tile_b, keys)};
+            atom_kernel.noalias() = features_a * features_b.transpose();
+          }
+          this->reduce_tile(std::move(atom_kernel), props, tile_a, props,
+                            tile_b, true, kernel);
+        });
         return kernel;
       }
 
@@ -183,7 +235,8 @@ namespace rascal {
                 class StructureManagers>
       math::Matrix_t compute(const StructureManagers & managers_a,
                              const StructureManagers & managers_b,
-                             const std::string & representation_name) {
+                             const std::string & representation_name,
+                             const size_t /*n_threads*/ = 1) {
         size_t n_centersA{0};
         for (const auto & manager_a : managers_a) {
           n_centersA += manager_a->size();
@@ -229,7 +282,8 @@ namespace rascal {
                 std::enable_if_t<Type == internal::TargetType::Atom, int> = 0,
                 class StructureManagers>
       math::Matrix_t compute(const StructureManagers & managers_a,
-                             const std::string & representation_name) {
+                             const std::string & representation_name,
+                             const size_t /*n_threads*/ = 1) {
         size_t n_centersA{0};
         for (const auto & manager_a : managers_a) {
           n_centersA += manager_a->size();
@@ -264,6 +318,122 @@ namespace rascal {
         }
         return kernel;
       }
+
+     protected:
+      //! range [first, last) of structures and their number of centers
+      struct Tile {
+        size_t first{0};
+        size_t last{0};
+        size_t n_centers{0};
+      };
+
+      //! fetch the representation of every structure once
+      template <class Property_t, class StructureManagers>
+      static std::vector<std::shared_ptr<Property_t>>
+      get_properties(StructureManagers & managers,
+                     const std::string & representation_name) {
+        std::vector<std::shared_ptr<Property_t>> props{};
+        props.reserve(managers.size());
+        for (auto & manager : managers) {
+          props.push_back(manager->template get_property<Property_t>(
+              representation_name, true));
+        }
+        return props;
+      }
+
+      //! union of the keys present in the representations of each tile
+      template <class Property_t>
+      static std::vector<typename Property_t::Keys_t>
+      get_tile_keys(const std::vector<std::shared_ptr<Property_t>> & props,
+                    const std::vector<Tile> & tiles) {
+        std::vector<typename Property_t::Keys_t> tile_keys(tiles.size());
+        for (size_t i_tile{0}; i_tile < tiles.size(); ++i_tile) {
+          for (size_t i_structure{tiles[i_tile].first};
+               i_structure < tiles[i_tile].last; ++i_structure) {
+            auto prop_keys{props[i_structure]->get_keys()};
+            tile_keys[i_tile].insert(prop_keys.begin(), prop_keys.end());
+          }
+        }
+        return tile_keys;
+      }
+
+      //! keys present in both keys_a and keys_b
+      template <class Keys_t>
+      static Keys_t get_common_keys(const Keys_t & keys_a,
+                                    const Keys_t & keys_b) {
+        Keys_t keys{};
+        std::set_intersection(keys_a.begin(), keys_a.end(), keys_b.begin(),
+                              keys_b.end(), std::inserter(keys, keys.end()));
+        return keys;
+      }
+
+      //! group consecutive structures up to about tile_size centers
+      template <class Property_t>
+      std::vector<Tile>
+      make_tiles(const std::vector<std::shared_ptr<Property_t>> & props) const {
+        std::vector<Tile> tiles{};
+        Tile tile{};
+        for (size_t i_structure{0}; i_structure < props.size();
+             ++i_structure) {
+          tile.n_centers += props[i_structure]->size();
+          tile.last = i_structure + 1;
+          if (tile.n_centers >= this->tile_size or
+              i_structure + 1 == props.size()) {
+            tiles.push_back(tile);
+            tile = Tile{tile.last, tile.last, 0};
+          }
+        }
+        return tiles;
+      }
+
+      //! dense features of the centers of the structures in tile
+      template <class Property_t>
+      static math::Matrix_t
+      pack_tile(const std::vector<std::shared_ptr<Property_t>> & props,
+                const Tile & tile, const typename Property_t::Keys_t & keys) {
+        const auto n_features{keys.size() *
+                              static_cast<size_t>(props[0]->get_nb_comp())};
+        math::Matrix_t features(tile.n_centers, n_features);
+        size_t i_row{0};
+        for (size_t i_structure{tile.first}; i_structure < tile.last;
+             ++i_structure) {
+          const auto & prop{*props[i_structure]};
+          prop.fill_dense_feature_matrix(
+              features.middleRows(i_row, prop.size()), keys);
+          i_row += prop.size();
+        }
+        return features;
+      }
+
+      /**
+       * Raise the center kernels of a pair of tiles to zeta and average them
+       * into the structure kernels. The (b, a) entries are set as well when
+       * symmetric.
+       */
+      template <class Property_t>
+      void reduce_tile(math::Matrix_t && atom_kernel,
+                       const std::vector<std::shared_ptr<Property_t>> & props_a,
+                       const Tile & tile_a,
+                       const std::vector<std::shared_ptr<Property_t>> & props_b,
+                       const Tile & tile_b, const bool symmetric,
+                       math::Matrix_t & kernel) const {
+        atom_kernel = pow_zeta(std::move(atom_kernel), this->zeta);
+        size_t i_row{0};
+        for (size_t ii_A{tile_a.first}; ii_A < tile_a.last; ++ii_A) {
+          const auto a_size{props_a[ii_A]->size()};
+          size_t i_col{0};
+          for (size_t ii_B{tile_b.first}; ii_B < tile_b.last; ++ii_B) {
+            const auto b_size{props_b[ii_B]->size()};
+            kernel(ii_A, ii_B) =
+                atom_kernel.block(i_row, i_col, a_size, b_size).mean();
+            if (symmetric) {
+              kernel(ii_B, ii_A) = kernel(ii_A, ii_B);
+            }
+            i_col += b_size;
+          }
+          i_row += a_size;
+        }
+      }
     };
   }  // namespace internal
 
@@ -337,11 +507,14 @@ namespace rascal {
      * structure managers
      * @param managers_b a ManagerCollection or similar collection of
      * structure managers
+     * @param n_threads number of threads used for the structure kernels, 0
+     * for as many as the hardware supports
      */
     template <class Calculator, class StructureManagers>
     math::Matrix_t compute(const Calculator & calculator,
                            const StructureManagers & managers_a,
-                           const StructureManagers & managers_b) {
+                           const StructureManagers & managers_b,
+                           const size_t n_threads = 1) {
       using ManagerPtr_t = typename StructureManagers::value_type;
       using Manager_t = typename ManagerPtr_t::element_type;
       using Property_t = typename Calculator::template Property_t<Manager_t>;
@@ -351,10 +524,10 @@ namespace rascal {
       switch (this->target_type) {
       case TargetType::Structure:
         return this->compute_helper<Property_t, TargetType::Structure>(
-            representation_name, managers_a, managers_b);
+            representation_name, managers_a, managers_b, n_threads);
       case TargetType::Atom:
         return this->compute_helper<Property_t, TargetType::Atom>(
-            representation_name, managers_a, managers_b);
+            representation_name, managers_a, managers_b, n_threads);
       default:
         throw std::logic_error(
             "Given target_type " +
@@ -368,13 +541,14 @@ namespace rascal {
               class StructureManagers>
     math::Matrix_t compute_helper(const std::string & representation_name,
                                   const StructureManagers & managers_a,
-                                  const StructureManagers & managers_b) {
+                                  const StructureManagers & managers_b,
+                                  const size_t n_threads) {
       using internal::KernelType;
 
       if (this->kernel_type == KernelType::Cosine) {
         auto kernel = downcast_kernel_impl<KernelType::Cosine>(kernel_impl);
         return kernel->template compute<Property_t, Type>(
-            managers_a, managers_b, representation_name);
+            managers_a, managers_b, representation_name, n_threads);
       } else {
         throw std::logic_error(
             "Given kernel_type " +
@@ -386,7 +560,8 @@ namespace rascal {
 
     template <class Calculator, class StructureManagers>
     math::Matrix_t compute(const Calculator & calculator,
-                           const StructureManagers & managers_a) {
+                           const StructureManagers & managers_a,
+                           const size_t n_threads = 1) {
       using ManagerPtr_t = typename StructureManagers::value_type;
       using Manager_t = typename ManagerPtr_t::element_type;
       using Property_t = typename Calculator::template Property_t<Manager_t>;
@@ -396,10 +571,10 @@ namespace rascal {
       switch (this->target_type) {
       case TargetType::Structure:
         return this->compute_helper<Property_t, TargetType::Structure>(
-            representation_name, managers_a);
+            representation_name, managers_a, n_threads);
       case TargetType::Atom:
         return this->compute_helper<Property_t, TargetType::Atom>(
-            representation_name, managers_a);
+            representation_name, managers_a, n_threads);
       default:
         throw std::logic_error(
             "Given target_type " +
@@ -412,13 +587,14 @@ namespace rascal {
     template <class Property_t, internal::TargetType Type,
               class StructureManagers>
     math::Matrix_t compute_helper(const std::string & representation_name,
-                                  const StructureManagers & managers_a) {
+                                  const StructureManagers & managers_a,
+                                  const size_t n_threads) {
       using internal::KernelType;
 
       if (this->kernel_type == KernelType::Cosine) {
         auto kernel = downcast_kernel_impl<KernelType::Cosine>(kernel_impl);
-        return kernel->template compute<Property_t, Type>(managers_a,
-                                                          representation_name);
+        return kernel->template compute<Property_t, Type>(
+            managers_a, representation_name, n_threads);
       } else {
         throw std::logic_error(
             "Given kernel_type " +
@@ -32,196 +32,174 @@
 #include "rascal/models/sparse_kernels.hh"
 #include "rascal/structure_managers/atomic_structure.hh"
 #include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/utils/parallel.hh"
 
-namespace rascal {
-
-  /*
-   * displacement of strain tensor in alpha beta spatial dimensions
-   * where alpha and beta can be one of the integers {0, 1, 2}
-   * corresponding to the spatial dimensions {x, y, z}
-   */
-  template <class KernelImpl, class Calculator, class Manager,
-            class SparsePoints>
-  math::Matrix_t compute_kernel_for_displaced_strain_tensor(
-      KernelImpl & kernel, Calculator & calculator, Manager & manager,
-      const SparsePoints & sparse_points, const int & alpha_spatial_dim,
-      const int & beta_spatial_dim, const double & h_disp) {
-    // get a copy of the atomic_structure object
-    auto manager_root = extract_underlying_manager<0>(manager);
-    json structure_copy = manager_root->get_atomic_structure();
-    auto atomic_structure =
-        structure_copy.template get<AtomicStructure<ThreeD>>();
-    atomic_structure.displace_strain_tensor(alpha_spatial_dim, beta_spatial_dim,
-                                            h_disp);
-    // make sure all atoms are in the unit cell
-    manager->update(atomic_structure);
-    calculator.compute(manager);
-    std::vector<std::remove_const_t<Manager>> managers{};
-    managers.emplace_back(manager);
-    math::Matrix_t KNM = kernel.compute(calculator, managers, sparse_points);
-    // reset neighborlist to the original structure
-    manager->update(structure_copy.template get<AtomicStructure<ThreeD>>());
-    return KNM;
-  }
-
-  /**
-   * Compute the sparse kernel associated to an atomic structure
-   * displacing atom `i_atom` by `disp`.
-   *
-   * @see compute_numerical_kernel_gradients
-   * @param i_atom index of the atom to displace
-   * @param disp 3D vector used to displace the position of i_atom
-   *
-   */
-  template <class KernelImpl, class Calculator, class Manager,
-            class SparsePoints, typename Derived>
-  math::Matrix_t compute_displaced_kernel(
-      KernelImpl & kernel, Calculator & calculator, Manager & manager,
-      const SparsePoints & sparse_points, const size_t & i_atom,
-      const Eigen::MatrixBase<Derived> & disp) {
-    // get a copy of the atomic_structure object
-    auto manager_root = extract_underlying_manager<0>(manager);
-    json structure_copy = manager_root->get_atomic_structure();
-    auto atomic_structure =
-        structure_copy.template get<AtomicStructure<ThreeD>>();
-    atomic_structure.displace_position(i_atom, disp);
-    // make sure all atoms are in the unit cell
-    atomic_structure.wrap();
-    manager->update(atomic_structure);
-    calculator.compute(manager);
-    std::vector<std::remove_const_t<Manager>> managers{};
-    managers.emplace_back(manager);
-    math::Matrix_t KNM = kernel.compute(calculator, managers, sparse_points);
-    // reset neighborlist to the original structure
-    manager->update(structure_copy.template get<AtomicStructure<ThreeD>>());
-    return KNM;
-  }
+#include <array>
+#include <memory>
+#include <vector>
 
-  /**
-   * Compute finite-difference gradient of the kernel of a sparse GPR model
-   * w.r.t. atomic positions for a single atomic structure.
-   *
-   * @param manager a structure manager
-   * @see compute_numerical_kernel_gradients
-   */
-  template <class KernelImpl, class Calculator, class Manager,
-            class SparsePoints>
-  math::Matrix_t compute_numerical_kernel_gradient(
-      KernelImpl & kernel, Calculator & calculator, Manager & manager,
-      const SparsePoints & sparse_points, const double & h_disp) {
-    Eigen::Matrix3d disps = h_disp * Eigen::Matrix3d::Identity();
-    size_t n_sparse_points{sparse_points.size()};
-    math::Matrix_t KNM{manager->size() * ThreeD, n_sparse_points};
-    KNM.setZero();
-    for (size_t i_atom{0}; i_atom < manager->size(); ++i_atom) {
-      for (int i_der{0}; i_der < ThreeD; ++i_der) {
-        // use centered finite difference to estimate gradient
-        math::Matrix_t KNM_p =
-            compute_displaced_kernel(kernel, calculator, manager, sparse_points,
-                                     i_atom, disps.row(i_der));
-        math::Matrix_t KNM_m =
-            compute_displaced_kernel(kernel, calculator, manager, sparse_points,
-                                     i_atom, -disps.row(i_der));
-        KNM.row(i_atom * ThreeD + i_der) =
-            (KNM_p - KNM_m).colwise().sum() / (2 * h_disp);
-      }
-    }
-    return KNM;
-  }
+namespace rascal {
 
-  /**
-   * Compute finite-difference kernel elements associated with
-   * the negative stress of a sparse GPR model for a single atomic structure.
-   *
-   * @param manager a structure manager
-   * @see compute_numerical_kernel_gradients
-   */
-  template <class KernelImpl, class Calculator, class Manager,
-            class SparsePoints>
-  math::Matrix_t compute_numerical_kernel_stress(
-      KernelImpl & kernel, Calculator & calculator, Manager & manager,
-      const SparsePoints & sparse_points, const double & h_disp) {
-    const std::array<std::array<int, 2>, 6> voigt_to_matrix_notation = {
+  namespace internal {
+    //! spatial dimensions of the strain tensor for each Voigt index
+    constexpr std::array<std::array<int, 2>, 6> VoigtToMatrixNotation{
         {{{0, 0}},    // xx NOLINT
          {{1, 1}},    // yy NOLINT
          {{2, 2}},    // zz NOLINT
          {{1, 2}},    // yz NOLINT
          {{0, 2}},    // xz NOLINT
          {{0, 1}}}};  // xy NOLINT
-    size_t n_sparse_points{sparse_points.size()};
-    math::Matrix_t KNM{6, n_sparse_points};
-    KNM.setZero();
-    math::Matrix_t positions(manager->size(), ThreeD);
-    size_t i_atom{0};
-    for (auto center : manager) {
-      positions.row(i_atom) = center.get_position();
-      i_atom++;
-    }
-    for (int i_der{0}; i_der < 6; ++i_der) {
-      // use centered finite difference to estimate gradient
-      const auto & matrix_idx = voigt_to_matrix_notation[i_der];
-      math::Matrix_t KNM_p = compute_kernel_for_displaced_strain_tensor(
-          kernel, calculator, manager, sparse_points, matrix_idx[0],
-          matrix_idx[1], h_disp);
-      math::Matrix_t KNM_m = compute_kernel_for_displaced_strain_tensor(
-          kernel, calculator, manager, sparse_points, matrix_idx[0],
-          matrix_idx[1], -h_disp);
-      KNM.row(i_der) = ((KNM_p - KNM_m) / (2 * h_disp)).colwise().sum();
+
+    /**
+     * Compute the kernel between the centers of manager and the pseudo
+     * points once the structure of manager has been set to structure and
+     * sum it over the centers.
+     */
+    template <class KernelImpl, class Calculator, class ManagerPtr,
+              class SparsePoints>
+    math::Matrix_t
+    compute_summed_kernel(KernelImpl & kernel, Calculator & calculator,
+                          ManagerPtr & manager,
+                          const SparsePoints & sparse_points,
+                          const AtomicStructure<ThreeD> & structure) {
+      manager->update(structure);
+      calculator.compute(manager);
+      std::vector<ManagerPtr> managers{manager};
+      return kernel.compute(calculator, managers, sparse_points)
+          .colwise()
+          .sum();
     }
 
-    auto manager_root = extract_underlying_manager<0>(manager);
-    json structure_copy = manager_root->get_atomic_structure();
-    auto atomic_structure =
-        structure_copy.template get<AtomicStructure<ThreeD>>();
-    KNM /= -atomic_structure.get_volume();
-    return KNM;
-  }
+    /**
+     * Centered finite difference of the kernel of the reference structure
+     * along one degree of freedom: the position of atom i_row / 3 along
+     * i_row % 3 if i_row < n_position_rows or the component
+     * i_row - n_position_rows of the strain tensor in Voigt order otherwise.
+     *
+     * The displaced structures are written into displaced, which keeps its
+     * memory when it has the shape of reference, and computed with manager.
+     */
+    template <class KernelImpl, class Calculator, class ManagerPtr,
+              class SparsePoints>
+    math::Matrix_t compute_kernel_finite_difference(
+        KernelImpl & kernel, Calculator & calculator, ManagerPtr & manager,
+        const SparsePoints & sparse_points,
+        const AtomicStructure<ThreeD> & reference,
+        AtomicStructure<ThreeD> & displaced, const size_t i_row,
+        const size_t n_position_rows, const double h_disp) {
+      math::Matrix_t KNM_p{};
+      math::Matrix_t KNM_m{};
+      for (const double sign : {1., -1.}) {
+        displaced = reference;
+        if (i_row < n_position_rows) {
+          displaced.displace_position(
+              i_row / ThreeD,
+              sign * h_disp * Eigen::Vector3d::Unit(i_row % ThreeD));
+          // make sure all atoms are in the unit cell
+          displaced.wrap();
+        } else {
+          const auto & matrix_idx{
+              VoigtToMatrixNotation[i_row - n_position_rows]};
+          displaced.displace_strain_tensor(matrix_idx[0], matrix_idx[1],
+                                           sign * h_disp);
+        }
+        (sign > 0. ? KNM_p : KNM_m) = compute_summed_kernel(
+            kernel, calculator, manager, sparse_points, displaced);
+      }
+      return (KNM_p - KNM_m) / (2 * h_disp);
+    }
+  }  // namespace internal
 
   /**
    * Compute finite-difference gradient of the kernel of a sparse GPR model
    * w.r.t. atomic positions for a collection of atomic structures
    * using centered finite differences.
    *
+   * The displaced structures are computed with copies of the stack of
+   * adaptors of managers (built with its adaptor parameters) and of
+   * calculator, one per thread, so the managers and the calculator given as
+   * input are left untouched. The atomic structures are copied once and
+   * displaced in place, and each gradient row, i.e. one atom and one
+   * direction or one component of the stress, is computed by one of the
+   * threads.
+   *
    * @param kernel a sparse kernel
    * @param calculator a representation of the atomic neighborhood
    * @param managers a collection of structure managers
    * @param sparse_points basis points used in the sparse GPR model
    * @param h_disp displacement used for the centered finite difference
-   *
+   * @param compute_stress append the 6 rows of the negative stress of each
+   *        structure
+   * @param n_threads number of threads used, 0 for as many as the hardware
+   *        supports
    */
   template <class KernelImpl, class Calculator, class Managers,
             class SparsePoints>
   math::Matrix_t compute_numerical_kernel_gradients(
-      KernelImpl & kernel, Calculator & calculator, Managers & managers,
+      KernelImpl & kernel, const Calculator & calculator, Managers & managers,
       const SparsePoints & sparse_points, double h_disp = 1e-5,
-      const bool compute_stress = false) {
-    size_t n_centers{0};
-    for (const auto & manager : managers) {
-      n_centers += manager->size() * ThreeD;
+      const bool compute_stress = false, const size_t n_threads = 1) {
+    using ManagerPtr_t = typename Managers::value_type;
+    using Hypers_t = typename Managers::Hypers_t;
+    using ManagerFactory_t =
+        make_structure_manager_stack_with_hypers_and_typeholder<
+            typename Managers::ManagerList_t>;
+
+    // reference structures and (structure, row in the structure) of each
+    // row of KNM
+    std::vector<AtomicStructure<ThreeD>> structures{};
+    std::vector<size_t> n_position_rows{};
+    std::vector<std::array<size_t, 2>> rows{};
+    for (auto manager : managers) {
+      auto manager_root = extract_underlying_manager<0>(manager);
+      structures.emplace_back(manager_root->get_atomic_structure());
+      n_position_rows.push_back(manager->size() * ThreeD);
+      for (size_t i_row{0}; i_row < n_position_rows.back(); ++i_row) {
+        rows.push_back({{structures.size() - 1, i_row}});
+      }
     }
     if (compute_stress) {
-      n_centers += 6 * managers.size();
+      for (size_t i_structure{0}; i_structure < structures.size();
+           ++i_structure) {
+        for (size_t i_voigt{0}; i_voigt < 6; ++i_voigt) {
+          rows.push_back(
+              {{i_structure, n_position_rows[i_structure] + i_voigt}});
+        }
+      }
     }
+
     size_t n_sparse_points{sparse_points.size()};
-    math::Matrix_t KNM{n_centers, n_sparse_points};
+    math::Matrix_t KNM{rows.size(), n_sparse_points};
     KNM.setZero();
-    size_t i_centers{0};
-    for (const auto & manager : managers) {
-      KNM.block(i_centers, 0, manager->size() * ThreeD, n_sparse_points) =
-          compute_numerical_kernel_gradient(kernel, calculator, manager,
-                                            sparse_points, h_disp);
-      i_centers += manager->size() * ThreeD;
-    }
 
-    if (compute_stress) {
-      for (const auto & manager : managers) {
-        KNM.block(i_centers, 0, 6, n_sparse_points) =
-            compute_numerical_kernel_stress(kernel, calculator, manager,
-                                            sparse_points, h_disp);
-        i_centers += 6;
+    // one contiguous chunk of rows and one set of copies per thread
+    const size_t n_chunks_max{internal::get_nb_threads(n_threads)};
+    std::vector<ManagerPtr_t> managers_copy(n_chunks_max);
+    std::vector<std::unique_ptr<Calculator>> calculators_copy(n_chunks_max);
+    std::vector<AtomicStructure<ThreeD>> displaced(n_chunks_max);
+    const Hypers_t & adaptor_parameters{managers.get_adaptors_parameters()};
+    internal::parallel_for_chunks(
+        rows.size(), n_threads, [&](size_t index, size_t i_chunk) {
+          auto & manager = managers_copy[i_chunk];
+          auto & calculator_copy = calculators_copy[i_chunk];
+          if (manager == nullptr) {
+            manager = ManagerFactory_t::apply(Hypers_t::object(),
+                                              adaptor_parameters);
+            calculator_copy = std::make_unique<Calculator>(calculator.hypers);
+          }
+          const auto & row{rows[index]};
+          KNM.row(index) = internal::compute_kernel_finite_difference(
+              kernel, *calculator_copy, manager, sparse_points,
+              structures[row[0]], displaced[i_chunk], row[1],
+              n_position_rows[row[0]], h_disp);
+        });
+
+    for (size_t index{0}; index < rows.size(); ++index) {
+      const auto & row{rows[index]};
+      if (row[1] >= n_position_rows[row[0]]) {
+        KNM.row(index) /= -structures[row[0]].get_volume();
       }
     }
-
     return KNM;
   }
 }  // namespace rascal
@@ -0,0 +1,397 @@
+/**
+ * @file   rascal/models/potential.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Fused evaluation of the energy, forces and stress of a GAP model
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_MODELS_POTENTIAL_HH_
+#define SRC_RASCAL_MODELS_POTENTIAL_HH_
+
+#include "rascal/math/utils.hh"
+#include "rascal/models/sparse_kernels.hh"
+#include "rascal/models/sparse_points.hh"
+#include "rascal/structure_managers/atomic_structure.hh"
+#include "rascal/structure_managers/structure_manager_collection.hh"
+#include "rascal/utils/json_io.hh"
+
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace rascal {
+
+  /**
+   * Interatomic potential made of a trained SOAP-GAP model (see
+   * @ref SparseKernelImpl<internal::SparseKernelType::GAP>::compute_derivative)
+   * meant to be called at every step of a molecular dynamics run.
+   *
+   * The energy, the forces and the stress of the structure are computed in a
+   * single pass over the centers: the kernel with the sparse points, its
+   * derivative w.r.t. the representation and the contraction with the
+   * gradients of the representation are done in place, so nothing is
+   * registered in the structure managers except the representation. The
+   * structure manager stack and the scratch arrays persist between the
+   * calls so the atoms are expected to keep their identity and order.
+   *
+   * It is built from a json object with the fields:
+   *   - representation: parameters of the Calculator
+   *   - kernel: parameters of the SparseKernel
+   *   - sparse_points: serialized SparsePointsBlockSparse
+   *   - weights: weights of the model
+   *   - self_contributions: baseline energy of each atomic species
+   *   - adaptors: parameters of the adaptors of the structure managers
+   *   - precontract (optional): see below
+   *
+   * For \f$\zeta=1\f$ and \f$\zeta=2\f$ the weights can be contracted with
+   * the sparse points of each species once and for all,
+   *
+   * @f[
+   *      E_i = X_i \cdot (T^T w) \quad \text{or} \quad
+   *      E_i = X_i^T (T^T \mathrm{diag}(w) T) X_i,
+   * @f]
+   *
+   * so that the cost of a center does not depend on the number of sparse
+   * points. By default it is done for \f$\zeta=1\f$, and for \f$\zeta=2\f$
+   * when the contracted matrix is cheaper to apply than the sparse points,
+   * i.e. when there are more than half as many sparse points as features.
+   * precontract set to true or false forces the choice.
+   */
+  template <class Calculator, class ManagerCollection>
+  class Potential {
+   public:
+    using Hypers_t = json;
+    using Manager_t = typename ManagerCollection::Manager_t;
+    using Property_t = typename Calculator::template Property_t<Manager_t>;
+    using PropertyGradient_t =
+        typename Calculator::template PropertyGradient_t<Manager_t>;
+    using SparsePoints_t = SparsePointsBlockSparse<Calculator>;
+    using Key_t = typename SparsePoints_t::Key_t;
+    using Positions_t = Eigen::Ref<const Eigen::MatrixXd>;
+    using AtomTypes_t = Eigen::Ref<const Eigen::VectorXi>;
+    using Cell_t = Eigen::Ref<const Eigen::MatrixXd>;
+    using PBC_t = Eigen::Ref<const Eigen::VectorXi>;
+
+    explicit Potential(const Hypers_t & hypers)
+        : managers{hypers.at("adaptors")},
+          calculator{Potential::get_calculator_hypers(hypers)},
+          sparse_points{hypers.at("sparse_points").get<SparsePoints_t>()} {
+      this->parameters = hypers;
+      const auto & kernel_hypers{hypers.at("kernel")};
+      if (kernel_hypers.at("name").get<std::string>() != "GAP") {
+        throw std::runtime_error("Only the GAP kernel is supported.");
+      }
+      this->zeta = kernel_hypers.at("zeta").get<size_t>();
+
+      const auto weights{hypers.at("weights").get<std::vector<double>>()};
+      if (weights.size() != this->sparse_points.size()) {
+        std::stringstream err_str{};
+        err_str << "The number of weights '" << weights.size()
+                << "' does not match the number of sparse points '"
+                << this->sparse_points.size() << "'.";
+        throw std::runtime_error(err_str.str());
+      }
+      for (const auto & item : hypers.at("self_contributions").items()) {
+        this->self_contributions[std::stoi(item.key())] =
+            item.value().get<double>();
+      }
+
+      // dense pseudo points and weights of each species
+      const auto offsets{this->sparse_points.get_offsets()};
+      Eigen::Index max_points{0}, max_features{0};
+      for (const int & sp : this->sparse_points.species()) {
+        auto & block{this->blocks[sp]};
+        block.T = this->sparse_points.get_features_by_species(sp);
+        block.keys.assign(this->sparse_points.keys_sp.at(sp).begin(),
+                          this->sparse_points.keys_sp.at(sp).end());
+        block.weights = Eigen::Map<const math::Vector_t>(
+            weights.data() + offsets.at(sp), block.T.rows());
+        block.is_contracted = this->is_contracted(block, hypers);
+        if (block.is_contracted and this->zeta == 1) {
+          // T^T w
+          block.contracted_weights = block.weights * block.T;
+        } else if (block.is_contracted) {
+          // T^T diag(w) T
+          block.contracted_weights = block.T.transpose() *
+                                     block.weights.asDiagonal() * block.T;
+        }
+        max_points = std::max(max_points, block.T.rows());
+        max_features = std::max(max_features, block.T.cols());
+      }
+      this->kernel_row.resize(max_points);
+      this->kernel_row_gradient.resize(max_points);
+      this->features.resize(max_features);
+      this->features_gradient.resize(max_features);
+    }
+
+    //! Copy constructor
+    Potential(const Potential & other) = delete;
+
+    //! Move constructor
+    Potential(Potential && other) = default;
+
+    //! Destructor
+    ~Potential() = default;
+
+    //! Copy assignment operator
+    Potential & operator=(const Potential & other) = delete;
+
+    //! Move assignment operator
+    Potential & operator=(Potential && other) = delete;
+
+    /**
+     * Compute the energy, forces and stress of the structure.
+     *
+     * @param positions 3xN atomic positions
+     * @param atom_types atomic numbers, they should not change during a run
+     * @param cell 3x3 matrix with the cell vectors as columns, it can be
+     *        filled with zeros if the structure is not periodic
+     * @param pbc periodic boundary conditions along the cell vectors
+     */
+    void compute(const Positions_t & positions, const AtomTypes_t & atom_types,
+                 const Cell_t & cell, const PBC_t & pbc) {
+      if ((pbc.array() == 0).all() and (cell.array().abs() < 1e-10).all()) {
+        // like sanitize_non_periodic_structure on the python side, use a
+        // cell that contains all the atoms
+        const Eigen::Vector3d lengths{
+            (1.05 * (positions.rowwise().maxCoeff() -
+                     positions.rowwise().minCoeff()))
+                .cwiseMax(1.)};
+        this->structure.set_structure(positions, atom_types,
+                                      Eigen::Matrix3d{lengths.asDiagonal()},
+                                      pbc);
+        const Eigen::Vector3d shift{0.5 * lengths -
+                                    positions.rowwise().mean()};
+        this->structure.positions.colwise() += shift;
+      } else {
+        this->structure.set_structure(positions, atom_types, cell, pbc);
+        this->structure.wrap();
+      }
+      if (this->managers.size() == 0) {
+        json structure_json = this->structure;
+        this->managers.add_structure(structure_json);
+      } else {
+        this->managers[0]->update(
+            this->structure.positions, this->structure.atom_types,
+            this->structure.cell, this->structure.pbc);
+      }
+      this->calculator.compute(this->managers);
+      this->compute_impl(this->managers[0]);
+    }
+
+    //! energy of the last structure given to compute
+    double get_energy() const { return this->energy; }
+
+    //! Nx3 forces of the last structure given to compute
+    const math::Matrix_t & get_forces() const { return this->forces; }
+
+    /**
+     * 3x3 stress of the last structure given to compute, i.e. the gradient
+     * of the energy w.r.t. the strain divided by the volume, like
+     * KRR.predict_stress.
+     */
+    const Eigen::Matrix3d & get_stress() const { return this->stress; }
+
+    //! parameters used to build the potential
+    Hypers_t parameters{};
+
+   protected:
+    //! pseudo points of one species as a dense matrix
+    struct SpeciesBlock {
+      math::Matrix_t T{};
+      math::Vector_t weights{};
+      std::vector<Key_t> keys{};
+      //! use contracted_weights instead of T and weights
+      bool is_contracted{false};
+      //! 1xD T^T w for zeta == 1 and DxD T^T diag(w) T for zeta == 2
+      math::Matrix_t contracted_weights{};
+    };
+
+    bool is_contracted(const SpeciesBlock & block,
+                       const Hypers_t & hypers) const {
+      if (this->zeta > 2) {
+        return false;
+      }
+      if (hypers.count("precontract") == 1) {
+        return hypers.at("precontract").get<bool>();
+      }
+      return this->zeta == 1 or block.T.cols() < 2 * block.T.rows();
+    }
+
+    static Hypers_t get_calculator_hypers(const Hypers_t & hypers) {
+      Hypers_t calculator_hypers = hypers.at("representation");
+      calculator_hypers["compute_gradients"] = true;
+      return calculator_hypers;
+    }
+
+    void compute_impl(std::shared_ptr<Manager_t> manager) {
+      auto && prop{*manager->template get_property<Property_t>(
+          this->calculator.get_name(), true)};
+      auto && prop_grad{*manager->template get_property<PropertyGradient_t>(
+          this->calculator.get_gradient_name(), true)};
+      const auto inner_size{static_cast<Eigen::Index>(prop.get_nb_comp())};
+      const bool do_block_by_key_dot{prop_grad.are_keys_uniform()};
+
+      const auto n_atoms{this->structure.positions.cols()};
+      this->energy = 0.;
+      this->forces.resize(n_atoms, ThreeD);
+      this->forces.setZero();
+      // \sum_{ij} r_{ji} \otimes dE/dr_j
+      Eigen::Matrix3d virial{Eigen::Matrix3d::Zero()};
+
+      Eigen::Index i_row{0};
+      for (auto center : manager) {
+        const int a_sp{center.get_atom_type()};
+        const auto n_neigh{
+            static_cast<Eigen::Index>(center.pairs_with_self_pair().size())};
+        this->energy += this->self_contributions[a_sp];
+        if (this->blocks.count(a_sp) == 0) {
+          i_row += n_neigh;
+          continue;
+        }
+        const auto & block{this->blocks.at(a_sp)};
+        const auto n_points{block.T.rows()};
+        const auto n_features{block.T.cols()};
+
+        // dense representation restricted to the keys of the pseudo points
+        auto && rep{prop[center]};
+        auto x{this->features.head(n_features)};
+        for (size_t i_key{0}; i_key < block.keys.size(); ++i_key) {
+          const auto & key{block.keys[i_key]};
+          if (rep.count(key)) {
+            x.segment(i_key * inner_size, inner_size) = rep.flat(key);
+          } else {
+            x.segment(i_key * inner_size, inner_size).setZero();
+          }
+        }
+        auto dEdX{this->features_gradient.head(n_features)};
+        if (block.is_contracted and this->zeta == 1) {
+          // E_i = X_i \cdot (T^T w)
+          dEdX = block.contracted_weights;
+          this->energy += x.dot(dEdX);
+        } else if (block.is_contracted) {
+          // E_i = X_i^T (T^T diag(w) T) X_i, the matrix is symmetric
+          dEdX.noalias() = x * block.contracted_weights;
+          this->energy += x.dot(dEdX);
+          dEdX *= 2.;
+        } else {
+          // k_m = (X_i \cdot T_m), E_i = \sum_m w_m k_m^\zeta and
+          // dE_i/dk_m = \zeta w_m k_m^{\zeta-1}
+          auto k{this->kernel_row.head(n_points)};
+          auto dEdk{this->kernel_row_gradient.head(n_points)};
+          k.noalias() = x * block.T.transpose();
+          for (Eigen::Index i_point{0}; i_point < n_points; ++i_point) {
+            const double k_pow{math::pow(k(i_point), this->zeta - 1)};
+            this->energy += block.weights(i_point) * k_pow * k(i_point);
+            dEdk(i_point) = this->zeta * block.weights(i_point) * k_pow;
+          }
+          // dE_i/dX_i = \sum_m dE_i/dk_m T_m
+          dEdX.noalias() = dEdk * block.T;
+        }
+
+        // dE_i/dr_j = dX_i/dr_j \cdot dE_i/dX_i
+        if (this->pair_gradients.rows() < n_neigh) {
+          this->pair_gradients.resize(n_neigh, ThreeD);
+        }
+        auto dEdr{this->pair_gradients.topRows(n_neigh)};
+        dEdr.setZero();
+        if (do_block_by_key_dot) {
+          auto rep_grads = prop_grad.get_raw_data_view();
+          for (size_t i_key{0}; i_key < block.keys.size(); ++i_key) {
+            const auto & key{block.keys[i_key]};
+            if (not prop_grad.get_keys().count(key)) {
+              continue;
+            }
+            const int col_st{prop_grad.get_gradient_col_by_key(key)};
+            for (int i_der{0}; i_der < ThreeD; i_der++) {
+              dEdr.col(i_der) +=
+                  rep_grads.block(i_row, col_st + i_der * inner_size,
+                                  n_neigh, inner_size) *
+                  dEdX.segment(i_key * inner_size, inner_size).transpose();
+            }
+          }
+        } else {
+          Eigen::Index i_neigh{0};
+          for (auto neigh : center.pairs_with_self_pair()) {
+            auto && rep_grad{prop_grad[neigh]};
+            for (size_t i_key{0}; i_key < block.keys.size(); ++i_key) {
+              const auto & key{block.keys[i_key]};
+              if (not rep_grad.count(key)) {
+                continue;
+              }
+              // the gradient directions are the outermost index
+              auto rep_grad_flat_by_key{rep_grad.flat(key)};
+              Eigen::Map<const Eigen::Matrix<double, ThreeD, Eigen::Dynamic,
+                                             Eigen::RowMajor>>
+                  rep_grad_by_key(rep_grad_flat_by_key.data(), ThreeD,
+                                  inner_size);
+              dEdr.row(i_neigh) +=
+                  (rep_grad_by_key *
+                   dEdX.segment(i_key * inner_size, inner_size).transpose())
+                      .transpose();
+            }
+            ++i_neigh;
+          }
+        }
+
+        const Eigen::Vector3d r_i = center.get_position();
+        Eigen::Index i_neigh{0};
+        for (auto neigh : center.pairs_with_self_pair()) {
+          const auto i_atom{neigh.get_atom_j().get_atom_tag()};
+          const Eigen::Vector3d dEdr_j{dEdr.row(i_neigh).transpose()};
+          this->forces.row(i_atom) -= dEdr_j.transpose();
+          const Eigen::Vector3d r_ji = r_i - neigh.get_position();
+          virial.noalias() += r_ji * dEdr_j.transpose();
+          ++i_neigh;
+        }
+        i_row += n_neigh;
+      }  // center
+
+      // the model is rotationally invariant so the virial is symmetric up to
+      // numerical noise
+      this->stress =
+          -0.5 * (virial + virial.transpose()) / this->structure.get_volume();
+    }
+
+    ManagerCollection managers;
+    Calculator calculator;
+    SparsePoints_t sparse_points;
+    size_t zeta{0};
+    std::map<int, double> self_contributions{};
+    std::map<int, SpeciesBlock> blocks{};
+    //! last structure given to compute
+    AtomicStructure<ThreeD> structure{};
+    double energy{0.};
+    math::Matrix_t forces{};
+    Eigen::Matrix3d stress{Eigen::Matrix3d::Zero()};
+
+    //! scratch arrays reused between the centers and the calls
+    math::Vector_t features{};
+    math::Vector_t features_gradient{};
+    math::Vector_t kernel_row{};
+    math::Vector_t kernel_row_gradient{};
+    Eigen::Matrix<double, Eigen::Dynamic, ThreeD> pair_gradients{};
+  };
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_MODELS_POTENTIAL_HH_
@@ -0,0 +1,172 @@
+/**
+ * @file   rascal/models/sparse_gpr_accumulator.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Streaming accumulation of the normal equations of the sparse GPR
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_MODELS_SPARSE_GPR_ACCUMULATOR_HH_
+#define SRC_RASCAL_MODELS_SPARSE_GPR_ACCUMULATOR_HH_
+
+#include "rascal/math/utils.hh"
+#include "rascal/models/sparse_kernels.hh"
+
+#include <sstream>
+#include <string>
+
+namespace rascal {
+
+  /**
+   * Accumulates the normal equations of the sparse GPR (GAP) problem
+   *
+   * @f[
+   *      K_{MN} \Lambda^{-2} K_{NM} \quad \text{and} \quad
+   *      K_{MN} \Lambda^{-2} Y,
+   * @f]
+   *
+   * one chunk of structures at a time. The rows of \f$K_{NM}\f$ associated
+   * with a chunk are folded in and discarded right away so only
+   * \f$O(M^2)\f$ storage is needed whatever the size of the training set.
+   *
+   * \f$\Lambda^{-1}\f$ is diagonal and its entries are given as weights for
+   * each row, e.g. \f$\sigma_y / (\lambda_E \sqrt{N_{atoms}})\f$ for the
+   * total energies and \f$\sigma_y / \lambda_F\f$ for the gradients with the
+   * conventions of train_gap_model.
+   */
+  class SparseGPRAccumulator {
+   public:
+    /**
+     * @param nb_sparse_points number of sparse points M
+     * @param nb_targets number of columns of the targets Y
+     */
+    explicit SparseGPRAccumulator(const size_t nb_sparse_points,
+                                  const size_t nb_targets = 1)
+        : KtK{math::Matrix_t::Zero(nb_sparse_points, nb_sparse_points)},
+          KtY{math::Matrix_t::Zero(nb_sparse_points, nb_targets)} {}
+
+    //! forget what has been accumulated so far
+    void reset() {
+      this->KtK.setZero();
+      this->KtY.setZero();
+      this->nb_rows = 0;
+    }
+
+    /**
+     * Fold a block of rows of K_NM, the associated targets Y and the
+     * diagonal of \f$\Lambda^{-1}\f$ for these rows.
+     */
+    void accumulate(const math::Matrix_Ref & KNM, const math::Matrix_Ref & Y,
+                    const math::Vector_Ref & weights) {
+      this->fold(math::Matrix_t{KNM}, Y, weights);
+    }
+
+    /**
+     * Compute the rows of K_NM associated with the properties of the
+     * structures in managers, e.g. total energies, and fold them in. kernel
+     * has to use target_type == "Structure".
+     *
+     * @param Y properties with one row per structure
+     * @param weights diagonal of \f$\Lambda^{-1}\f$ for each structure
+     */
+    template <class Calculator, class StructureManagers, class SparsePoints>
+    void accumulate_properties(SparseKernel & kernel,
+                               const Calculator & calculator,
+                               const StructureManagers & managers,
+                               const SparsePoints & sparse_points,
+                               const math::Matrix_Ref & Y,
+                               const math::Vector_Ref & weights) {
+      if (kernel.target_type != internal::TargetType::Structure) {
+        throw std::runtime_error(
+            "The properties can only be accumulated with a kernel with "
+            "target_type == 'Structure'.");
+      }
+      this->fold(kernel.compute(calculator, managers, sparse_points), Y,
+                 weights);
+    }
+
+    /**
+     * Compute the rows of K_NM associated with the gradients of the
+     * properties w.r.t. the atomic positions of the structures in managers,
+     * e.g. minus the forces, and fold them in.
+     *
+     * @param Y gradients with 3 rows per atom, ordered like in
+     *          SparseKernel::compute_derivative
+     * @param weights diagonal of \f$\Lambda^{-1}\f$ for each gradient row
+     * @param n_threads number of threads used to compute the rows, 0 for as
+     *        many as the hardware supports
+     */
+    template <class Calculator, class StructureManagers, class SparsePoints>
+    void accumulate_gradients(SparseKernel & kernel,
+                              const Calculator & calculator,
+                              const StructureManagers & managers,
+                              const SparsePoints & sparse_points,
+                              const math::Matrix_Ref & Y,
+                              const math::Vector_Ref & weights,
+                              const size_t n_threads = 1) {
+      this->fold(kernel.compute_derivative(calculator, managers, sparse_points,
+                                           false, n_threads),
+                 Y, weights);
+    }
+
+    //! \f$K_{MN} \Lambda^{-2} K_{NM}\f$
+    math::Matrix_t get_KtK() const {
+      // only the upper triangle is updated
+      return this->KtK.selfadjointView<Eigen::Upper>();
+    }
+
+    //! \f$K_{MN} \Lambda^{-2} Y\f$
+    const math::Matrix_t & get_KtY() const { return this->KtY; }
+
+    //! number of rows of K_NM accumulated so far
+    size_t get_nb_rows() const { return this->nb_rows; }
+
+   protected:
+    void fold(math::Matrix_t && KNM, const math::Matrix_Ref & Y,
+              const math::Vector_Ref & weights) {
+      if (KNM.cols() != this->KtK.cols() or KNM.rows() != Y.rows() or
+          KNM.rows() != weights.size() or Y.cols() != this->KtY.cols()) {
+        std::stringstream err_str{};
+        err_str << "Shape mismatch: K_NM is (" << KNM.rows() << ", "
+                << KNM.cols() << "), Y is (" << Y.rows() << ", " << Y.cols()
+                << ") and there are " << weights.size()
+                << " weights while the accumulator expects "
+                << this->KtK.cols() << " sparse points and "
+                << this->KtY.cols() << " targets.";
+        throw std::runtime_error(err_str.str());
+      }
+      // \Lambda^{-1} K_NM in place
+      KNM = weights.asDiagonal() * KNM;
+      this->KtK.selfadjointView<Eigen::Upper>().rankUpdate(KNM.transpose());
+      this->KtY.noalias() += KNM.transpose() * (weights.asDiagonal() * Y);
+      this->nb_rows += KNM.rows();
+    }
+
+    //! upper triangle of K_MN \Lambda^{-2} K_NM
+    math::Matrix_t KtK;
+    //! K_MN \Lambda^{-2} Y
+    math::Matrix_t KtY;
+    size_t nb_rows{0};
+  };
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_MODELS_SPARSE_GPR_ACCUMULATOR_HH_
@@ -128,6 +128,13 @@ namespace rascal {
     size_t i_row{0};
     for (auto center : manager) {
       const int a_sp{center.get_atom_type()};
+      const size_t n_neigh{center.pairs_with_self_pair().size()};
+      if (species_intersect.count(a_sp) == 0) {
+        // no pseudo points for this central species so its pair gradients
+        // stay zero
+        i_row += n_neigh;
+        continue;
+      }
       // compute contraction of the model weights with the gradient of the
       // kernel with respect to the representation in 2 steps
       // 1. \alpha_n^{scaled} = \alpha_n * [z* (X_j \dot T_n)^{z-1}]
@@ -138,19 +145,19 @@ namespace rascal {
                .transpose()
                .array())
               .matrix();
-      // 2. \sum_n \alpha_n^{scaled} T_n
-      SparsePoints sparse_point_scaled{sparse_points.dot(a_sp, weights_scaled)};
-      const size_t n_neigh{center.pairs_with_self_pair().size()};
       // contract weights&kernel_grad with the gradient of the representation
       // w.r.t. atoms positions, namely sparse_point_scaled \dot dX_i/dr_j
       if (do_block_by_key_dot) {
         auto rep_grads = prop_grad.get_raw_data_view();
-        const auto & values_by_sp = sparse_point_scaled.values.at(a_sp);
+        // 2. \sum_n \alpha_n^{scaled} T_n
+        const auto T_sp{sparse_points.get_features_view(a_sp)};
+        const auto offset{sparse_points.get_offset(a_sp)};
+        const math::Vector_t sparse_point_scaled{
+            weights_scaled.segment(offset, T_sp.rows()) * T_sp};
 
         for (const Key_t & key : keys_intersect.at(a_sp)) {
-          const auto & values_by_sp_key = values_by_sp.at(key);
-          auto spts = Eigen::Map<const math::Vector_t>(
-              values_by_sp_key.data(), static_cast<Eigen::Index>(inner_size));
+          auto spts = sparse_point_scaled.segment(
+              sparse_points.get_key_column(a_sp, key), inner_size);
 
           math::Vector_t fij_block(n_neigh);
 
@@ -170,6 +177,9 @@ namespace rascal {
         }      // key
         i_row += n_neigh;
       } else {
+        // 2. \sum_n \alpha_n^{scaled} T_n
+        SparsePoints sparse_point_scaled{
+            sparse_points.dot(a_sp, weights_scaled)};
         for (auto neigh : center.pairs_with_self_pair()) {
           pair_grad_atom_i_r_j[neigh] =
               sparse_point_scaled.dot_derivative(a_sp, prop_grad[neigh]);
@@ -31,6 +31,11 @@
 #include "rascal/models/kernels.hh"
 #include "rascal/structure_managers/structure_manager_collection.hh"
 #include "rascal/utils/json_io.hh"
+#include "rascal/utils/parallel.hh"
+
+#include <array>
+#include <sstream>
+#include <vector>
 
 namespace rascal {
 
@@ -109,19 +114,9 @@ namespace rascal {
                              const std::string & representation_name) {
         math::Matrix_t KNM(managers.size(), sparse_points.size());
         KNM.setZero();
-        size_t ii_A{0};
-        for (auto & manager : managers) {
-          auto && propA{*manager->template get_property<Property_t>(
-              representation_name, true)};
-          for (auto center : manager) {
-            int sp = center.get_atom_type();
-            // only the pseudo points of species sp contribute
-            KNM.row(ii_A) +=
-                pow_zeta(sparse_points.dot(sp, propA[center]), this->zeta)
-                    .transpose();
-          }
-          ++ii_A;
-        }
+        constexpr bool IsStructureWise{true};
+        this->compute_by_species_blocks<Property_t, IsStructureWise>(
+            KNM, managers, sparse_points, representation_name);
         return KNM;
       }
 
@@ -173,21 +168,105 @@ namespace rascal {
         }
         size_t nb_sparse_points{sparse_points.size()};
         math::Matrix_t KNM(n_centersA, nb_sparse_points);
-        size_t ii_A{0};
-        for (auto & manager : managers) {
-          auto && propA{*manager->template get_property<Property_t>(
-              representation_name, true)};
-          for (auto center : manager) {
-            int sp = center.get_atom_type();
-            KNM.row(ii_A) =
-                pow_zeta(sparse_points.dot(sp, propA[center]), this->zeta)
-                    .transpose();
-            ii_A++;
-          }
-        }
+        KNM.setZero();
+        constexpr bool IsStructureWise{false};
+        this->compute_by_species_blocks<Property_t, IsStructureWise>(
+            KNM, managers, sparse_points, representation_name);
         return KNM;
       }
 
+      /**
+       * Maximum number of elements of the blocks of packed features used in
+       * compute_by_species_blocks, i.e. 8MB of doubles.
+       */
+      constexpr static size_t MaxBlockSize{1 << 20};
+
+      /**
+       * Accumulate the kernel between the centers of managers and the pseudo
+       * points into KNM.
+       *
+       * For each central atom type sp, the features of the centers of type sp
+       * are packed into a dense block (restricted to the keys of the pseudo
+       * points of type sp) that is multiplied with the packed pseudo points
+       * with one matrix-matrix product. The zeta power is applied to the block
+       * and its rows are then added to the rows of KNM, i.e. summed per
+       * structure if IsStructureWise or one row per center otherwise.
+       */
+      template <class Property_t, bool IsStructureWise,
+                class StructureManagers, class SparsePoints>
+      void compute_by_species_blocks(math::Matrix_t & KNM,
+                                     const StructureManagers & managers,
+                                     const SparsePoints & sparse_points,
+                                     const std::string & representation_name) {
+        const auto offsets{sparse_points.get_offsets()};
+        const auto inner_size{
+            static_cast<Eigen::Index>(sparse_points.inner_size)};
+        for (const int & sp : sparse_points.species()) {
+          const auto & keys_sp{sparse_points.keys_sp.at(sp)};
+          const auto T_sp{sparse_points.get_features_view(sp)};
+          const Eigen::Index n_points{T_sp.rows()};
+          const Eigen::Index n_features{T_sp.cols()};
+          if (n_points == 0 or n_features == 0) {
+            continue;
+          }
+          const Eigen::Index block_size{std::max(
+              static_cast<Eigen::Index>(MaxBlockSize) / n_features,
+              Eigen::Index{1})};
+          const Eigen::Index offset{offsets.at(sp)};
+
+          math::Matrix_t X_block(block_size, n_features);
+          // row of KNM associated with each row of X_block
+          std::vector<Eigen::Index> knm_rows{};
+          knm_rows.reserve(block_size);
+          auto flush = [&]() {
+            const auto n_rows{static_cast<Eigen::Index>(knm_rows.size())};
+            math::Matrix_t KNM_block{pow_zeta(
+                X_block.topRows(n_rows) * T_sp.transpose(), this->zeta)};
+            for (Eigen::Index i_row{0}; i_row < n_rows; ++i_row) {
+              KNM.block(knm_rows[i_row], offset, 1, n_points) +=
+                  KNM_block.row(i_row);
+            }
+            knm_rows.clear();
+          };
+
+          Eigen::Index ii_A{0};
+          for (auto & manager : managers) {
+            auto && propA{*manager->template get_property<Property_t>(
+                representation_name, true)};
+            for (auto center : manager) {
+              if (center.get_atom_type() == sp) {
+                auto && rep{propA[center]};
+                auto && x_row{X_block.row(knm_rows.size())};
+                Eigen::Index i_col{0};
+                // only the keys of the pseudo points of type sp contribute
+                for (const auto & key : keys_sp) {
+                  if (rep.count(key)) {
+                    x_row.segment(i_col, inner_size) = rep.flat(key);
+                  } else {
+                    x_row.segment(i_col, inner_size).setZero();
+                  }
+                  i_col += inner_size;
+                }
+                knm_rows.push_back(ii_A);
+                if (static_cast<Eigen::Index>(knm_rows.size()) ==
+                    block_size) {
+                  flush();
+                }
+              }
+              if (not IsStructureWise) {
+                ++ii_A;
+              }
+            }
+            if (IsStructureWise) {
+              ++ii_A;
+            }
+          }
+          if (knm_rows.size() > 0) {
+            flush();
+          }
+        }  // sp
+      }
+
       /**
        * This documentation contains specific information for the GAP
        * implementation See
@@ -252,6 +331,8 @@ namespace rascal {
        *        gradient data has been registered in the elements of managers
        * @param compute_neg_stress the computed negative stresses are appended
        *        at the end of the kernel matrix
+       * @param n_threads number of threads used to fill the rows of the
+       *        structures, 0 for as many as the hardware supports
        * @return kernel matrix
        */
       template <class Property_t, class PropertyGradient_t,
@@ -263,24 +344,116 @@ namespace rascal {
                          SparsePoints & sparse_points,
                          const std::string & representation_name,
                          const std::string & representation_grad_name,
-                         const bool compute_neg_stress) {
-        using Manager_t = typename StructureManagers::Manager_t;
-        using Keys_t = typename SparsePoints::Keys_t;
-        using Key_t = typename SparsePoints::Key_t;
+                         const bool compute_neg_stress,
+                         const size_t n_threads = 1) {
+        math::Matrix_t KNM_der(
+            get_derivative_nb_rows(managers, compute_neg_stress),
+            sparse_points.size());
+        this->template fill_derivative<Property_t, PropertyGradient_t, Type>(
+            managers, sparse_points, representation_name,
+            representation_grad_name, compute_neg_stress, KNM_der, n_threads);
+        return KNM_der;
+      }
+
+      /**
+       * Number of rows of the kernel derivative of managers, see
+       * compute_derivative.
+       */
+      template <class StructureManagers>
+      static size_t get_derivative_nb_rows(const StructureManagers & managers,
+                                           const bool compute_neg_stress) {
         // the nb of rows of the kernel matrix consist of:
         // - 3*nb_centers rows for each center for each spatial_dim
         // - 6 rows at the end for the stress tensor in voigt notation if
         //   `compute_neg_stress` is true
         size_t nb_kernel_gradient_rows{0};
-        // find the total number of rows the matrix block should have
         for (const auto & manager : managers) {
           nb_kernel_gradient_rows += manager->size() * SpatialDims;
         }
-        // the stress terms are stored at the bottom of the KNM in a block
-        size_t row_idx_stress{nb_kernel_gradient_rows};
         if (compute_neg_stress) {
           nb_kernel_gradient_rows += 2 * SpatialDims * managers.size();
         }
+        return nb_kernel_gradient_rows;
+      }
+
+      /**
+       * Fill KNM_der with the kernel derivative, see compute_derivative. The
+       * row range of each structure is known in advance so the structures
+       * are handled in parallel with n_threads threads (0 for as many as the
+       * hardware supports).
+       *
+       * @param KNM_der buffer of shape (get_derivative_nb_rows, number of
+       *        sparse points), e.g. a view on a memory map
+       * @throw std::runtime_error if the shape of KNM_der is wrong
+       */
+      template <class Property_t, class PropertyGradient_t,
+                internal::TargetType Type,
+                std::enable_if_t<Type == internal::TargetType::Atom, int> = 0,
+                class StructureManagers, class SparsePoints>
+      void fill_derivative(StructureManagers & managers,
+                           SparsePoints & sparse_points,
+                           const std::string & representation_name,
+                           const std::string & representation_grad_name,
+                           const bool compute_neg_stress,
+                           Eigen::Ref<math::Matrix_t> KNM_der,
+                           const size_t n_threads = 1) {
+        const auto nb_rows{static_cast<Eigen::Index>(
+            get_derivative_nb_rows(managers, compute_neg_stress))};
+        const auto nb_sparse_points{
+            static_cast<Eigen::Index>(sparse_points.size())};
+        if (KNM_der.rows() != nb_rows or KNM_der.cols() != nb_sparse_points) {
+          std::stringstream err_str{};
+          err_str << "The kernel derivative buffer has shape ("
+                  << KNM_der.rows() << ", " << KNM_der.cols()
+                  << ") but should have shape (" << nb_rows << ", "
+                  << nb_sparse_points << ").";
+          throw std::runtime_error(err_str.str());
+        }
+        KNM_der.setZero();
+
+        // first row of the centers and of the stress of each structure, the
+        // stress terms are stored at the bottom of the KNM in a block
+        std::vector<size_t> center_rows{};
+        std::vector<size_t> stress_rows{};
+        size_t idx_center{0};
+        size_t row_idx_stress{0};
+        for (const auto & manager : managers) {
+          row_idx_stress += manager->size() * SpatialDims;
+        }
+        for (const auto & manager : managers) {
+          center_rows.push_back(idx_center);
+          stress_rows.push_back(row_idx_stress);
+          idx_center += manager->size() * SpatialDims;
+          row_idx_stress += 2 * SpatialDims;
+        }
+
+        internal::parallel_for(
+            managers.size(), n_threads, [&](size_t i_manager) {
+              this->template fill_derivative_by_structure<
+                  Property_t, PropertyGradient_t>(
+                  managers[i_manager], sparse_points, representation_name,
+                  representation_grad_name, compute_neg_stress,
+                  center_rows[i_manager], stress_rows[i_manager], KNM_der);
+            });
+      }
+
+      /**
+       * Fill the rows of KNM_der associated with the structure of manager,
+       * i.e. 3 rows per center starting at idx_center and 6 rows of stress
+       * starting at row_idx_stress if compute_neg_stress. Only these rows are
+       * modified so several structures can be filled concurrently.
+       */
+      template <class Property_t, class PropertyGradient_t, class ManagerPtr,
+                class SparsePoints>
+      void fill_derivative_by_structure(
+          ManagerPtr manager, SparsePoints & sparse_points,
+          const std::string & representation_name,
+          const std::string & representation_grad_name,
+          const bool compute_neg_stress, size_t idx_center,
+          const size_t row_idx_stress, Eigen::Ref<math::Matrix_t> KNM_der) {
+        using Manager_t = typename ManagerPtr::element_type;
+        using Keys_t = typename SparsePoints::Keys_t;
+        using Key_t = typename SparsePoints::Key_t;
         // Voigt order is xx, yy, zz, yz, xz, xy. To compute xx, yy, zz
         // and yz, xz, xy in one loop over the three spatial dimensions
         // dK/dr_{x,y,z}, we fill the off-diagonals yz, xz, xy by computing
@@ -294,207 +467,177 @@ namespace rascal {
                                         {{3, 1}}}};  //    yz,            y
 
         const size_t nb_sparse_points{sparse_points.size()};
-        math::Matrix_t KNM_der(nb_kernel_gradient_rows, nb_sparse_points);
-        KNM_der.setZero();
         const size_t zeta{this->zeta};
-        size_t idx_center{0};
-        // loop over the structures
-        for (auto & manager : managers) {
-          auto && prop_repr{*manager->template get_property<Property_t>(
-              representation_name, true)};
-          auto && prop_repr_grad{
-              *manager->template get_property<PropertyGradient_t>(
-                  representation_grad_name, true)};
-          // dk/dr_i this is col major hence dim order
-          Property<double, 1, Manager_t, Eigen::Dynamic, SpatialDims> dkdr{
-              *manager, "dkdr", true};
-          dkdr.set_nb_row(nb_sparse_points);
-          dkdr.resize();
-          dkdr.setZero();
-
-          // dk/dX without sparse point factor T
-          Property<double, 1, Manager_t, Eigen::Dynamic, 1> dkdX_missing_T{
-              *manager, "dkdX without sparse point factor T", true};
-          dkdX_missing_T.set_nb_row(nb_sparse_points);
-          dkdX_missing_T.resize();
-          if (zeta > 1) {
-            dkdX_missing_T.setZero();
-            // zeta * (X * T)**(zeta-1)
-            for (auto center : manager) {
-              int a_species{center.get_atom_type()};
-              dkdX_missing_T[center] =
-                  zeta *
-                  pow_zeta(sparse_points.dot(a_species, prop_repr[center]),
-                           zeta - 1);
-            }
+        auto && prop_repr{*manager->template get_property<Property_t>(
+            representation_name, true)};
+        auto && prop_repr_grad{
+            *manager->template get_property<PropertyGradient_t>(
+                representation_grad_name, true)};
+        // dk/dr_i this is col major hence dim order
+        Property<double, 1, Manager_t, Eigen::Dynamic, SpatialDims> dkdr{
+            *manager, "dkdr", true};
+        dkdr.set_nb_row(nb_sparse_points);
+        dkdr.resize();
+        dkdr.setZero();
+
+        // dk/dX without sparse point factor T
+        Property<double, 1, Manager_t, Eigen::Dynamic, 1> dkdX_missing_T{
+            *manager, "dkdX without sparse point factor T", true};
+        dkdX_missing_T.set_nb_row(nb_sparse_points);
+        dkdX_missing_T.resize();
+        if (zeta > 1) {
+          dkdX_missing_T.setZero();
+          // zeta * (X * T)**(zeta-1)
+          for (auto center : manager) {
+            int a_species{center.get_atom_type()};
+            dkdX_missing_T[center] =
+                zeta *
+                pow_zeta(sparse_points.dot(a_species, prop_repr[center]),
+                         zeta - 1);
           }
-          //
-          const int block_size{prop_repr.get_nb_comp()};
+        }
+        //
+        const int block_size{prop_repr.get_nb_comp()};
 
-          bool do_block_by_key_dot{false};
-          if (prop_repr_grad.are_keys_uniform()) {
-            do_block_by_key_dot = true;
-          }
+        bool do_block_by_key_dot{false};
+        if (prop_repr_grad.are_keys_uniform()) {
+          do_block_by_key_dot = true;
+        }
 
-          std::set<int> unique_species{};
-          for (auto center : manager) {
-            unique_species.insert(center.get_atom_type());
-          }
+        std::set<int> unique_species{};
+        for (auto center : manager) {
+          unique_species.insert(center.get_atom_type());
+        }
 
-          // find shared central atom species
-          std::set<int> species_intersect{internal::set_intersection(
-              unique_species, sparse_points.species())};
+        // find shared central atom species
+        std::set<int> species_intersect{internal::set_intersection(
+            unique_species, sparse_points.species())};
 
-          if (species_intersect.size() == 0) {
-            return KNM_der;
-          }
+        if (species_intersect.size() == 0) {
+          return;
+        }
 
-          // find offsets along the sparse points spatial_dim
-          std::map<int, int> offsets{sparse_points.get_offsets()};
-          Keys_t repr_keys{prop_repr_grad.get_keys()};
-          std::map<int, Keys_t> keys_intersect{};
-          for (const int & species : species_intersect) {
-            keys_intersect[species] = internal::set_intersection(
-                repr_keys, sparse_points.keys_sp.at(species));
-          }
-          // compute dX/dr * T * k_{zeta-1} * zeta
-          if (do_block_by_key_dot) {
-            size_t idx_row{0};
-            auto repr_grads = prop_repr_grad.get_raw_data_view();
-            for (auto center : manager) {
-              int a_species{center.get_atom_type()};
-              Eigen::Vector3d r_i = center.get_position();
-              if (species_intersect.count(a_species) == 0) {
-                continue;
-              }
-              auto dkdX_i_missing_T = dkdX_missing_T[center];
-              const int offset = offsets.at(a_species);
-              const auto & values_by_sp = sparse_points.values.at(a_species);
-              const auto & indices_by_sp = sparse_points.indices.at(a_species);
-              const size_t nb_rows{center.pairs_with_self_pair().size()};
-              for (const Key_t & key : keys_intersect.at(a_species)) {
-                const auto & indices_by_sp_key = indices_by_sp.at(key);
-                const auto & values_by_sp_key = values_by_sp.at(key);
-                auto sparse_points_block = Eigen::Map<const math::Matrix_t>(
-                    values_by_sp_key.data(),
-                    static_cast<Eigen::Index>(indices_by_sp_key.size()),
-                    static_cast<Eigen::Index>(block_size));
-                assert(indices_by_sp_key.size() * block_size ==
-                       values_by_sp_key.size());
-                math::Matrix_t KNM_der_block(nb_rows, indices_by_sp_key.size());
-                // copy subset of k_{zeta-1} * zeta that matches a_species and
-                // key
-                math::Vector_t dkdX_i_missing_T_a_species_block{
-                    indices_by_sp_key.size()};
-                if (zeta > 1) {
-                  for (size_t idx_col{0}; idx_col < indices_by_sp_key.size();
-                       idx_col++) {
-                    dkdX_i_missing_T_a_species_block(idx_col) =
-                        dkdX_i_missing_T(offset + indices_by_sp_key[idx_col]);
-                  }  // sparse points
-                }
-                int block_start_col_idx{
-                    prop_repr_grad.get_gradient_col_by_key(key)};
-                for (int idx_spatial_dim{0}; idx_spatial_dim < SpatialDims;
-                     idx_spatial_dim++) {
-                  // dX/dr * T
-                  KNM_der_block =
-                      repr_grads.block(idx_row,
-                                       block_start_col_idx +
-                                           idx_spatial_dim * block_size,
-                                       nb_rows, block_size) *
-                      sparse_points_block.transpose();
-                  // * zeta * (X * T)**(zeta-1)
-                  if (zeta > 1) {
-                    KNM_der_block *=
-                        dkdX_i_missing_T_a_species_block.asDiagonal();
-                  }
-                  int idx_neigh{0};
-                  for (auto neigh : center.pairs_with_self_pair()) {
-                    auto dkdr_ji{dkdr[neigh.get_atom_j()]};
-                    for (int idx_col{0}; idx_col < KNM_der_block.cols();
-                         idx_col++) {
-                      dkdr_ji(offset + indices_by_sp_key[idx_col],
-                              idx_spatial_dim) +=
-                          KNM_der_block(idx_neigh, idx_col);
-                    }  // sparse points
-                    idx_neigh++;
-                  }  // neigh
-                  if (compute_neg_stress) {
-                    const auto & voigt =
-                        voigt_id_to_spatial_dim[idx_spatial_dim];
-                    idx_neigh = 0;
-                    for (auto neigh : center.pairs_with_self_pair()) {
-                      Eigen::Vector3d r_ji = r_i - neigh.get_position();
-                      for (int idx_col{0}; idx_col < KNM_der_block.cols();
-                           idx_col++) {
-                        // computes in order xx, yy, zz
-                        KNM_der(row_idx_stress + idx_spatial_dim,
-                                offset + indices_by_sp_key[idx_col]) +=
-                            r_ji(idx_spatial_dim) *
-                            KNM_der_block(idx_neigh, idx_col);
-                        // computes in order xz, xy, yz
-                        KNM_der(row_idx_stress + voigt[0],
-                                offset + indices_by_sp_key[idx_col]) +=
-                            r_ji(voigt[1]) * KNM_der_block(idx_neigh, idx_col);
-                      }  // sparse points
-                      idx_neigh++;
-                    }  // neigh
-                  }    // if compute_neg_stress
-                }      // idx_spatial_dim
-              }        // key
+        // find offsets along the sparse points spatial_dim
+        std::map<int, int> offsets{sparse_points.get_offsets()};
+        Keys_t repr_keys{prop_repr_grad.get_keys()};
+        std::map<int, Keys_t> keys_intersect{};
+        for (const int & species : species_intersect) {
+          keys_intersect[species] = internal::set_intersection(
+              repr_keys, sparse_points.keys_sp.at(species));
+        }
+        // compute dX/dr * T * k_{zeta-1} * zeta
+        if (do_block_by_key_dot) {
+          size_t idx_row{0};
+          auto repr_grads = prop_repr_grad.get_raw_data_view();
+          for (auto center : manager) {
+            int a_species{center.get_atom_type()};
+            Eigen::Vector3d r_i = center.get_position();
+            const size_t nb_rows{center.pairs_with_self_pair().size()};
+            if (species_intersect.count(a_species) == 0) {
+              // skip the gradient rows of this center too
               idx_row += nb_rows;
-            }  // center
-          } else {
-            for (auto center : manager) {
-              int a_species{center.get_atom_type()};
-              Eigen::Vector3d r_i = center.get_position();
-              auto dkdX_i_missing_T = dkdX_missing_T[center];
-              for (auto neigh : center.pairs_with_self_pair()) {
-                // T * dX/dr
-                auto T_times_dXdr = sparse_points.dot_derivative(
-                    a_species, prop_repr_grad[neigh]);
+              continue;
+            }
+            auto dkdX_i_missing_T = dkdX_missing_T[center];
+            const int offset = offsets.at(a_species);
+            // pseudo points of a_species, the keys are column blocks
+            const auto T_sp{sparse_points.get_features_view(a_species)};
+            const Eigen::Index n_points{T_sp.rows()};
+            math::Matrix_t KNM_der_block(nb_rows, n_points);
+            for (const Key_t & key : keys_intersect.at(a_species)) {
+              auto sparse_points_block = T_sp.middleCols(
+                  sparse_points.get_key_column(a_species, key), block_size);
+              int block_start_col_idx{
+                  prop_repr_grad.get_gradient_col_by_key(key)};
+              for (int idx_spatial_dim{0}; idx_spatial_dim < SpatialDims;
+                   idx_spatial_dim++) {
+                // dX/dr * T
+                KNM_der_block.noalias() =
+                    repr_grads.block(idx_row,
+                                     block_start_col_idx +
+                                         idx_spatial_dim * block_size,
+                                     nb_rows, block_size) *
+                    sparse_points_block.transpose();
                 // * zeta * (X * T)**(zeta-1)
                 if (zeta > 1) {
-                  T_times_dXdr.transpose() *= dkdX_i_missing_T.asDiagonal();
+                  KNM_der_block *=
+                      dkdX_i_missing_T.segment(offset, n_points).asDiagonal();
                 }
-                dkdr[neigh.get_atom_j()] += T_times_dXdr;
+                int idx_neigh{0};
+                for (auto neigh : center.pairs_with_self_pair()) {
+                  auto dkdr_ji{dkdr[neigh.get_atom_j()]};
+                  dkdr_ji.block(offset, idx_spatial_dim, n_points, 1) +=
+                      KNM_der_block.row(idx_neigh).transpose();
+                  idx_neigh++;
+                }  // neigh
                 if (compute_neg_stress) {
-                  Eigen::Vector3d r_ji = r_i - neigh.get_position();
-                  for (int i_der{0}; i_der < SpatialDims; i_der++) {
-                    const auto & voigt = voigt_id_to_spatial_dim[i_der];
+                  const auto & voigt =
+                      voigt_id_to_spatial_dim[idx_spatial_dim];
+                  idx_neigh = 0;
+                  for (auto neigh : center.pairs_with_self_pair()) {
+                    Eigen::Vector3d r_ji = r_i - neigh.get_position();
                     // computes in order xx, yy, zz
-                    KNM_der.row(row_idx_stress + i_der) +=
-                        r_ji(i_der) * T_times_dXdr.transpose().row(i_der);
+                    KNM_der.block(row_idx_stress + idx_spatial_dim, offset, 1,
+                                  n_points) +=
+                        r_ji(idx_spatial_dim) * KNM_der_block.row(idx_neigh);
                     // computes in order xz, xy, yz
-                    KNM_der.row(row_idx_stress + voigt[0]) +=
-                        r_ji(voigt[1]) * T_times_dXdr.transpose().row(i_der);
-                  }
-                }
-              }  // neigh
-            }    // center
-          }      // if do_block_by_key_dot
-
-          // copy the data to the kernel matrix
+                    KNM_der.block(row_idx_stress + voigt[0], offset, 1,
+                                  n_points) +=
+                        r_ji(voigt[1]) * KNM_der_block.row(idx_neigh);
+                    idx_neigh++;
+                  }  // neigh
+                }    // if compute_neg_stress
+              }      // idx_spatial_dim
+            }        // key
+            idx_row += nb_rows;
+          }  // center
+        } else {
           for (auto center : manager) {
-            KNM_der.block(idx_center, 0, SpatialDims, nb_sparse_points) =
-                dkdr[center].transpose();
-            idx_center += SpatialDims;
-          }
-          if (compute_neg_stress) {
-            // TODO(alex) when we established how we deal with
-            // `get_atomic_structure` method for other root managers
-            // replace this part
-            auto manager_root = extract_underlying_manager<0>(manager);
-            json structure_copy = manager_root->get_atomic_structure();
-            auto atomic_structure =
-                structure_copy.template get<AtomicStructure<SpatialDims>>();
-            KNM_der.block(row_idx_stress, 0, 6, KNM_der.cols()) /=
-                atomic_structure.get_volume();
-            row_idx_stress += SpatialDims * 2;
-          }
-        }  // managers
-        return KNM_der;
+            int a_species{center.get_atom_type()};
+            Eigen::Vector3d r_i = center.get_position();
+            auto dkdX_i_missing_T = dkdX_missing_T[center];
+            for (auto neigh : center.pairs_with_self_pair()) {
+              // T * dX/dr
+              auto T_times_dXdr = sparse_points.dot_derivative(
+                  a_species, prop_repr_grad[neigh]);
+              // * zeta * (X * T)**(zeta-1)
+              if (zeta > 1) {
+                T_times_dXdr.transpose() *= dkdX_i_missing_T.asDiagonal();
+              }
+              dkdr[neigh.get_atom_j()] += T_times_dXdr;
+              if (compute_neg_stress) {
+                Eigen::Vector3d r_ji = r_i - neigh.get_position();
+                for (int i_der{0}; i_der < SpatialDims; i_der++) {
+                  const auto & voigt = voigt_id_to_spatial_dim[i_der];
+                  // computes in order xx, yy, zz
+                  KNM_der.row(row_idx_stress + i_der) +=
+                      r_ji(i_der) * T_times_dXdr.transpose().row(i_der);
+                  // computes in order xz, xy, yz
+                  KNM_der.row(row_idx_stress + voigt[0]) +=
+                      r_ji(voigt[1]) * T_times_dXdr.transpose().row(i_der);
+                }
+              }
+            }  // neigh
+          }    // center
+        }      // if do_block_by_key_dot
+
+        // copy the data to the kernel matrix
+        for (auto center : manager) {
+          KNM_der.block(idx_center, 0, SpatialDims, nb_sparse_points) =
+              dkdr[center].transpose();
+          idx_center += SpatialDims;
+        }
+        if (compute_neg_stress) {
+          // TODO(alex) when we established how we deal with
+          // `get_atomic_structure` method for other root managers
+          // replace this part
+          auto manager_root = extract_underlying_manager<0>(manager);
+          json structure_copy = manager_root->get_atomic_structure();
+          auto atomic_structure =
+              structure_copy.template get<AtomicStructure<SpatialDims>>();
+          KNM_der.block(row_idx_stress, 0, 6, KNM_der.cols()) /=
+              atomic_structure.get_volume();
+        }
       }
     };
   }  // namespace internal
@@ -689,12 +832,15 @@ namespace rascal {
      * @param sparse_points class of pseudo points
      * @param managers_b a ManagerCollection or similar collection of
      *        structure managers
+     * @param n_threads number of threads used to fill the rows of the
+     *        structures, 0 for as many as the hardware supports
      */
     template <class Calculator, class StructureManagers, class SparsePoints>
     math::Matrix_t compute_derivative(const Calculator & calculator,
                                       const StructureManagers & managers,
                                       const SparsePoints & sparse_points,
-                                      const bool compute_neg_stress) {
+                                      const bool compute_neg_stress,
+                                      const size_t n_threads = 1) {
       using ManagerPtr_t = typename StructureManagers::value_type;
       using Manager_t = typename ManagerPtr_t::element_type;
       using Property_t = typename Calculator::template Property_t<Manager_t>;
@@ -715,7 +861,63 @@ namespace rascal {
         return kernel->template compute_derivative<
             Property_t, PropertyGradient_t, TargetType::Atom>(
             managers, sparse_points, representation_name,
-            representation_grad_name, compute_neg_stress);
+            representation_grad_name, compute_neg_stress, n_threads);
+      } else {
+        throw std::logic_error(
+            "Given kernel_type " +
+            this->parameters["kernel_type"].get<std::string>() +
+            " is not known."
+            " It is 'GAP'");
+      }
+    }
+
+    /**
+     * Shape of the matrix returned by compute_derivative.
+     */
+    template <class StructureManagers>
+    std::array<size_t, 2>
+    get_derivative_shape(const StructureManagers & managers,
+                         const size_t nb_sparse_points,
+                         const bool compute_neg_stress) const {
+      using internal::SparseKernelImpl;
+      using internal::SparseKernelType;
+      return {SparseKernelImpl<SparseKernelType::GAP>::get_derivative_nb_rows(
+                  managers, compute_neg_stress),
+              nb_sparse_points};
+    }
+
+    /**
+     * Same as compute_derivative but fills the caller provided KNM_der, e.g.
+     * a view on a memory map, which should have the shape given by
+     * get_derivative_shape.
+     */
+    template <class Calculator, class StructureManagers, class SparsePoints>
+    void fill_derivative(const Calculator & calculator,
+                         const StructureManagers & managers,
+                         const SparsePoints & sparse_points,
+                         const bool compute_neg_stress,
+                         Eigen::Ref<math::Matrix_t> KNM_der,
+                         const size_t n_threads = 1) {
+      using ManagerPtr_t = typename StructureManagers::value_type;
+      using Manager_t = typename ManagerPtr_t::element_type;
+      using Property_t = typename Calculator::template Property_t<Manager_t>;
+      using PropertyGradient_t =
+          typename Calculator::template PropertyGradient_t<Manager_t>;
+      if (not calculator.does_gradients()) {
+        throw std::runtime_error(
+            "This representation does not compute gradients.");
+      }
+      using internal::SparseKernelType;
+      using internal::TargetType;
+
+      if (this->kernel_type == SparseKernelType::GAP) {
+        auto kernel =
+            downcast_sparse_kernel_impl<SparseKernelType::GAP>(kernel_impl);
+        kernel->template fill_derivative<Property_t, PropertyGradient_t,
+                                         TargetType::Atom>(
+            managers, sparse_points, calculator.get_name(),
+            calculator.get_gradient_name(), compute_neg_stress, KNM_der,
+            n_threads);
       } else {
         throw std::logic_error(
             "Given kernel_type " +
@@ -50,9 +50,10 @@ namespace rascal {
    public:
     using Key_t = typename CalculatorBase::Key_t;
     using Keys_t = std::set<Key_t>;
-    using Data_t = std::map<int, std::map<Key_t, std::vector<double>>>;
-    using Indices_t = std::map<int, std::map<Key_t, std::vector<size_t>>>;
+    using Data_t = std::map<int, std::vector<double>>;
+    using Columns_t = std::map<int, std::map<Key_t, Eigen::Index>>;
     using Counters_t = std::map<int, size_t>;
+    using ConstMatrixMap_t = Eigen::Map<const math::Matrix_t>;
 
     template <class StructureManager>
     using Property_t =
@@ -62,22 +63,16 @@ namespace rascal {
         typename Calculator::template PropertyGradient_t<StructureManager>;
 
     /**
-     * Container for the actual data. By construction it gathers pseudo points
-     * in a particular manner: [sp][key][feature_idx] ; where sp is the type
-     * of the central atom to which these features correspond to, key is a
-     * valid key taken from the BlockSparse original container and feature_idx
-     * is a linear index containing all the features associated to several
-     * sparse points.
-     * This storage keeps the minimal amount of data.
+     * Container for the actual data. The pseudo points of central atom type
+     * sp are stored in values[sp] as the rows of a dense row-major matrix of
+     * shape (counters[sp], keys_sp[sp].size() * inner_size). The features of
+     * a key are stored in the inner_size columns starting at
+     * key_columns[sp][key] and they are zero for the pseudo points that do
+     * not have this key.
      */
     Data_t values{};
-    /**
-     * Container for the sparse points indices arranged like:
-     * [sp][key][sparse_point_idx] ; where sp and key are like in values and
-     * sparse_point_idx are the indices of the sparse points in the particular
-     * [sp][key] bin.
-     */
-    Indices_t indices{};
+    //! first column of the features of [key] in values[sp]
+    Columns_t key_columns{};
     //! counts number of sparse points for each [sp]
     Counters_t counters{};
     //! size of one feature block in [sp][key]
@@ -102,8 +97,7 @@ namespace rascal {
     SparsePointsBlockSparse(SparsePointsBlockSparse && other) = default;
 
     bool operator==(const SparsePointsBlockSparse<Calculator> & other) const {
-      if ((values == other.values) and (indices == other.indices) and  // NOLINT
-          (counters == other.counters) and                             // NOLINT
+      if ((values == other.values) and (counters == other.counters) and
           (inner_size == other.inner_size) and                         // NOLINT
           (center_species == other.center_species) and                 // NOLINT
           (keys == other.keys) and                                     // NOLINT
@@ -139,33 +133,31 @@ namespace rascal {
       }
       return species;
     }
+
+    /**
+     * View of the pseudo points of central atom type sp as a dense
+     * row-major matrix without copy, see values. It is invalidated by
+     * push_back.
+     */
+    ConstMatrixMap_t get_features_view(const int & sp) const {
+      const auto & values_by_sp = this->values.at(sp);
+      const auto n_rows{static_cast<Eigen::Index>(this->counters.at(sp))};
+      const auto n_cols{static_cast<Eigen::Index>(
+          this->keys_sp.at(sp).size() * this->inner_size)};
+      return ConstMatrixMap_t(values_by_sp.data(), n_rows, n_cols);
+    }
+
+    //! first column of the features of key in get_features_view(sp)
+    Eigen::Index get_key_column(const int & sp, const Key_t & key) const {
+      return this->key_columns.at(sp).at(key);
+    }
+
     //! dot product with itself to build the K_{MM} kernel matrix
     math::Matrix_t self_dot(const int & sp) const {
-      math::Matrix_t KMM_by_sp(this->counters.at(sp), this->counters.at(sp));
-      KMM_by_sp.setZero();
-      const auto & values_by_sp = this->values.at(sp);
-      const auto & indices_by_sp = this->indices.at(sp);
-      for (const Key_t & key : this->keys_sp.at(sp)) {
-        const auto & indices_by_sp_key = indices_by_sp.at(key);
-        auto mat = Eigen::Map<const math::Matrix_t>(
-            values_by_sp.at(key).data(),
-            static_cast<Eigen::Index>(indices_by_sp_key.size()),
-            static_cast<Eigen::Index>(this->inner_size));
-        // the following does the same as:
-        // auto KMM_by_key = (mat * mat.transpose()).eval();
-        math::Matrix_t KMM_by_key(indices_by_sp_key.size(),
-                                  indices_by_sp_key.size());
-        KMM_by_key =
-            KMM_by_key.setZero().selfadjointView<Eigen::Upper>().rankUpdate(
-                mat);
-        for (int i_row{0}; i_row < KMM_by_key.rows(); i_row++) {
-          for (int i_col{0}; i_col < KMM_by_key.cols(); i_col++) {
-            KMM_by_sp(indices_by_sp_key[i_row], indices_by_sp_key[i_col]) +=
-                KMM_by_key(i_row, i_col);
-          }
-        }
-      }  // key
-      return KMM_by_sp;
+      const auto T_sp{this->get_features_view(sp)};
+      math::Matrix_t KMM_by_sp{math::Matrix_t::Zero(T_sp.rows(), T_sp.rows())};
+      KMM_by_sp.selfadjointView<Eigen::Upper>().rankUpdate(T_sp);
+      return KMM_by_sp.selfadjointView<Eigen::Upper>();
     }
 
     using ColVector_t = Eigen::Matrix<double, Eigen::Dynamic, 1>;
@@ -185,34 +177,16 @@ namespace rascal {
         // the type of the central atom is not in the pseudo points
         return KNM_row;
       }
-
-      const auto & values_by_sp = this->values.at(sp);
-      const auto & indices_by_sp = this->indices.at(sp);
-
-      int offset{0};
-      for (const int & csp : this->center_species) {
-        if (csp == sp) {
-          break;
-        } else {
-          offset += this->counters.at(csp);
-        }
-      }
-
-      Keys_t keys_intersect{internal::set_intersection(
-          representation.get_keys(), this->keys_sp.at(sp))};
-
-      for (const Key_t & key : keys_intersect) {
-        if (representation.count(key)) {
-          auto rep_flat_by_key{representation.flat(key)};
-          const auto & indices_by_sp_key = indices_by_sp.at(key);
-          auto mat = Eigen::Map<const math::Matrix_t>(
-              values_by_sp.at(key).data(),
-              static_cast<Eigen::Index>(indices_by_sp_key.size()),
-              static_cast<Eigen::Index>(this->inner_size));
-          auto KNM_row_key = (mat * rep_flat_by_key.transpose()).eval();
-          for (int i_row{0}; i_row < KNM_row_key.size(); i_row++) {
-            KNM_row(offset + indices_by_sp_key[i_row]) += KNM_row_key(i_row);
-          }
+      const auto T_sp{this->get_features_view(sp)};
+      const auto & key_columns_by_sp = this->key_columns.at(sp);
+      auto && KNM_row_sp{
+          KNM_row.segment(this->get_offset(sp), T_sp.rows())};
+      const auto inner{static_cast<Eigen::Index>(this->inner_size)};
+      for (const Key_t & key : representation.get_keys()) {
+        auto col{key_columns_by_sp.find(key)};
+        if (col != key_columns_by_sp.end()) {
+          KNM_row_sp.noalias() += T_sp.middleCols(col->second, inner) *
+                                  representation.flat(key).transpose();
         }
       }
       return KNM_row;
@@ -227,45 +201,19 @@ namespace rascal {
      */
     SparsePointsBlockSparse<Calculator> dot(const int & sp,
                                             math::Vector_t & vec) const {
-      const auto & values_by_sp = this->values.at(sp);
-      const auto & indices_by_sp = this->indices.at(sp);
-      int n_feature{
-          static_cast<int>(this->keys_sp.at(sp).size() * this->inner_size)};
-      Array_t result(n_feature);
-      result.setZero();
-      internal::InternallySortedKeyMap<Key_t, math::Matrix_t> res_map(result);
-      res_map.resize_view(this->keys_sp.at(sp), 1, this->inner_size, 0);
       SparsePointsBlockSparse out{};
       if (this->center_species.count(sp) == 0) {
         // the type of the central atom is not in the pseudo points
-        out.push_back(res_map, sp);
         return out;
       }
-      int offset{0};
-      // int length{0};
-      for (const int & csp : this->center_species) {
-        if (csp == sp) {
-          break;
-        } else {
-          offset += this->counters.at(csp);
-        }
-      }
-
-      for (const Key_t & key : this->keys_sp.at(sp)) {
-        auto res_map_by_key = res_map.at(key);
-        const auto & indices_by_sp_key = indices_by_sp.at(key);
-        math::Vector_t vec_subset(indices_by_sp_key.size());
-        for (size_t i_col{0}; i_col < indices_by_sp_key.size(); i_col++) {
-          vec_subset(i_col) = vec(offset + indices_by_sp_key[i_col]);
-        }
-        auto mat = Eigen::Map<const math::Matrix_t>(
-            values_by_sp.at(key).data(),
-            static_cast<Eigen::Index>(indices_by_sp_key.size()),
-            static_cast<Eigen::Index>(this->inner_size));
-
-        res_map_by_key = vec_subset * mat;
-      }
-
+      const auto T_sp{this->get_features_view(sp)};
+      // the features of res_map follow the same layout as the rows of T_sp
+      Array_t result{
+          (vec.segment(this->get_offset(sp), T_sp.rows()) * T_sp)
+              .transpose()
+              .array()};
+      internal::InternallySortedKeyMap<Key_t, math::Matrix_t> res_map(result);
+      res_map.resize_view(this->keys_sp.at(sp), 1, this->inner_size, 0);
       out.push_back(res_map, sp);
       return out;
     }
@@ -287,52 +235,28 @@ namespace rascal {
         // the type of the central atom is not in the pseudo points
         return KNM_row;
       }
-      const auto & values_by_sp = this->values.at(sp);
-      const auto & indices_by_sp = this->indices.at(sp);
-
-      int offset{0};
-      for (const int & csp : this->center_species) {
-        if (csp == sp) {
-          break;
-        } else {
-          offset += this->counters.at(csp);
+      const auto T_sp{this->get_features_view(sp)};
+      const auto & key_columns_by_sp = this->key_columns.at(sp);
+      auto && KNM_row_sp{
+          KNM_row.middleRows(this->get_offset(sp), T_sp.rows())};
+      const auto inner{static_cast<Eigen::Index>(this->inner_size)};
+      for (const Key_t & key : representation_grad.get_keys()) {
+        auto col{key_columns_by_sp.find(key)};
+        if (col == key_columns_by_sp.end()) {
+          continue;
         }
-      }
-
-      Keys_t keys_intersect{internal::set_intersection(
-          representation_grad.get_keys(), this->keys_sp.at(sp))};
-
-      for (const Key_t & key : keys_intersect) {
         // get the representation gradient features and shape it
         // assumes the gradient directions are the outermost index
         auto rep_grad_flat_by_key{representation_grad.flat(key)};
         Eigen::Map<const Eigen::Matrix<double, ThreeD, Eigen::Dynamic,
                                        Eigen::RowMajor>>
-            rep_grad_by_key(rep_grad_flat_by_key.data(), ThreeD,
-                            this->inner_size);
-        assert(rep_grad_flat_by_key.size() ==
-               static_cast<int>(ThreeD * this->inner_size));
-        const auto & indices_by_sp_key = indices_by_sp.at(key);
-        // get the block of pseudo points features
-        auto mat = Eigen::Map<const math::Matrix_t>(
-            values_by_sp.at(key).data(),
-            static_cast<Eigen::Index>(indices_by_sp_key.size()),
-            static_cast<Eigen::Index>(this->inner_size));
-        assert(indices_by_sp_key.size() * this->inner_size ==
-               values_by_sp.at(key).size());
+            rep_grad_by_key(rep_grad_flat_by_key.data(), ThreeD, inner);
+        assert(rep_grad_flat_by_key.size() == ThreeD * inner);
         // compute the product between pseudo points and representation
         // gradient block
-        ColVectorDer_t KNM_row_key(indices_by_sp_key.size(), ThreeD);
-        KNM_row_key = (mat * rep_grad_by_key.transpose());
-        // dispatach kernel partial elements to the proper pseudo points
-        // indices
-        for (int i_dim{0}; i_dim < ThreeD; i_dim++) {
-          for (int i_row{0}; i_row < KNM_row_key.rows(); i_row++) {
-            KNM_row(offset + indices_by_sp_key[i_row], i_dim) +=
-                KNM_row_key(i_row, i_dim);
-          }  // M
-        }    // dim
-      }      // key
+        KNM_row_sp.noalias() +=
+            T_sp.middleCols(col->second, inner) * rep_grad_by_key.transpose();
+      }  // key
       return KNM_row;
     }
 
@@ -347,6 +271,18 @@ namespace rascal {
       return offsets;
     }
 
+    //! get the offset of the pseudo points of type sp
+    Eigen::Index get_offset(const int & sp) const {
+      Eigen::Index offset{0};
+      for (const int & csp : this->center_species) {
+        if (csp == sp) {
+          break;
+        }
+        offset += this->counters.at(csp);
+      }
+      return offset;
+    }
+
     /**
      * Fill the pseudo points container with features computed with calculator
      * on the atomic structure contained in collection using
@@ -386,64 +322,105 @@ namespace rascal {
     template <class Val>
     void push_back(internal::InternallySortedKeyMap<Key_t, Val> & pseudo_point,
                    const int & center_type) {
-      auto & values_by_sp = this->values[center_type];
-      auto & counters_by_sp = this->counters[center_type];
-      auto & indices_by_sp = this->indices[center_type];
-      auto & keys_by_sp = this->keys_sp[center_type];
-      this->center_species.insert(center_type);
-      for (const auto & key : pseudo_point.get_keys()) {
-        this->keys.insert(key);
-        keys_by_sp.insert(key);
-        auto & values_by_sp_key = values_by_sp[key];
-        auto pseudo_point_by_key = pseudo_point.flat(key);
-        for (int ii{0}; ii < pseudo_point_by_key.size(); ++ii) {
-          values_by_sp_key.push_back(pseudo_point_by_key[ii]);
-        }
-        indices_by_sp[key].push_back(counters_by_sp);
+      const auto pseudo_point_keys{pseudo_point.get_keys()};
+      for (const auto & key : pseudo_point_keys) {
+        const auto block_size{pseudo_point.flat(key).size()};
         if (this->inner_size == 0) {
-          this->inner_size = pseudo_point_by_key.size();
-        } else if (static_cast<Eigen::Index>(this->inner_size) !=
-                   pseudo_point_by_key.size()) {
+          this->inner_size = block_size;
+        } else if (static_cast<Eigen::Index>(this->inner_size) != block_size) {
           std::stringstream err_str{};
           err_str << "The representation changed size during the set-up of "
                      "SparsePointsBlockSparse:"
-                  << "'" << this->inner_size
-                  << "!=" << pseudo_point_by_key.size() << "'.";
+                  << "'" << this->inner_size << "!=" << block_size << "'.";
           throw std::logic_error(err_str.str());
         }
       }
-      ++counters_by_sp;
+      this->center_species.insert(center_type);
+      this->keys.insert(pseudo_point_keys.begin(), pseudo_point_keys.end());
+      auto & keys_by_sp = this->keys_sp[center_type];
+      const size_t n_keys{keys_by_sp.size()};
+      Keys_t new_keys_by_sp{keys_by_sp};
+      new_keys_by_sp.insert(pseudo_point_keys.begin(), pseudo_point_keys.end());
+      if (new_keys_by_sp.size() != n_keys or
+          this->key_columns.count(center_type) == 0) {
+        this->set_keys_by_species(center_type, new_keys_by_sp);
+      }
+
+      // append a row filled with the features of pseudo_point
+      auto & values_by_sp = this->values[center_type];
+      const size_t n_cols{keys_by_sp.size() * this->inner_size};
+      values_by_sp.resize(values_by_sp.size() + n_cols, 0.);
+      Eigen::Map<math::Vector_t> row{
+          &values_by_sp[values_by_sp.size() - n_cols],
+          static_cast<Eigen::Index>(n_cols)};
+      const auto & key_columns_by_sp = this->key_columns.at(center_type);
+      const auto inner{static_cast<Eigen::Index>(this->inner_size)};
+      for (const auto & key : pseudo_point_keys) {
+        row.segment(key_columns_by_sp.at(key), inner) = pseudo_point.flat(key);
+      }
+      ++this->counters[center_type];
     }
 
     math::Matrix_t get_features() const {
-      size_t n_sparse_points{0};
-      for (const auto & sp : this->center_species) {
-        n_sparse_points += counters.at(sp);
-      }
-      math::Matrix_t mat{n_sparse_points, this->inner_size * this->keys.size()};
+      math::Matrix_t mat{this->size(), this->inner_size * this->keys.size()};
       mat.setZero();
-      size_t i_row{0};
+      const auto inner{static_cast<Eigen::Index>(this->inner_size)};
+      std::map<Key_t, Eigen::Index> global_columns{};
+      for (const auto & key : this->keys) {
+        global_columns.emplace(
+            key, static_cast<Eigen::Index>(global_columns.size()) * inner);
+      }
+      Eigen::Index i_row{0};
       for (const auto & sp : this->center_species) {
-        auto & values_by_sp = this->values.at(sp);
-        auto & indices_by_sp = this->indices.at(sp);
-        size_t i_col{0};
-        for (const auto & key : this->keys) {
-          if (values_by_sp.count(key)) {
-            Eigen::Map<const math::Matrix_t> block{
-                values_by_sp.at(key).data(),
-                static_cast<Eigen::Index>(indices_by_sp.at(key).size()),
-                static_cast<Eigen::Index>(this->inner_size)};
-            for (size_t ii{0}; ii < indices_by_sp.at(key).size(); ii++) {
-              mat.block(i_row + indices_by_sp.at(key)[ii], i_col, 1,
-                        this->inner_size) = block.row(ii);
-            }
-          }
-          i_col += this->inner_size;
+        const auto T_sp{this->get_features_view(sp)};
+        for (const auto & key_col : this->key_columns.at(sp)) {
+          mat.block(i_row, global_columns.at(key_col.first), T_sp.rows(),
+                    inner) = T_sp.middleCols(key_col.second, inner);
         }
-        i_row += this->counters.at(sp);
+        i_row += T_sp.rows();
       }
       return mat;
     }
+
+    /**
+     * Get the pseudo points of central atom type sp as a dense matrix. The
+     * columns are the features of the keys of keys_sp[sp] (in the order of
+     * the set) so the matrix only contains the keys relevant for sp. See
+     * get_features_view to avoid the copy.
+     *
+     * @return matrix of shape (size_by_species(sp),
+     *         keys_sp[sp].size() * inner_size)
+     */
+    math::Matrix_t get_features_by_species(const int & sp) const {
+      return this->get_features_view(sp);
+    }
+
+    /**
+     * Set the keys of the pseudo points of type sp and move their features
+     * accordingly. new_keys has to contain the current keys of sp.
+     */
+    void set_keys_by_species(const int & sp, const Keys_t & new_keys) {
+      const auto inner{static_cast<Eigen::Index>(this->inner_size)};
+      std::map<Key_t, Eigen::Index> new_columns{};
+      for (const auto & key : new_keys) {
+        new_columns.emplace(
+            key, static_cast<Eigen::Index>(new_columns.size()) * inner);
+      }
+      const auto n_rows{static_cast<Eigen::Index>(this->counters[sp])};
+      const auto n_cols{static_cast<Eigen::Index>(new_keys.size()) * inner};
+      std::vector<double> new_values(static_cast<size_t>(n_rows * n_cols), 0.);
+      if (n_rows > 0 and this->key_columns.count(sp)) {
+        const auto T_sp{this->get_features_view(sp)};
+        Eigen::Map<math::Matrix_t> new_T_sp{new_values.data(), n_rows, n_cols};
+        for (const auto & key_col : this->key_columns.at(sp)) {
+          new_T_sp.middleCols(new_columns.at(key_col.first), inner) =
+              T_sp.middleCols(key_col.second, inner);
+        }
+      }
+      this->values[sp] = std::move(new_values);
+      this->key_columns[sp] = std::move(new_columns);
+      this->keys_sp[sp] = new_keys;
+    }
   };
 
   /**
@@ -457,7 +434,6 @@ namespace rascal {
     j["name"] = internal::type_name_demangled(
         typeid(SparsePointsBlockSparse<Calculator>).name());
     j["values"] = sparse_points.values;
-    j["indices"] = sparse_points.indices;
     j["counters"] = sparse_points.counters;
     j["inner_size"] = sparse_points.inner_size;
     j["center_species"] = sparse_points.center_species;
@@ -469,14 +445,19 @@ namespace rascal {
    * Function used to read from the JSON file, given the keywords and convert
    * the data into standard types. Overload of the function defined in
    * json.hpp class header.
+   *
+   * The former format, where the features were stored per [sp][key] with the
+   * indices of the pseudo points in each bin, is converted to the dense
+   * layout.
    */
   template <class Calculator>
   void from_json(const json & j,
                  SparsePointsBlockSparse<Calculator> & sparse_points) {
     using Data_t = typename SparsePointsBlockSparse<Calculator>::Data_t;
-    using Indices_t = typename SparsePointsBlockSparse<Calculator>::Indices_t;
     using Counters_t = typename SparsePointsBlockSparse<Calculator>::Counters_t;
     using Key_t = typename SparsePointsBlockSparse<Calculator>::Key_t;
+    using LegacyData_t = std::map<int, std::map<Key_t, std::vector<double>>>;
+    using LegacyIndices_t = std::map<int, std::map<Key_t, std::vector<size_t>>>;
 
     std::string name{internal::type_name_demangled(
         typeid(SparsePointsBlockSparse<Calculator>).name())};
@@ -486,14 +467,49 @@ namespace rascal {
               << name << "' != '" << j.at("name").get<std::string>() << "'.";
       throw std::runtime_error(err_str.str());
     }
-    sparse_points.values = j.at("values").get<Data_t>();
-    sparse_points.indices = j.at("indices").get<Indices_t>();
     sparse_points.counters = j.at("counters").get<Counters_t>();
     sparse_points.inner_size = j.at("inner_size").get<size_t>();
     sparse_points.center_species = j.at("center_species").get<std::set<int>>();
     sparse_points.keys = j.at("keys").get<std::set<Key_t>>();
-    sparse_points.keys_sp =
-        j.at("keys_sp").get<std::map<int, std::set<Key_t>>>();
+    auto keys_sp{j.at("keys_sp").get<std::map<int, std::set<Key_t>>>()};
+    sparse_points.values.clear();
+    sparse_points.key_columns.clear();
+    sparse_points.keys_sp.clear();
+    if (j.count("indices") == 0) {
+      sparse_points.values = j.at("values").get<Data_t>();
+      for (const auto & sp_keys : keys_sp) {
+        const int & sp{sp_keys.first};
+        auto & columns = sparse_points.key_columns[sp];
+        for (const auto & key : sp_keys.second) {
+          columns.emplace(key, columns.size() * sparse_points.inner_size);
+        }
+      }
+      sparse_points.keys_sp = std::move(keys_sp);
+      return;
+    }
+    // former format
+    const auto values{j.at("values").get<LegacyData_t>()};
+    const auto indices{j.at("indices").get<LegacyIndices_t>()};
+    const auto inner{static_cast<Eigen::Index>(sparse_points.inner_size)};
+    for (const auto & sp_keys : keys_sp) {
+      const int & sp{sp_keys.first};
+      sparse_points.set_keys_by_species(sp, sp_keys.second);
+      auto & values_by_sp = sparse_points.values.at(sp);
+      Eigen::Map<math::Matrix_t> T_sp{
+          values_by_sp.data(),
+          static_cast<Eigen::Index>(sparse_points.counters.at(sp)),
+          static_cast<Eigen::Index>(sp_keys.second.size()) * inner};
+      for (const auto & key : sp_keys.second) {
+        const auto & indices_by_sp_key = indices.at(sp).at(key);
+        Eigen::Map<const math::Matrix_t> block{
+            values.at(sp).at(key).data(),
+            static_cast<Eigen::Index>(indices_by_sp_key.size()), inner};
+        const auto col{sparse_points.get_key_column(sp, key)};
+        for (size_t ii{0}; ii < indices_by_sp_key.size(); ++ii) {
+          T_sp.block(indices_by_sp_key[ii], col, 1, inner) = block.row(ii);
+        }
+      }
+    }
   }
 
 }  // namespace rascal
@@ -34,6 +34,7 @@
 #include <Eigen/Dense>
 
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -41,6 +42,8 @@
 
 namespace rascal {
 
+  class FeatureCache;
+
   class CalculatorBase {
    public:
     //! type for the hyper parameter class
@@ -61,7 +64,8 @@ namespace rascal {
     CalculatorBase(CalculatorBase && other) noexcept
         : name{std::move(other.name)}, default_prefix{std::move(
                                            other.default_prefix)},
-          hypers{}, options{std::move(other.options)} {
+          hypers{}, options{std::move(other.options)},
+          feature_cache{std::move(other.feature_cache)} {
       this->hypers = std::move(other.hypers);
     }
 
@@ -131,6 +135,19 @@ namespace rascal {
     //! returns a string representation of the current hypers dict
     std::string get_hypers_string();
 
+    /**
+     * Persist the computed representations in feature_cache and load them
+     * from it when the same structure is computed again with the same
+     * hypers. Pass a nullptr to disable the cache.
+     */
+    void set_feature_cache(std::shared_ptr<FeatureCache> feature_cache) {
+      this->feature_cache = std::move(feature_cache);
+    }
+
+    const std::shared_ptr<FeatureCache> & get_feature_cache() const {
+      return this->feature_cache;
+    }
+
     //! name of the calculator
     std::string name{""};
     //! default prefix of the calculator
@@ -141,6 +158,9 @@ namespace rascal {
     //! stores the hyperparameters that change
     //! the behaviour of the representation
     std::map<std::string, std::string> options{};
+
+    //! optional on-disk cache of the computed representations
+    std::shared_ptr<FeatureCache> feature_cache{};
   };
 
 }  // namespace rascal
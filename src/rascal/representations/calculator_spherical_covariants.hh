@@ -34,6 +34,7 @@
 #include "rascal/representations/calculator_base.hh"
 #include "rascal/representations/calculator_spherical_expansion.hh"
 #include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/representations/coupling_cache.hh"
 #include "rascal/structure_managers/property.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager.hh"
@@ -51,106 +52,6 @@ namespace rascal {
 
   namespace internal {
     enum class SphericalCovariantsType { LambdaSpectrum };
-
-    inline Eigen::ArrayXd precompute_wigner_3js(size_t max_angular,
-                                                bool inversion_symmetry,
-                                                size_t lambda) {
-      Eigen::ArrayXd wigner_3js{};
-      // get the number of non zero elements in the w3j
-      // Use the well-known selection rules for the Wigner 3j symbols
-      int n_elements{0};
-      size_t l3{lambda};
-      for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
-        for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
-          // Triangle rule
-          if (l1 < static_cast<size_t>(std::abs<int>(l2 - l3)) ||
-              l1 > l2 + l3) {
-            continue;
-          }
-          if (inversion_symmetry) {
-            if ((l1 + l2 + l3) % 2 == 1) {
-              continue;
-            }
-          }
-          for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-            int m1s{static_cast<int>(m1 - l1)};
-            for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-              int m2s{static_cast<int>(m2 - l2)};
-              for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                int m3s{static_cast<int>(m3 - l3)};
-                // Selection rule for m
-                if ((m1s + m2s + m3s != 0) && (m1s + m2s - m3s != 0)) {
-                  continue;
-                }
-                ++n_elements;
-              }
-            }
-          }
-        }
-      }
-
-      wigner_3js.resize(n_elements);
-      n_elements = 0;
-      wig_table_init(2 * (max_angular + 1), 3);
-      wig_temp_init(2 * (max_angular + 1));
-      for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
-        for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
-          if ((l1 < static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-              (l1 > l2 + l3)) {
-            continue;
-          }
-          if (inversion_symmetry) {
-            if ((l1 + l2 + l3) % 2 == 1) {
-              continue;
-            }
-          }
-
-          // NB: the order of this loop MATTERS because it mirrors the
-          // order of evaluation of the covariants further down
-          for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-            int m3s{static_cast<int>(m3 - l3)};
-            for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-              int m1s{static_cast<int>(m1 - l1)};
-              for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                int m2s{static_cast<int>(m2 - l2)};
-                if ((m1s + m2s + m3s != 0) && (m1s + m2s - m3s != 0)) {
-                  continue;
-                }
-                double w3j1{
-                    wig3jj(2 * l1, 2 * l2, 2 * l3, 2 * m1s, 2 * m2s, 2 * m3s)};
-                double w3j2{
-                    wig3jj(2 * l1, 2 * l2, 2 * l3, 2 * m1s, 2 * m2s, -2 * m3s)};
-                if (m3s > 0) {
-                  wigner_3js(n_elements) =
-                      (w3j2 + math::pow(-1, m3s) * w3j1) * math::INV_SQRT_TWO;
-                } else if (m3s < 0) {
-                  wigner_3js(n_elements) =
-                      ((w3j1 - math::pow(-1, m3s) * w3j2)) * math::INV_SQRT_TWO;
-                } else if (m3s == 0) {
-                  wigner_3js(n_elements) = w3j1;
-                }
-                // change to the following for agreement with SOAPFAST
-                // (different definition of the real spherical harmonics)
-                /*
-                if (m3s > 0) { wigner_3js.push_back((w3j1 + pow(-1,
-                m3s)*w3j2)/sqrt(2.0)); } else if (m3s == 0) {
-                wigner_3js.push_back(w3j1); } else if (m3s < 0) {
-                wigner_3js.push_back(((w3j2 - pow(-1,
-                m3s)*w3j1))/sqrt(2.0));
-                }
-                */
-                ++n_elements;
-              }
-            }
-          }
-        }
-      }
-      wig_temp_free();
-      wig_table_free();
-
-      return wigner_3js;
-    }
-
   }  // namespace internal
 
   class CalculatorSphericalCovariants : public CalculatorBase {
@@ -190,7 +91,8 @@ namespace rascal {
                                                 other.max_radial)},
           max_angular{std::move(other.max_angular)}, rep_expansion{std::move(
                                                          other.rep_expansion)},
-          type{std::move(other.type)}, wigner_3js{std::move(other.wigner_3js)},
+          type{std::move(other.type)}, wigner_couplings{std::move(
+                                            other.wigner_couplings)},
           inversion_symmetry{std::move(other.inversion_symmetry)},
           lambda{std::move(other.lambda)}, normalize{
                                                std::move(other.normalize)} {}
@@ -211,7 +113,8 @@ namespace rascal {
               this->max_angular == other.max_angular and
               this->rep_expansion == other.rep_expansion and
               this->type == other.type and
-              (this->wigner_3js.array() == other.wigner_3js.array()).all() and
+              internal::has_same_couplings(this->wigner_couplings,
+                                           other.wigner_couplings) and
               this->inversion_symmetry == other.inversion_symmetry and
               this->lambda == other.lambda and
               this->normalize == other.normalize);
@@ -228,9 +131,9 @@ namespace rascal {
 
       if (soap_type == "LambdaSpectrum") {
         this->type = SphericalCovariantsType::LambdaSpectrum;
-        this->wigner_3js = internal::precompute_wigner_3js(
-            this->max_angular, this->inversion_symmetry, this->lambda);
-
+        this->wigner_couplings =
+            CouplingCache::get_instance().get_lambda_spectrum_table(
+                this->max_angular, this->inversion_symmetry, this->lambda);
       } else {
         throw std::logic_error("Requested Spherical Covariants type '" +
                                soap_type +
@@ -303,8 +206,8 @@ namespace rascal {
     CalculatorSphericalExpansion rep_expansion;
     internal::SphericalCovariantsType type{};
 
-    /// precomputed wigner symbols
-    Eigen::ArrayXd wigner_3js{};
+    /// couplings of the real coefficients for the LambdaSpectrum
+    CouplingCache::Table_t wigner_couplings{};
 
     bool inversion_symmetry{false};
     size_t lambda{0};
@@ -331,35 +234,10 @@ namespace rascal {
     using math::pow;
 
     size_t n_row{pow(this->max_radial, 2_size_t)};
-    // number of combinations of l1 and l2 satisfying the triangle constraint
-    size_t n_col{0};
-    if (this->inversion_symmetry == false) {
-      n_col = static_cast<size_t>(
-          (2 + this->lambda - 3 * pow(this->lambda, 2_size_t) +
-           2 * this->max_angular + 4 * this->lambda * this->max_angular) /
-          2 * (2 * this->lambda + 1));
-    } else {
-      n_col =
-          static_cast<size_t>(
-              std::ceil(pow(this->max_angular + 1, 2_size_t) / 2.0) -
-              pow(1.0 + std::floor((this->lambda - 1) / 2.0), 2) -
-              std::floor(pow(this->max_angular + 1 - this->lambda, 2_size_t) /
-                         2.0) *
-                  (this->lambda % 2) -
-              (std::ceil(pow(this->max_angular + 1 - this->lambda, 2_size_t) /
-                         2.0) -
-               (this->max_angular - this->lambda + 1)) *
-                  (1.0 - this->lambda % 2)) *
-          (2 * this->lambda + 1);
-      if (this->lambda % 2 == 1) {
-        n_col = static_cast<size_t>(
-            0.5 *
-                (2 + this->lambda - 3 * pow(this->lambda, 2_size_t) +
-                 2 * this->max_angular + 4 * this->lambda * this->max_angular) *
-                (2 * this->lambda + 1) -
-            static_cast<int>(n_col));
-      }
-    }
+    // one block of 2 lambda + 1 components per combination of l1 and l2
+    // satisfying the triangle constraint
+    size_t n_col{this->wigner_couplings->blocks.size() *
+                 (2 * this->lambda + 1)};
 
     // clear the data container and resize it
     soap_vectors.clear();
@@ -404,7 +282,6 @@ namespace rascal {
     using Prop_t = Property_t<StructureManager>;
     using internal::SphericalCovariantsType;
     using math::pow;
-    using complex = std::complex<double>;
 
     // Compute the spherical expansions of the current structure
     rep_expansion.compute(manager);
@@ -424,6 +301,8 @@ namespace rascal {
     this->initialize_per_center_lambda_soap_vectors(
         soap_vectors, expansions_coefficients, manager);
 
+    const auto & couplings{this->wigner_couplings->couplings};
+    const auto & blocks{this->wigner_couplings->blocks};
     Key_t p_type{0, 0};
     internal::SortedKey<Key_t> pair_type{p_type};
 
@@ -438,7 +317,7 @@ namespace rascal {
           pair_type[1] = el2.first[0];
           auto & coef2{el2.second};
 
-          size_t & l3{this->lambda};
+          const size_t & l3{this->lambda};
           if (soap_vector.count(pair_type) == 1) {
             auto && soap_vector_by_type{soap_vector[pair_type]};
 
@@ -446,89 +325,17 @@ namespace rascal {
             for (size_t n1{0}; n1 < this->max_radial; n1++) {
               for (size_t n2{0}; n2 < this->max_radial; n2++) {
                 size_t l0{0};
-                int wigner_count{0};
-                for (size_t l1{0}; l1 < this->max_angular + 1; l1++) {
-                  for (size_t l2{0}; l2 < this->max_angular + 1; l2++) {
-                    if ((l1 < static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-                        (l1 > l2 + l3)) {
-                      continue;
-                    }
-                    if (this->inversion_symmetry == true) {
-                      if ((l1 + l2 + l3) % 2 == 1) {
-                        continue;
-                      }
-                    }
-                    for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                      int m3s{static_cast<int>(m3 - l3)};
-                      for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-                        int m1s{static_cast<int>(m1 - l1)};
-                        size_t lm1{pow(l1, 2_size_t) + m1};
-                        for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                          int m2s{static_cast<int>(m2 - l2)};
-
-                          if ((m1s + m2s + m3s != 0) &&
-                              (m1s + m2s - m3s != 0)) {
-                            continue;
-                          }
-                          size_t lm2{pow(l2, 2_size_t) + m2};
-                          complex coef1c, coef2c;
-                          double w3j = this->wigner_3js[wigner_count];
-                          // usual formulae for converting from real to complex
-                          // These are the inverses of the formulae we used to
-                          // define the real spherical harmonics in
-                          // src/math/spherical_harmonics.hh
-                          if (m1s > 0) {
-                            coef1c = pow(-1.0, m1s) *
-                                     complex(coef1(n1, lm1),
-                                             coef1(n1, lm1 - 2 * m1s));
-                          } else if (m1s == 0) {
-                            coef1c =
-                                complex(coef1(n1, lm1), 0.0) * math::SQRT_TWO;
-                          } else if (m1s < 0) {
-                            coef1c = complex(coef1(n1, lm1 - 2 * m1s),
-                                             -coef1(n1, lm1));
-                          }
-                          if (m2s > 0) {
-                            coef2c = pow(-1.0, m2s) *
-                                     complex(coef2(n2, lm2),
-                                             coef2(n2, lm2 - 2 * m2s));
-                          } else if (m2s == 0) {
-                            coef2c =
-                                complex(coef2(n2, lm2), 0.0) * math::SQRT_TWO;
-                          } else if (m2s < 0) {
-                            coef2c = complex{coef2(n2, lm2 - 2 * m2s),
-                                             -coef2(n2, lm2)};
-                          }
-                          coef1c *= math::INV_SQRT_TWO;
-                          coef2c *= math::INV_SQRT_TWO;
-
-                          // combine the coefficients with Wigner 3j symbols
-                          // TODO(andrea, michael) avoid complex arithmetic
-                          complex i_unit{0.0, 1.0};
-                          if ((l1 + l2 + l3) % 2 == 0) {
-                            if (m3s < 0) {
-                              soap_vector_by_type(nn, l0) +=
-                                  w3j * (i_unit * coef1c * coef2c).real();
-                            } else {
-                              soap_vector_by_type(nn, l0) +=
-                                  w3j * (coef1c * coef2c).real();
-                            }
-                          } else if (this->inversion_symmetry == false) {
-                            if (m3s < 0) {
-                              soap_vector_by_type(nn, l0) +=
-                                  w3j * (i_unit * coef1c * coef2c).imag();
-                            } else {
-                              soap_vector_by_type(nn, l0) +=
-                                  w3j * (coef1c * coef2c).imag();
-                            }
-                          }
-                          wigner_count++;
-                        }  // m2
-                      }    // m1
-                      l0++;
-                    }  // m3
-                  }    // l2
-                }      // l1
+                for (const auto & block : blocks) {
+                  const double * coef1_l{&coef1(n1, pow(block.l1, 2_size_t))};
+                  const double * coef2_l{&coef2(n2, pow(block.l2, 2_size_t))};
+                  for (size_t i_c{block.begin}; i_c < block.end; ++i_c) {
+                    const auto & coupling{couplings[i_c]};
+                    soap_vector_by_type(nn, l0 + coupling.m3) +=
+                        coupling.value * coef1_l[coupling.m1] *
+                        coef2_l[coupling.m2];
+                  }
+                  l0 += 2 * l3 + 1;
+                }  // block
                 nn++;
               }  // n2
             }    // n1
@@ -38,6 +38,7 @@
 #include "rascal/math/utils.hh"
 #include "rascal/representations/calculator_base.hh"
 #include "rascal/representations/cutoff_functions.hh"
+#include "rascal/representations/spline_cache.hh"
 #include "rascal/structure_managers/make_structure_manager.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager.hh"
@@ -50,9 +51,13 @@
 #include <array>
 #include <cmath>
 #include <exception>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace rascal {
@@ -251,6 +256,15 @@ namespace rascal {
         return Matrix_Ref(Matrix_t::Zero());
       }
 
+      /**
+       * Called with the distances of all the neighbours of a center, in the
+       * order they are then passed to compute_neighbour_contribution, so
+       * that their contributions can be evaluated all at once. Does nothing
+       * by default.
+       */
+      void precompute_neighbour_contributions(
+          const Vector_Ref & /*distances*/) {}
+
       /**
        * Compute the radial derivative of the neighbour contribution
        *
@@ -290,6 +304,13 @@ namespace rascal {
                                  "implemented in a derived class");
         return Matrix_Ref(Matrix_t::Zero());
       }
+
+      /**
+       * True when the neighbour contribution and its derivative already
+       * include the cutoff function, i.e. they are R_nl(r) f_c(r) and its
+       * derivative, so the cutoff function must not be applied again.
+       */
+      bool includes_cutoff_function{false};
     };
 
     template <RadialBasisType RBT>
@@ -543,8 +564,10 @@ namespace rascal {
               (this->a_b_l_n.col(angular_l - 1).array() * a_b_l).matrix();
         }
 
-        this->hyp1f1_calculator.calc(distance, fac_a, this->fac_b,
-                                     this->compute_gradients);
+        if (not this->load_neighbour_from_batch(distance, fac_a)) {
+          this->hyp1f1_calculator.calc(distance, fac_a, this->fac_b,
+                                       this->compute_gradients);
+        }
 
         this->radial_integral_neighbour =
             (this->a_b_l_n.array() *
@@ -555,6 +578,23 @@ namespace rascal {
         return Matrix_Ref(this->radial_integral_neighbour);
       }
 
+      using RadialContributionBase::precompute_neighbour_contributions;
+
+      /**
+       * Evaluate the 1F1 of the neighbour contributions for all the
+       * distances at once, they are then used by
+       * compute_neighbour_contribution when it is called with the same
+       * distances in the same order.
+       */
+      void precompute_neighbour_contributions(const Vector_Ref & distances,
+                                              const double fac_a) {
+        this->hyp1f1_calculator.calc(distances, fac_a, this->fac_b,
+                                     this->compute_gradients);
+        this->batch_distances = distances;
+        this->batch_fac_a = fac_a;
+        this->i_batch = 0;
+      }
+
       //! Compute the radial derivative of the neighbour contribution
       template <size_t Order, size_t Layer>
       Matrix_Ref
@@ -691,9 +731,31 @@ namespace rascal {
         return Matrix_Ref(this->radial_neighbour_derivative);
       }
 
+      /**
+       * Load the 1F1 of distance from the last batch if it is the next
+       * distance of the batch.
+       */
+      bool load_neighbour_from_batch(const double distance,
+                                     const double fac_a) {
+        if (this->i_batch < this->batch_distances.size() and
+            this->batch_distances(this->i_batch) == distance and
+            this->batch_fac_a == fac_a) {
+          this->hyp1f1_calculator.set_from_batch(this->i_batch);
+          ++this->i_batch;
+          return true;
+        }
+        // the batch does not match the neighbours anymore
+        this->batch_distances.resize(0);
+        return false;
+      }
+
       std::shared_ptr<AtomicSmearingSpecificationBase> atomic_smearing{};
       AtomicSmearingType atomic_smearing_type{};
       math::Hyp1f1SphericalExpansion hyp1f1_calculator{true, 1e-13, 200};
+      // distances of the batch evaluated by the hyp1f1_calculator
+      Vector_t batch_distances{};
+      double batch_fac_a{0.};
+      int i_batch{0};
       // data member used to store the contributions to the expansion
       Matrix_t radial_integral_neighbour{};
       Vector_t radial_integral_center{};
@@ -879,7 +941,9 @@ namespace rascal {
         using math::pow;
         using std::sqrt;
 
-        this->bessel.calc(distance, fac_a);
+        if (not this->load_neighbour_from_batch(distance, fac_a)) {
+          this->bessel.calc(distance, fac_a);
+        }
 
         this->radial_integral_neighbour =
             this->legendre_radial_factor.asDiagonal() *
@@ -888,6 +952,22 @@ namespace rascal {
         return Matrix_Ref(this->radial_integral_neighbour);
       }
 
+      using RadialContributionBase::precompute_neighbour_contributions;
+
+      /**
+       * Evaluate the modified spherical Bessel functions of the neighbour
+       * contributions for all the distances at once, they are then used by
+       * compute_neighbour_contribution (and compute_neighbour_derivative)
+       * when it is called with the same distances in the same order.
+       */
+      void precompute_neighbour_contributions(const Vector_Ref & distances,
+                                              const double fac_a) {
+        this->bessel.calc(distances, fac_a);
+        this->batch_distances = distances;
+        this->batch_fac_a = fac_a;
+        this->i_batch = 0;
+      }
+
       //! Compute the radial derivative of the neighbour contribution
       template <size_t Order, size_t Layer>
       Matrix_Ref
@@ -912,7 +992,29 @@ namespace rascal {
       void finalize_coefficients_der(Coeffs & /*coefficients_gradient*/,
                                      Center & /*center*/) const {}
 
+      /**
+       * Load the Bessel functions of distance from the last batch if it is
+       * the next distance of the batch.
+       */
+      bool load_neighbour_from_batch(const double distance,
+                                     const double fac_a) {
+        if (this->i_batch < this->batch_distances.size() and
+            this->batch_distances(this->i_batch) == distance and
+            this->batch_fac_a == fac_a) {
+          this->bessel.set_from_batch(this->i_batch);
+          ++this->i_batch;
+          return true;
+        }
+        // the batch does not match the neighbours anymore
+        this->batch_distances.resize(0);
+        return false;
+      }
+
       math::ModifiedSphericalBessel bessel{};
+      // distances of the batch evaluated by bessel
+      Vector_t batch_distances{};
+      double batch_fac_a{0.};
+      int i_batch{0};
 
       std::shared_ptr<AtomicSmearingSpecificationBase> atomic_smearing{};
       AtomicSmearingType atomic_smearing_type{};
@@ -981,6 +1083,10 @@ namespace rascal {
         return Parent::compute_neighbour_contribution(this->fac_a);
       }
 
+      void precompute_neighbour_contributions(const Vector_Ref & distances) {
+        Parent::precompute_neighbour_contributions(distances, this->fac_a);
+      }
+
       template <size_t Order, size_t Layer>
       Matrix_Ref
       compute_neighbour_derivative(const double distance,
@@ -1012,6 +1118,298 @@ namespace rascal {
       double fac_a{};
     };
 
+    /**
+     * Cutoff function to tabulate in the splines of the radial contribution.
+     *
+     * The splines then tabulate R_nl(r) f_c(r) and the spline derivative
+     * gives the derivative of the product so the cutoff function does not
+     * have to be evaluated and applied for each pair. f_c is only continuously
+     * differentiable at the boundaries of the smoothing region
+     * [cutoff - smooth_width, cutoff] so it is split in two smooth functions:
+     * inner is used below smoothing_begin = cutoff - smooth_width and outer,
+     * a smooth continuation of f_c, above. Each of them is tabulated in its
+     * own spline and the two splines share smoothing_begin as a grid point.
+     * Their second derivatives there are set to the ones of inner and outer
+     * so the accuracy of the derivative is the same as without the cutoff
+     * function.
+     */
+    struct SplinedCutoffFunction {
+      //! f_c(r) for r <= smoothing_begin, empty if f_c is not splined
+      std::function<double(double)> inner{};
+      //! smooth continuation of f_c(r) for r > smoothing_begin, if any
+      std::function<double(double)> outer{};
+      //! cutoff - smooth_width when outer is set
+      double smoothing_begin{std::numeric_limits<double>::infinity()};
+      double smooth_width{0.};
+
+      bool is_splined() const { return static_cast<bool>(this->inner); }
+
+      /**
+       * Only keep the functions needed to tabulate f_c on
+       * [range_begin, range_end], i.e. outer alone when the smoothing region
+       * covers the whole range and inner alone when it is outside of it.
+       */
+      void restrict_to(const double range_begin, const double range_end) {
+        if (not this->outer) {
+          return;
+        }
+        if (this->smoothing_begin <= range_begin) {
+          this->inner = this->outer;
+        }
+        if (this->smoothing_begin <= range_begin or
+            this->smoothing_begin >= range_end) {
+          this->outer = nullptr;
+          this->smoothing_begin = std::numeric_limits<double>::infinity();
+        }
+      }
+
+      //! step of the finite differences of the boundary conditions
+      double get_finite_difference_step() const {
+        return 1e-3 * this->smooth_width;
+      }
+    };
+
+    /**
+     * Returns the cutoff function to tabulate in the splines of the radial
+     * contribution when "include_cutoff_function" is true in the Spline
+     * optimization hypers, and an empty one otherwise.
+     *
+     * @throw logic_error if the cutoff function diverges at r = 0, i.e.
+     *        RadialScaling with rate == 0, since it cannot be splined
+     */
+    template <class Hypers>
+    SplinedCutoffFunction get_splined_cutoff_function(const Hypers & hypers) {
+      SplinedCutoffFunction splined_cutoff_function{};
+      auto spline_hypers = hypers.at("radial_contribution")
+                               .at("optimization")
+                               .at("Spline")
+                               .template get<json>();
+      if (not(spline_hypers.count("include_cutoff_function") and
+              spline_hypers.at("include_cutoff_function")
+                  .template get<bool>())) {
+        return splined_cutoff_function;
+      }
+      auto fc_hypers = hypers.at("cutoff_function").template get<json>();
+      auto fc_type = fc_hypers.at("type").template get<std::string>();
+      double cutoff{fc_hypers.at("cutoff").at("value").template get<double>()};
+      double smooth_width{
+          fc_hypers.at("smooth_width").at("value").template get<double>()};
+      // radial scaling factor of f_c
+      std::function<double(double)> scaling{};
+      if (fc_type == "ShiftedCosine") {
+        scaling = [](const double) { return 1.; };
+      } else if (fc_type == "RadialScaling") {
+        auto cutoff_function = std::make_shared<
+            CutoffFunction<CutoffFunctionType::RadialScaling>>(fc_hypers);
+        if (std::abs(cutoff_function->rate) <= math::DBL_FTOL) {
+          throw std::logic_error("RadialScaling with rate == 0 diverges at "
+                                 "r = 0 and can't be included in the Spline.");
+        }
+        scaling = [cutoff_function](const double distance) {
+          return cutoff_function->value(distance);
+        };
+      } else {
+        throw std::logic_error("Requested cutoff function type \'" + fc_type +
+                               "\' can't be included in the Spline.");
+      }
+      splined_cutoff_function.inner = scaling;
+      if (smooth_width > 0.) {
+        splined_cutoff_function.outer = [scaling, cutoff,
+                                         smooth_width](const double distance) {
+          return scaling(distance) * switching_function_cosine_continued(
+                                         distance, cutoff, smooth_width);
+        };
+        splined_cutoff_function.smoothing_begin = cutoff - smooth_width;
+        splined_cutoff_function.smooth_width = smooth_width;
+      }
+      return splined_cutoff_function;
+    }
+
+    /**
+     * Number of threads evaluating the radial contribution while its splines
+     * are refined, "n_threads" in the Spline optimization hypers, 1 by
+     * default and 0 for as many as the hardware supports.
+     */
+    template <class Hypers>
+    size_t get_spline_n_threads(const Hypers & hypers) {
+      auto spline_hypers = hypers.at("radial_contribution")
+                               .at("optimization")
+                               .at("Spline")
+                               .template get<json>();
+      if (not spline_hypers.count("n_threads")) {
+        return 1;
+      }
+      int n_threads{spline_hypers.at("n_threads").template get<int>()};
+      if (n_threads < 0) {
+        std::stringstream err_str{};
+        err_str << "The number of threads of the Spline must be positive or "
+                   "0, got: "
+                << n_threads;
+        throw std::logic_error(err_str.str());
+      }
+      return static_cast<size_t>(n_threads);
+    }
+
+    /**
+     * Number of segments of the piecewise uniform grid of the splines of the
+     * radial contribution, "n_segments" in the Spline optimization hypers, 1
+     * by default. The grid of each segment is refined separately so the
+     * radial contribution is tabulated more finely where it varies quickly.
+     */
+    template <class Hypers>
+    int get_spline_nb_segments(const Hypers & hypers) {
+      auto spline_hypers = hypers.at("radial_contribution")
+                               .at("optimization")
+                               .at("Spline")
+                               .template get<json>();
+      if (not spline_hypers.count("n_segments")) {
+        return 1;
+      }
+      int nb_segments{spline_hypers.at("n_segments").template get<int>()};
+      if (nb_segments < 1) {
+        std::stringstream err_str{};
+        err_str << "The number of segments of the Spline must be at least 1, "
+                   "got: "
+                << nb_segments;
+        throw std::logic_error(err_str.str());
+      }
+      return nb_segments;
+    }
+
+    /**
+     * Radial contributions to evaluate the function tabulated in the splines
+     * of a radial contribution handler from several threads. The radial
+     * contributions keep their intermediate results in data members so each
+     * evaluation borrows one that no other thread is using: the handler
+     * itself or, when it is busy, a radial contribution of its own built
+     * from the same hypers.
+     */
+    template <RadialBasisType RBT>
+    class RadialContributionPool {
+     public:
+      using Contribution_t = RadialContribution<RBT>;
+
+      explicit RadialContributionPool(Contribution_t & handler)
+          : hypers(handler.hypers), available{&handler} {}
+
+      /**
+       * @return func(contribution) with a radial contribution no other
+       *         thread uses during the call
+       */
+      template <class Func>
+      auto evaluate(Func && func)
+          -> decltype(func(std::declval<Contribution_t &>())) {
+        Contribution_t * contribution{this->acquire()};
+        try {
+          auto result = func(*contribution);
+          this->release(contribution);
+          return result;
+        } catch (...) {
+          this->release(contribution);
+          throw;
+        }
+      }
+
+     protected:
+      Contribution_t * acquire() {
+        {
+          std::lock_guard<std::mutex> lock{this->mutex};
+          if (not this->available.empty()) {
+            Contribution_t * contribution{this->available.back()};
+            this->available.pop_back();
+            return contribution;
+          }
+        }
+        // built outside of the lock since it is as expensive as a few
+        // evaluations
+        auto contribution{std::make_unique<Contribution_t>(this->hypers)};
+        contribution->precompute();
+        std::lock_guard<std::mutex> lock{this->mutex};
+        this->owned.push_back(std::move(contribution));
+        return this->owned.back().get();
+      }
+
+      void release(Contribution_t * contribution) {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        this->available.push_back(contribution);
+      }
+
+      json hypers;
+      std::vector<Contribution_t *> available;
+      std::vector<std::unique_ptr<Contribution_t>> owned{};
+      std::mutex mutex{};
+    };
+
+    /**
+     * Initialize the splines of a radial contribution handler by calling
+     * init() unless they can be found in the SplineCache. The cache is used
+     * when "cache" is true or "cache_directory" is given in the Spline
+     * optimization hypers, the latter to also store the splines on disk.
+     * The splines are keyed by the hypers the radial contribution depends on
+     * and by the range and accuracy of the splines.
+     *
+     * @param write appends the splines to a BinaryWriter
+     * @param read reads the splines back from a BinaryReader, it throws
+     *        if the data is invalid and the splines are then recomputed
+     */
+    template <class Hypers, class Init, class Write, class Read>
+    void init_splines_with_cache(const Hypers & hypers,
+                                 const double range_begin,
+                                 const double range_end, const double accuracy,
+                                 Init && init, Write && write, Read && read) {
+      auto spline_hypers = hypers.at("radial_contribution")
+                               .at("optimization")
+                               .at("Spline")
+                               .template get<json>();
+      bool use_cache{spline_hypers.count("cache") and
+                     spline_hypers.at("cache").template get<bool>()};
+      std::string directory{};
+      if (spline_hypers.count("cache_directory")) {
+        directory =
+            spline_hypers.at("cache_directory").template get<std::string>();
+        use_cache = true;
+      }
+      if (not use_cache) {
+        init();
+        return;
+      }
+
+      json key_hypers{};
+      for (const char * name : {"max_radial", "max_angular", "gaussian_density",
+                                "cutoff_function", "radial_contribution"}) {
+        if (hypers.count(name)) {
+          key_hypers[name] = hypers.at(name);
+        }
+      }
+      auto & key_spline_hypers =
+          key_hypers["radial_contribution"]["optimization"]["Spline"];
+      key_spline_hypers.erase("cache");
+      key_spline_hypers.erase("cache_directory");
+      key_spline_hypers.erase("n_threads");
+      std::string key{key_hypers.dump()};
+      // the range is appended with all its bits
+      const double range[3] = {range_begin, range_end, accuracy};
+      key.append(reinterpret_cast<const char *>(range), sizeof(range));
+
+      auto & cache{SplineCache::get_instance()};
+      std::vector<char> blob{};
+      if (cache.load(key, blob, directory)) {
+        BinaryReader reader{blob.data(), blob.data() + blob.size()};
+        try {
+          read(reader);
+          if (reader.at_end()) {
+            return;
+          }
+        } catch (const std::exception &) {
+          // recompute and overwrite the invalid table
+        }
+      }
+      init();
+      BinaryWriter writer{};
+      write(writer);
+      cache.store(key, writer.buffer, directory);
+    }
+
     /* For the a constant smearing type the "a" factor can be precomputed and
      * when using the spline has to be initialized and used.
      */
@@ -1025,7 +1423,7 @@ namespace rascal {
       using Matrix_t = typename Parent::Matrix_t;
       using Matrix_Ref = typename Parent::Matrix_Ref;
       using Vector_Ref = typename Parent::Vector_Ref;
-      using Spline_t = math::InterpolatorMatrixUniformCubicSpline<
+      using Spline_t = math::InterpolatorMatrixPiecewiseUniformCubicSpline<
           math::RefinementMethod_t::Exponential>;
 
       explicit RadialContributionHandler(const Hypers_t & hypers)
@@ -1056,7 +1454,16 @@ namespace rascal {
       Matrix_Ref compute_neighbour_contribution(
           const double distance, const ClusterRefKey<Order, Layer> & /*pair*/,
           int /*neighbour_type*/) {
-        this->radial_integral_neighbour = this->intp->interpolate(distance);
+        auto & intp{this->get_interpolator(distance)};
+        if (this->compute_gradients) {
+          // the derivative is interpolated together with the contribution
+          // and compute_neighbour_derivative only returns it
+          intp.interpolate_with_derivative(distance,
+                                           this->radial_integral_neighbour,
+                                           this->radial_neighbour_derivative);
+        } else {
+          intp.interpolate_into(distance, this->radial_integral_neighbour);
+        }
         return Matrix_Ref(this->radial_integral_neighbour);
       }
 
@@ -1065,8 +1472,10 @@ namespace rascal {
       compute_neighbour_derivative(const double distance,
                                    const ClusterRefKey<Order, Layer> & /*pair*/,
                                    int /*neighbour_type*/) {
-        this->radial_neighbour_derivative =
-            this->intp->interpolate_derivative(distance);
+        if (not this->compute_gradients) {
+          this->get_interpolator(distance).interpolate_derivative_into(
+              distance, this->radial_neighbour_derivative);
+        }
         return Matrix_Ref(this->radial_neighbour_derivative);
       }
 
@@ -1114,23 +1523,104 @@ namespace rascal {
         // function
         double range_begin{math::SPHERICAL_BESSEL_FUNCTION_FTOL};
         double range_end{this->interaction_cutoff};
-        this->init_interpolator(range_begin, range_end, accuracy);
+        this->cutoff_function = get_splined_cutoff_function(hypers);
+        this->cutoff_function.restrict_to(range_begin, range_end);
+        this->includes_cutoff_function = this->cutoff_function.is_splined();
+        this->n_threads = get_spline_n_threads(hypers);
+        this->nb_segments = get_spline_nb_segments(hypers);
+        init_splines_with_cache(
+            hypers, range_begin, range_end, accuracy,
+            [&]() {
+              this->init_interpolator(range_begin, range_end, accuracy);
+            },
+            [&](BinaryWriter & writer) { this->write_interpolators(writer); },
+            [&](BinaryReader & reader) { this->read_interpolators(reader); });
       }
 
       void init_interpolator(const double range_begin, const double range_end,
                              const double accuracy) {
-        // "this" is passed by reference and is mutable
-        std::function<Matrix_t(double)> func{
-            [&](const double distance) mutable {
-              Parent::compute_neighbour_contribution(distance, this->fac_a);
-              Parent::finalize_radial_integral_neighbour();
-              return this->radial_integral_neighbour;
-            }};
+        auto & f_c = this->cutoff_function;
+        if (not f_c.outer) {
+          this->intp =
+              this->make_interpolator(range_begin, range_end, accuracy,
+                                      f_c.inner, false, this->nb_segments);
+        } else {
+          // f_c is only C1 at smoothing_begin so the splines on each side
+          // use the second derivatives of inner and outer there
+          this->intp = this->make_interpolator(range_begin, f_c.smoothing_begin,
+                                               accuracy, f_c.inner, false,
+                                               this->nb_segments);
+          this->intp_smoothing = this->make_interpolator(
+              f_c.smoothing_begin, range_end, accuracy, f_c.outer, true);
+        }
+      }
+
+      /**
+       * Spline of the radial contribution times f_c, if set, on
+       * [range_begin, range_end] split in nb_segments segments. When
+       * curvature_begin is true the second derivative of the function is
+       * used as boundary condition at range_begin instead of the natural one,
+       * and likewise at range_end whenever f_c is part of the smoothing of
+       * the cutoff function.
+       */
+      std::unique_ptr<Spline_t>
+      make_interpolator(const double range_begin, const double range_end,
+                        const double accuracy,
+                        const std::function<double(double)> & f_c,
+                        const bool curvature_begin = false,
+                        const int nb_segments = 1) {
+        RadialContributionPool<RBT> pool{*this};
+        std::function<Matrix_t(double)> func{[&](const double distance) {
+          return pool.evaluate([&](Parent & contribution) {
+            contribution.compute_neighbour_contribution(distance, this->fac_a);
+            contribution.finalize_radial_integral_neighbour();
+            Matrix_t value{contribution.radial_integral_neighbour};
+            if (f_c) {
+              value *= f_c(distance);
+            }
+            return value;
+          });
+        }};
         Matrix_t result = func(range_begin);
         int cols{static_cast<int>(result.cols())};
         int rows{static_cast<int>(result.rows())};
-        this->intp = std::make_unique<Spline_t>(func, range_begin, range_end,
-                                                accuracy, cols, rows);
+        // zeros are the natural boundary conditions
+        Matrix_t d2f_begin{Matrix_t::Zero(rows, cols)};
+        Matrix_t d2f_end{Matrix_t::Zero(rows, cols)};
+        if (this->cutoff_function.outer) {
+          double step{this->cutoff_function.get_finite_difference_step()};
+          if (curvature_begin) {
+            d2f_begin = math::second_derivative_central_difference(
+                func, range_begin, step);
+          }
+          d2f_end =
+              math::second_derivative_central_difference(func, range_end, step);
+        }
+        return std::make_unique<Spline_t>(
+            func, range_begin, range_end, accuracy, cols, rows, d2f_begin,
+            d2f_end, nb_segments, 100000, 5, this->n_threads);
+      }
+
+      void write_interpolators(BinaryWriter & writer) {
+        write_spline(writer, *this->intp);
+        if (this->cutoff_function.outer) {
+          write_spline(writer, *this->intp_smoothing);
+        }
+      }
+
+      void read_interpolators(BinaryReader & reader) {
+        this->intp = read_spline<Spline_t>(reader);
+        if (this->cutoff_function.outer) {
+          this->intp_smoothing = read_spline<Spline_t>(reader);
+        }
+      }
+
+      //! spline tabulating the radial contribution at distance
+      Spline_t & get_interpolator(const double distance) {
+        if (distance > this->cutoff_function.smoothing_begin) {
+          return *this->intp_smoothing;
+        }
+        return *this->intp;
       }
 
       double get_interpolator_accuracy(const Hypers_t & optimization_hypers) {
@@ -1151,7 +1641,15 @@ namespace rascal {
       }
 
       double fac_a{};
+      //! cutoff function tabulated in the splines, if any
+      SplinedCutoffFunction cutoff_function{};
       std::unique_ptr<Spline_t> intp{};
+      //! spline used in the smoothing region of the splined cutoff function
+      std::unique_ptr<Spline_t> intp_smoothing{};
+      //! threads evaluating the radial contribution to refine the splines
+      size_t n_threads{1};
+      //! number of segments of the piecewise uniform grid of the splines
+      int nb_segments{1};
     };
 
     /*
@@ -1174,7 +1672,7 @@ namespace rascal {
       using Vector_Ref = typename Parent::Vector_Ref;
       using Matrix_t = math::Matrix_t;
       using Vector_t = math::Vector_t;
-      using Spline_t = math::InterpolatorMatrixUniformCubicSpline<
+      using Spline_t = math::InterpolatorMatrixPiecewiseUniformCubicSpline<
           math::RefinementMethod_t::Exponential>;
 
       explicit RadialContributionHandler(const Hypers_t & hypers)
@@ -1368,8 +1866,15 @@ namespace rascal {
           const double distance, const ClusterRefKey<Order, Layer> & /*pair*/,
           int neighbour_type) {
         try {
-          this->radial_integral_neighbour =
-              this->intps.at(neighbour_type)->interpolate(distance);
+          auto & intp{this->get_interpolator(distance, neighbour_type)};
+          if (this->compute_gradients) {
+            // see compute_neighbour_derivative
+            intp.interpolate_with_derivative(
+                distance, this->radial_integral_neighbour,
+                this->radial_neighbour_derivative);
+          } else {
+            intp.interpolate_into(distance, this->radial_integral_neighbour);
+          }
           return Matrix_Ref(this->radial_integral_neighbour);
         } catch (const std::exception & e) {
           std::stringstream err_str{};
@@ -1386,8 +1891,13 @@ namespace rascal {
                                    const ClusterRefKey<Order, Layer> & /*pair*/,
                                    int neighbour_type) {
         try {
-          this->radial_neighbour_derivative =
-              this->intps[neighbour_type]->interpolate_derivative(distance);
+          // already interpolated with the contribution when the gradients
+          // are computed
+          if (not this->compute_gradients) {
+            this->get_interpolator(distance, neighbour_type)
+                .interpolate_derivative_into(distance,
+                                             this->radial_neighbour_derivative);
+          }
           return Matrix_Ref(this->radial_neighbour_derivative);
         } catch (const std::exception & e) {
           std::stringstream err_str{};
@@ -1418,13 +1928,23 @@ namespace rascal {
                                                 int neighbour_type) {
         Parent::compute_neighbour_contribution(distance, this->fac_a);
         Parent::finalize_radial_integral_neighbour();
+        this->project_radial_integral(this->radial_integral_neighbour,
+                                      neighbour_type,
+                                      this->reduced_radial_integral_neighbour);
+        return Matrix_Ref(this->reduced_radial_integral_neighbour);
+      }
+
+      //! projects each angular channel of radial_integral into reduced
+      void project_radial_integral(const Matrix_t & radial_integral,
+                                   int neighbour_type,
+                                   Matrix_t & reduced) const {
+        const auto & species_projections{
+            this->projection_matrices.at(neighbour_type)};
         for (size_t angular_l{0}; angular_l < this->max_angular + 1;
              ++angular_l) {
-          this->reduced_radial_integral_neighbour.col(angular_l) =
-              this->projection_matrices.at(neighbour_type).at(angular_l) *
-              this->radial_integral_neighbour.col(angular_l);
+          reduced.col(angular_l) = species_projections.at(angular_l) *
+                                   radial_integral.col(angular_l);
         }
-        return Matrix_Ref(this->reduced_radial_integral_neighbour);
       }
 
       void precompute_fac_a() {
@@ -1460,30 +1980,133 @@ namespace rascal {
         // function
         double range_begin{math::SPHERICAL_BESSEL_FUNCTION_FTOL};
         double range_end{this->interaction_cutoff};
-        this->init_interpolator(range_begin, range_end, accuracy);
+        this->cutoff_function = get_splined_cutoff_function(hypers);
+        this->cutoff_function.restrict_to(range_begin, range_end);
+        this->includes_cutoff_function = this->cutoff_function.is_splined();
+        this->n_threads = get_spline_n_threads(hypers);
+        this->nb_segments = get_spline_nb_segments(hypers);
+        init_splines_with_cache(
+            hypers, range_begin, range_end, accuracy,
+            [&]() {
+              this->init_interpolator(range_begin, range_end, accuracy);
+            },
+            [&](BinaryWriter & writer) { this->write_interpolators(writer); },
+            [&](BinaryReader & reader) { this->read_interpolators(reader); });
       }
 
       void init_interpolator(const double range_begin, const double range_end,
                              const double accuracy) {
+        auto & f_c = this->cutoff_function;
         int species;
         for (auto it = projection_matrices.begin();
              it != projection_matrices.end(); ++it) {
           species = it->first;
-          // "this" is passed by reference and is mutable
-          std::function<Matrix_t(double)> func{
-              [&](const double distance) mutable {
-                this->compute_neighbour_contribution(distance, species);
-                return this->reduced_radial_integral_neighbour;
-              }};
-          Matrix_t result = func(range_begin);
-          int cols{static_cast<int>(result.cols())};
-          int rows{static_cast<int>(result.rows())};
+          if (not f_c.outer) {
+            this->intps.insert(std::pair<int, std::unique_ptr<Spline_t>>(
+                species, this->make_interpolator(
+                             species, range_begin, range_end, accuracy,
+                             f_c.inner, false, this->nb_segments)));
+            continue;
+          }
+          // see the Spline handler
           this->intps.insert(std::pair<int, std::unique_ptr<Spline_t>>(
-              species, std::make_unique<Spline_t>(func, range_begin, range_end,
-                                                  accuracy, cols, rows)));
+              species, this->make_interpolator(
+                           species, range_begin, f_c.smoothing_begin,
+                           accuracy, f_c.inner, false, this->nb_segments)));
+          this->intps_smoothing.insert(
+              std::pair<int, std::unique_ptr<Spline_t>>(
+                  species, this->make_interpolator(
+                               species, f_c.smoothing_begin, range_end,
+                               accuracy, f_c.outer, true)));
         }
       }
 
+      //! see the Spline handler
+      std::unique_ptr<Spline_t>
+      make_interpolator(const int species, const double range_begin,
+                        const double range_end, const double accuracy,
+                        const std::function<double(double)> & f_c,
+                        const bool curvature_begin = false,
+                        const int nb_segments = 1) {
+        RadialContributionPool<RBT> pool{*this};
+        std::function<Matrix_t(double)> func{[&](const double distance) {
+          return pool.evaluate([&](Parent & contribution) {
+            contribution.compute_neighbour_contribution(distance, this->fac_a);
+            contribution.finalize_radial_integral_neighbour();
+            Matrix_t value(this->n_components, this->max_angular + 1);
+            this->project_radial_integral(
+                contribution.radial_integral_neighbour, species, value);
+            if (f_c) {
+              value *= f_c(distance);
+            }
+            return value;
+          });
+        }};
+        Matrix_t result = func(range_begin);
+        int cols{static_cast<int>(result.cols())};
+        int rows{static_cast<int>(result.rows())};
+        // zeros are the natural boundary conditions
+        Matrix_t d2f_begin{Matrix_t::Zero(rows, cols)};
+        Matrix_t d2f_end{Matrix_t::Zero(rows, cols)};
+        if (this->cutoff_function.outer) {
+          double step{this->cutoff_function.get_finite_difference_step()};
+          if (curvature_begin) {
+            d2f_begin = math::second_derivative_central_difference(
+                func, range_begin, step);
+          }
+          d2f_end =
+              math::second_derivative_central_difference(func, range_end, step);
+        }
+        return std::make_unique<Spline_t>(
+            func, range_begin, range_end, accuracy, cols, rows, d2f_begin,
+            d2f_end, nb_segments, 100000, 5, this->n_threads);
+      }
+
+      void write_interpolators(BinaryWriter & writer) {
+        for (const auto & species_intp : this->intps) {
+          writer.write<int32_t>(species_intp.first);
+          write_spline(writer, *species_intp.second);
+          if (this->cutoff_function.outer) {
+            write_spline(writer, *this->intps_smoothing.at(species_intp.first));
+          }
+        }
+      }
+
+      //! @throw std::runtime_error if the species do not match
+      void read_interpolators(BinaryReader & reader) {
+        // the splines are only replaced once everything has been read
+        std::map<int, std::unique_ptr<Spline_t>> new_intps{};
+        std::map<int, std::unique_ptr<Spline_t>> new_intps_smoothing{};
+        for (const auto & species_projections : this->projection_matrices) {
+          int species{species_projections.first};
+          if (reader.read<int32_t>() != species) {
+            throw std::runtime_error("The species of the cached splines do "
+                                     "not match the projection matrices.");
+          }
+          new_intps[species] = read_spline<Spline_t>(reader);
+          if (this->cutoff_function.outer) {
+            new_intps_smoothing[species] = read_spline<Spline_t>(reader);
+          }
+        }
+        this->intps = std::move(new_intps);
+        this->intps_smoothing = std::move(new_intps_smoothing);
+      }
+
+      /**
+       * spline tabulating the radial contribution of neighbour_type at
+       * distance
+       *
+       * @throw std::out_of_range if there is no projection matrix for
+       *        neighbour_type
+       */
+      Spline_t & get_interpolator(const double distance,
+                                  const int neighbour_type) {
+        if (distance > this->cutoff_function.smoothing_begin) {
+          return *this->intps_smoothing.at(neighbour_type);
+        }
+        return *this->intps.at(neighbour_type);
+      }
+
       double get_interpolator_accuracy(const Hypers_t & optimization_hypers) {
         auto spline_hypers =
             optimization_hypers.at("Spline").template get<json>();
@@ -1509,7 +2132,15 @@ namespace rascal {
       size_t n_species{};
       // 1/(2σ^2)
       double fac_a{};
+      //! cutoff function tabulated in the splines, if any
+      SplinedCutoffFunction cutoff_function{};
       std::map<int, std::unique_ptr<Spline_t>> intps{};
+      //! splines used in the smoothing region of the splined cutoff function
+      std::map<int, std::unique_ptr<Spline_t>> intps_smoothing{};
+      //! threads evaluating the radial contribution to refine the splines
+      size_t n_threads{1};
+      //! number of segments of the piecewise uniform grid of the splines
+      int nb_segments{1};
     };
 
   }  // namespace internal
@@ -1648,6 +2279,26 @@ namespace rascal {
         this->global_species.clear();
       }
 
+      if (hypers.count("spherical_harmonics_method")) {
+        auto method =
+            hypers.at("spherical_harmonics_method").get<std::string>();
+        if (method == "Legendre") {
+          this->spherical_harmonics.set_method(
+              math::SphericalHarmonicsMethod::Legendre);
+        } else if (method == "Solid") {
+          this->spherical_harmonics.set_method(
+              math::SphericalHarmonicsMethod::Solid);
+        } else {
+          throw std::logic_error(
+              "Requested spherical harmonics method \'" + method +
+              "\' has not been implemented.  Must be one of" +
+              ": \'Legendre\', \'Solid\'.");
+        }
+      } else {
+        // default value for backward compatibility
+        this->spherical_harmonics.set_method(
+            math::SphericalHarmonicsMethod::Legendre);
+      }
       this->spherical_harmonics.precompute(this->max_angular,
                                            this->compute_gradients);
 
@@ -2206,33 +2857,68 @@ namespace rascal {
     auto radial_integral{
         downcast_radial_integral_handler<RadialType, SmearingType, OptType>(
             this->radial_integral)};
+    // the splined radial contribution might already include f_c
+    const bool includes_cutoff_function{
+        radial_integral->includes_cutoff_function};
     auto n_row{this->max_radial};
     // to store linearly all l,m components with
     // -l-1<=m<=l+1 needs (l+1)**2 elements
     auto n_col{(this->max_angular + 1) * (this->max_angular + 1)};
-    expansions_coefficients.clear();
-    expansions_coefficients.set_shape(n_row, n_col);
+    // the keys only depend on the clusters and their types so when the
+    // topology of the manager did not change since the last computation,
+    // e.g. only the positions changed, the layout is kept
+    const size_t topology_version{manager->get_topology_version()};
+    bool is_layout_valid{
+        expansions_coefficients.get_layout_version() == topology_version and
+        expansions_coefficients.size() == manager->size()};
     if (compute_gradients) {
-      expansions_coefficients_gradient.clear();
-      // Row-major ordering, so the Cartesian (spatial) index varies slowest
-      expansions_coefficients_gradient.set_shape(ThreeD * n_row, n_col);
+      is_layout_valid =
+          is_layout_valid and
+          expansions_coefficients_gradient.get_layout_version() ==
+              topology_version;
     }
 
-    if (this->expansion_by_species == "environment wise") {
-      this->initialize_expansion_environment_wise(
-          manager, expansions_coefficients, expansions_coefficients_gradient);
-    } else if (this->expansion_by_species == "user defined") {
-      this->initialize_expansion_with_global_species(
-          manager, expansions_coefficients, expansions_coefficients_gradient);
-    } else if (this->expansion_by_species == "structure wise") {
-      this->initialize_expansion_structure_wise(
-          manager, expansions_coefficients, expansions_coefficients_gradient);
+    if (is_layout_valid) {
+      expansions_coefficients.setZero();
+      if (compute_gradients) {
+        expansions_coefficients_gradient.setZero();
+      }
     } else {
-      throw std::runtime_error("should not arrive here");
+      expansions_coefficients.clear();
+      expansions_coefficients.set_shape(n_row, n_col);
+      if (compute_gradients) {
+        expansions_coefficients_gradient.clear();
+        // Row-major ordering, so the Cartesian (spatial) index varies slowest
+        expansions_coefficients_gradient.set_shape(ThreeD * n_row, n_col);
+      }
+
+      if (this->expansion_by_species == "environment wise") {
+        this->initialize_expansion_environment_wise(
+            manager, expansions_coefficients,
+            expansions_coefficients_gradient);
+      } else if (this->expansion_by_species == "user defined") {
+        this->initialize_expansion_with_global_species(
+            manager, expansions_coefficients,
+            expansions_coefficients_gradient);
+      } else if (this->expansion_by_species == "structure wise") {
+        this->initialize_expansion_structure_wise(
+            manager, expansions_coefficients,
+            expansions_coefficients_gradient);
+      } else {
+        throw std::runtime_error("should not arrive here");
+      }
+      expansions_coefficients.set_layout_version(topology_version);
+      if (compute_gradients) {
+        expansions_coefficients_gradient.set_layout_version(topology_version);
+      }
     }
 
     // coeff C^{ij}_{nlm}
     auto c_ij_nlm = math::Matrix_t(n_row, n_col);
+    // d/dr_{ij} (c_{ij} f_c{r_{ij}}) when f_c is not in the radial integral
+    math::Matrix_t radial_derivative_buffer{};
+    // distances of the neighbours of the current center
+    std::vector<double> neighbour_distances{};
 
     for (auto center : manager) {
       // c^{i}
@@ -2249,6 +2935,14 @@ namespace rascal {
               center, center.get_atom_type()) /
           sqrt(4.0 * PI);
 
+      neighbour_distances.clear();
+      for (auto neigh : center.pairs()) {
+        neighbour_distances.push_back(manager->get_distance(neigh));
+      }
+      radial_integral->precompute_neighbour_contributions(
+          Eigen::Map<const Eigen::VectorXd>(neighbour_distances.data(),
+                                            neighbour_distances.size()));
+
       for (auto neigh : center.pairs()) {
         auto atom_j = neigh.get_atom_j();
         const int atom_j_tag = atom_j.get_atom_tag();
@@ -2268,7 +2962,10 @@ namespace rascal {
         auto && neighbour_contribution =
             radial_integral->template compute_neighbour_contribution(
                 dist, neigh, neigh.get_atom_type());
-        double f_c{cutoff_function->f_c(dist)};
+        double f_c{1.};
+        if (not includes_cutoff_function) {
+          f_c = cutoff_function->f_c(dist);
+        }
         auto coefficients_center_by_type{coefficients_center[neigh_type]};
 
         // compute the coefficients
@@ -2281,7 +2978,9 @@ namespace rascal {
               harmonics.segment(l_block_idx, l_block_size);
           l_block_idx += l_block_size;
         }
-        c_ij_nlm *= f_c;
+        if (not includes_cutoff_function) {
+          c_ij_nlm *= f_c;
+        }
         coefficients_center_by_type += c_ij_nlm;
 
         // half list branch for c^{ji} terms using
@@ -2318,7 +3017,6 @@ namespace rascal {
           auto && neighbour_derivative =
               radial_integral->compute_neighbour_derivative(
                   dist, neigh, neigh.get_atom_type());
-          double df_c{cutoff_function->df_c(dist)};
           // The type of the contribution c^{ij} to the coefficient c^{i}
           // depends on the type of j (and it is the same for the gradients)
           // In the following atom i is of type a and atom j is of type b
@@ -2330,11 +3028,16 @@ namespace rascal {
           auto && gradient_neigh_by_type{
               coefficients_neigh_gradient[neigh_type]};
 
-          // clang-format off
           // d/dr_{ij} (c_{ij} f_c{r_{ij}})
-          Matrix_t pair_gradient_contribution_p1 =
-                ((neighbour_derivative * f_c)
-                 + (neighbour_contribution * df_c));
+          if (not includes_cutoff_function) {
+            double df_c{cutoff_function->df_c(dist)};
+            radial_derivative_buffer =
+                neighbour_derivative * f_c + neighbour_contribution * df_c;
+          }
+          const Matrix_Ref pair_gradient_contribution_p1{
+              includes_cutoff_function ? neighbour_derivative
+                                       : Matrix_Ref(radial_derivative_buffer)};
+          // clang-format off
           // grad_j c^{ij}
           Matrix_t pair_gradient_contribution{this->max_radial,
                                               this->max_angular + 1};
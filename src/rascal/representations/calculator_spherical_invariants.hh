@@ -33,12 +33,12 @@
 #include "rascal/math/utils.hh"
 #include "rascal/representations/calculator_base.hh"
 #include "rascal/representations/calculator_spherical_expansion.hh"
+#include "rascal/representations/coupling_cache.hh"
+#include "rascal/representations/feature_cache.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager.hh"
 #include "rascal/utils/utils.hh"
 
-#include <wigxjpf.h>
-
 #include <Eigen/Dense>
 #include <Eigen/Eigenvalues>
 
@@ -66,81 +66,6 @@ namespace rascal {
       }
       return l_factors;
     }
-
-    //! Wigner pre-factors
-    inline Eigen::ArrayXd precompute_wigner_w3js(size_t max_angular,
-                                                 bool inversion_symmetry) {
-      Eigen::ArrayXd wigner_w3js{};
-      // get the number of non zero elements in the w3j
-      int n_elements{0};
-      for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
-        for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
-          for (size_t l3{0}; l3 < max_angular + 1; ++l3) {
-            if ((l1 < static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-                (l1 > l2 + l3)) {
-              continue;
-            }
-            if (inversion_symmetry) {
-              if ((l1 + l2 + l3) % 2 == 1) {
-                continue;
-              }
-            }
-            for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-              int m1s{static_cast<int>(m1 - l1)};
-              for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                int m2s{static_cast<int>(m2 - l2)};
-                for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                  int m3s{static_cast<int>(m3 - l3)};
-                  if (m1s + m2s + m3s != 0) {
-                    continue;
-                  }
-                  ++n_elements;
-                }
-              }
-            }
-          }
-        }
-      }
-
-      wigner_w3js.resize(n_elements);
-      n_elements = 0;
-      wig_table_init(2 * (max_angular + 1), 3);
-      wig_temp_init(2 * (max_angular + 1));
-      for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
-        for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
-          for (size_t l3{0}; l3 < max_angular + 1; ++l3) {
-            if ((l1 < static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-                (l1 > l2 + l3)) {
-              continue;
-            }
-            if (inversion_symmetry) {
-              if ((l1 + l2 + l3) % 2 == 1) {
-                continue;
-              }
-            }
-            for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-              int m1s{static_cast<int>(m1 - l1)};
-              for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                int m2s{static_cast<int>(m2 - l2)};
-                for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                  int m3s{static_cast<int>(m3 - l3)};
-                  if (m1s + m2s + m3s != 0) {
-                    continue;
-                  }
-                  wigner_w3js(n_elements) =
-                      wig3jj(2 * l1, 2 * l2, 2 * l3, 2 * m1s, 2 * m2s, 2 * m3s);
-                  ++n_elements;
-                }
-              }
-            }
-          }
-        }
-      }
-      wig_temp_free();
-      wig_table_free();
-
-      return wigner_w3js;
-    }
   }  // namespace internal
 
   class CalculatorSphericalInvariants : public CalculatorBase {
@@ -194,7 +119,7 @@ namespace rascal {
           inversion_symmetry{std::move(other.inversion_symmetry)},
           rep_expansion{std::move(other.rep_expansion)},
           type{std::move(other.type)}, l_factors{std::move(other.l_factors)},
-          wigner_w3js{std::move(other.wigner_w3js)} {}
+          wigner_couplings{std::move(other.wigner_couplings)} {}
     //! Destructor
     virtual ~CalculatorSphericalInvariants() = default;
 
@@ -331,8 +256,9 @@ namespace rascal {
       } else if (soap_type == "BiSpectrum") {
         this->type = internal::SphericalInvariantsType::BiSpectrum;
         this->inversion_symmetry = hypers.at("inversion_symmetry").get<bool>();
-        this->wigner_w3js = internal::precompute_wigner_w3js(
-            this->max_angular, this->inversion_symmetry);
+        this->wigner_couplings =
+            CouplingCache::get_instance().get_bispectrum_table(
+                this->max_angular, this->inversion_symmetry);
       } else {
         throw std::logic_error(
             "Requested SphericalInvariants type \'" + soap_type +
@@ -531,7 +457,8 @@ namespace rascal {
           this->inversion_symmetry == other.inversion_symmetry and
           this->type == other.type and
           (this->l_factors.array() == other.l_factors.array()).all() and
-          (this->wigner_w3js.array() == other.wigner_w3js.array()).all()};
+          internal::has_same_couplings(this->wigner_couplings,
+                                       other.wigner_couplings)};
       bool rep_expansion_match{this->rep_expansion == other.rep_expansion};
       bool sparsification_match{
           this->unique_pair_list == other.unique_pair_list and
@@ -571,7 +498,7 @@ namespace rascal {
                          int> = 0>
     void compute_loop(StructureManager & managers) {
       for (auto & manager : managers) {
-        this->compute_impl<BodyOrder>(manager);
+        this->compute_cached<BodyOrder>(manager);
       }
     }
 
@@ -582,7 +509,45 @@ namespace rascal {
             not(internal::is_proper_iterator<StructureManager>::value), int> =
             0>
     void compute_loop(StructureManager & manager) {
-      this->compute_impl<BodyOrder>(manager);
+      this->compute_cached<BodyOrder>(manager);
+    }
+
+    /**
+     * Load the representation from the feature cache if possible, otherwise
+     * compute it and store it in the cache. Without cache just call
+     * compute_impl.
+     */
+    template <internal::SphericalInvariantsType BodyOrder,
+              class StructureManager>
+    void compute_cached(std::shared_ptr<StructureManager> manager) {
+      using Prop_t = Property_t<StructureManager>;
+      using PropGrad_t = PropertyGradient_t<StructureManager>;
+      constexpr bool ExcludeGhosts{true};
+      auto cache{this->get_feature_cache()};
+      if (cache == nullptr) {
+        this->compute_impl<BodyOrder>(manager);
+        return;
+      }
+      auto && soap_vectors{*manager->template get_property<Prop_t>(
+          this->get_name(), true, true, ExcludeGhosts)};
+      // no need to go to the disk if the representation has already been
+      // computed for the current structure
+      if (soap_vectors.is_updated()) {
+        return;
+      }
+      if (not cache->template load<Prop_t, PropGrad_t>(*this, manager,
+                                                       ExcludeGhosts)) {
+        this->compute_impl<BodyOrder>(manager);
+        cache->template store<Prop_t, PropGrad_t>(*this, manager,
+                                                  ExcludeGhosts);
+      }
+      soap_vectors.set_updated_status(true);
+      if (this->compute_gradients) {
+        auto && soap_vector_gradients{
+            *manager->template get_property<PropGrad_t>(
+                this->get_gradient_name(), true, true)};
+        soap_vector_gradients.set_updated_status(true);
+      }
     }
 
     //! compute representation @f$ \nu == 1 @f$
@@ -722,8 +687,8 @@ namespace rascal {
     //! precomputed l-factors the PowerSpectrum
     Eigen::VectorXd l_factors{};
 
-    //! precomputed wigner symbols for the BiSpectrum
-    Eigen::ArrayXd wigner_w3js{};
+    //! couplings of the real coefficients for the BiSpectrum
+    CouplingCache::Table_t wigner_couplings{};
   };
 
   template <class StructureManager>
@@ -1096,7 +1061,11 @@ namespace rascal {
     this->initialize_per_center_bispectrum_soap_vectors(
         soap_vectors, expansions_coefficients, manager);
 
-    using complex = std::complex<double>;
+    const auto & couplings{this->wigner_couplings->couplings};
+    const auto & blocks{this->wigner_couplings->blocks};
+    // couplings multiplied by the coefficients of the first two neighbours,
+    // they are shared by all the n3
+    std::vector<double> partial_products(couplings.size());
 
     // factor that takes into acount the missing equivalent off diagonal
     // element with respect to the key (or species) index
@@ -1136,102 +1105,31 @@ namespace rascal {
               size_t nn{0};
               for (size_t n1{0}; n1 < this->max_radial; n1++) {
                 for (size_t n2{0}; n2 < this->max_radial; n2++) {
+                  for (const auto & block : blocks) {
+                    const double * coef1_l{
+                        &coef1(n1, math::pow(block.l1, 2_size_t))};
+                    const double * coef2_l{
+                        &coef2(n2, math::pow(block.l2, 2_size_t))};
+                    for (size_t i_c{block.begin}; i_c < block.end; ++i_c) {
+                      const auto & coupling{couplings[i_c]};
+                      partial_products[i_c] = coupling.value *
+                                              coef1_l[coupling.m1] *
+                                              coef2_l[coupling.m2];
+                    }
+                  }
                   for (size_t n3{0}; n3 < this->max_radial; n3++) {
-                    size_t l0{0};
-                    int wigner_count{0};
-                    for (size_t l1{0}; l1 < this->max_angular + 1; l1++) {
-                      for (size_t l2{0}; l2 < this->max_angular + 1; l2++) {
-                        for (size_t l3{0}; l3 < this->max_angular + 1; l3++) {
-                          if (this->inversion_symmetry == true) {
-                            if ((l1 + l2 + l3) % 2 == 1) {
-                              continue;
-                            }
-                          }
-
-                          if ((l1 <
-                               static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-                              (l1 > l2 + l3)) {
-                            continue;
-                          }
-
-                          for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-                            int m1s{static_cast<int>(m1 - l1)};
-                            size_t lm1{math::pow(l1, 2_size_t) + m1};
-                            for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                              int m2s{static_cast<int>(m2 - l2)};
-                              size_t lm2{math::pow(l2, 2_size_t) + m2};
-                              for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                                int m3s{static_cast<int>(m3 - l3)};
-                                if (m1s + m2s + m3s != 0) {
-                                  continue;
-                                }
-                                size_t lm3{math::pow(l3, 2_size_t) + m3};
-                                double w3j = this->wigner_w3js[wigner_count];
-                                complex coef1c, coef2c, coef3c;
-                                // usual formulae for converting from real to
-                                // complex
-                                // see src/math/spherical_harmonics.hh for the
-                                // inverse transformation
-                                // TODO(andrea, michael) avoid complex
-                                // arithmetic
-                                if (m1s > 0) {
-                                  coef1c = math::pow(-1, m1s) *
-                                           complex{coef1(n1, lm1),
-                                                   coef1(n1, lm1 - 2 * m1s)};
-                                } else if (m1s == 0) {
-                                  coef1c = complex(coef1(n1, lm1), 0.0) *
-                                           math::SQRT_TWO;
-                                } else if (m1s < 0) {
-                                  coef1c = complex{coef1(n1, lm1 - 2 * m1s),
-                                                   -coef1(n1, lm1)};
-                                }
-                                if (m2s > 0) {
-                                  coef2c = math::pow(-1.0, m2s) *
-                                           complex{coef2(n2, lm2),
-                                                   coef2(n2, lm2 - 2 * m2s)};
-                                } else if (m2s == 0) {
-                                  coef2c = complex(coef2(n2, lm2), 0.0) *
-                                           math::SQRT_TWO;
-                                } else if (m2s < 0) {
-                                  coef2c = complex{coef2(n2, lm2 - 2 * m2s),
-                                                   -coef2(n2, lm2)};
-                                }
-                                if (m3s > 0) {
-                                  coef3c = math::pow(-1.0, m3s) *
-                                           complex{coef3(n3, lm3),
-                                                   coef3(n3, lm3 - 2 * m3s)};
-                                } else if (m3s == 0) {
-                                  coef3c = complex(coef3(n3, lm3), 0.0) *
-                                           math::SQRT_TWO;
-                                } else if (m3s < 0) {
-                                  coef3c = complex{coef3(n3, lm3 - 2 * m3s),
-                                                   -coef3(n3, lm3)};
-                                }
-                                coef1c *= math::INV_SQRT_TWO;
-                                coef2c *= math::INV_SQRT_TWO;
-                                coef3c *= math::INV_SQRT_TWO;
-
-                                // The descriptor components are purely real or
-                                // imaginary
-                                // depending on the divisibility of l1 + l2 +l3
-                                // by 2.
-                                if ((l1 + l2 + l3) % 2 == 0) {
-                                  soap_vector_by_type(nn, l0) +=
-                                      w3j * mult *
-                                      (coef1c * coef2c * coef3c).real();
-                                } else {
-                                  soap_vector_by_type(nn, l0) +=
-                                      w3j * mult *
-                                      (coef1c * coef2c * coef3c).imag();
-                                }
-                                wigner_count++;
-                              }  // m3
-                            }    // m2
-                          }      // m1
-                          l0++;
-                        }  // l3
-                      }    // l2
-                    }      // l1
+                    // one feature per (l1, l2, l3) block
+                    for (size_t l0{0}; l0 < blocks.size(); ++l0) {
+                      const auto & block{blocks[l0]};
+                      const double * coef3_l{
+                          &coef3(n3, math::pow(block.l3, 2_size_t))};
+                      double feature{0.};
+                      for (size_t i_c{block.begin}; i_c < block.end; ++i_c) {
+                        feature += partial_products[i_c] *
+                                   coef3_l[couplings[i_c].m3];
+                      }
+                      soap_vector_by_type(nn, l0) += mult * feature;
+                    }
                     nn++;
                   }  // n3
                 }    // n2
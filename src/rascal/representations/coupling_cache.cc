@@ -0,0 +1,305 @@
+/**
+ * @file   rascal/representations/coupling_cache.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Implementation of the cache of the couplings of the real spherical
+ *        expansion coefficients
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/representations/coupling_cache.hh"
+
+#include "rascal/math/utils.hh"
+
+#include <wigxjpf.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <limits>
+
+namespace rascal {
+
+  namespace {
+    using complex = std::complex<double>;
+
+    constexpr int BiSpectrumTable{0};
+    constexpr int LambdaSpectrumTable{1};
+
+    //! couplings below this are round-off errors of vanishing ones
+    constexpr double CouplingZero{10 * std::numeric_limits<double>::epsilon()};
+
+    /**
+     * The complex coefficient of a given m as a combination of at most two
+     * real coefficients. These are the inverses of the formulae used to
+     * define the real spherical harmonics in src/math/spherical_harmonics.hh
+     */
+    struct RealToComplex {
+      explicit RealToComplex(int m) {
+        if (m > 0) {
+          double sign{math::pow(-1.0, m)};
+          this->nb_terms = 2;
+          this->m_real = {m, -m};
+          this->factors = {complex{sign * math::INV_SQRT_TWO, 0.},
+                           complex{0., sign * math::INV_SQRT_TWO}};
+        } else if (m == 0) {
+          this->nb_terms = 1;
+          this->m_real = {0, 0};
+          this->factors = {complex{1., 0.}, complex{0., 0.}};
+        } else {
+          this->nb_terms = 2;
+          this->m_real = {-m, m};
+          this->factors = {complex{math::INV_SQRT_TWO, 0.},
+                           complex{0., -math::INV_SQRT_TWO}};
+        }
+      }
+
+      int nb_terms{};
+      std::array<int, 2> m_real{};
+      std::array<complex, 2> factors{};
+    };
+
+    //! wigxjpf keeps its tables in a state global to the process
+    struct WigxjpfTables {
+      explicit WigxjpfTables(size_t max_angular) {
+        wig_table_init(2 * (max_angular + 1), 3);
+        wig_temp_init(2 * (max_angular + 1));
+      }
+
+      ~WigxjpfTables() {
+        wig_temp_free();
+        wig_table_free();
+      }
+    };
+
+    /**
+     * Append the nonzero couplings of the block (l1, l2, l3) stored densely
+     * with the index (m3, m1, m2).
+     */
+    void append_block(internal::CouplingTable & table, size_t l1, size_t l2,
+                      size_t l3, const std::vector<double> & dense) {
+      const int n_m1{static_cast<int>(2 * l1 + 1)};
+      const int n_m2{static_cast<int>(2 * l2 + 1)};
+      const int n_m3{static_cast<int>(2 * l3 + 1)};
+      internal::CouplingTable::Block block{l1, l2, l3, table.couplings.size(),
+                                           0};
+      size_t i_dense{0};
+      for (int m3{0}; m3 < n_m3; ++m3) {
+        for (int m1{0}; m1 < n_m1; ++m1) {
+          for (int m2{0}; m2 < n_m2; ++m2) {
+            const double value{dense[i_dense++]};
+            if (std::abs(value) > CouplingZero) {
+              table.couplings.push_back({m1, m2, m3, value});
+            }
+          }
+        }
+      }
+      block.end = table.couplings.size();
+      table.blocks.push_back(block);
+    }
+
+    //! selection rules of the blocks
+    bool is_coupled(size_t l1, size_t l2, size_t l3, bool inversion_symmetry) {
+      if ((l1 < static_cast<size_t>(std::abs<int>(l2 - l3))) ||
+          (l1 > l2 + l3)) {
+        return false;
+      }
+      return not(inversion_symmetry and (l1 + l2 + l3) % 2 == 1);
+    }
+  }  // namespace
+
+  namespace internal {
+    /* ---------------------------------------------------------------------- */
+    CouplingTable compute_bispectrum_couplings(size_t max_angular,
+                                               bool inversion_symmetry) {
+      CouplingTable table{};
+      WigxjpfTables wigxjpf_tables{max_angular};
+      std::vector<double> dense{};
+      for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
+        for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
+          for (size_t l3{0}; l3 < max_angular + 1; ++l3) {
+            if (not is_coupled(l1, l2, l3, inversion_symmetry)) {
+              continue;
+            }
+            const int il1{static_cast<int>(l1)};
+            const int il2{static_cast<int>(l2)};
+            const int il3{static_cast<int>(l3)};
+            const bool is_real{(l1 + l2 + l3) % 2 == 0};
+            dense.assign((2 * l1 + 1) * (2 * l2 + 1) * (2 * l3 + 1), 0.);
+            for (int m1s{-il1}; m1s < il1 + 1; ++m1s) {
+              RealToComplex coef1{m1s};
+              for (int m2s{-il2}; m2s < il2 + 1; ++m2s) {
+                const int m3s{-m1s - m2s};
+                if (std::abs(m3s) > il3) {
+                  continue;
+                }
+                RealToComplex coef2{m2s}, coef3{m3s};
+                const double w3j{
+                    wig3jj(2 * il1, 2 * il2, 2 * il3, 2 * m1s, 2 * m2s,
+                           2 * m3s)};
+                for (int i1{0}; i1 < coef1.nb_terms; ++i1) {
+                  for (int i2{0}; i2 < coef2.nb_terms; ++i2) {
+                    for (int i3{0}; i3 < coef3.nb_terms; ++i3) {
+                      complex factor{coef1.factors[i1] * coef2.factors[i2] *
+                                     coef3.factors[i3]};
+                      size_t i_dense{static_cast<size_t>(
+                          ((coef3.m_real[i3] + il3) * (2 * il1 + 1) +
+                           coef1.m_real[i1] + il1) *
+                              (2 * il2 + 1) +
+                          coef2.m_real[i2] + il2)};
+                      dense[i_dense] +=
+                          w3j * (is_real ? factor.real() : factor.imag());
+                    }
+                  }
+                }
+              }
+            }
+            append_block(table, l1, l2, l3, dense);
+          }
+        }
+      }
+      return table;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    CouplingTable compute_lambda_spectrum_couplings(size_t max_angular,
+                                                    bool inversion_symmetry,
+                                                    size_t lambda) {
+      CouplingTable table{};
+      WigxjpfTables wigxjpf_tables{std::max(max_angular, lambda)};
+      std::vector<double> dense{};
+      const size_t l3{lambda};
+      const int il3{static_cast<int>(l3)};
+      for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
+        for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
+          if (not is_coupled(l1, l2, l3, inversion_symmetry)) {
+            continue;
+          }
+          const int il1{static_cast<int>(l1)};
+          const int il2{static_cast<int>(l2)};
+          const bool is_real{(l1 + l2 + l3) % 2 == 0};
+          dense.assign((2 * l1 + 1) * (2 * l2 + 1) * (2 * l3 + 1), 0.);
+          for (int m3s{-il3}; m3s < il3 + 1; ++m3s) {
+            // the real component m3 mixes the complex ones m3 and -m3
+            const complex phase{m3s < 0 ? complex{0., 1.} : complex{1., 0.}};
+            for (int m1s{-il1}; m1s < il1 + 1; ++m1s) {
+              RealToComplex coef1{m1s};
+              for (int m2s{-il2}; m2s < il2 + 1; ++m2s) {
+                if ((m1s + m2s + m3s != 0) && (m1s + m2s - m3s != 0)) {
+                  continue;
+                }
+                RealToComplex coef2{m2s};
+                const double w3j1{wig3jj(2 * il1, 2 * il2, 2 * il3, 2 * m1s,
+                                         2 * m2s, 2 * m3s)};
+                const double w3j2{wig3jj(2 * il1, 2 * il2, 2 * il3, 2 * m1s,
+                                         2 * m2s, -2 * m3s)};
+                // SOAPFAST swaps w3j1 and w3j2 for m3 != 0 because of its
+                // different definition of the real spherical harmonics
+                double w3j{w3j1};
+                if (m3s > 0) {
+                  w3j = (w3j2 + math::pow(-1, m3s) * w3j1) * math::INV_SQRT_TWO;
+                } else if (m3s < 0) {
+                  w3j = (w3j1 - math::pow(-1, m3s) * w3j2) * math::INV_SQRT_TWO;
+                }
+                for (int i1{0}; i1 < coef1.nb_terms; ++i1) {
+                  for (int i2{0}; i2 < coef2.nb_terms; ++i2) {
+                    complex factor{phase * coef1.factors[i1] *
+                                   coef2.factors[i2]};
+                    size_t i_dense{static_cast<size_t>(
+                        ((m3s + il3) * (2 * il1 + 1) + coef1.m_real[i1] +
+                         il1) *
+                            (2 * il2 + 1) +
+                        coef2.m_real[i2] + il2)};
+                    dense[i_dense] +=
+                        w3j * (is_real ? factor.real() : factor.imag());
+                  }
+                }
+              }
+            }
+          }
+          append_block(table, l1, l2, l3, dense);
+        }
+      }
+      return table;
+    }
+  }  // namespace internal
+
+  /* ---------------------------------------------------------------------- */
+  CouplingCache & CouplingCache::get_instance() {
+    static CouplingCache instance{};
+    return instance;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  auto CouplingCache::get_bispectrum_table(size_t max_angular,
+                                           bool inversion_symmetry)
+      -> Table_t {
+    Key_t key{BiSpectrumTable, max_angular, inversion_symmetry, 0};
+    // the table is computed while holding the lock because of the global
+    // state of wigxjpf
+    std::lock_guard<std::mutex> lock{this->tables_mutex};
+    auto it{this->tables.find(key)};
+    if (it != this->tables.end()) {
+      ++this->hits;
+      return it->second;
+    }
+    ++this->misses;
+    auto table{std::make_shared<const internal::CouplingTable>(
+        internal::compute_bispectrum_couplings(max_angular,
+                                               inversion_symmetry))};
+    this->tables[key] = table;
+    return table;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  auto CouplingCache::get_lambda_spectrum_table(size_t max_angular,
+                                                bool inversion_symmetry,
+                                                size_t lambda) -> Table_t {
+    Key_t key{LambdaSpectrumTable, max_angular, inversion_symmetry, lambda};
+    std::lock_guard<std::mutex> lock{this->tables_mutex};
+    auto it{this->tables.find(key)};
+    if (it != this->tables.end()) {
+      ++this->hits;
+      return it->second;
+    }
+    ++this->misses;
+    auto table{std::make_shared<const internal::CouplingTable>(
+        internal::compute_lambda_spectrum_couplings(
+            max_angular, inversion_symmetry, lambda))};
+    this->tables[key] = table;
+    return table;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void CouplingCache::clear() {
+    std::lock_guard<std::mutex> lock{this->tables_mutex};
+    this->tables.clear();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  size_t CouplingCache::size() {
+    std::lock_guard<std::mutex> lock{this->tables_mutex};
+    return this->tables.size();
+  }
+
+}  // namespace rascal
@@ -0,0 +1,184 @@
+/**
+ * @file   rascal/representations/coupling_cache.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Process wide cache of the sparse couplings of the real spherical
+ *        expansion coefficients used by the BiSpectrum and LambdaSpectrum
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_REPRESENTATIONS_COUPLING_CACHE_HH_
+#define SRC_RASCAL_REPRESENTATIONS_COUPLING_CACHE_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace rascal {
+
+  namespace internal {
+    /**
+     * Couplings of the real spherical expansion coefficients obtained by
+     * folding the Wigner 3j symbols with the transformation from the real
+     * to the complex spherical harmonics, so that the features can be
+     * computed with real arithmetic only.
+     *
+     * The couplings are grouped in blocks of (l1, l2, l3), in the order of
+     * the feature columns, and only the nonzero ones are stored. Within a
+     * block they are sorted by m3, then m1 and m2.
+     */
+    struct CouplingTable {
+      /**
+       * One nonzero coupling, the m are shifted by l so that they index
+       * the 2l+1 real coefficients of the corresponding l.
+       */
+      struct Coupling {
+        int m1;
+        int m2;
+        int m3;
+        double value;
+
+        bool operator==(const Coupling & other) const {
+          return this->m1 == other.m1 and this->m2 == other.m2 and
+                 this->m3 == other.m3 and this->value == other.value;
+        }
+      };
+
+      //! the couplings of the block are in [begin, end)
+      struct Block {
+        size_t l1;
+        size_t l2;
+        size_t l3;
+        size_t begin;
+        size_t end;
+
+        bool operator==(const Block & other) const {
+          return this->l1 == other.l1 and this->l2 == other.l2 and
+                 this->l3 == other.l3 and this->begin == other.begin and
+                 this->end == other.end;
+        }
+      };
+
+      bool operator==(const CouplingTable & other) const {
+        return this->blocks == other.blocks and
+               this->couplings == other.couplings;
+      }
+
+      std::vector<Block> blocks{};
+      std::vector<Coupling> couplings{};
+    };
+
+    //! both tables are missing or they have the same couplings
+    inline bool
+    has_same_couplings(const std::shared_ptr<const CouplingTable> & table,
+                       const std::shared_ptr<const CouplingTable> & other) {
+      if (table == other) {
+        return true;
+      }
+      return table and other and *table == *other;
+    }
+
+    /**
+     * Couplings of the BiSpectrum, the block (l1, l2, l3) gives
+     *
+     *    sum_m1m2m3 w3j(l1 l2 l3; m1 m2 m3) c1_l1m1 c2_l2m2 c3_l3m3
+     *
+     * in terms of the real coefficients, i.e. its real part when l1+l2+l3
+     * is even and its imaginary part otherwise.
+     */
+    CouplingTable compute_bispectrum_couplings(size_t max_angular,
+                                               bool inversion_symmetry);
+
+    /**
+     * Couplings of the LambdaSpectrum, the block (l1, l2, lambda) gives
+     * the 2 lambda + 1 real components of the covariant built from
+     * c1_l1m1 c2_l2m2.
+     */
+    CouplingTable compute_lambda_spectrum_couplings(size_t max_angular,
+                                                    bool inversion_symmetry,
+                                                    size_t lambda);
+  }  // namespace internal
+
+  /**
+   * Cache of the coupling tables so that they are computed once per process
+   * and shared by all the calculators using them. The tables are immutable
+   * once computed.
+   */
+  class CouplingCache {
+   public:
+    using Table_t = std::shared_ptr<const internal::CouplingTable>;
+
+    //! the cache shared by the whole process
+    static CouplingCache & get_instance();
+
+    //! Copy constructor
+    CouplingCache(const CouplingCache & other) = delete;
+
+    //! Move constructor
+    CouplingCache(CouplingCache && other) = delete;
+
+    //! Destructor
+    ~CouplingCache() = default;
+
+    //! Copy assignment operator
+    CouplingCache & operator=(const CouplingCache & other) = delete;
+
+    //! Move assignment operator
+    CouplingCache & operator=(CouplingCache && other) = delete;
+
+    //! couplings of the BiSpectrum, computed on the first request
+    Table_t get_bispectrum_table(size_t max_angular, bool inversion_symmetry);
+
+    //! couplings of the LambdaSpectrum, computed on the first request
+    Table_t get_lambda_spectrum_table(size_t max_angular,
+                                      bool inversion_symmetry, size_t lambda);
+
+    //! forget the tables, the calculators keep the ones they hold
+    void clear();
+
+    //! number of tables kept in the process
+    size_t size();
+
+    //! number of tables that were already computed when requested
+    size_t get_hits() const { return this->hits; }
+
+    //! number of tables that had to be computed
+    size_t get_misses() const { return this->misses; }
+
+   protected:
+    CouplingCache() = default;
+
+    //! kind of table, max_angular, inversion_symmetry and lambda
+    using Key_t = std::tuple<int, size_t, bool, size_t>;
+
+    std::map<Key_t, Table_t> tables{};
+    std::mutex tables_mutex{};
+    std::atomic<size_t> hits{0};
+    std::atomic<size_t> misses{0};
+  };
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_REPRESENTATIONS_COUPLING_CACHE_HH_
@@ -76,6 +76,22 @@ namespace rascal {
       return (0.5 * (1. + std::cos(r_scaled)));
     }
 
+    /**
+     * Smooth continuation of the cosine-type switching function
+     *
+     * sw(r) = 1/2 + 1/2 cos(pi * (r - cutoff + smooth_width) / smooth_width)
+     *
+     * for any r, i.e. it is equal to switching_function_cosine() inside the
+     * cutoff region (cutoff - smooth_width < r <= cutoff) but, unlike it, it
+     * is infinitely differentiable everywhere. It should not be used with
+     * smooth_width equal to zero.
+     */
+    inline double switching_function_cosine_continued(double r, double cutoff,
+                                                      double smooth_width) {
+      double r_scaled{math::PI * (r - cutoff + smooth_width) / smooth_width};
+      return (0.5 * (1. + std::cos(r_scaled)));
+    }
+
     /**
      * Compute the derivative of the cosine-type switching function
      *
@@ -0,0 +1,251 @@
+/**
+ * @file   rascal/representations/feature_cache.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Implementation of the on-disk feature cache
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/representations/feature_cache.hh"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace rascal {
+
+  namespace {
+    constexpr char CacheMagic[8] = {'R', 'A', 'S', 'C', 'A', 'L', 'F', 'C'};
+    constexpr uint32_t CacheVersion{1};
+    constexpr uint32_t CacheByteOrder{0x01020304};
+
+    bool ends_with(const std::string & str, const std::string & suffix) {
+      return str.size() >= suffix.size() and
+             str.compare(str.size() - suffix.size(), suffix.size(), suffix) ==
+                 0;
+    }
+  }  // namespace
+
+  namespace internal {
+    /* ---------------------------------------------------------------------- */
+    uint64_t hash_structure(StructureManagerCenters & manager) {
+      // get_positions does not copy structures read from a StructureStore
+      auto positions{manager.get_positions()};
+      auto atom_types{manager.get_atom_types()};
+      auto cell{manager.get_cell()};
+      auto pbc{manager.get_periodic_boundary_conditions()};
+      auto center_atoms_mask{manager.get_center_atoms_mask()};
+
+      uint64_t hash{hash_bytes(positions.data(),
+                               positions.size() * sizeof(double))};
+      hash = hash_bytes(atom_types.data(), atom_types.size() * sizeof(int),
+                        hash);
+      hash = hash_bytes(cell.data(), cell.size() * sizeof(double), hash);
+      hash = hash_bytes(pbc.data(), pbc.size() * sizeof(int), hash);
+      hash = hash_bytes(center_atoms_mask.data(),
+                        center_atoms_mask.size() * sizeof(bool), hash);
+      return hash;
+    }
+  }  // namespace internal
+
+  const std::string FeatureCache::Extension{".rfc"};
+
+  /* ---------------------------------------------------------------------- */
+  FeatureCache::FeatureCache(const std::string & directory, size_t max_size)
+      : directory{directory}, max_size{max_size} {
+    if (this->directory.empty()) {
+      throw std::runtime_error("The feature cache directory is empty.");
+    }
+    if (::mkdir(this->directory.c_str(), 0755) != 0 and errno != EEXIST) {
+      throw std::runtime_error(
+          "Could not create the feature cache directory: " + this->directory);
+    }
+    struct stat dir_stat {};
+    if (::stat(this->directory.c_str(), &dir_stat) != 0 or
+        not S_ISDIR(dir_stat.st_mode)) {
+      throw std::runtime_error("The feature cache path is not a directory: " +
+                               this->directory);
+    }
+    this->evict();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  std::string FeatureCache::get_entry_filename(uint64_t hypers_hash,
+                                               uint64_t structure_hash) const {
+    std::stringstream filename{};
+    filename << this->directory << "/" << std::hex << std::setfill('0')
+             << std::setw(16) << hypers_hash << "-" << std::setw(16)
+             << structure_hash << FeatureCache::Extension;
+    return filename.str();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  bool FeatureCache::open_entry(const std::string & filename,
+                                MappedFile & file,
+                                internal::FeatureCacheReader & reader) {
+    if (::access(filename.c_str(), R_OK) != 0) {
+      return false;
+    }
+    try {
+      // the entry can be evicted by another process in the mean time, the
+      // mapping stays valid in that case
+      file.open(filename, MappedFile::Mode::ReadOnly);
+    } catch (const std::runtime_error &) {
+      return false;
+    }
+    reader = internal::FeatureCacheReader{file.data(),
+                                          file.data() + file.size()};
+    try {
+      char magic[sizeof(CacheMagic)];
+      reader.read_array(magic, sizeof(magic));
+      if (std::memcmp(magic, CacheMagic, sizeof(CacheMagic)) != 0 or
+          reader.read<uint32_t>() != CacheVersion or
+          reader.read<uint32_t>() != CacheByteOrder) {
+        return false;
+      }
+    } catch (const std::runtime_error &) {
+      return false;
+    }
+    // update the access time for the LRU eviction
+    ::utimes(filename.c_str(), nullptr);
+    return true;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void FeatureCache::write_header(internal::FeatureCacheWriter & writer,
+                                  uint64_t n_properties) {
+    writer.write_array(CacheMagic, sizeof(CacheMagic));
+    writer.write(CacheVersion);
+    writer.write(CacheByteOrder);
+    writer.write(n_properties);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void FeatureCache::write_entry(const std::string & filename,
+                                 const internal::FeatureCacheWriter & writer) {
+    const auto & buffer{writer.buffer};
+    if (this->max_size > 0 and buffer.size() > this->max_size) {
+      // would be evicted right away
+      return;
+    }
+    // the temporary file is unique to the process so that concurrent writers
+    // of the same entry do not interfere, the last rename wins
+    // an existing entry is overwritten so its size is not used anymore
+    size_t previous_size{0};
+    struct stat file_stat {};
+    if (::stat(filename.c_str(), &file_stat) == 0) {
+      previous_size = static_cast<size_t>(file_stat.st_size);
+    }
+    std::string tmp_filename{filename + ".tmp" + std::to_string(::getpid())};
+    {
+      std::ofstream stream{tmp_filename, std::ios::binary | std::ios::trunc};
+      stream.write(buffer.data(), buffer.size());
+      stream.close();
+      if (stream.fail()) {
+        std::remove(tmp_filename.c_str());
+        throw std::runtime_error("Could not write the feature cache entry: " +
+                                 tmp_filename);
+      }
+    }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+      std::remove(tmp_filename.c_str());
+      throw std::runtime_error("Could not write the feature cache entry: " +
+                               filename);
+    }
+    this->size += buffer.size();
+    this->size -= std::min(previous_size, this->size.load());
+    if (this->max_size > 0 and this->size > this->max_size) {
+      this->evict();
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  std::vector<FeatureCache::Entry> FeatureCache::scan() const {
+    std::vector<Entry> entries{};
+    DIR * dir{::opendir(this->directory.c_str())};
+    if (dir == nullptr) {
+      return entries;
+    }
+    while (auto * dir_entry = ::readdir(dir)) {
+      std::string name{dir_entry->d_name};
+      if (not ends_with(name, FeatureCache::Extension)) {
+        continue;
+      }
+      std::string filename{this->directory + "/" + name};
+      struct stat file_stat {};
+      if (::stat(filename.c_str(), &file_stat) != 0) {
+        // removed by another process
+        continue;
+      }
+      double last_access{static_cast<double>(file_stat.st_mtim.tv_sec) +
+                         1e-9 * static_cast<double>(file_stat.st_mtim.tv_nsec)};
+      entries.push_back(
+          Entry{filename, last_access, static_cast<size_t>(file_stat.st_size)});
+    }
+    ::closedir(dir);
+    return entries;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void FeatureCache::evict() {
+    std::lock_guard<std::mutex> lock{this->eviction_mutex};
+    auto entries{this->scan()};
+    size_t total_size{0};
+    for (const auto & entry : entries) {
+      total_size += entry.size;
+    }
+    if (this->max_size > 0 and total_size > this->max_size) {
+      // least recently used first
+      std::sort(entries.begin(), entries.end(),
+                [](const Entry & a, const Entry & b) {
+                  return a.last_access < b.last_access;
+                });
+      for (const auto & entry : entries) {
+        if (total_size <= this->max_size) {
+          break;
+        }
+        // readers that mapped the entry keep a valid mapping
+        if (std::remove(entry.filename.c_str()) == 0) {
+          total_size -= entry.size;
+        }
+      }
+    }
+    this->size = total_size;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void FeatureCache::clear() {
+    std::lock_guard<std::mutex> lock{this->eviction_mutex};
+    for (const auto & entry : this->scan()) {
+      std::remove(entry.filename.c_str());
+    }
+    this->size = 0;
+  }
+
+}  // namespace rascal
@@ -0,0 +1,383 @@
+/**
+ * @file   rascal/representations/feature_cache.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief On-disk cache of the representations computed by the calculators
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_REPRESENTATIONS_FEATURE_CACHE_HH_
+#define SRC_RASCAL_REPRESENTATIONS_FEATURE_CACHE_HH_
+
+#include "rascal/representations/calculator_base.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/property_block_sparse.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+#include "rascal/utils/binary_io.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace rascal {
+
+  namespace internal {
+    //! hash of positions, atom types, cell, pbc and center mask
+    uint64_t hash_structure(StructureManagerCenters & manager);
+
+    /**
+     * hash of the atom tags of the centers and of their neighbours. The same
+     * structure can be given to neighbour lists with different cutoffs, which
+     * give different features and gradients.
+     */
+    template <class StructureManager>
+    uint64_t hash_clusters(StructureManager & manager, uint64_t hash) {
+      for (auto center : manager) {
+        int tag{center.get_atom_tag()};
+        hash = hash_bytes(&tag, sizeof(tag), hash);
+        uint64_t n_neighbours{center.pairs().size()};
+        hash = hash_bytes(&n_neighbours, sizeof(n_neighbours), hash);
+        for (auto neigh : center.pairs()) {
+          tag = neigh.get_atom_tag();
+          hash = hash_bytes(&tag, sizeof(tag), hash);
+        }
+      }
+      return hash;
+    }
+
+    /**
+     * Append the content of a BlockSparseProperty to a binary buffer.
+     */
+    class FeatureCacheWriter : public BinaryWriter {
+     public:
+      template <class Property>
+      void write_property(const Property & property) {
+        using Key_t = typename Property::Key_t;
+        static_assert(std::is_same<Key_t, std::vector<int>>::value,
+                      "only std::vector<int> keys are supported");
+        uint64_t n_entries{property.size()};
+        this->write(n_entries);
+        this->write<int32_t>(property.get_nb_row());
+        this->write<int32_t>(property.get_nb_col());
+        for (size_t i_entry{0}; i_entry < n_entries; ++i_entry) {
+          auto keys{property[i_entry].get_keys()};
+          this->write<uint64_t>(keys.size());
+          for (const auto & key : keys) {
+            this->write<uint64_t>(key.size());
+            this->write_array(key.data(), key.size());
+          }
+        }
+        // the data of each entry is contiguous and ordered by key
+        for (size_t i_entry{0}; i_entry < n_entries; ++i_entry) {
+          auto values{property[i_entry].get_full_vector()};
+          this->write<uint64_t>(values.size());
+          this->write_array(values.data(), values.size());
+        }
+      }
+    };
+
+    /**
+     * Read back what FeatureCacheWriter wrote from a memory mapped file.
+     *
+     * @throw std::runtime_error if reading past the end of the file
+     */
+    class FeatureCacheReader : public BinaryReader {
+     public:
+      using BinaryReader::BinaryReader;
+
+      /**
+       * Fill property with the data read. Returns false if the layout of the
+       * stored property does not match the manager it is attached to, e.g.
+       * the neighbour list has a different number of pairs.
+       */
+      template <class Property>
+      bool read_property(Property & property) {
+        using Key_t = typename Property::Key_t;
+        auto n_entries{this->read<uint64_t>()};
+        auto n_row{this->read<int32_t>()};
+        auto n_col{this->read<int32_t>()};
+
+        property.clear();
+        property.set_shape(n_row, n_col);
+        property.resize();
+        if (property.size() != n_entries) {
+          return false;
+        }
+        std::vector<std::set<Key_t>> keys_list(n_entries);
+        for (auto & keys : keys_list) {
+          auto n_keys{this->read<uint64_t>()};
+          for (uint64_t i_key{0}; i_key < n_keys; ++i_key) {
+            Key_t key(this->read<uint64_t>());
+            this->read_array(key.data(), key.size());
+            keys.insert(key);
+          }
+        }
+        property.resize(keys_list);
+        for (size_t i_entry{0}; i_entry < n_entries; ++i_entry) {
+          auto values{property[i_entry].get_full_vector()};
+          if (this->read<uint64_t>() != static_cast<uint64_t>(values.size())) {
+            return false;
+          }
+          this->read_array(values.data(), values.size());
+        }
+        return true;
+      }
+    };
+
+    //! can the features computed on StructureManager be cached
+    template <class StructureManager>
+    struct IsFeatureCacheable {
+      using Root_t = typename decltype(extract_underlying_manager<0>(
+          std::declval<std::shared_ptr<StructureManager>>()))::element_type;
+      static constexpr bool value{
+          std::is_same<Root_t, StructureManagerCenters>::value};
+    };
+  }  // namespace internal
+
+  /**
+   * Persistent cache of the features (and their gradients) computed by a
+   * calculator. Each entry is stored in its own file in the cache directory
+   * and is keyed by a hash of the hypers of the calculator and a hash of the
+   * atomic structure, so that the features of a structure are computed only
+   * once for a given set of hypers, across runs and processes.
+   *
+   * Entries are written to a temporary file that is then renamed so readers
+   * never see partially written entries. They are read through a read only
+   * memory mapping so that several processes can share the same cache.
+   *
+   * When the total size of the cache exceeds max_size (in bytes) the least
+   * recently used entries are removed. A max_size of 0 means no limit.
+   */
+  class FeatureCache {
+   public:
+    //! file extension of the cache entries
+    static const std::string Extension;
+
+    /**
+     * @param directory where the entries are stored, created if needed
+     * @param max_size maximum size of the cache in bytes, 0 for no limit
+     */
+    explicit FeatureCache(const std::string & directory, size_t max_size = 0);
+
+    //! Copy constructor
+    FeatureCache(const FeatureCache & other) = delete;
+
+    //! Move constructor
+    FeatureCache(FeatureCache && other) = delete;
+
+    //! Destructor
+    ~FeatureCache() = default;
+
+    //! Copy assignment operator
+    FeatureCache & operator=(const FeatureCache & other) = delete;
+
+    //! Move assignment operator
+    FeatureCache & operator=(FeatureCache && other) = delete;
+
+    /**
+     * Try to load the features computed by calculator on the structure of
+     * manager from the cache.
+     *
+     * @tparam Property type of the features
+     * @tparam PropertyGradient type of the gradients of the features
+     * @return true if the features (and gradients if the calculator computes
+     *         them) have been loaded
+     */
+    template <class Property, class PropertyGradient, class StructureManager>
+    bool load(CalculatorBase & calculator,
+              std::shared_ptr<StructureManager> manager,
+              bool exclude_ghosts);
+
+    /**
+     * Save the features computed by calculator on the structure of manager to
+     * the cache and evict old entries if the cache is too large.
+     */
+    template <class Property, class PropertyGradient, class StructureManager>
+    void store(CalculatorBase & calculator,
+               std::shared_ptr<StructureManager> manager, bool exclude_ghosts);
+
+    //! remove the least recently used entries until size <= max_size
+    void evict();
+
+    //! remove all the entries of the cache
+    void clear();
+
+    //! total size of the entries in bytes
+    size_t get_size() const { return this->size; }
+
+    size_t get_max_size() const { return this->max_size; }
+
+    void set_max_size(size_t max_size) {
+      this->max_size = max_size;
+      this->evict();
+    }
+
+    const std::string & get_directory() const { return this->directory; }
+
+    //! number of successful loads
+    size_t get_hits() const { return this->hits; }
+
+    //! number of unsuccessful loads
+    size_t get_misses() const { return this->misses; }
+
+   protected:
+    template <class StructureManager,
+              std::enable_if_t<
+                  internal::IsFeatureCacheable<StructureManager>::value, int> =
+                  0>
+    std::string get_entry_filename(CalculatorBase & calculator,
+                                   std::shared_ptr<StructureManager> manager) {
+      // the type of the stack is part of the key since the layout of the
+      // gradients depends on the neighbour list
+      std::string stack_name{typeid(StructureManager).name()};
+      auto root{extract_underlying_manager<0>(manager)};
+      auto structure_hash{internal::hash_structure(*root)};
+      structure_hash = internal::hash_bytes(stack_name.data(),
+                                            stack_name.size(), structure_hash);
+      structure_hash = internal::hash_clusters(*manager, structure_hash);
+      auto hypers{calculator.get_hypers_string()};
+      auto hypers_hash{internal::hash_bytes(hypers.data(), hypers.size())};
+      return this->get_entry_filename(hypers_hash, structure_hash);
+    }
+
+    //! only structures read by StructureManagerCenters can be cached
+    template <class StructureManager,
+              std::enable_if_t<
+                  not(internal::IsFeatureCacheable<StructureManager>::value),
+                  int> = 0>
+    std::string get_entry_filename(CalculatorBase &,
+                                   std::shared_ptr<StructureManager>) {
+      return std::string{};
+    }
+
+    std::string get_entry_filename(uint64_t hypers_hash,
+                                   uint64_t structure_hash) const;
+
+    /**
+     * Map filename and check its header.
+     *
+     * @return false if the entry does not exist or is invalid
+     */
+    bool open_entry(const std::string & filename, MappedFile & file,
+                    internal::FeatureCacheReader & reader);
+
+    //! atomically write buffer to filename
+    void write_entry(const std::string & filename,
+                     const internal::FeatureCacheWriter & writer);
+
+    //! write the header of an entry
+    void write_header(internal::FeatureCacheWriter & writer,
+                      uint64_t n_properties);
+
+    struct Entry {
+      std::string filename;
+      //! time of the last access in seconds
+      double last_access;
+      //! in bytes
+      size_t size;
+    };
+
+    //! list the entries of the cache directory
+    std::vector<Entry> scan() const;
+
+    std::string directory;
+    size_t max_size;
+    std::atomic<size_t> size{0};
+    std::atomic<size_t> hits{0};
+    std::atomic<size_t> misses{0};
+    //! serializes the evictions within the process
+    std::mutex eviction_mutex{};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  template <class Property, class PropertyGradient, class StructureManager>
+  bool FeatureCache::load(CalculatorBase & calculator,
+                          std::shared_ptr<StructureManager> manager,
+                          bool exclude_ghosts) {
+    auto filename{this->get_entry_filename(calculator, manager)};
+    if (filename.empty()) {
+      return false;
+    }
+    MappedFile file{};
+    internal::FeatureCacheReader reader{nullptr, nullptr};
+    bool is_loaded{false};
+    if (this->open_entry(filename, file, reader)) {
+      try {
+        auto n_properties{reader.read<uint64_t>()};
+        bool with_gradients{calculator.does_gradients()};
+        if (n_properties == (with_gradients ? 2u : 1u)) {
+          auto && features{*manager->template get_property<Property>(
+              calculator.get_name(), true, true, exclude_ghosts)};
+          is_loaded = reader.read_property(features);
+          if (is_loaded and with_gradients) {
+            auto && gradients{
+                *manager->template get_property<PropertyGradient>(
+                    calculator.get_gradient_name(), true, true)};
+            is_loaded = reader.read_property(gradients);
+          }
+        }
+      } catch (const std::runtime_error &) {
+        // a corrupted entry is a miss, it will be overwritten
+        is_loaded = false;
+      }
+    }
+    if (is_loaded) {
+      ++this->hits;
+    } else {
+      ++this->misses;
+    }
+    return is_loaded;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  template <class Property, class PropertyGradient, class StructureManager>
+  void FeatureCache::store(CalculatorBase & calculator,
+                           std::shared_ptr<StructureManager> manager,
+                           bool exclude_ghosts) {
+    auto filename{this->get_entry_filename(calculator, manager)};
+    if (filename.empty()) {
+      return;
+    }
+    bool with_gradients{calculator.does_gradients()};
+    internal::FeatureCacheWriter writer{};
+    this->write_header(writer, with_gradients ? 2 : 1);
+    auto && features{*manager->template get_property<Property>(
+        calculator.get_name(), true, false, exclude_ghosts)};
+    writer.write_property(features);
+    if (with_gradients) {
+      auto && gradients{*manager->template get_property<PropertyGradient>(
+          calculator.get_gradient_name(), true, false)};
+      writer.write_property(gradients);
+    }
+    this->write_entry(filename, writer);
+  }
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_REPRESENTATIONS_FEATURE_CACHE_HH_
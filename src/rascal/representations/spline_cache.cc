@@ -0,0 +1,211 @@
+/**
+ * @file   rascal/representations/spline_cache.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Implementation of the cache of the splines of the radial
+ *        contribution
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/representations/spline_cache.hh"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+namespace rascal {
+
+  namespace {
+    constexpr char CacheMagic[8] = {'R', 'A', 'S', 'C', 'A', 'L', 'S', 'C'};
+    // to bump whenever the layout of the entries or of the splines changes
+    constexpr uint32_t CacheVersion{3};
+    constexpr uint32_t CacheByteOrder{0x01020304};
+  }  // namespace
+
+  const std::string SplineCache::Extension{".rsc"};
+
+  /* ---------------------------------------------------------------------- */
+  SplineCache & SplineCache::get_instance() {
+    static SplineCache instance{};
+    return instance;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  bool SplineCache::load(const std::string & key, std::vector<char> & blob,
+                         const std::string & directory) {
+    {
+      std::lock_guard<std::mutex> lock{this->tables_mutex};
+      auto it{this->tables.find(key)};
+      if (it != this->tables.end()) {
+        blob = it->second;
+        ++this->hits;
+        return true;
+      }
+    }
+    if (not directory.empty() and
+        this->read_entry(this->get_entry_filename(key, directory), key,
+                         blob)) {
+      std::lock_guard<std::mutex> lock{this->tables_mutex};
+      this->tables[key] = blob;
+      ++this->hits;
+      return true;
+    }
+    ++this->misses;
+    return false;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void SplineCache::store(const std::string & key,
+                          const std::vector<char> & blob,
+                          const std::string & directory) {
+    {
+      std::lock_guard<std::mutex> lock{this->tables_mutex};
+      this->tables[key] = blob;
+    }
+    if (directory.empty()) {
+      return;
+    }
+    if (::mkdir(directory.c_str(), 0755) != 0 and errno != EEXIST) {
+      throw std::runtime_error(
+          "Could not create the spline cache directory: " + directory);
+    }
+    this->write_entry(this->get_entry_filename(key, directory), key, blob);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void SplineCache::clear() {
+    std::lock_guard<std::mutex> lock{this->tables_mutex};
+    this->tables.clear();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void SplineCache::clear_directory(const std::string & directory) {
+    DIR * dir{::opendir(directory.c_str())};
+    if (dir == nullptr) {
+      return;
+    }
+    const auto & extension{SplineCache::Extension};
+    while (auto * dir_entry = ::readdir(dir)) {
+      std::string name{dir_entry->d_name};
+      if (name.size() >= extension.size() and
+          name.compare(name.size() - extension.size(), extension.size(),
+                       extension) == 0) {
+        std::remove((directory + "/" + name).c_str());
+      }
+    }
+    ::closedir(dir);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  size_t SplineCache::size() {
+    std::lock_guard<std::mutex> lock{this->tables_mutex};
+    return this->tables.size();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  std::string
+  SplineCache::get_entry_filename(const std::string & key,
+                                  const std::string & directory) const {
+    std::stringstream filename{};
+    filename << directory << "/" << std::hex << std::setfill('0')
+             << std::setw(16) << internal::hash_bytes(key.data(), key.size())
+             << SplineCache::Extension;
+    return filename.str();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  bool SplineCache::read_entry(const std::string & filename,
+                               const std::string & key,
+                               std::vector<char> & blob) {
+    std::ifstream stream{filename, std::ios::binary};
+    if (not stream) {
+      return false;
+    }
+    std::vector<char> content{std::istreambuf_iterator<char>(stream),
+                              std::istreambuf_iterator<char>()};
+    internal::BinaryReader reader{content.data(),
+                                  content.data() + content.size()};
+    try {
+      char magic[sizeof(CacheMagic)];
+      reader.read_array(magic, sizeof(magic));
+      if (std::memcmp(magic, CacheMagic, sizeof(CacheMagic)) != 0 or
+          reader.read<uint32_t>() != CacheVersion or
+          reader.read<uint32_t>() != CacheByteOrder) {
+        return false;
+      }
+      // the file name is only a hash of the key
+      std::string entry_key(reader.read<uint64_t>(), '\0');
+      reader.read_array(&entry_key[0], entry_key.size());
+      if (entry_key != key) {
+        return false;
+      }
+    } catch (const std::runtime_error &) {
+      return false;
+    }
+    const size_t header_size{sizeof(CacheMagic) + 2 * sizeof(uint32_t) +
+                             sizeof(uint64_t) + key.size()};
+    blob.assign(content.begin() + header_size, content.end());
+    return true;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void SplineCache::write_entry(const std::string & filename,
+                                const std::string & key,
+                                const std::vector<char> & blob) {
+    internal::BinaryWriter writer{};
+    writer.write_array(CacheMagic, sizeof(CacheMagic));
+    writer.write(CacheVersion);
+    writer.write(CacheByteOrder);
+    writer.write<uint64_t>(key.size());
+    writer.write_array(key.data(), key.size());
+    writer.write_array(blob.data(), blob.size());
+    // the temporary file is unique to the thread so that concurrent writers
+    // of the same table do not interfere, the last rename wins
+    auto thread_id{std::hash<std::thread::id>{}(std::this_thread::get_id())};
+    std::string tmp_filename{filename + ".tmp" + std::to_string(::getpid()) +
+                             "-" + std::to_string(thread_id)};
+    {
+      std::ofstream stream{tmp_filename, std::ios::binary | std::ios::trunc};
+      stream.write(writer.buffer.data(), writer.buffer.size());
+      stream.close();
+      if (stream.fail()) {
+        std::remove(tmp_filename.c_str());
+        throw std::runtime_error("Could not write the spline cache entry: " +
+                                 tmp_filename);
+      }
+    }
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+      std::remove(tmp_filename.c_str());
+      throw std::runtime_error("Could not write the spline cache entry: " +
+                               filename);
+    }
+  }
+
+}  // namespace rascal
@@ -0,0 +1,237 @@
+/**
+ * @file   rascal/representations/spline_cache.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Process wide and on-disk cache of the splines of the radial
+ *        contribution
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_REPRESENTATIONS_SPLINE_CACHE_HH_
+#define SRC_RASCAL_REPRESENTATIONS_SPLINE_CACHE_HH_
+
+#include "rascal/math/interpolator.hh"
+#include "rascal/utils/binary_io.hh"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rascal {
+
+  namespace internal {
+    /**
+     * Append the tabulated values of a matrix spline and its boundary
+     * conditions to writer. The CacheVersion of the SplineCache has to be
+     * bumped whenever this layout changes.
+     */
+    template <class Spline>
+    void write_spline(BinaryWriter & writer, Spline & spline) {
+      auto grid{spline.get_grid_ref()};
+      auto evaluated_grid{spline.get_evaluated_grid_ref()};
+      writer.write<uint64_t>(grid.size());
+      writer.write<int32_t>(spline.get_rows());
+      writer.write<int32_t>(spline.get_cols());
+      writer.write_array(grid.data(), grid.size());
+      writer.write_array(evaluated_grid.data(), evaluated_grid.size());
+      uint8_t curvature{spline.has_curvature_boundary_conditions()};
+      writer.write(curvature);
+      if (curvature) {
+        writer.write_array(spline.get_d2fx1_ref().data(),
+                           spline.get_matrix_size());
+        writer.write_array(spline.get_d2fx2_ref().data(),
+                           spline.get_matrix_size());
+      }
+    }
+
+    //! Append the segments of a piecewise uniform spline to writer.
+    template <math::RefinementMethod_t RefinementMethod, class ErrorMethod_t>
+    void write_spline(BinaryWriter & writer,
+                      math::InterpolatorMatrixPiecewiseUniformCubicSpline<
+                          RefinementMethod, ErrorMethod_t> & spline) {
+      writer.write<int32_t>(spline.get_nb_segments());
+      for (int i_segment{0}; i_segment < spline.get_nb_segments();
+           ++i_segment) {
+        write_spline(writer, spline.get_segment(i_segment));
+      }
+    }
+
+    template <class Spline>
+    std::unique_ptr<Spline> read_spline(BinaryReader & reader);
+
+    //! Reads back the splines written with write_spline
+    template <class Spline>
+    struct SplineReader {
+      static std::unique_ptr<Spline> read(BinaryReader & reader) {
+        auto grid_size{reader.read<uint64_t>()};
+        auto rows{reader.read<int32_t>()};
+        auto cols{reader.read<int32_t>()};
+        math::Vector_t grid(grid_size);
+        reader.read_array(grid.data(), grid.size());
+        math::Matrix_t evaluated_grid(grid_size, rows * cols);
+        reader.read_array(evaluated_grid.data(), evaluated_grid.size());
+        if (reader.read<uint8_t>()) {
+          math::Vector_t d2fx1(rows * cols);
+          math::Vector_t d2fx2(rows * cols);
+          reader.read_array(d2fx1.data(), d2fx1.size());
+          reader.read_array(d2fx2.data(), d2fx2.size());
+          return std::make_unique<Spline>(grid, evaluated_grid, cols, rows,
+                                          d2fx1, d2fx2);
+        }
+        return std::make_unique<Spline>(grid, evaluated_grid, cols, rows);
+      }
+    };
+
+    template <math::RefinementMethod_t RefinementMethod, class ErrorMethod_t>
+    struct SplineReader<math::InterpolatorMatrixPiecewiseUniformCubicSpline<
+        RefinementMethod, ErrorMethod_t>> {
+      using Spline_t =
+          math::InterpolatorMatrixPiecewiseUniformCubicSpline<RefinementMethod,
+                                                              ErrorMethod_t>;
+      using Segment_t = typename Spline_t::Segment_t;
+
+      static std::unique_ptr<Spline_t> read(BinaryReader & reader) {
+        auto nb_segments{reader.read<int32_t>()};
+        if (nb_segments < 1) {
+          throw std::runtime_error("Invalid number of spline segments.");
+        }
+        std::vector<std::unique_ptr<Segment_t>> segments{};
+        for (int i_segment{0}; i_segment < nb_segments; ++i_segment) {
+          segments.push_back(read_spline<Segment_t>(reader));
+        }
+        return std::make_unique<Spline_t>(std::move(segments));
+      }
+    };
+
+    /**
+     * Rebuild a spline written with write_spline. Only the second
+     * derivatives of the spline are recomputed, the function is not
+     * evaluated.
+     *
+     * @throw std::runtime_error if the data is truncated
+     */
+    template <class Spline>
+    std::unique_ptr<Spline> read_spline(BinaryReader & reader) {
+      return SplineReader<Spline>::read(reader);
+    }
+  }  // namespace internal
+
+  /**
+   * Cache of the tables of the splines used to interpolate the radial
+   * contribution so that calculators constructed with the same hypers do not
+   * have to evaluate the radial integrals again to refine the splines.
+   *
+   * The tables are binary blobs keyed by a description of the hypers they
+   * depend on. They are kept for the lifetime of the process and, when a
+   * directory is given, also stored in their own file in that directory so
+   * that they can be shared across runs and processes. The files are named
+   * after a hash of the key and also contain the key itself, so that a
+   * table is only loaded for the exact same key. They are written to a
+   * temporary file that is then renamed so readers never see partially
+   * written tables.
+   */
+  class SplineCache {
+   public:
+    //! file extension of the tables stored on disk
+    static const std::string Extension;
+
+    //! the cache shared by the whole process
+    static SplineCache & get_instance();
+
+    //! Copy constructor
+    SplineCache(const SplineCache & other) = delete;
+
+    //! Move constructor
+    SplineCache(SplineCache && other) = delete;
+
+    //! Destructor
+    ~SplineCache() = default;
+
+    //! Copy assignment operator
+    SplineCache & operator=(const SplineCache & other) = delete;
+
+    //! Move assignment operator
+    SplineCache & operator=(SplineCache && other) = delete;
+
+    /**
+     * Look for the table associated with key in the process, then in
+     * directory if it is not empty.
+     *
+     * @return true if the table has been found and copied to blob
+     */
+    bool load(const std::string & key, std::vector<char> & blob,
+              const std::string & directory = "");
+
+    /**
+     * Keep blob as the table associated with key for the rest of the process
+     * and store it in directory if it is not empty.
+     *
+     * @throw std::runtime_error if directory can't be created or written to
+     */
+    void store(const std::string & key, const std::vector<char> & blob,
+               const std::string & directory = "");
+
+    //! forget the tables kept in the process, the files are left untouched
+    void clear();
+
+    //! remove the tables stored in directory
+    void clear_directory(const std::string & directory);
+
+    //! number of tables kept in the process
+    size_t size();
+
+    //! number of successful loads
+    size_t get_hits() const { return this->hits; }
+
+    //! number of unsuccessful loads
+    size_t get_misses() const { return this->misses; }
+
+   protected:
+    SplineCache() = default;
+
+    std::string get_entry_filename(const std::string & key,
+                                   const std::string & directory) const;
+
+    /**
+     * read the table associated with key stored in filename, false if
+     * missing, invalid or stored for another key
+     */
+    bool read_entry(const std::string & filename, const std::string & key,
+                    std::vector<char> & blob);
+
+    //! atomically write key and blob to filename
+    void write_entry(const std::string & filename, const std::string & key,
+                     const std::vector<char> & blob);
+
+    std::map<std::string, std::vector<char>> tables{};
+    std::mutex tables_mutex{};
+    std::atomic<size_t> hits{0};
+    std::atomic<size_t> misses{0};
+  };
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_REPRESENTATIONS_SPLINE_CACHE_HH_
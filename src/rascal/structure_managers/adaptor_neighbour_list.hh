@@ -816,10 +816,9 @@ namespace rascal {
     if (sizeof...(arguments) > 0) {
       // TODO(felix) should not have to assume that the underlying manager is
       // manager centers.
-      auto && atomic_structure{this->manager->get_atomic_structure()};
       // if the structure has not changed by more than skin**2
-      if (not atomic_structure.is_similar(std::forward<Args>(arguments)...,
-                                          this->skin2)) {
+      if (not this->manager->is_similar(std::forward<Args>(arguments)...,
+                                        this->skin2)) {
         this->need_update = true;
       } else {
         this->need_update = false;
@@ -30,6 +30,7 @@
 #define SRC_RASCAL_STRUCTURE_MANAGERS_ATOMIC_STRUCTURE_HH_
 
 #include "rascal/math/utils.hh"
+#include "rascal/structure_managers/updateable_base.hh"
 #include "rascal/utils/basic_types.hh"
 #include "rascal/utils/json_io.hh"
 
@@ -41,6 +42,8 @@
 
 // TODO(markus): CHECK for skewedness
 namespace rascal {
+  //! forward declaration, see structure_store.hh
+  struct MappedAtomicStructure;
 
   /**
    * A common structure to access atom and cell related data, based on the
@@ -344,6 +347,10 @@ namespace rascal {
 
     bool is_similar(const std::string &, double) const { return false; }
 
+    bool is_similar(const MappedAtomicStructure &, double) const {
+      return false;
+    }
+
     bool is_similar(const AtomicStructure<Dim> & other,
                     double threshold2) const {
       bool is_similar_{true};
@@ -392,6 +399,69 @@ namespace rascal {
       }
       return is_similar_;
     }
+
+    /**
+     * Find what differs between the incoming structure and itself.
+     *
+     * As for is_similar, a structure given as json, filename or read from a
+     * StructureStore is assumed to be completely different.
+     */
+    StructureChange get_changes() const { return StructureChange::None; }
+
+    StructureChange get_changes(const json_io::AtomicJsonData &) const {
+      return StructureChange::All;
+    }
+
+    StructureChange get_changes(const json &) const {
+      return StructureChange::All;
+    }
+
+    StructureChange get_changes(const std::string &) const {
+      return StructureChange::All;
+    }
+
+    StructureChange get_changes(const MappedAtomicStructure &) const {
+      return StructureChange::All;
+    }
+
+    StructureChange get_changes(const AtomicStructure<Dim> & other) const {
+      return this->get_changes(other.positions, other.atom_types, other.cell,
+                               other.pbc, other.center_atoms_mask);
+    }
+
+    StructureChange get_changes(const PositionsInput_t & positions,
+                                const AtomTypesInput_t & atom_types,
+                                const CellInput_t cell,
+                                const PBCInput_t & pbc) const {
+      auto center_atoms_mask = ArrayB_t::Ones(atom_types.size());
+      return this->get_changes(positions, atom_types, cell, pbc,
+                               center_atoms_mask);
+    }
+
+    StructureChange
+    get_changes(const PositionsInput_t & positions,
+                const AtomTypesInput_t & atom_types, const CellInput_t cell,
+                const PBCInput_t & pbc,
+                const ConstArrayBool_ref & center_atoms_mask) const {
+      if (this->positions.cols() != positions.cols()) {
+        return StructureChange::All;
+      }
+      StructureChange changes{StructureChange::None};
+      if ((this->positions.array() != positions.array()).any()) {
+        changes |= StructureChange::Positions;
+      }
+      if ((this->pbc.array() != pbc.array()).any() or
+          (this->cell.array() != cell.array()).any()) {
+        changes |= StructureChange::Cell;
+      }
+      if ((this->atom_types.array() != atom_types.array()).any()) {
+        changes |= StructureChange::AtomTypes;
+      }
+      if ((this->center_atoms_mask != center_atoms_mask).any()) {
+        changes |= StructureChange::CenterAtomsMask;
+      }
+      return changes;
+    }
   };
 
   /* ---------------------------------------------------------------------- */
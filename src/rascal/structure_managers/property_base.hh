@@ -110,6 +110,16 @@ namespace rascal {
 
     void set_updated_status(bool is_updated) { this->updated = is_updated; }
 
+    /**
+     * Topology version of the manager (see
+     * Updateable::get_topology_version) for which the layout of the property
+     * was built, 0 if it is unknown. When it matches the one of the manager
+     * the layout can be kept and only the values have to be recomputed.
+     */
+    size_t get_layout_version() const { return this->layout_version; }
+
+    void set_layout_version(size_t version) { this->layout_version = version; }
+
    protected:
     //!< base-class reference to StructureManager
     StructureManagerBase & base_manager;
@@ -124,6 +134,8 @@ namespace rascal {
     //! tells if the property is in synch with the underlying structure of
     //! the structure manager
     bool updated{false};
+    //! see get_layout_version
+    size_t layout_version{0};
     //! constructor
     PropertyBase(StructureManagerBase & manager, Dim_t nb_row, Dim_t nb_col,
                  size_t order, size_t layer,
@@ -520,6 +520,39 @@ namespace rascal {
         return val;
       }
 
+      /**
+       * dot product with another internally sorted map that leaves both maps
+       * untouched, so it can be called concurrently on shared features
+       */
+      Precision_t dot(const Self_t & B) const {
+        // avoid breaking down product if this and B have the same layout
+        if (this->get_key_hash() == B.get_key_hash() and
+            this->total_length == B.total_length) {
+          return this->get_full_vector().dot(B.get_full_vector());
+        }
+        // both maps are sorted by key
+        Precision_t val{0.};
+        auto it_a{this->map.cbegin()};
+        auto it_b{B.map.cbegin()};
+        while (it_a != this->map.cend() and it_b != B.map.cend()) {
+          if (it_a->first < it_b->first) {
+            ++it_a;
+          } else if (it_b->first < it_a->first) {
+            ++it_b;
+          } else {
+            const auto & posA{it_a->second};
+            const auto & posB{it_b->second};
+            const auto size{std::get<1>(posA) * std::get<2>(posA)};
+            val += VectorMapConst_Ref_t(&this->data[std::get<0>(posA)], size)
+                       .dot(VectorMapConst_Ref_t(&B.data[std::get<0>(posB)],
+                                                 size));
+            ++it_a;
+            ++it_b;
+          }
+        }
+        return val;
+      }
+
       /**
        * dot product from the left side
        * A = left_side_mat*A where A are all the key blocks
@@ -799,6 +832,7 @@ namespace rascal {
     void clear() {
       // this->values.resize(0);
       this->maps.clear();
+      this->layout_version = 0;
     }
 
     Manager_t & get_manager() {
@@ -901,33 +935,41 @@ namespace rascal {
      * missing entries are filled with zeros.
      * The features are flattened out following the underlying storage order.
      *
-     * @param features dense Eigen matrix of the proper size
+     * @param features dense Eigen matrix (or block of a matrix) of the proper
+     * size. Any scalar type and storage order is accepted so that the
+     * features can be written directly into a buffer provided by the caller,
+     * e.g. a row major single precision numpy array.
      *
      * @param all_keys set of all the keys that should be considered when
      * building the feature matrix
      *
      */
-    void fill_dense_feature_matrix(Eigen::Ref<Matrix_t> features,
+    template <class Derived>
+    void fill_dense_feature_matrix(const Eigen::MatrixBase<Derived> & features_,
                                    const Keys_t & all_keys) const {
+      using Scalar_t = typename Derived::Scalar;
+      using ConstRowMap_t =
+          const Eigen::Map<const Eigen::Matrix<Precision_t, 1, Eigen::Dynamic>>;
+      // features_ can be a temporary block expression, see the "Writing
+      // Functions Taking Eigen Types as Parameters" section of Eigen's doc
+      auto & features{const_cast<Eigen::MatrixBase<Derived> &>(features_)};
       int inner_size{this->get_nb_comp()};
-      int i_row{0};
       size_t n_center{this->maps.size()};
       for (size_t i_center{0}; i_center < n_center; i_center++) {
         int i_feat{0};
         const auto & center_val = this->maps[i_center];
         for (const auto & key : all_keys) {
-          if (this->maps[i_center].count(key) == 1) {
-            const auto & center_key_val = center_val[key];
-            for (int i_pos{0}; i_pos < inner_size; i_pos++) {
-              features(i_row, i_feat) = center_key_val(i_pos);
-              i_feat++;
-            }
+          auto && features_block{
+              features.block(i_center, i_feat, 1, inner_size)};
+          if (center_val.count(key) == 1) {
+            ConstRowMap_t center_key_val(center_val[key].data(), inner_size);
+            features_block = center_key_val.template cast<Scalar_t>();
           } else {
-            i_feat += inner_size;
+            features_block.setZero();
           }
+          i_feat += inner_size;
         }  // keys
-        i_row++;
-      }  // centers
+      }    // centers
     }
 
     /**
@@ -951,17 +993,23 @@ namespace rascal {
      * missing entries are filled with zeros.
      * The features are flattened out following the underlying storage order.
      *
-     * @param features dense Eigen matrix of the proper size
+     * @param features dense Eigen matrix (or block of a matrix) of the proper
+     * size, with any scalar type and storage order
      *
      * @param all_keys set of all the keys that should be considered when
      * building the feature matrix
      *
      */
-    void fill_dense_feature_matrix_gradient(Eigen::Ref<Matrix_t> features,
-                                            const Keys_t & all_keys) const {
+    template <class Derived>
+    void fill_dense_feature_matrix_gradient(
+        const Eigen::MatrixBase<Derived> & features_,
+        const Keys_t & all_keys) const {
       static_assert(Order_ == 2, "Gradients are a property of order 2.");
+      using Scalar_t = typename Derived::Scalar;
       using ConstMapSoapGradFlat_t = const Eigen::Map<
           const Eigen::Matrix<double, ThreeD, Eigen::Dynamic, Eigen::RowMajor>>;
+      // features_ can be a temporary block expression
+      auto & features{const_cast<Eigen::MatrixBase<Derived> &>(features_)};
       int inner_size{this->get_nb_comp() / ThreeD};
       int i_row_global{0};
       size_t n_pairs{this->maps.size()};
@@ -969,12 +1017,15 @@ namespace rascal {
         int i_feat{0};
         const auto & neigh_val = this->maps[i_pair];
         for (const auto & key : all_keys) {
-          if (this->maps[i_pair].count(key) == 1) {
+          auto && features_block{
+              features.block(i_row_global, i_feat, ThreeD, inner_size)};
+          if (neigh_val.count(key) == 1) {
             const auto & neigh_key_val = neigh_val[key];
             ConstMapSoapGradFlat_t neigh_key_val_flat(neigh_key_val.data(),
                                                       ThreeD, inner_size);
-            features.block(i_row_global, i_feat, ThreeD, inner_size) =
-                neigh_key_val_flat;
+            features_block = neigh_key_val_flat.template cast<Scalar_t>();
+          } else {
+            features_block.setZero();
           }
           i_feat += inner_size;
         }  // keys
@@ -982,6 +1033,83 @@ namespace rascal {
       }  // centers
     }
 
+    /**
+     * @return the number of non zero entries of the gradient feature matrix
+     * built with all_keys, i.e. the number of stored elements whose key is in
+     * all_keys. See fill_sparse_feature_matrix_gradient.
+     */
+    size_t get_nb_nonzero_gradient(const Keys_t & all_keys) const {
+      static_assert(Order_ == 2, "Gradients are a property of order 2.");
+      int inner_size{this->get_nb_comp() / ThreeD};
+      size_t n_nonzero{0};
+      for (const auto & neigh_val : this->maps) {
+        for (const auto & el : neigh_val) {
+          n_nonzero += all_keys.count(el.first) * inner_size;
+        }
+      }
+      return ThreeD * n_nonzero;
+    }
+
+    /**
+     * Fill the rows, starting at i_row, of a row major (CSR) sparse matrix
+     * with the gradients of the features. The matrix is the sparse
+     * counterpart of fill_dense_feature_matrix_gradient: only the blocks of
+     * the keys stored for each pair are written, the other keys of all_keys
+     * are implicit zeros.
+     *
+     * The matrix has to be compressed and have room for
+     * get_nb_nonzero_gradient entries after outerIndexPtr()[i_row], which is
+     * where the first entry is written.
+     *
+     * @param features row major Eigen::SparseMatrix of the proper size
+     *
+     * @param all_keys set of all the keys that should be considered when
+     * building the feature matrix
+     *
+     * @param i_row index of the first row to fill
+     */
+    template <class SparseMatrix>
+    void fill_sparse_feature_matrix_gradient(SparseMatrix & features,
+                                             const Keys_t & all_keys,
+                                             Eigen::Index i_row) const {
+      static_assert(Order_ == 2, "Gradients are a property of order 2.");
+      static_assert(SparseMatrix::IsRowMajor,
+                    "The sparse matrix should be row major.");
+      using StorageIndex_t = typename SparseMatrix::StorageIndex;
+      int inner_size{this->get_nb_comp() / ThreeD};
+      // column of the first element of each key in the feature matrix
+      std::map<Key_t, StorageIndex_t> key_cols{};
+      StorageIndex_t i_col{0};
+      for (const auto & key : all_keys) {
+        key_cols[key] = i_col;
+        i_col += inner_size;
+      }
+      auto outer{features.outerIndexPtr()};
+      auto inner{features.innerIndexPtr()};
+      auto values{features.valuePtr()};
+      StorageIndex_t i_nonzero{outer[i_row]};
+      for (const auto & neigh_val : this->maps) {
+        for (int i_der{0}; i_der < ThreeD; ++i_der) {
+          // keys are sorted in neigh_val so the columns are increasing
+          for (const auto & el : neigh_val) {
+            auto key_col{key_cols.find(el.first)};
+            if (key_col == key_cols.end()) {
+              continue;
+            }
+            // the block of the key is stored as [ThreeD, inner_size]
+            const Precision_t * block{el.second.data() + i_der * inner_size};
+            for (int i_pos{0}; i_pos < inner_size; ++i_pos) {
+              inner[i_nonzero] = key_col->second + i_pos;
+              values[i_nonzero] = block[i_pos];
+              ++i_nonzero;
+            }
+          }  // keys
+          ++i_row;
+          outer[i_row] = i_nonzero;
+        }  // derivatives
+      }    // pairs
+    }
+
     Matrix_t get_features_gradient() {
       auto all_keys = this->get_keys();
       return this->get_features_gradient(all_keys);
@@ -340,16 +340,24 @@ namespace rascal {
                               this->get_nb_col())(i_row, i_col);
     }
 
-    void fill_dense_feature_matrix(Eigen::Ref<Matrix_t> features) const {
+    /**
+     * Fill a dense feature matrix (or block of a matrix) of shape
+     * [N_{entries}, N_{comp}]. Any scalar type and storage order is accepted
+     * so that the features can be written directly into a buffer provided
+     * by the caller.
+     */
+    template <class Derived>
+    void fill_dense_feature_matrix(
+        const Eigen::MatrixBase<Derived> & features_) const {
+      using Scalar_t = typename Derived::Scalar;
+      // features_ can be a temporary block expression
+      auto & features{const_cast<Eigen::MatrixBase<Derived> &>(features_)};
       size_t n_center{this->get_nb_item()};
       auto n_cols{this->get_nb_comp()};
       auto mat = const_reference(this->values.data(), n_cols, n_center);
-      for (size_t i_center{0}; i_center < n_center; i_center++) {
-        for (int i_pos{0}; i_pos < n_cols; i_pos++) {
-          // the storage order is swapped here because mat is ColMajor
-          features(i_center, i_pos) = mat(i_pos, i_center);
-        }
-      }
+      // the storage order is swapped here because mat is ColMajor
+      features.topLeftCorner(n_center, n_cols) =
+          mat.transpose().template cast<Scalar_t>();
     }
 
     //! get number of different distinct element in the property
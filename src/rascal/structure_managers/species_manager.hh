@@ -158,11 +158,13 @@ namespace rascal {
      * invalid. This function triggers the setting of the statue variable to
      * `false` along the tree to the managers and the properties it holds.
      */
-    void send_changed_structure_signal() final {
+    void send_changed_structure_signal(
+        StructureChange changes = StructureChange::All) final {
+      this->register_structure_changes(changes);
       this->set_update_status(false);
       for (auto && child : this->children) {
         if (not child.expired()) {
-          child.lock()->send_changed_structure_signal();
+          child.lock()->send_changed_structure_signal(changes);
         }
       }
     }
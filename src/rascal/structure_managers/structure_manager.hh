@@ -753,12 +753,14 @@ namespace rascal {
      * invalid. This function triggers the setting of the statue variable to
      * `false` along the tree to the managers and the properties it holds.
      */
-    void send_changed_structure_signal() final {
+    void send_changed_structure_signal(
+        StructureChange changes = StructureChange::All) final {
+      this->register_structure_changes(changes);
       this->set_updated_property_status(false);
       this->set_update_status(false);
       for (auto && child : this->children) {
         if (not child.expired()) {
-          child.lock()->send_changed_structure_signal();
+          child.lock()->send_changed_structure_signal(changes);
         }
       }
     }
@@ -784,6 +786,15 @@ namespace rascal {
     void update_children() final {
       if (not this->get_update_status()) {
         this->implementation().update_self();
+        // a change of the positions or of the cell can make pairs enter or
+        // leave the cutoff, which modifies the layout of the properties. The
+        // manager is not flagged as updated yet so that the change is added
+        // to the ones sent with the update signal.
+        size_t fingerprint{this->get_clusters_fingerprint()};
+        if (fingerprint != this->clusters_fingerprint) {
+          this->clusters_fingerprint = fingerprint;
+          this->register_structure_changes(StructureChange::Neighbours);
+        }
         this->set_update_status(true);
       }
       for (auto && child : this->children) {
@@ -793,6 +804,39 @@ namespace rascal {
       }
     }
 
+    /**
+     * Hash of the atom tags and types of the centers and of their pairs. Two
+     * managers with the same fingerprint have (up to hash collisions) the
+     * same clusters in the same order.
+     */
+    template <bool C = (traits::MaxOrder >= 2), std::enable_if_t<C, int> = 0>
+    size_t get_clusters_fingerprint() {
+      constexpr size_t Prime{1099511628211UL};
+      size_t fingerprint{this->implementation().get_size()};
+      auto && mix{[&fingerprint](int value) {
+        fingerprint = (fingerprint ^ static_cast<size_t>(value)) * Prime;
+      }};
+      for (auto center : *this) {
+        mix(center.get_atom_tag());
+        mix(center.get_atom_type());
+        for (auto neigh : center.pairs()) {
+          mix(neigh.get_atom_tag());
+          mix(neigh.get_atom_type());
+        }
+      }
+      return fingerprint;
+    }
+
+    //! the centers are tracked with the StructureChange flags of the root
+    template <bool C = (traits::MaxOrder >= 2),
+              std::enable_if_t<not C, int> = 0>
+    size_t get_clusters_fingerprint() {
+      return 0;
+    }
+
+    //! fingerprint of the clusters at the last update
+    size_t clusters_fingerprint{0};
+
     //! returns the current layer
     template <size_t Order>
     constexpr static size_t cluster_layer() {
@@ -42,24 +42,31 @@ namespace rascal {
         static_cast<size_t>(this->get_positions().size() / traits::Dim)};
     this->n_ghosts = ntot - this->n_centers;
 
-    // initialize necessary data structure
-    this->atoms_index[0].clear();
-    this->offsets.clear();
-    internal::for_each(this->cluster_indices_container,
-                       internal::ResizePropertyToZero());
+    // the atom tag lists only depend on the number of atoms and on the mask
+    // so they are kept when e.g. only the positions changed
+    bool is_layout_changed{has_structure_change(
+        this->structure_changes, StructureChange::NumberOfAtoms |
+                                     StructureChange::CenterAtomsMask)};
+    if (is_layout_changed) {
+      // initialize necessary data structure
+      this->atoms_index[0].clear();
+      this->offsets.clear();
+      internal::for_each(this->cluster_indices_container,
+                         internal::ResizePropertyToZero());
 
-    // set the references to the center atoms positions and types
-    for (size_t id{0}; id < ntot; ++id) {
-      if (center_atoms_mask(id)) {
-        this->atoms_index[0].push_back(id);
-        this->offsets.push_back(id);
+      // set the references to the center atoms positions and types
+      for (size_t id{0}; id < ntot; ++id) {
+        if (center_atoms_mask(id)) {
+          this->atoms_index[0].push_back(id);
+          this->offsets.push_back(id);
+        }
       }
-    }
 
-    for (size_t id{0}; id < ntot; ++id) {
-      if (not center_atoms_mask(id)) {
-        this->atoms_index[0].push_back(id);
-        this->offsets.push_back(id);
+      for (size_t id{0}; id < ntot; ++id) {
+        if (not center_atoms_mask(id)) {
+          this->atoms_index[0].push_back(id);
+          this->offsets.push_back(id);
+        }
       }
     }
 
@@ -68,7 +75,8 @@ namespace rascal {
 
     // Check if all atoms are inside the unit cell assuming the cell starts
     // at (0,0,0)
-    auto positions_scaled = this->atoms_object.get_scaled_positions();
+    Positions_t positions_scaled =
+        this->atoms_object.cell.inverse() * this->get_positions();
     double tol{1e-10};
     if ((positions_scaled.array().rowwise().minCoeff() < -tol).any() or
         (positions_scaled.array().rowwise().maxCoeff() > 1. + tol).any()) {
@@ -80,8 +88,11 @@ namespace rascal {
     // center_atoms_mask.all() is false is no centers are masked
     this->are_any_centers_masked = not center_atoms_mask.all();
 
-    auto & atom_cluster_indices{std::get<0>(this->cluster_indices_container)};
-    atom_cluster_indices.fill_sequence();
+    if (is_layout_changed) {
+      auto & atom_cluster_indices{
+          std::get<0>(this->cluster_indices_container)};
+      atom_cluster_indices.fill_sequence();
+    }
 
     if ((this->atoms_object.atom_types.array() >= MaxChemElements).any() or
         (this->atoms_object.atom_types.array() < 0).any()) {
@@ -92,6 +103,27 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  void StructureManagerCenters::update_self(
+      const MappedAtomicStructure & structure) {
+    auto n_atoms{structure.get_number_of_atoms()};
+    this->atoms_object.cell = structure.get_cell();
+    this->atoms_object.pbc = structure.get_pbc();
+    this->atoms_object.atom_types = structure.get_atom_types();
+    this->atoms_object.center_atoms_mask =
+        structure.get_center_atoms_mask() != 0;
+    // the positions are read from the mapping
+    this->atoms_object.positions.resize(traits::Dim, 0);
+    this->mapped_store = structure.store;
+    this->mapped_positions = structure.get_positions().data();
+
+    if (n_atoms == 0) {
+      // an empty map would be indistinguishable from a non mapped structure
+      this->release_mapped_structure();
+    }
+    this->build();
+  }
+
   /* ---------------------------------------------------------------------- */
   // returns the number of cluster at Order=1, which is the number of atoms
   size_t StructureManagerCenters::get_nb_clusters(size_t order) const {
@@ -36,6 +36,7 @@
 #include "rascal/structure_managers/atomic_structure.hh"
 #include "rascal/structure_managers/lattice.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/structure_managers/structure_store.hh"
 #include "rascal/utils/basic_types.hh"
 #include "rascal/utils/json_io.hh"
 
@@ -181,8 +182,9 @@ namespace rascal {
     template <class... Args>
     void update(Args &&... arguments) {
       if (sizeof...(arguments) > 0) {
-        // the structure has changed to tell it to the whole tree
-        this->send_changed_structure_signal();
+        // the structure has changed to tell it to the whole tree, with what
+        // changed so that the layouts can be kept when possible
+        this->send_changed_structure_signal(this->get_changes(arguments...));
       }
 
       // update the underlying structure
@@ -239,9 +241,17 @@ namespace rascal {
       return Vector_ref(xval);
     }
 
-    //! returns a map to all atomic positions.
+    /**
+     * returns a map to all atomic positions. When the structure comes from a
+     * StructureStore the map points directly to the mapped file.
+     */
     Positions_ref get_positions() {
-      return Positions_ref(this->atoms_object.positions);
+      if (this->mapped_positions == nullptr) {
+        return Positions_ref(this->atoms_object.positions);
+      }
+      Eigen::Map<Positions_t> positions(this->mapped_positions, traits::Dim,
+                                        this->atoms_object.atom_types.size());
+      return Positions_ref(positions);
     }
 
     //! returns number of I atoms in the list
@@ -309,14 +319,65 @@ namespace rascal {
     /**
      * Use AtomObject to read the incoming structure
      */
-    template <class... Args>
+    template <class... Args,
+              std::enable_if_t<
+                  not(internal::IsMappedAtomicStructure<Args...>::value), int> =
+                  0>
     void update_self(Args &&... arguments) {
+      this->release_mapped_structure();
       this->atoms_object.set_structure(std::forward<Args>(arguments)...);
       this->build();
     }
 
-    const AtomicStructure<traits::Dim> & get_atomic_structure() const {
-      return this->atoms_object;
+    /**
+     * Read the structure from a StructureStore. The positions are not copied,
+     * they are accessed through the mapping of the store which is kept alive
+     * by the manager.
+     */
+    void update_self(const MappedAtomicStructure & structure);
+
+    /**
+     * Get a copy of the atomic structure of the manager. When the positions
+     * are read from a StructureStore they are copied from the mapping into
+     * the returned structure, the manager keeps reading from the mapping.
+     */
+    AtomicStructure<traits::Dim> get_atomic_structure() const {
+      AtomicStructure<traits::Dim> structure{this->atoms_object};
+      if (this->mapped_positions != nullptr) {
+        structure.positions = Eigen::Map<const Positions_t>(
+            this->mapped_positions, traits::Dim,
+            this->atoms_object.atom_types.size());
+      }
+      return structure;
+    }
+
+    //! is the structure read from a StructureStore
+    bool is_mapped() const { return this->mapped_positions != nullptr; }
+
+    /**
+     * Check if the structure defined by arguments is similar to the current
+     * one, see AtomicStructure::is_similar. A structure read from a
+     * StructureStore is never considered similar.
+     */
+    template <class... Args>
+    bool is_similar(Args &&... arguments) const {
+      if (this->is_mapped()) {
+        return false;
+      }
+      return this->atoms_object.is_similar(std::forward<Args>(arguments)...);
+    }
+
+    /**
+     * Find what differs between the structure defined by arguments and the
+     * current one, see AtomicStructure::get_changes. A structure read from a
+     * StructureStore is always considered different.
+     */
+    template <class... Args>
+    StructureChange get_changes(const Args &... arguments) const {
+      if (this->is_mapped()) {
+        return StructureChange::All;
+      }
+      return this->atoms_object.get_changes(arguments...);
     }
 
     bool is_not_masked() const { return (not this->are_any_centers_masked); }
@@ -324,6 +385,13 @@ namespace rascal {
    protected:
     //! makes atom tag lists and offsets
     void build();
+
+    //! stop reading the positions from the StructureStore
+    void release_mapped_structure() {
+      this->mapped_positions = nullptr;
+      this->mapped_store.reset();
+    }
+
     /**
      * Get a ptr of the previous manager, required for forwarding requests
      * downwards a stack. Since there is no last manager, the manager returns
@@ -341,9 +409,18 @@ namespace rascal {
      * Object which can interface to the json header to read and write atom
      * related data in the ASE format: positions, cell, periodicity, atom types
      * (corresponding to element numbers)
+     *
+     * When the structure is read from a StructureStore its positions are left
+     * empty (see get_atomic_structure).
      */
     AtomicStructure<traits::Dim> atoms_object{};
 
+    //! positions in the mapping of mapped_store, nullptr if not mapped
+    double * mapped_positions{nullptr};
+
+    //! keeps the mapping of the positions alive
+    std::shared_ptr<const StructureStore> mapped_store{};
+
     //! Lattice type for storing the cell and querying cell-related data
     Lattice<traits::Dim> lattice;
 
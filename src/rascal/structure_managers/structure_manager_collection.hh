@@ -32,10 +32,16 @@
 #include "rascal/structure_managers/make_structure_manager.hh"
 #include "rascal/structure_managers/property.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/structure_managers/structure_store.hh"
 #include "rascal/structure_managers/updateable_base.hh"
 #include "rascal/utils/json_io.hh"
 #include "rascal/utils/utils.hh"
 
+#include <Eigen/SparseCore>
+
+#include <array>
+#include <sstream>
+
 namespace rascal {
 
   /**
@@ -71,6 +77,9 @@ namespace rascal {
     using Data_t = std::vector<ManagerPtr_t>;
     using value_type = typename Data_t::value_type;
     using Matrix_t = math::Matrix_t;
+    //! 64 bits indices so that large datasets can be exported
+    using SparseMatrix_t =
+        Eigen::SparseMatrix<double, Eigen::RowMajor, Eigen::Index>;
 
    protected:
     Data_t managers{};
@@ -221,6 +230,42 @@ namespace rascal {
       }
     }
 
+    /**
+     * Add the structures of a StructureStore to the collection. The positions
+     * are not copied, the managers read them directly from the mapping.
+     *
+     * @param store the memory-mapped structure store
+     * @param start index of the first structure to include
+     * @param length number of structure to include, -1 correspondons to all
+     * after start
+     */
+    void add_structures(const std::shared_ptr<const StructureStore> & store,
+                        int start = 0, int length = -1) {
+      int n_structures{static_cast<int>(store->size())};
+      if (start < 0 or start > n_structures) {
+        std::stringstream error{};
+        error << "start '" << start << "' is out of bound for the '"
+              << n_structures << "' structures of the store.";
+        throw std::runtime_error(error.str());
+      }
+      if (length < -1 or start + length > n_structures) {
+        std::stringstream error{};
+        error << "length '" << length << "' starting from '" << start
+              << "' is out of bound for the '" << n_structures
+              << "' structures of the store.";
+        throw std::runtime_error(error.str());
+      }
+      if (length == -1) {
+        length = n_structures - start;
+      }
+      Hypers_t empty_structure = Hypers_t::object();
+      this->managers.reserve(this->managers.size() + length);
+      for (int index{start}; index < start + length; ++index) {
+        this->add_structure(empty_structure);
+        this->managers.back()->update(store->get_structure(index));
+      }
+    }
+
     void add_structures(const Hypers_t & structures,
                         const Hypers_t & adaptors_inputs) {
       if (not structures.is_array()) {
@@ -321,21 +366,166 @@ namespace rascal {
      */
     template <class Calculator>
     Matrix_t get_features(const Calculator & calculator) {
+      auto shape{this->get_features_shape(calculator)};
+      Matrix_t features(shape[0], shape[1]);
+      this->fill_features(calculator, features);
+      return features;
+    }
+
+    /**
+     * @return the shape of the feature matrix returned by get_features, so
+     * that the caller can allocate it, e.g. as a memory mapped file.
+     */
+    template <class Calculator>
+    std::array<size_t, 2> get_features_shape(const Calculator & calculator) {
       using Prop_t = typename Calculator::template Property_t<Manager_t>;
+      auto property_name{this->get_calculator_name(calculator, false)};
+      auto n_rows{this->template get_number_of_elements<Prop_t>(property_name)};
+      auto n_cols{FeatureMatrixHelper<Prop_t>::get_n_cols(this->managers,
+                                                          property_name)};
+      return {{n_rows, n_cols}};
+    }
 
+    /**
+     * Write the dense feature matrix associated with calculator (see
+     * get_features) into a matrix allocated by the caller, e.g. a map to a
+     * (memory mapped) numpy array, so that no intermediate copy of the
+     * features is made. Any scalar type and storage order is accepted.
+     *
+     * @throw std::runtime_error if features does not have the shape given
+     * by get_features_shape
+     */
+    template <class Calculator, class Derived>
+    void fill_features(const Calculator & calculator,
+                       const Eigen::MatrixBase<Derived> & features) {
+      using Prop_t = typename Calculator::template Property_t<Manager_t>;
       auto property_name{this->get_calculator_name(calculator, false)};
+      this->check_features_shape(features,
+                                 this->get_features_shape(calculator));
+      FeatureMatrixHelper<Prop_t>::apply(this->managers, property_name,
+                                         features);
+    }
 
-      auto && property_ =
-          *managers[0]->template get_property<Prop_t>(property_name);
-      // assume inner_size is consistent for all managers
-      int inner_size{property_.get_nb_comp()};
+    /**
+     * Should only be used if calculator has BlockSparseProperty.
+     * @return the shape of the feature matrix built with the keys all_keys
+     */
+    template <class Calculator, class Keys>
+    std::array<size_t, 2> get_features_shape(const Calculator & calculator,
+                                             const Keys & all_keys) {
+      using Prop_t = typename Calculator::template Property_t<Manager_t>;
+      return this->template get_block_sparse_shape<Prop_t>(
+          this->get_calculator_name(calculator, false), all_keys, 1);
+    }
 
-      Matrix_t features{};
+    /**
+     * Should only be used if calculator has BlockSparseProperty.
+     * Same as fill_features but the columns of the feature matrix are given
+     * by all_keys instead of the keys present in the managers.
+     */
+    template <class Calculator, class Keys, class Derived>
+    void fill_features(const Calculator & calculator, const Keys & all_keys,
+                       const Eigen::MatrixBase<Derived> & features) {
+      using Prop_t = typename Calculator::template Property_t<Manager_t>;
+      auto property_name{this->get_calculator_name(calculator, false)};
+      this->check_features_shape(
+          features, this->template get_block_sparse_shape<Prop_t>(
+                        property_name, all_keys, 1));
+      auto & features_{const_cast<Eigen::MatrixBase<Derived> &>(features)};
+      int n_cols{static_cast<int>(features_.cols())};
+      int i_row{0};
+      for (auto & manager : this->managers) {
+        auto && property =
+            *manager->template get_property<Prop_t>(property_name);
+        int n_rows_manager = property.size();
+        property.fill_dense_feature_matrix(
+            features_.block(i_row, 0, n_rows_manager, n_cols), all_keys);
+        i_row += n_rows_manager;
+      }
+    }
 
-      auto n_rows{this->template get_number_of_elements<Prop_t>(property_name)};
+    /**
+     * Should only be used if calculator has BlockSparseProperty.
+     * @return the shape of the feature gradient matrix built with the keys
+     * all_keys
+     */
+    template <class Calculator, class Keys>
+    std::array<size_t, 2>
+    get_features_gradient_shape(const Calculator & calculator,
+                                const Keys & all_keys) {
+      using Prop_t =
+          typename Calculator::template PropertyGradient_t<Manager_t>;
+      return this->template get_block_sparse_shape<Prop_t>(
+          this->get_calculator_name(calculator, true), all_keys, ThreeD);
+    }
 
-      FeatureMatrixHelper<Prop_t>::apply(this->managers, property_name,
-                                         features, n_rows, inner_size);
+    /**
+     * Should only be used if calculator has BlockSparseProperty.
+     * Write the dense gradients of the features built with the keys all_keys
+     * into a matrix allocated by the caller. It has 3 rows per entry of the
+     * gradient property, see get_features_gradient_shape.
+     */
+    template <class Calculator, class Keys, class Derived>
+    void fill_features_gradient(const Calculator & calculator,
+                                const Keys & all_keys,
+                                const Eigen::MatrixBase<Derived> & features) {
+      using Prop_t =
+          typename Calculator::template PropertyGradient_t<Manager_t>;
+      auto property_name{this->get_calculator_name(calculator, true)};
+      this->check_features_shape(
+          features, this->template get_block_sparse_shape<Prop_t>(
+                        property_name, all_keys, ThreeD));
+      auto & features_{const_cast<Eigen::MatrixBase<Derived> &>(features)};
+      int n_cols{static_cast<int>(features_.cols())};
+      int i_row{0};
+      for (auto & manager : this->managers) {
+        auto && property =
+            *manager->template get_property<Prop_t>(property_name);
+        int n_rows_manager = property.size() * ThreeD;
+        property.fill_dense_feature_matrix_gradient(
+            features_.block(i_row, 0, n_rows_manager, n_cols), all_keys);
+        i_row += n_rows_manager;
+      }
+    }
+
+    /**
+     * Should only be used if calculator has BlockSparseProperty.
+     * Get the gradients of the features built with the keys all_keys as a
+     * row major (CSR) sparse matrix with the same layout as the dense matrix
+     * filled by fill_features_gradient. The gradient of the features of a
+     * center with respect to a neighbour is only non zero for the keys that
+     * involve the species of the neighbour, so for multi-species systems
+     * most of the dense matrix is made of zeros.
+     *
+     * The matrix is built directly from the blocks of the properties, the
+     * explicitly stored entries are the ones of the keys stored for each
+     * pair (they can still be zero).
+     */
+    template <class Calculator, class Keys>
+    SparseMatrix_t get_features_gradient_sparse(const Calculator & calculator,
+                                                const Keys & all_keys) {
+      using Prop_t =
+          typename Calculator::template PropertyGradient_t<Manager_t>;
+      auto property_name{this->get_calculator_name(calculator, true)};
+      auto shape{this->template get_block_sparse_shape<Prop_t>(
+          property_name, all_keys, ThreeD)};
+      size_t n_nonzero{0};
+      for (auto & manager : this->managers) {
+        auto && property =
+            *manager->template get_property<Prop_t>(property_name);
+        n_nonzero += property.get_nb_nonzero_gradient(all_keys);
+      }
+      SparseMatrix_t features(shape[0], shape[1]);
+      features.resizeNonZeros(n_nonzero);
+      features.outerIndexPtr()[0] = 0;
+      Eigen::Index i_row{0};
+      for (auto & manager : this->managers) {
+        auto && property =
+            *manager->template get_property<Prop_t>(property_name);
+        property.fill_sparse_feature_matrix_gradient(features, all_keys,
+                                                     i_row);
+        i_row += property.size() * ThreeD;
+      }
       return features;
     }
 
@@ -400,10 +590,41 @@ namespace rascal {
     }
 
    protected:
+    //! shape of a block sparse feature matrix with n_rows_per_entry rows
+    template <class Prop_t, class Keys>
+    std::array<size_t, 2>
+    get_block_sparse_shape(const std::string & property_name,
+                           const Keys & all_keys, size_t n_rows_per_entry) {
+      if (this->managers.size() == 0) {
+        throw std::runtime_error("There are no structure to get features from");
+      }
+      auto && property_ =
+          *this->managers[0]->template get_property<Prop_t>(property_name);
+      // assume inner_size is consistent for all managers
+      size_t inner_size{property_.get_nb_comp() / n_rows_per_entry};
+      auto n_rows{this->template get_number_of_elements<Prop_t>(property_name)};
+      return {{n_rows_per_entry * n_rows, all_keys.size() * inner_size}};
+    }
+
+    template <class Derived>
+    static void
+    check_features_shape(const Eigen::MatrixBase<Derived> & features,
+                         const std::array<size_t, 2> & shape) {
+      if (static_cast<size_t>(features.rows()) != shape[0] or
+          static_cast<size_t>(features.cols()) != shape[1]) {
+        std::stringstream err_str{};
+        err_str << "The feature matrix has shape (" << features.rows() << ", "
+                << features.cols() << ") but (" << shape[0] << ", "
+                << shape[1] << ") is expected.";
+        throw std::runtime_error(err_str.str());
+      }
+    }
+
     /**
      * Helper classes to deal with the differentiation between Property and
      * BlockSparseProperty when filling the feature matrix.
-     * Fills a feature matrix with the properties contained in managers.
+     * Fills a feature matrix, already allocated with get_n_cols columns, with
+     * the properties contained in managers.
      */
     template <typename T>
     struct FeatureMatrixHelper {};
@@ -411,17 +632,26 @@ namespace rascal {
     template <typename T, size_t Order, int NbRow, int NbCol>
     struct FeatureMatrixHelper<Property<T, Order, Manager_t, NbRow, NbCol>> {
       using Prop_t = Property<T, Order, Manager_t, NbRow, NbCol>;
-      template <class StructureManagers, class Matrix>
+
+      template <class StructureManagers>
+      static size_t get_n_cols(StructureManagers & managers,
+                               const std::string & property_name) {
+        auto && property_ =
+            *managers[0]->template get_property<Prop_t>(property_name);
+        return property_.get_nb_comp();
+      }
+
+      template <class StructureManagers, class Derived>
       static void apply(StructureManagers & managers,
-                        const std::string & property_name, Matrix & features,
-                        int n_rows, int inner_size) {
-        features.resize(n_rows, inner_size);
-        features.setZero();
+                        const std::string & property_name,
+                        const Eigen::MatrixBase<Derived> & features_) {
+        auto & features{const_cast<Eigen::MatrixBase<Derived> &>(features_)};
+        int inner_size{static_cast<int>(features.cols())};
         int i_row{0};
         for (auto & manager : managers) {
           auto && property =
               *manager->template get_property<Prop_t>(property_name);
-          auto n_rows_manager = property.get_nb_item();
+          int n_rows_manager = property.get_nb_item();
           property.fill_dense_feature_matrix(
               features.block(i_row, 0, n_rows_manager, inner_size));
           i_row += n_rows_manager;
@@ -434,15 +664,10 @@ namespace rascal {
       using Prop_t = BlockSparseProperty<T, Order, Manager_t, Key>;
       using Keys_t = typename Prop_t::Keys_t;
 
-      /**
-       * Fill features matrix with the representation labeled with
-       * property_name present in managers using the keys in present in the
-       * accross the managers.
-       */
-      template <class StructureManagers, class Matrix>
-      static void apply(StructureManagers & managers,
-                        const std::string & property_name, Matrix & features,
-                        int n_rows, int inner_size) {
+      //! keys present accross the managers
+      template <class StructureManagers>
+      static Keys_t get_keys(StructureManagers & managers,
+                             const std::string & property_name) {
         Keys_t all_keys{};
         for (auto & manager : managers) {
           auto && property =
@@ -450,15 +675,36 @@ namespace rascal {
           auto keys = property.get_keys();
           all_keys.insert(keys.begin(), keys.end());
         }
+        return all_keys;
+      }
+
+      template <class StructureManagers>
+      static size_t get_n_cols(StructureManagers & managers,
+                               const std::string & property_name) {
+        auto && property_ =
+            *managers[0]->template get_property<Prop_t>(property_name);
+        // assume inner_size is consistent for all managers
+        return get_keys(managers, property_name).size() *
+               property_.get_nb_comp();
+      }
 
-        size_t n_cols{all_keys.size() * inner_size};
-        features.resize(n_rows, n_cols);
-        features.setZero();
+      /**
+       * Fill features matrix with the representation labeled with
+       * property_name present in managers using the keys in present in the
+       * accross the managers.
+       */
+      template <class StructureManagers, class Derived>
+      static void apply(StructureManagers & managers,
+                        const std::string & property_name,
+                        const Eigen::MatrixBase<Derived> & features_) {
+        auto & features{const_cast<Eigen::MatrixBase<Derived> &>(features_)};
+        auto all_keys{get_keys(managers, property_name)};
+        int n_cols{static_cast<int>(features.cols())};
         int i_row{0};
         for (auto & manager : managers) {
           auto && property =
               *manager->template get_property<Prop_t>(property_name);
-          auto n_rows_manager = property.size();
+          int n_rows_manager = property.size();
           property.fill_dense_feature_matrix(
               features.block(i_row, 0, n_rows_manager, n_cols), all_keys);
           i_row += n_rows_manager;
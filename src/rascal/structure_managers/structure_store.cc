@@ -0,0 +1,294 @@
+/**
+ * @file   rascal/structure_managers/structure_store.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Implementation of the memory-mapped structure store
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/structure_managers/structure_store.hh"
+
+#include "rascal/utils/json_io.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace rascal {
+
+  namespace {
+    constexpr char StoreMagic[8] = {'R', 'A', 'S', 'C', 'A', 'L', 'S', 'S'};
+  }  // namespace
+
+  static_assert(sizeof(int) == sizeof(int32_t),
+                "the atom types are stored as 32 bits integers");
+
+  /* ---------------------------------------------------------------------- */
+  size_t MappedAtomicStructure::get_number_of_atoms() const {
+    return this->store->get_number_of_atoms(this->index);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  MappedAtomicStructure::PositionsMap_t
+  MappedAtomicStructure::get_positions() const {
+    return PositionsMap_t(this->store->get_positions_data(this->index), 3,
+                          this->get_number_of_atoms());
+  }
+
+  /* ---------------------------------------------------------------------- */
+  MappedAtomicStructure::ConstAtomTypesMap_t
+  MappedAtomicStructure::get_atom_types() const {
+    return ConstAtomTypesMap_t(this->store->get_atom_types_data(this->index),
+                               this->get_number_of_atoms());
+  }
+
+  /* ---------------------------------------------------------------------- */
+  MappedAtomicStructure::ConstCellMap_t
+  MappedAtomicStructure::get_cell() const {
+    return ConstCellMap_t(this->store->get_cell_data(this->index));
+  }
+
+  /* ---------------------------------------------------------------------- */
+  MappedAtomicStructure::ConstPBCMap_t MappedAtomicStructure::get_pbc() const {
+    return ConstPBCMap_t(this->store->get_pbc_data(this->index));
+  }
+
+  /* ---------------------------------------------------------------------- */
+  MappedAtomicStructure::ConstMaskMap_t
+  MappedAtomicStructure::get_center_atoms_mask() const {
+    return ConstMaskMap_t(
+        this->store->get_center_atoms_mask_data(this->index),
+        this->get_number_of_atoms());
+  }
+
+  /* ---------------------------------------------------------------------- */
+  AtomicStructure<3> MappedAtomicStructure::get_atomic_structure() const {
+    AtomicStructure<3> structure{};
+    structure.positions = this->get_positions();
+    structure.atom_types = this->get_atom_types();
+    structure.cell = this->get_cell();
+    structure.pbc = this->get_pbc();
+    structure.center_atoms_mask = this->get_center_atoms_mask() != 0;
+    return structure;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  StructureStore::StructureStore(const std::string & filename)
+      : file{filename, MappedFile::Mode::CopyOnWrite} {
+    this->validate();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  MappedAtomicStructure StructureStore::get_structure(size_t index) const {
+    if (index >= this->size()) {
+      std::stringstream err_str{};
+      err_str << "Structure index '" << index << "' is out of bound for '"
+              << this->size() << "' structures in the store '"
+              << this->get_filename() << "'.";
+      throw std::out_of_range(err_str.str());
+    }
+    return MappedAtomicStructure{this->shared_from_this(), index};
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void StructureStore::validate() const {
+    const auto & filename{this->get_filename()};
+    if (this->file.size() < sizeof(Header_t)) {
+      throw std::runtime_error("The file '" + filename +
+                               "' is too small to be a structure store.");
+    }
+    const auto & head{this->header()};
+    if (std::memcmp(head.magic, StoreMagic, sizeof(StoreMagic)) != 0) {
+      throw std::runtime_error("The file '" + filename +
+                               "' is not a structure store.");
+    }
+    if (head.byte_order != Header_t::ByteOrder) {
+      throw std::runtime_error("The structure store '" + filename +
+                               "' was written with a different endianness.");
+    }
+    if (head.version != Header_t::Version) {
+      std::stringstream err_str{};
+      err_str << "The structure store '" << filename << "' has version '"
+              << head.version << "' but only version '" << Header_t::Version
+              << "' is supported.";
+      throw std::runtime_error(err_str.str());
+    }
+
+    // check that every column fits in the file, every structure and atom
+    // takes at least one byte so bounding the counts by the file size first
+    // keeps the column sizes from overflowing
+    const uint64_t file_size{this->file.size()};
+    auto check_column = [&](uint64_t offset, uint64_t n_bytes) {
+      if (head.n_structures >= file_size or head.n_atoms > file_size or
+          offset > file_size or n_bytes > file_size - offset) {
+        throw std::runtime_error("The structure store '" + filename +
+                                 "' is truncated.");
+      }
+    };
+    check_column(head.atom_offsets,
+                 (head.n_structures + 1) * sizeof(uint64_t));
+    check_column(head.cells, head.n_structures * 9 * sizeof(double));
+    check_column(head.pbc, head.n_structures * 3 * sizeof(int32_t));
+    check_column(head.positions, head.n_atoms * 3 * sizeof(double));
+    check_column(head.atom_types, head.n_atoms * sizeof(int32_t));
+    check_column(head.center_atoms_mask, head.n_atoms * sizeof(uint8_t));
+
+    // the atom offsets must start at 0, never decrease and end at n_atoms
+    // so that the atom range of every structure lies in the per-atom fields
+    const uint64_t * atom_offsets{this->atom_offsets()};
+    bool consistent_offsets{atom_offsets[0] == 0 and
+                            atom_offsets[head.n_structures] == head.n_atoms};
+    for (uint64_t index{0}; index < head.n_structures and consistent_offsets;
+         ++index) {
+      consistent_offsets = atom_offsets[index] <= atom_offsets[index + 1];
+    }
+    if (not consistent_offsets) {
+      throw std::runtime_error("The atom offsets of the structure store '" +
+                               filename + "' are inconsistent.");
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  StructureStoreWriter::StructureStoreWriter(const std::string & filename)
+      : filename{filename}, stream{filename,
+                                   std::ios::binary | std::ios::trunc} {
+    if (not this->stream.is_open()) {
+      throw std::runtime_error("Could not open the file: " + filename);
+    }
+    // placeholder for the header, written in close()
+    Header_t head{};
+    this->stream.write(reinterpret_cast<const char *>(&head), sizeof(head));
+    this->positions_offset = this->align();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  StructureStoreWriter::~StructureStoreWriter() {
+    try {
+      this->close();
+    } catch (...) {
+      // destructors should not throw
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void StructureStoreWriter::append(const AtomicStructure<3> & structure) {
+    if (not this->stream.is_open()) {
+      throw std::runtime_error("The structure store '" + this->filename +
+                               "' has already been closed.");
+    }
+    size_t n_atoms{structure.get_number_of_atoms()};
+    // Positions_t is column major with 3 rows so the data is already laid out
+    // as [n_atoms][3]
+    this->stream.write(
+        reinterpret_cast<const char *>(structure.positions.data()),
+        3 * n_atoms * sizeof(double));
+    this->atom_offsets.push_back(this->atom_offsets.back() + n_atoms);
+    for (int i_elem{0}; i_elem < 9; ++i_elem) {
+      this->cells.push_back(structure.cell.data()[i_elem]);
+    }
+    for (int i_dim{0}; i_dim < 3; ++i_dim) {
+      this->pbc.push_back(structure.pbc(i_dim));
+    }
+    for (size_t i_atom{0}; i_atom < n_atoms; ++i_atom) {
+      this->atom_types.push_back(structure.atom_types(i_atom));
+    }
+    if (static_cast<size_t>(structure.center_atoms_mask.size()) == n_atoms) {
+      for (size_t i_atom{0}; i_atom < n_atoms; ++i_atom) {
+        this->center_atoms_mask.push_back(structure.center_atoms_mask(i_atom));
+      }
+    } else {
+      this->center_atoms_mask.insert(this->center_atoms_mask.end(), n_atoms,
+                                     1);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  uint64_t StructureStoreWriter::align() {
+    constexpr uint64_t Alignment{Header_t::Alignment};
+    auto position{static_cast<uint64_t>(this->stream.tellp())};
+    auto padding{(Alignment - position % Alignment) % Alignment};
+    const char zeros[Alignment] = {};
+    this->stream.write(zeros, padding);
+    return position + padding;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void StructureStoreWriter::close() {
+    if (not this->stream.is_open()) {
+      return;
+    }
+    Header_t head{};
+    std::memcpy(head.magic, StoreMagic, sizeof(StoreMagic));
+    head.version = Header_t::Version;
+    head.byte_order = Header_t::ByteOrder;
+    head.n_structures = this->size();
+    head.n_atoms = this->atom_offsets.back();
+    head.positions = this->positions_offset;
+    head.atom_offsets = this->write_column(this->atom_offsets);
+    head.cells = this->write_column(this->cells);
+    head.pbc = this->write_column(this->pbc);
+    head.atom_types = this->write_column(this->atom_types);
+    head.center_atoms_mask = this->write_column(this->center_atoms_mask);
+    // keep the file size a multiple of the alignment
+    this->align();
+
+    this->stream.seekp(0);
+    this->stream.write(reinterpret_cast<const char *>(&head), sizeof(head));
+    this->stream.close();
+    if (this->stream.fail()) {
+      throw std::runtime_error("Could not write the structure store: " +
+                               this->filename);
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void
+  write_structure_store(const std::string & store_filename,
+                        const std::vector<AtomicStructure<3>> & structures) {
+    StructureStoreWriter writer{store_filename};
+    for (const auto & structure : structures) {
+      writer.append(structure);
+    }
+    writer.close();
+  }
+
+  /* ---------------------------------------------------------------------- */
+  size_t convert_to_structure_store(const std::string & filename,
+                                    const std::string & store_filename) {
+    json structures = json_io::load(filename);
+    if (not structures.is_object() or structures.count("ids") != 1) {
+      throw std::runtime_error("The json structure format is not recognized");
+    }
+    auto ids{structures["ids"].get<std::vector<int>>()};
+    std::sort(ids.begin(), ids.end());
+
+    StructureStoreWriter writer{store_filename};
+    AtomicStructure<3> structure{};
+    for (auto & idx : ids) {
+      structure.set_structure(structures[std::to_string(idx)]);
+      writer.append(structure);
+    }
+    writer.close();
+    return ids.size();
+  }
+
+}  // namespace rascal
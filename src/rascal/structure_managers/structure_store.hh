@@ -0,0 +1,327 @@
+/**
+ * @file   rascal/structure_managers/structure_store.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Memory-mapped, columnar binary storage of atomic structures
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_STRUCTURE_MANAGERS_STRUCTURE_STORE_HH_
+#define SRC_RASCAL_STRUCTURE_MANAGERS_STRUCTURE_STORE_HH_
+
+#include "rascal/structure_managers/atomic_structure.hh"
+#include "rascal/utils/mapped_file.hh"
+
+#include <Eigen/Dense>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace rascal {
+
+  class StructureStore;
+  struct MappedAtomicStructure;
+
+  namespace internal {
+    /**
+     * Layout of the header at the beginning of a structure store file. All
+     * offsets are in bytes from the beginning of the file and are aligned on
+     * StructureStoreHeader::Alignment.
+     */
+    struct StructureStoreHeader {
+      constexpr static uint32_t Version{1};
+      constexpr static uint32_t ByteOrder{0x01020304};
+      constexpr static size_t Alignment{64};
+      //! "RASCALSS"
+      char magic[8];
+      uint32_t version;
+      //! to detect files written on a machine with a different endianness
+      uint32_t byte_order;
+      uint64_t n_structures;
+      uint64_t n_atoms;
+      //! uint64[n_structures + 1], index of the first atom of each structure
+      uint64_t atom_offsets;
+      //! double[n_structures][3][3], column major (cell vectors as columns)
+      uint64_t cells;
+      //! int32[n_structures][3]
+      uint64_t pbc;
+      //! double[n_atoms][3]
+      uint64_t positions;
+      //! int32[n_atoms]
+      uint64_t atom_types;
+      //! uint8[n_atoms]
+      uint64_t center_atoms_mask;
+    };
+
+    //! is the argument pack a single MappedAtomicStructure
+    template <class... Args>
+    struct IsMappedAtomicStructure : std::false_type {};
+
+    template <class Arg>
+    struct IsMappedAtomicStructure<Arg>
+        : std::is_same<std::decay_t<Arg>, MappedAtomicStructure> {};
+  }  // namespace internal
+
+  /**
+   * Light-weight handle on the i-th structure of a StructureStore. It keeps
+   * the store (and thus the mapping) alive and gives access to the mapped data
+   * without copying it.
+   *
+   * It can be passed to the update function of a StructureManagerCenters so
+   * that the manager reads the positions directly from the mapping.
+   */
+  struct MappedAtomicStructure {
+    using Positions_t = AtomicStructure<3>::Positions_t;
+    using PositionsMap_t = Eigen::Map<Positions_t>;
+    using ConstAtomTypesMap_t =
+        Eigen::Map<const Eigen::Matrix<int32_t, Eigen::Dynamic, 1>>;
+    using ConstCellMap_t = Eigen::Map<const Eigen::Matrix3d>;
+    using ConstPBCMap_t = Eigen::Map<const Eigen::Matrix<int32_t, 3, 1>>;
+    using ConstMaskMap_t =
+        Eigen::Map<const Eigen::Array<uint8_t, Eigen::Dynamic, 1>>;
+
+    std::shared_ptr<const StructureStore> store;
+    size_t index;
+
+    size_t get_number_of_atoms() const;
+
+    /**
+     * Map to the positions of the structure. The store is mapped copy on
+     * write so the positions can be modified without altering the file, but
+     * the modification is visible to every handle on the same structure.
+     */
+    PositionsMap_t get_positions() const;
+
+    ConstAtomTypesMap_t get_atom_types() const;
+
+    ConstCellMap_t get_cell() const;
+
+    ConstPBCMap_t get_pbc() const;
+
+    ConstMaskMap_t get_center_atoms_mask() const;
+
+    //! copy the structure into an AtomicStructure
+    AtomicStructure<3> get_atomic_structure() const;
+  };
+
+  /**
+   * Columnar binary storage of a dataset of atomic structures that is
+   * accessed through a memory mapping of the file. Contrary to the ASE json
+   * format, opening a store does not parse anything and accessing the i-th
+   * structure costs O(1), so that very large datasets can be used without
+   * loading them in memory.
+   *
+   * The data of all the structures is concatenated per field (positions,
+   * atom types, cells, pbc, masks) and the atoms of structure i are in the
+   * range [atom_offsets[i], atom_offsets[i+1]) of the per-atom fields. See
+   * internal::StructureStoreHeader for the detailed layout.
+   *
+   * Stores are written with StructureStoreWriter or converted from the ASE
+   * json/ubjson format with convert_to_structure_store.
+   */
+  class StructureStore : public std::enable_shared_from_this<StructureStore> {
+   public:
+    using Header_t = internal::StructureStoreHeader;
+
+    //! open and map the store in filename
+    explicit StructureStore(const std::string & filename);
+
+    //! Copy constructor
+    StructureStore(const StructureStore & other) = delete;
+
+    //! Move constructor
+    StructureStore(StructureStore && other) = delete;
+
+    //! Destructor
+    ~StructureStore() = default;
+
+    //! Copy assignment operator
+    StructureStore & operator=(const StructureStore & other) = delete;
+
+    //! Move assignment operator
+    StructureStore & operator=(StructureStore && other) = delete;
+
+    //! number of structures in the store
+    size_t size() const { return this->header().n_structures; }
+
+    //! total number of atoms in the store
+    size_t get_number_of_atoms() const { return this->header().n_atoms; }
+
+    size_t get_number_of_atoms(size_t index) const {
+      return this->atom_offsets()[index + 1] - this->atom_offsets()[index];
+    }
+
+    //! index of the first atom of structure index in the per-atom fields
+    size_t get_atom_offset(size_t index) const {
+      return this->atom_offsets()[index];
+    }
+
+    /**
+     * Get a handle on the structure index. The store has to be owned by a
+     * std::shared_ptr.
+     *
+     * @throw std::out_of_range if index >= size()
+     */
+    MappedAtomicStructure get_structure(size_t index) const;
+
+    //! copy the structure index into an AtomicStructure
+    AtomicStructure<3> get_atomic_structure(size_t index) const {
+      return this->get_structure(index).get_atomic_structure();
+    }
+
+    const std::string & get_filename() const {
+      return this->file.get_filename();
+    }
+
+    /**
+     * Raw access to the per-structure and per-atom columns. The pointers are
+     * valid as long as the store is alive.
+     */
+    double * get_positions_data(size_t index) const {
+      return this->column<double>(this->header().positions) +
+             3 * this->get_atom_offset(index);
+    }
+
+    const int32_t * get_atom_types_data(size_t index) const {
+      return this->column<int32_t>(this->header().atom_types) +
+             this->get_atom_offset(index);
+    }
+
+    const double * get_cell_data(size_t index) const {
+      return this->column<double>(this->header().cells) + 9 * index;
+    }
+
+    const int32_t * get_pbc_data(size_t index) const {
+      return this->column<int32_t>(this->header().pbc) + 3 * index;
+    }
+
+    const uint8_t * get_center_atoms_mask_data(size_t index) const {
+      return this->column<uint8_t>(this->header().center_atoms_mask) +
+             this->get_atom_offset(index);
+    }
+
+   protected:
+    const Header_t & header() const {
+      return *reinterpret_cast<const Header_t *>(this->file.data());
+    }
+
+    const uint64_t * atom_offsets() const {
+      return this->column<uint64_t>(this->header().atom_offsets);
+    }
+
+    //! pointer to the column starting at byte offset
+    template <typename T>
+    T * column(uint64_t offset) const {
+      // the mapping is copy on write so handing out non const pointers is
+      // safe for the file
+      return reinterpret_cast<T *>(const_cast<char *>(this->file.data()) +
+                                   offset);
+    }
+
+    //! check the header and the size of the file
+    void validate() const;
+
+    MappedFile file{};
+  };
+
+  /**
+   * Write a StructureStore by appending structures one by one. The positions
+   * are streamed to the file while the other (small) fields are kept in
+   * memory until close() is called (or the writer is destroyed).
+   */
+  class StructureStoreWriter {
+   public:
+    using Header_t = internal::StructureStoreHeader;
+
+    //! create the file filename, overwriting it if it exists
+    explicit StructureStoreWriter(const std::string & filename);
+
+    //! Copy constructor
+    StructureStoreWriter(const StructureStoreWriter & other) = delete;
+
+    //! Move constructor
+    StructureStoreWriter(StructureStoreWriter && other) = delete;
+
+    //! Destructor, finalizes the file
+    ~StructureStoreWriter();
+
+    //! Copy assignment operator
+    StructureStoreWriter &
+    operator=(const StructureStoreWriter & other) = delete;
+
+    //! Move assignment operator
+    StructureStoreWriter & operator=(StructureStoreWriter && other) = delete;
+
+    //! append a structure to the store
+    void append(const AtomicStructure<3> & structure);
+
+    //! number of structures appended so far
+    size_t size() const { return this->pbc.size() / 3; }
+
+    //! write the remaining columns and the header
+    void close();
+
+   protected:
+    //! pad the file with zeros up to the next aligned offset and return it
+    uint64_t align();
+
+    template <typename T>
+    uint64_t write_column(const std::vector<T> & column) {
+      auto offset{this->align()};
+      this->stream.write(reinterpret_cast<const char *>(column.data()),
+                         column.size() * sizeof(T));
+      return offset;
+    }
+
+    std::string filename;
+    std::ofstream stream{};
+    uint64_t positions_offset{0};
+    std::vector<uint64_t> atom_offsets{0};
+    std::vector<double> cells{};
+    std::vector<int32_t> pbc{};
+    std::vector<int32_t> atom_types{};
+    std::vector<uint8_t> center_atoms_mask{};
+  };
+
+  /**
+   * Convert the structures of an ASE json (or ubjson) file to a structure
+   * store.
+   *
+   * @param filename path to the file in the ASE format (see
+   *        ManagerCollection::add_structures)
+   * @param store_filename path of the store to write
+   * @return number of structures written
+   */
+  size_t convert_to_structure_store(const std::string & filename,
+                                    const std::string & store_filename);
+
+  //! write structures to a structure store
+  void
+  write_structure_store(const std::string & store_filename,
+                        const std::vector<AtomicStructure<3>> & structures);
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_STRUCTURE_MANAGERS_STRUCTURE_STORE_HH_
@@ -28,11 +28,62 @@
 #ifndef SRC_RASCAL_STRUCTURE_MANAGERS_UPDATEABLE_BASE_HH_
 #define SRC_RASCAL_STRUCTURE_MANAGERS_UPDATEABLE_BASE_HH_
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
 namespace rascal {
 
+  /**
+   * Flags describing what changed in the atomic structure between two
+   * updates. They are sent along the tree of Updateable with the update
+   * signal so that each node can decide how much of its data has to be
+   * rebuilt, e.g. a positions only change (an MD step where no pair enters or
+   * leaves the cutoff) keeps the layout of the properties and only their
+   * values have to be recomputed.
+   */
+  enum class StructureChange : unsigned int {
+    None = 0,
+    Positions = 1 << 0,
+    //! the cell or the periodic boundary conditions
+    Cell = 1 << 1,
+    AtomTypes = 1 << 2,
+    NumberOfAtoms = 1 << 3,
+    CenterAtomsMask = 1 << 4,
+    //! the list of clusters of a manager, e.g. a pair entered the cutoff
+    Neighbours = 1 << 5,
+    All = (1 << 6) - 1
+  };
+
+  constexpr StructureChange operator|(StructureChange lhs,
+                                      StructureChange rhs) {
+    return static_cast<StructureChange>(static_cast<unsigned int>(lhs) |
+                                        static_cast<unsigned int>(rhs));
+  }
+
+  constexpr StructureChange operator&(StructureChange lhs,
+                                      StructureChange rhs) {
+    return static_cast<StructureChange>(static_cast<unsigned int>(lhs) &
+                                        static_cast<unsigned int>(rhs));
+  }
+
+  inline StructureChange & operator|=(StructureChange & lhs,
+                                      StructureChange rhs) {
+    lhs = lhs | rhs;
+    return lhs;
+  }
+
+  //! Changes that modify the layout of the clusters and of the properties
+  constexpr StructureChange TopologyChanges{
+      StructureChange::AtomTypes | StructureChange::NumberOfAtoms |
+      StructureChange::CenterAtomsMask | StructureChange::Neighbours};
+
+  //! does changes contain at least one of flags
+  constexpr bool has_structure_change(StructureChange changes,
+                                      StructureChange flags) {
+    return (changes & flags) != StructureChange::None;
+  }
+
   /**
    * Base class providing/defining the interface of an updatable object.
    * Adaptors, StructureManagers and ManagerSpecies are,
@@ -104,8 +155,11 @@ namespace rascal {
      * When the underlying structure changes, all computations are potentially
      * invalid. This function triggers the setting of the status variable to
      * `false` along the tree to the managers and the properties it holds.
+     *
+     * @param changes what changed in the structure, by default everything
      */
-    virtual void send_changed_structure_signal() = 0;
+    virtual void send_changed_structure_signal(
+        StructureChange changes = StructureChange::All) = 0;
 
     //! Setter function for update statue variable
     void set_update_status(const bool sig) { this->updated = sig; }
@@ -113,6 +167,22 @@ namespace rascal {
     //! Getter function for update status variable.
     bool get_update_status() const { return this->updated; }
 
+    /**
+     * What changed in the structure during the last update (or since the last
+     * update if the object has not been updated yet).
+     */
+    StructureChange get_structure_changes() const {
+      return this->structure_changes;
+    }
+
+    /**
+     * Counter incremented each time the layout of the clusters of the object
+     * changes, i.e. with any of the TopologyChanges. Properties whose layout
+     * was built for the current topology version only need to have their
+     * values refreshed.
+     */
+    size_t get_topology_version() const { return this->topology_version; }
+
    protected:
     //! List of children which are stacked on top of current object.
     std::vector<Children_t> children{};
@@ -123,6 +193,25 @@ namespace rascal {
      */
     bool updated;
 
+    //! see get_structure_changes
+    StructureChange structure_changes{StructureChange::All};
+
+    //! see get_topology_version, 0 is never a valid version
+    size_t topology_version{1};
+
+    //! record the changes sent with the update signal
+    void register_structure_changes(StructureChange changes) {
+      if (this->updated) {
+        this->structure_changes = changes;
+      } else {
+        // the previous changes have not been processed yet
+        this->structure_changes |= changes;
+      }
+      if (has_structure_change(changes, TopologyChanges)) {
+        ++this->topology_version;
+      }
+    }
+
    private:
   };
 
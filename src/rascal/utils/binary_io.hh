@@ -0,0 +1,115 @@
+/**
+ * @file   rascal/utils/binary_io.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Helpers to write and read plain data to and from binary buffers
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_UTILS_BINARY_IO_HH_
+#define SRC_RASCAL_UTILS_BINARY_IO_HH_
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace rascal {
+  namespace internal {
+    /**
+     * FNV-1a hash of n_bytes starting at data. Contrary to std::hash it does
+     * not depend on the standard library implementation so it can be used to
+     * name files that persist between runs.
+     */
+    inline uint64_t hash_bytes(const void * data, size_t n_bytes,
+                               uint64_t seed = 0xcbf29ce484222325) {
+      constexpr uint64_t Prime{0x100000001b3};
+      auto bytes{static_cast<const unsigned char *>(data)};
+      uint64_t hash{seed};
+      for (size_t i_byte{0}; i_byte < n_bytes; ++i_byte) {
+        hash ^= bytes[i_byte];
+        hash *= Prime;
+      }
+      return hash;
+    }
+
+    /**
+     * Append plain data to a binary buffer.
+     */
+    class BinaryWriter {
+     public:
+      template <typename T>
+      void write(const T & value) {
+        this->write_array(&value, 1);
+      }
+
+      template <typename T>
+      void write_array(const T * values, size_t n_values) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only plain data can be written");
+        auto ptr{reinterpret_cast<const char *>(values)};
+        this->buffer.insert(this->buffer.end(), ptr,
+                            ptr + n_values * sizeof(T));
+      }
+
+      std::vector<char> buffer{};
+    };
+
+    /**
+     * Read back what BinaryWriter wrote from [begin, end).
+     *
+     * @throw std::runtime_error if reading past end
+     */
+    class BinaryReader {
+     public:
+      BinaryReader(const char * begin, const char * end)
+          : ptr{begin}, end{end} {}
+
+      template <typename T>
+      T read() {
+        T value{};
+        this->read_array(&value, 1);
+        return value;
+      }
+
+      template <typename T>
+      void read_array(T * values, size_t n_values) {
+        size_t n_bytes{n_values * sizeof(T)};
+        if (static_cast<size_t>(this->end - this->ptr) < n_bytes) {
+          throw std::runtime_error("Truncated binary data.");
+        }
+        // the data is not necessarily aligned in the buffer
+        std::memcpy(values, this->ptr, n_bytes);
+        this->ptr += n_bytes;
+      }
+
+      //! has everything been read
+      bool at_end() const { return this->ptr == this->end; }
+
+     protected:
+      const char * ptr;
+      const char * end;
+    };
+  }  // namespace internal
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_UTILS_BINARY_IO_HH_
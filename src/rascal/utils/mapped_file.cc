@@ -0,0 +1,152 @@
+/**
+ * @file   rascal/utils/mapped_file.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief implementation of the memory-mapped file wrapper
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/utils/mapped_file.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace rascal {
+
+  /* ---------------------------------------------------------------------- */
+  MappedFile::MappedFile(MappedFile && other) noexcept
+      : ptr{other.ptr}, n_bytes{other.n_bytes}, mode{other.mode},
+        filename{std::move(other.filename)} {
+    other.ptr = nullptr;
+    other.n_bytes = 0;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  MappedFile & MappedFile::operator=(MappedFile && other) noexcept {
+    if (this != &other) {
+      this->close();
+      std::swap(this->ptr, other.ptr);
+      std::swap(this->n_bytes, other.n_bytes);
+      this->mode = other.mode;
+      this->filename = std::move(other.filename);
+    }
+    return *this;
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void MappedFile::open(const std::string & filename, Mode mode) {
+    this->close();
+    int flags{mode == Mode::ReadWrite ? O_RDWR : O_RDONLY};
+    int fd{::open(filename.c_str(), flags)};
+    if (fd < 0) {
+      throw std::runtime_error("Could not open the file: " + filename + " (" +
+                               std::strerror(errno) + ")");
+    }
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Could not stat the file: " + filename);
+    }
+    this->filename = filename;
+    try {
+      this->map(fd, static_cast<size_t>(file_stat.st_size), mode);
+    } catch (...) {
+      ::close(fd);
+      throw;
+    }
+    // the mapping stays valid after the file descriptor is closed
+    ::close(fd);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void MappedFile::create(const std::string & filename, size_t n_bytes) {
+    this->close();
+    int fd{::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+    if (fd < 0) {
+      throw std::runtime_error("Could not create the file: " + filename +
+                               " (" + std::strerror(errno) + ")");
+    }
+    if (::ftruncate(fd, static_cast<off_t>(n_bytes)) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Could not resize the file: " + filename);
+    }
+    this->filename = filename;
+    try {
+      this->map(fd, n_bytes, Mode::ReadWrite);
+    } catch (...) {
+      ::close(fd);
+      throw;
+    }
+    ::close(fd);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void MappedFile::map(int fd, size_t n_bytes, Mode mode) {
+    this->mode = mode;
+    this->n_bytes = n_bytes;
+    if (n_bytes == 0) {
+      // mmap does not accept empty mappings
+      throw std::runtime_error("Can't map the empty file: " + this->filename);
+    }
+    int protection{PROT_READ};
+    int flags{MAP_SHARED};
+    if (mode == Mode::CopyOnWrite) {
+      protection |= PROT_WRITE;
+      flags = MAP_PRIVATE;
+    } else if (mode == Mode::ReadWrite) {
+      protection |= PROT_WRITE;
+    }
+    void * addr{::mmap(nullptr, n_bytes, protection, flags, fd, 0)};
+    if (addr == MAP_FAILED) {
+      this->n_bytes = 0;
+      throw std::runtime_error("Could not map the file: " + this->filename +
+                               " (" + std::strerror(errno) + ")");
+    }
+    this->ptr = static_cast<char *>(addr);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void MappedFile::flush() {
+    if (this->is_open() and this->mode == Mode::ReadWrite) {
+      if (::msync(this->ptr, this->n_bytes, MS_SYNC) != 0) {
+        throw std::runtime_error("Could not flush the file: " +
+                                 this->filename);
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  void MappedFile::close() {
+    if (this->ptr != nullptr) {
+      ::munmap(this->ptr, this->n_bytes);
+      this->ptr = nullptr;
+      this->n_bytes = 0;
+    }
+  }
+
+}  // namespace rascal
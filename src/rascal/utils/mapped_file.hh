@@ -0,0 +1,118 @@
+/**
+ * @file   rascal/utils/mapped_file.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief RAII wrapper around a memory-mapped file
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_UTILS_MAPPED_FILE_HH_
+#define SRC_RASCAL_UTILS_MAPPED_FILE_HH_
+
+#include <cstddef>
+#include <string>
+
+namespace rascal {
+
+  /**
+   * Owns the memory mapping of a whole file. The mapping is released when the
+   * object is destroyed.
+   *
+   * Three access modes are supported:
+   *   - ReadOnly: the pages can only be read, any write is a segfault.
+   *   - CopyOnWrite: the pages can be written but the modifications are
+   *     private to the process and never reach the file.
+   *   - ReadWrite: the modifications are written back to the file.
+   */
+  class MappedFile {
+   public:
+    enum class Mode { ReadOnly, CopyOnWrite, ReadWrite };
+
+    //! Default constructor, nothing is mapped
+    MappedFile() = default;
+
+    //! map the file filename
+    explicit MappedFile(const std::string & filename,
+                        Mode mode = Mode::ReadOnly) {
+      this->open(filename, mode);
+    }
+
+    //! Copy constructor
+    MappedFile(const MappedFile & other) = delete;
+
+    //! Move constructor
+    MappedFile(MappedFile && other) noexcept;
+
+    //! Destructor
+    ~MappedFile() { this->close(); }
+
+    //! Copy assignment operator
+    MappedFile & operator=(const MappedFile & other) = delete;
+
+    //! Move assignment operator
+    MappedFile & operator=(MappedFile && other) noexcept;
+
+    /**
+     * Map the file filename. If a file was already mapped it is released
+     * first.
+     *
+     * @throw std::runtime_error if the file can't be opened or mapped
+     */
+    void open(const std::string & filename, Mode mode = Mode::ReadOnly);
+
+    /**
+     * Create (or truncate) filename with a size of n_bytes and map it in
+     * ReadWrite mode.
+     */
+    void create(const std::string & filename, size_t n_bytes);
+
+    //! release the mapping
+    void close();
+
+    //! write back the modified pages to the file (ReadWrite mode only)
+    void flush();
+
+    bool is_open() const { return this->ptr != nullptr; }
+
+    const char * data() const { return this->ptr; }
+
+    char * data() { return this->ptr; }
+
+    //! number of bytes mapped
+    size_t size() const { return this->n_bytes; }
+
+    const std::string & get_filename() const { return this->filename; }
+
+    Mode get_mode() const { return this->mode; }
+
+   protected:
+    //! map n_bytes of the opened file descriptor fd
+    void map(int fd, size_t n_bytes, Mode mode);
+
+    char * ptr{nullptr};
+    size_t n_bytes{0};
+    Mode mode{Mode::ReadOnly};
+    std::string filename{};
+  };
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_UTILS_MAPPED_FILE_HH_
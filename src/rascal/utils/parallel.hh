@@ -0,0 +1,231 @@
+/**
+ * @file   rascal/utils/parallel.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   18 Oct 2026
+ *
+ * @brief Minimal thread based parallel loop
+ *
+ * Copyright 2026 agent
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_UTILS_PARALLEL_HH_
+#define SRC_RASCAL_UTILS_PARALLEL_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rascal {
+  namespace internal {
+
+    /**
+     * Number of threads to use when n_threads are requested, 0 means as many
+     * as the hardware supports.
+     */
+    inline size_t get_nb_threads(size_t n_threads) {
+      if (n_threads == 0) {
+        n_threads = std::thread::hardware_concurrency();
+      }
+      return std::max(n_threads, size_t{1});
+    }
+
+    /**
+     * Call func(index) for every index in [0, n_items) using up to n_threads
+     * threads (see get_nb_threads). The indices are handed out one by one so
+     * items with uneven costs, e.g. structures of different sizes, are
+     * balanced between the threads. func has to be safe to call concurrently
+     * for different indices.
+     *
+     * The loop runs in the calling thread when a single thread is used. The
+     * first exception thrown by func is rethrown in the calling thread once
+     * all the threads have stopped.
+     */
+    template <class Func>
+    void parallel_for(size_t n_items, size_t n_threads, Func && func) {
+      n_threads = std::min(get_nb_threads(n_threads), n_items);
+      if (n_threads <= 1) {
+        for (size_t index{0}; index < n_items; ++index) {
+          func(index);
+        }
+        return;
+      }
+
+      std::atomic<size_t> next_index{0};
+      std::exception_ptr error{nullptr};
+      std::mutex error_mutex{};
+      auto worker = [&]() {
+        size_t index{next_index++};
+        while (index < n_items) {
+          try {
+            func(index);
+          } catch (...) {
+            std::lock_guard<std::mutex> lock{error_mutex};
+            if (error == nullptr) {
+              error = std::current_exception();
+            }
+            // stop handing out work
+            next_index = n_items;
+            return;
+          }
+          index = next_index++;
+        }
+      };
+
+      std::vector<std::thread> threads{};
+      threads.reserve(n_threads - 1);
+      for (size_t i_thread{1}; i_thread < n_threads; ++i_thread) {
+        threads.emplace_back(worker);
+      }
+      worker();
+      for (auto & thread : threads) {
+        thread.join();
+      }
+      if (error != nullptr) {
+        std::rethrow_exception(error);
+      }
+    }
+
+    /**
+     * Same as parallel_for but the items are split in contiguous chunks, one
+     * per thread, and func(index, i_chunk) is called so that the caller can
+     * use one accumulator per chunk. Returns the number of chunks used.
+     */
+    template <class Func>
+    size_t parallel_for_chunks(size_t n_items, size_t n_threads,
+                               Func && func) {
+      const size_t n_chunks_max{
+          std::max(std::min(get_nb_threads(n_threads), n_items), size_t{1})};
+      const size_t chunk_size{
+          std::max((n_items + n_chunks_max - 1) / n_chunks_max, size_t{1})};
+      const size_t n_chunks{
+          std::max((n_items + chunk_size - 1) / chunk_size, size_t{1})};
+      parallel_for(n_chunks, n_chunks, [&](size_t i_chunk) {
+        const size_t end{std::min((i_chunk + 1) * chunk_size, n_items)};
+        for (size_t index{i_chunk * chunk_size}; index < end; ++index) {
+          func(index, i_chunk);
+        }
+      });
+      return n_chunks;
+    }
+
+    /**
+     * Reusable barrier for the threads of parallel_team: wait() returns once
+     * all the threads have called it and the barrier is then ready for the
+     * next step. When one of the threads fails the barrier is broken and
+     * wait() throws Broken in the others so that they stop instead of
+     * waiting forever.
+     */
+    class TeamBarrier {
+     public:
+      //! thrown by wait() when another thread of the team failed
+      struct Broken {};
+
+      explicit TeamBarrier(size_t n_threads) : n_threads{n_threads} {}
+
+      void wait() {
+        std::unique_lock<std::mutex> lock{this->mutex};
+        if (this->broken) {
+          throw Broken{};
+        }
+        const size_t generation{this->generation};
+        if (++this->n_waiting == this->n_threads) {
+          this->n_waiting = 0;
+          ++this->generation;
+          this->condition.notify_all();
+          return;
+        }
+        this->condition.wait(lock, [this, generation]() {
+          return this->broken or this->generation != generation;
+        });
+        if (this->generation == generation) {
+          throw Broken{};
+        }
+      }
+
+      void set_broken() {
+        std::lock_guard<std::mutex> lock{this->mutex};
+        this->broken = true;
+        this->condition.notify_all();
+      }
+
+     protected:
+      const size_t n_threads;
+      size_t n_waiting{0};
+      //! number of times all the threads went through the barrier
+      size_t generation{0};
+      bool broken{false};
+      std::mutex mutex{};
+      std::condition_variable condition{};
+    };
+
+    /**
+     * Call func(i_thread, barrier) exactly once in each of n_threads threads
+     * (see get_nb_threads), the calling thread being the thread 0. Unlike
+     * parallel_for the threads are created once for work made of many
+     * short steps, e.g. an iterative selection, which are separated with
+     * barrier.wait().
+     *
+     * The first exception thrown by func is rethrown in the calling thread
+     * once all the threads have stopped.
+     */
+    template <class Func>
+    void parallel_team(size_t n_threads, Func && func) {
+      n_threads = get_nb_threads(n_threads);
+      TeamBarrier barrier{n_threads};
+      std::exception_ptr error{nullptr};
+      std::mutex error_mutex{};
+      auto worker = [&](size_t i_thread) {
+        try {
+          func(i_thread, barrier);
+        } catch (const TeamBarrier::Broken &) {
+          // another thread failed and holds the error
+        } catch (...) {
+          {
+            std::lock_guard<std::mutex> lock{error_mutex};
+            if (error == nullptr) {
+              error = std::current_exception();
+            }
+          }
+          barrier.set_broken();
+        }
+      };
+
+      std::vector<std::thread> threads{};
+      threads.reserve(n_threads - 1);
+      for (size_t i_thread{1}; i_thread < n_threads; ++i_thread) {
+        threads.emplace_back(worker, i_thread);
+      }
+      worker(0);
+      for (auto & thread : threads) {
+        thread.join();
+      }
+      if (error != nullptr) {
+        std::rethrow_exception(error);
+      }
+    }
+
+  }  // namespace internal
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_UTILS_PARALLEL_HH_
@@ -44,6 +44,27 @@ class TestGenericMD(unittest.TestCase):
         self.assertTrue(np.allclose(forces, new_forces))
         self.assertTrue(np.allclose(stress, new_stress))
 
+    def test_potential_vs_predict(self):
+        """Check that the potential gives the same energy, forces and stress
+        as the predict methods of the model"""
+        self.assertIsNotNone(self.calculator.potential)
+        predict_calculator = GenericMDCalculator(
+            "reference_data/tests_only/simple_gap_model.json",
+            True,
+            "reference_data/inputs/methane_dimer_sample.xyz",
+        )
+        predict_calculator.potential = None
+        for cell in [self.test_cell, np.eye(3) * 10.0]:
+            energy, forces, stress = self.calculator.calculate(
+                self.test_positions, cell
+            )
+            ref_energy, ref_forces, ref_stress = predict_calculator.calculate(
+                self.test_positions, cell
+            )
+            self.assertTrue(np.allclose(energy, ref_energy))
+            self.assertTrue(np.allclose(forces, ref_forces))
+            self.assertTrue(np.allclose(stress, ref_stress))
+
     def test_atomic_number_init(self):
         atomic_numbers = ase.io.read(
             "reference_data/inputs/methane_dimer_sample.xyz", 0
@@ -14,7 +14,11 @@ from python_representation_calculator_test import (
     TestSphericalExpansionRepresentation,
     TestSphericalInvariantsRepresentation,
 )
-from python_models_test import TestNumericalKernelGradient, TestCosineKernel
+from python_models_test import (
+    TestNumericalKernelGradient,
+    TestCosineKernel,
+    TestGAPTraining,
+)
 from python_math_test import TestMath
 from test_filter import FPSTest, CURTest
 from python_utils_test import TestOptimalRadialBasis
@@ -1,8 +1,14 @@
 from rascal.representations import SphericalInvariants
-from rascal.models import Kernel
+from rascal.models import (
+    Kernel,
+    compute_KNM,
+    train_gap_model,
+    train_gap_model_streaming,
+)
 from rascal.models.sparse_points import SparsePoints
 from rascal.models.kernels import compute_numerical_kernel_gradients
-from rascal.utils import from_dict, to_dict
+from rascal.utils import from_dict, to_dict, FPSFilter
+from rascal.neighbourlist.structure_manager import mask_center_atoms_by_id
 from test_utils import load_json_frame, BoxList, Box, compute_relative_error
 from ase.calculators.lj import LennardJones
 import ase.io
@@ -281,3 +287,120 @@ class TestCosineKernel(unittest.TestCase):
             cosine_kernel_copy_dict = to_dict(cosine_kernel_copy)
 
             self.assertTrue(cosine_kernel_dict == cosine_kernel_copy_dict)
+
+
+class TestGAPTraining(unittest.TestCase):
+    def setUp(self):
+        """
+        builds the test case from a few methane dimers with their energies
+        and forces
+        """
+        self.frames = ase.io.read(
+            "reference_data/inputs/methane_dimer_sample.xyz", ":6"
+        )
+        self.hypers = dict(
+            soap_type="PowerSpectrum",
+            interaction_cutoff=3.5,
+            max_radial=4,
+            max_angular=3,
+            gaussian_sigma_constant=0.4,
+            gaussian_sigma_type="Constant",
+            cutoff_smooth_width=0.5,
+            compute_gradients=True,
+        )
+        self.n_sparses = {1: 6, 6: 3}
+
+    def get_sparse_points(self, rep, frames):
+        managers = rep.transform(frames)
+        compressor = FPSFilter(rep, self.n_sparses, act_on="sample per species")
+        return compressor.select_and_filter(managers)
+
+    def test_sparse_gradients_KNM(self):
+        """Tests that the kernel computed from the sparse (CSR) export of the
+        gradients of the representation matches the dense one."""
+        rep = SphericalInvariants(**self.hypers)
+        X_sparse = self.get_sparse_points(rep, self.frames)
+        for zeta in [1, 2]:
+            kernel = Kernel(
+                rep,
+                name="GAP",
+                zeta=zeta,
+                target_type="Structure",
+                kernel_type="Sparse",
+            )
+            KNM_ref = compute_KNM(self.frames, X_sparse, kernel, rep)
+            KNM = compute_KNM(self.frames, X_sparse, kernel, rep, sparse_gradients=True)
+            self.assertEqual(KNM.shape, KNM_ref.shape)
+            self.assertTrue(np.allclose(KNM, KNM_ref, rtol=1e-10, atol=1e-12))
+
+    def test_train_gap_model_streaming(self):
+        """Tests that accumulating the normal equations chunk by chunk gives
+        the weights of train_gap_model, also when some centers are masked."""
+        rep = SphericalInvariants(**self.hypers)
+        X_sparse = self.get_sparse_points(rep, self.frames)
+        kernel = Kernel(
+            rep, name="GAP", zeta=2, target_type="Structure", kernel_type="Sparse"
+        )
+        self_contributions = {1: 0.001, 6: 0.002}
+        lambdas = [1e-2, 1e-1]
+
+        masked_frames = copy.deepcopy(self.frames)
+        for frame in masked_frames:
+            # the last atom of the dimers is an hydrogen
+            mask_center_atoms_by_id(frame, id_blacklist=[len(frame) - 1])
+
+        for frames, with_forces in [
+            (self.frames, False),
+            (self.frames, True),
+            (masked_frames, False),
+        ]:
+            y = np.array([frame.get_potential_energy() for frame in frames])
+            grad = -np.concatenate([frame.arrays["force"] for frame in frames])
+            Y0 = np.array(
+                [
+                    sum(self_contributions[sp] for sp in frame.numbers)
+                    for frame in frames
+                ]
+            )
+            delta = np.std(y - Y0)
+
+            managers = rep.transform(frames)
+            KNM = kernel(managers, X_sparse)
+            if with_forces:
+                KNM_der = kernel(managers, X_sparse, grad=(True, False))
+                KNM = np.vstack([KNM, KNM_der])
+            model_ref = train_gap_model(
+                kernel,
+                frames,
+                KNM,
+                X_sparse,
+                y,
+                self_contributions,
+                grad_train=grad if with_forces else None,
+                lambdas=lambdas,
+                solver="solve",
+            )
+
+            chunks = []
+            for i_start in range(0, len(frames), 4):
+                chunk = frames[i_start : i_start + 4]
+                chunk_grad = None
+                if with_forces:
+                    chunk_grad = -np.concatenate(
+                        [frame.arrays["force"] for frame in chunk]
+                    )
+                chunks.append(
+                    (rep.transform(chunk), y[i_start : i_start + 4], chunk_grad)
+                )
+            model = train_gap_model_streaming(
+                kernel,
+                chunks,
+                X_sparse,
+                self_contributions,
+                delta,
+                lambdas,
+                solver="solve",
+            )
+            self.assertTrue(
+                np.allclose(model.weights, model_ref.weights, rtol=1e-6, atol=1e-10)
+            )
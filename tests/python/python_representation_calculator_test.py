@@ -318,6 +318,94 @@ class TestSphericalInvariantsRepresentation(unittest.TestCase):
 
         self.assertTrue(np.allclose(KNM_ref, KNM))
 
+    def test_fill_features(self):
+        """
+        Test that the features and their gradients written into preallocated
+        arrays are the ones returned by get_features and
+        get_features_gradient
+        """
+        hypers = deepcopy(self.hypers)
+        hypers["compute_gradients"] = True
+        rep = SphericalInvariants(**hypers)
+        managers = rep.transform(self.frames)
+
+        for species in [None, self.global_species]:
+            X_ref = managers.get_features(rep, species)
+            shape = managers.get_features_shape(rep, species)
+            self.assertEqual(shape, X_ref.shape)
+
+            out = np.zeros(shape)
+            X = managers.get_features(rep, species, out=out)
+            self.assertIs(X, out)
+            self.assertTrue(np.array_equal(out, X_ref))
+
+            X = managers.get_features(rep, species, dtype=np.float32)
+            self.assertEqual(X.dtype, np.float32)
+            self.assertTrue(np.allclose(X, X_ref, rtol=1e-6, atol=1e-7))
+
+            out = np.zeros(shape, dtype=np.float32)
+            X = managers.get_features(rep, species, out=out)
+            self.assertIs(X, out)
+            self.assertTrue(np.allclose(out, X_ref, rtol=1e-6, atol=1e-7))
+
+            dX_ref = managers.get_features_gradient(rep, species)
+            out = np.zeros(dX_ref.shape)
+            dX = managers.get_features_gradient(rep, species, out=out)
+            self.assertIs(dX, out)
+            self.assertTrue(np.array_equal(out, dX_ref))
+
+            dX = managers.get_features_gradient(rep, species, dtype=np.float32)
+            self.assertEqual(dX.dtype, np.float32)
+            self.assertTrue(np.allclose(dX, dX_ref, rtol=1e-6, atol=1e-7))
+
+            # the output array has to match the shape of the features
+            out = np.zeros((shape[0] + 1, shape[1]))
+            with self.assertRaises(RuntimeError):
+                managers.get_features(rep, species, out=out)
+            out = np.zeros((dX_ref.shape[0], dX_ref.shape[1] + 1))
+            with self.assertRaises(RuntimeError):
+                managers.get_features_gradient(rep, species, out=out)
+
+            # and be a C contiguous array of float64 or float32 to be written
+            # in place
+            for out in [
+                np.zeros(shape, dtype=np.int64),
+                np.zeros(shape, dtype=np.float16),
+                np.zeros(shape, order="F"),
+            ]:
+                with self.assertRaises(TypeError):
+                    managers.get_features(rep, species, out=out)
+
+    def test_features_views(self):
+        """
+        Test that the views on the features of each structure reference the
+        memory of the representation without copying it
+        """
+        hypers = deepcopy(self.hypers)
+        hypers["expansion_by_species_method"] = "user defined"
+        hypers["global_species"] = self.global_species
+        rep = SphericalInvariants(**hypers)
+        managers = rep.transform(self.frames)
+
+        views = managers.get_features_views(rep)
+        self.assertEqual(len(views), len(self.frames))
+        X_ref = managers.get_features(rep)
+        i_center = 0
+        for keys, view in views:
+            n_centers = view.shape[0]
+            self.assertEqual(view.shape[1], X_ref.shape[1])
+            X_frame = X_ref[i_center : i_center + n_centers]
+            self.assertTrue(np.array_equal(view, X_frame))
+            self.assertFalse(view.flags.writeable)
+            self.assertFalse(view.flags.owndata)
+            i_center += n_centers
+        self.assertEqual(i_center, X_ref.shape[0])
+
+        # the views of two calls are backed by the same memory
+        views_bis = managers.get_features_views(rep)
+        for (_, view), (_, view_bis) in zip(views, views_bis):
+            self.assertTrue(np.shares_memory(view, view_bis))
+
     def test_serialization(self):
         rep = SphericalInvariants(**self.hypers)
 
@@ -149,6 +149,12 @@ class IndexConversionTest(unittest.TestCase):
 
 
 class FilterTest:
+    # error raised when selecting samples of a species which is not present
+    missing_species_error = (
+        r"Found array with 0 sample\(s\) \(shape=\(0, 4480\)\) while a minimum "
+        r"of 2 is required."
+    )
+
     def abstractSetUp(self):
         example_frames = ase.io.read(
             "reference_data/inputs/small_molecules-20.json", ":"
@@ -230,10 +236,7 @@ class FilterTest:
         """
         n_sparses = {1: 0, 6: 2, 7: 4, 8: 1, 12: 3}
         compressor = self._filter(self.repr, n_sparses, act_on="sample per species")
-        with self.assertRaisesRegex(
-            ValueError,
-            r"Found array with 0 sample\(s\) \(shape=\(0, 4480\)\) while a minimum of 2 is required.",
-        ):
+        with self.assertRaisesRegex(ValueError, self.missing_species_error):
             compressor.select_and_filter(self.managers)
 
     def test_bad_mode(self):
@@ -263,16 +266,116 @@ class FilterTest:
 
 
 class FPSTest(FilterTest, unittest.TestCase):
+    # the native selection checks the number of samples itself
+    missing_species_error = r"^Cannot select 3 samples of species \[12\] out of 0$"
+
     def setUp(self):
         self._filter = FPSFilter
         self.abstractSetUp()
 
+    def test_native_distances(self):
+        """Check the Hausdorff distances of the native selection against the
+        dense feature matrix for both sample modes
+        """
+        n_sparses = {1: 5, 6: 4, 7: 3, 8: 2}
+        compressor = self._filter(
+            self.repr, n_sparses, act_on="sample per species", n_threads=2
+        )
+        compressor.select(self.managers)
+        X_by_sp = filter._split_feature_matrix_by_species(
+            self.managers, self.example_features, n_sparses.keys()
+        )
+        distances = compressor.get_fps_distances()
+        for sp, X in X_by_sp.items():
+            ids = compressor.selected_sample_ids_by_sp[sp]
+            self.assertTrue(np.isinf(distances[sp][0]))
+            for i_select in range(1, n_sparses[sp]):
+                ref = np.min(
+                    np.sum((X[ids[:i_select]] - X[ids[i_select]]) ** 2, axis=1)
+                )
+                max_ref = np.max(
+                    np.min(
+                        np.sum(
+                            (X[:, None, :] - X[None, ids[:i_select], :]) ** 2,
+                            axis=2,
+                        ),
+                        axis=1,
+                    )
+                )
+                self.assertAlmostEqual(distances[sp][i_select], ref)
+                self.assertAlmostEqual(ref, max_ref)
+
+        compressor = self._filter(self.repr, 10, act_on="sample")
+        compressor.select(self.managers)
+        self.assertEqual(compressor.selected_sample_ids[0], 0)
+        self.assertEqual(len(set(compressor.selected_sample_ids)), 10)
+        self.assertEqual(len(compressor.get_fps_distances()), 10)
+
+    def test_native_too_many_samples(self):
+        """Asking for more samples than there are centers raises an error
+        before any selection"""
+        n_samples = self.example_features.shape[0]
+        compressor = self._filter(self.repr, n_samples + 1, act_on="sample")
+        with self.assertRaisesRegex(
+            ValueError, rf"^Cannot select {n_samples + 1} samples out of {n_samples}$"
+        ):
+            compressor.select(self.managers)
+
 
 class CURTest(FilterTest, unittest.TestCase):
     def setUp(self):
         self._filter = CURFilter
         self.abstractSetUp()
 
+    def test_randomized_missing_species(self):
+        """The randomized selection checks the number of samples of each
+        species before the selection
+        """
+        n_sparses = {1: 0, 6: 2, 7: 4, 8: 1, 12: 3}
+        compressor = self._filter(
+            self.repr, n_sparses, act_on="sample per species", method="randomized"
+        )
+        with self.assertRaisesRegex(
+            ValueError, r"^Cannot select 3 samples of species \[12\] out of 0$"
+        ):
+            compressor.select_and_filter(self.managers)
+
+    def test_randomized_too_many_features(self):
+        """The errors of the randomized selection are raised as ValueError"""
+        n_features = self.example_features.shape[1]
+        compressor = self._filter(
+            self.repr, n_features + 1, act_on="feature", method="randomized"
+        )
+        with self.assertRaisesRegex(
+            ValueError, rf"^Cannot select {n_features + 1} features out of {n_features}"
+        ):
+            compressor.select(self.managers)
+
+    def test_native_leverage(self):
+        """With the randomized selection the first selected feature and sample
+        have the largest leverage score, i.e. the largest component in the
+        first singular vector
+        """
+        _, _, vt = np.linalg.svd(self.example_features, full_matrices=False)
+        compressor = self._filter(
+            self.repr,
+            3,
+            act_on="feature",
+            selector_args=dict(seed=1),
+            method="randomized",
+        )
+        compressor.select(self.managers)
+        first = compressor.selected_feature_ids_global[0]
+        self.assertAlmostEqual(np.abs(vt[0, first]), np.max(np.abs(vt[0])))
+
+        u, _, _ = np.linalg.svd(self.example_features, full_matrices=False)
+        compressor = self._filter(
+            self.repr, 3, act_on="sample", n_threads=2, method="randomized"
+        )
+        compressor.select(self.managers)
+        first = compressor.selected_sample_ids[0]
+        self.assertAlmostEqual(np.abs(u[first, 0]), np.max(np.abs(u[:, 0])))
+
 
 if __name__ == "__main__":
     unittest.main(verbosity=2)
@@ -583,6 +583,47 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that moving an atom across the cutoff reports both the change of
+   * the positions and of the neighbours of the strict adaptor
+   */
+  BOOST_AUTO_TEST_CASE(neighbours_change_test) {
+    double cutoff{2.};
+    AtomicStructure<3> structure{};
+    structure.positions.resize(3, 2);
+    structure.positions << 1., 2.5, 1., 1., 1., 1.;
+    structure.atom_types.resize(2);
+    structure.atom_types << 1, 1;
+    structure.cell = 10. * Eigen::Matrix3d::Identity();
+    structure.pbc.setZero();
+    structure.center_atoms_mask.resize(2);
+    structure.center_atoms_mask.setConstant(true);
+
+    auto manager{make_structure_manager<StructureManagerCenters>()};
+    auto pair_manager{
+        make_adapted_manager<AdaptorNeighbourList>(manager, cutoff)};
+    auto adaptor_strict{
+        make_adapted_manager<AdaptorStrict>(pair_manager, cutoff)};
+    adaptor_strict->update(structure);
+    BOOST_CHECK_EQUAL(adaptor_strict->get_nb_clusters(2), 2);
+
+    // the atoms stay within the cutoff
+    auto moved_structure{structure};
+    moved_structure.positions(0, 1) = 2.6;
+    adaptor_strict->update(moved_structure);
+    BOOST_CHECK(adaptor_strict->get_structure_changes() ==
+                StructureChange::Positions);
+
+    // the second atom leaves the cutoff
+    moved_structure.positions(0, 1) = 3.5;
+    adaptor_strict->update(moved_structure);
+    BOOST_CHECK_EQUAL(adaptor_strict->get_nb_clusters(2), 0);
+    auto changes{adaptor_strict->get_structure_changes()};
+    BOOST_CHECK(has_structure_change(changes, StructureChange::Positions));
+    BOOST_CHECK(has_structure_change(changes, StructureChange::Neighbours));
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
@@ -85,6 +85,51 @@ namespace rascal {
     BOOST_CHECK(not structure1.is_similar(structure3, skin2));
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test the detection of what changed between two structures
+   */
+  BOOST_FIXTURE_TEST_CASE(structure_changes_test, AtomicStructureFixture) {
+    AtomicStructure<3> structure1{};
+    AtomicStructure<3> structure2{};
+    AtomicStructure<3> structure3{};
+
+    structure1.set_structure(ref_filename1);
+    structure2.set_structure(ref_filename2);
+
+    BOOST_CHECK(structure1.get_changes(structure1) == StructureChange::None);
+    BOOST_CHECK(structure1.get_changes(structure2) == StructureChange::All);
+    BOOST_CHECK(structure1.get_changes(ref_filename1) ==
+                StructureChange::All);
+
+    structure3.set_structure(structure1);
+    structure3.positions(0, 0) += 0.05;
+    BOOST_CHECK(structure1.get_changes(structure3) ==
+                StructureChange::Positions);
+    BOOST_CHECK(not has_structure_change(structure1.get_changes(structure3),
+                                         TopologyChanges));
+
+    structure3.set_structure(structure1);
+    structure3.pbc(0) = false;
+    BOOST_CHECK(structure1.get_changes(structure3) == StructureChange::Cell);
+
+    structure3.set_structure(structure1);
+    structure3.cell(0, 0) = 20;
+    structure3.atom_types(0) = 1;
+    BOOST_CHECK(structure1.get_changes(structure3) ==
+                (StructureChange::Cell | StructureChange::AtomTypes));
+    BOOST_CHECK(has_structure_change(structure1.get_changes(structure3),
+                                     TopologyChanges));
+
+    structure3.set_structure(structure1);
+    structure3.center_atoms_mask(0) = false;
+    BOOST_CHECK(
+        structure1.get_changes(structure3.positions, structure3.atom_types,
+                               structure3.cell, structure3.pbc,
+                               structure3.center_atoms_mask) ==
+        StructureChange::CenterAtomsMask);
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Test the wrapping of the atoms in a structure
@@ -29,9 +29,14 @@
 
 #include "test_math.hh"  // for the gradient test
 
+#include <wigxjpf.h>
+
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <iomanip>
+#include <sstream>
+
 namespace rascal {
   /* ---------------------------------------------------------------------- */
   using multiple_fixtures =
@@ -197,6 +202,23 @@ namespace rascal {
           BOOST_CHECK_EQUAL(feat_prop.cols(), feat_col.cols());
           auto diff_rep{math::relative_error(feat_prop, feat_col)};
           BOOST_CHECK_LE(diff_rep.maxCoeff(), 6e-12);
+
+          // fill caller provided matrices with a different layout
+          auto shape{collection.get_features_shape(representations.back())};
+          BOOST_CHECK_EQUAL(shape[0], feat_col.rows());
+          BOOST_CHECK_EQUAL(shape[1], feat_col.cols());
+          Eigen::MatrixXf feat_float{Eigen::MatrixXf::Constant(
+              shape[0], shape[1], std::nanf(""))};
+          collection.fill_features(representations.back(), feat_float);
+          BOOST_CHECK(feat_float == feat_col.cast<float>());
+          math::Matrix_t feat_block{
+              math::Matrix_t::Zero(shape[0] + 1, shape[1])};
+          collection.fill_features(representations.back(),
+                                   feat_block.bottomRows(shape[0]));
+          BOOST_CHECK(feat_block.bottomRows(shape[0]) == feat_col);
+          BOOST_CHECK_THROW(
+              collection.fill_features(representations.back(), feat_block),
+              std::runtime_error);
         }
       }
       manager_i++;
@@ -277,6 +299,108 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  using feature_cache_fixtures =
+      boost::mpl::list<CalculatorFixture<MultipleStructureSphericalInvariants<
+          MultipleStructureManagerNLCCStrictFixture>>>;
+
+  /**
+   * Test that the features (and gradients) loaded from the feature cache are
+   * the ones that have been computed and that the size of the cache is
+   * bounded
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(feature_cache_test, Fix,
+                                   feature_cache_fixtures, Fix) {
+    using Representation_t = typename Fix::Representation_t;
+    using Manager_t = typename Fix::Manager_t;
+    using Property_t = typename Fix::Property_t;
+    using PropertyGradient_t =
+        typename Representation_t::template PropertyGradient_t<Manager_t>;
+    auto & managers = Fix::managers;
+    auto & representation_hypers = Fix::representation_hypers;
+
+    // some hypers give NaN gradients that should be restored as they are
+    auto is_identical = [](const math::Matrix_t & a, const math::Matrix_t & b) {
+      return a.rows() == b.rows() and a.cols() == b.cols() and
+             ((a.array() == b.array()) or
+              (a.array().isNaN() and b.array().isNaN()))
+                 .all();
+    };
+
+    std::string directory{"feature_cache_test"};
+    auto cache{std::make_shared<FeatureCache>(directory)};
+    cache->clear();
+
+    size_t n_computed{0};
+    for (auto hyper : representation_hypers) {
+      if (hyper["soap_type"] != "BiSpectrum") {
+        hyper["compute_gradients"] = true;
+      }
+      Representation_t representation{hyper};
+      representation.set_feature_cache(cache);
+      for (auto & manager : managers) {
+        representation.compute(manager);
+        ++n_computed;
+        auto && features{*manager->template get_property<Property_t>(
+            representation.get_name(), true)};
+        math::Matrix_t features_ref = features.get_features();
+        std::shared_ptr<PropertyGradient_t> gradients{};
+        math::Matrix_t gradients_ref{};
+        if (representation.does_gradients()) {
+          gradients = manager->template get_property<PropertyGradient_t>(
+              representation.get_gradient_name(), true);
+          gradients_ref = gradients->get_features_gradient();
+        }
+
+        // update the manager with the same structure and forget the
+        // features so that they have to be loaded from the cache
+        auto root{extract_underlying_manager<0>(manager)};
+        auto structure{root->get_atomic_structure()};
+        manager->update(structure);
+        features.clear();
+        if (gradients) {
+          gradients->clear();
+        }
+        size_t n_hits{cache->get_hits()};
+        representation.compute(manager);
+        BOOST_CHECK_EQUAL(cache->get_hits(), n_hits + 1);
+        BOOST_CHECK(features.is_updated());
+
+        // the loaded features are up to date so the cache is not read again
+        size_t n_misses{cache->get_misses()};
+        representation.compute(manager);
+        BOOST_CHECK_EQUAL(cache->get_hits(), n_hits + 1);
+        BOOST_CHECK_EQUAL(cache->get_misses(), n_misses);
+
+        // overwriting an entry does not change the size of the cache
+        size_t size{cache->get_size()};
+        cache->template store<Property_t, PropertyGradient_t>(
+            representation, manager, true);
+        BOOST_CHECK_EQUAL(cache->get_size(), size);
+
+        math::Matrix_t features_test = features.get_features();
+        BOOST_CHECK(is_identical(features_test, features_ref));
+        if (gradients) {
+          math::Matrix_t gradients_test = gradients->get_features_gradient();
+          BOOST_CHECK(is_identical(gradients_test, gradients_ref));
+        }
+      }
+    }
+    // identical hypers are only computed once
+    BOOST_CHECK_LE(cache->get_hits() + cache->get_misses(), 2 * n_computed);
+    BOOST_CHECK_LT(cache->get_misses(), n_computed);
+
+    // the least recently used entries are evicted
+    size_t size{cache->get_size()};
+    BOOST_CHECK_GT(size, 0);
+    cache->set_max_size(size / 2);
+    BOOST_CHECK_LE(cache->get_size(), size / 2);
+
+    cache->clear();
+    BOOST_CHECK_EQUAL(cache->get_size(), 0);
+    std::remove(directory.c_str());
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Test if the no center option takes out the centers
@@ -398,6 +522,426 @@ namespace rascal {
 
   /* ---------------------------------------------------------------------- */
 
+  using expansion_fixtures =
+      boost::mpl::list<CalculatorFixture<MultipleStructureSphericalExpansion<
+          MultipleStructureManagerNLCCStrictFixture>>>;
+
+  /**
+   * Test that when only the positions change the layout of the spherical
+   * expansion is kept and that the coefficients are the same as after a full
+   * rebuild of the managers
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(positions_update_test, Fix,
+                                   expansion_fixtures, Fix) {
+    auto & managers = Fix::managers;
+    auto & hypers = Fix::representation_hypers;
+    using Representation_t = typename Fix::Representation_t;
+    using Property_t = typename Fix::Property_t;
+
+    for (auto & manager : managers) {
+      auto root{extract_underlying_manager<0>(manager)};
+      auto structure{root->get_atomic_structure()};
+      auto moved_structure{structure};
+      // stay inside the unit cell
+      moved_structure.positions *= 1. - 1e-6;
+      for (auto & hyper : hypers) {
+        double representation_cutoff{
+            extract_interaction_cutoff_from_representation_hyper(hyper)};
+        if (manager->get_cutoff() != representation_cutoff) {
+          continue;
+        }
+        manager->update(structure);
+        Representation_t representation{hyper};
+        representation.compute(manager);
+        auto & prop = *manager->template get_property<Property_t>(
+            representation.get_name(), true);
+        auto layout_version{prop.get_layout_version()};
+        BOOST_CHECK_EQUAL(layout_version, manager->get_topology_version());
+
+        manager->update(moved_structure);
+        BOOST_CHECK(root->get_structure_changes() ==
+                    StructureChange::Positions);
+        representation.compute(manager);
+        math::Matrix_t features = prop.get_features();
+        if (not has_structure_change(manager->get_structure_changes(),
+                                     TopologyChanges)) {
+          BOOST_CHECK_EQUAL(prop.get_layout_version(), layout_version);
+        }
+
+        // rebuild everything
+        root->send_changed_structure_signal();
+        manager->update();
+        representation.compute(manager);
+        BOOST_CHECK_NE(prop.get_layout_version(), layout_version);
+        math::Matrix_t features_ref = prop.get_features();
+        BOOST_CHECK_EQUAL(features.rows(), features_ref.rows());
+        BOOST_CHECK_EQUAL(features.cols(), features_ref.cols());
+        BOOST_CHECK_LE((features - features_ref).norm(), math::DBL_FTOL);
+      }
+    }
+  }
+
+  /**
+   * Test that including the cutoff function in the spline of the radial
+   * contribution gives the same expansion and gradients as applying it for
+   * each pair
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(spline_cutoff_function_test, Fix,
+                                   expansion_fixtures, Fix) {
+    using Representation_t = typename Fix::Representation_t;
+    using Manager_t = typename Fix::Manager_t;
+    using Property_t = typename Fix::Property_t;
+    using PropertyGradient_t =
+        typename Representation_t::template PropertyGradient_t<Manager_t>;
+    auto & managers = Fix::managers;
+    auto & hypers = Fix::representation_hypers;
+
+    for (auto & manager : managers) {
+      for (auto & hyper : hypers) {
+        json hyper_ref = hyper;
+        hyper_ref["cutoff_function"]["cutoff"]["value"] =
+            manager->get_cutoff();
+        hyper_ref["compute_gradients"] = true;
+        hyper_ref["radial_contribution"]["optimization"] = {
+            {"Spline", {{"accuracy", 1e-10}}}};
+        json hyper_fc = hyper_ref;
+        hyper_fc["radial_contribution"]["optimization"]["Spline"]
+                ["include_cutoff_function"] = true;
+        json fc_hypers = hyper.at("cutoff_function");
+        if (fc_hypers.at("type") == "RadialScaling" and
+            fc_hypers.at("rate").at("value").get<double>() == 0.) {
+          BOOST_CHECK_THROW(Representation_t{hyper_fc}, std::logic_error);
+          continue;
+        }
+
+        Representation_t representation_ref{hyper_ref};
+        representation_ref.compute(manager);
+        Representation_t representation_fc{hyper_fc};
+        representation_fc.compute(manager);
+
+        auto & prop_ref = *manager->template get_property<Property_t>(
+            representation_ref.get_name(), true);
+        auto & prop_fc = *manager->template get_property<Property_t>(
+            representation_fc.get_name(), true);
+        math::Matrix_t features_ref = prop_ref.get_features();
+        math::Matrix_t features_fc = prop_fc.get_features();
+        BOOST_CHECK_EQUAL(features_fc.rows(), features_ref.rows());
+        BOOST_CHECK_EQUAL(features_fc.cols(), features_ref.cols());
+        BOOST_CHECK_LE((features_fc - features_ref).cwiseAbs().maxCoeff(),
+                       1e-8);
+
+        auto & grad_ref = *manager->template get_property<PropertyGradient_t>(
+            representation_ref.get_gradient_name(), true);
+        auto & grad_fc = *manager->template get_property<PropertyGradient_t>(
+            representation_fc.get_gradient_name(), true);
+        math::Matrix_t gradients_ref = grad_ref.get_features_gradient();
+        math::Matrix_t gradients_fc = grad_fc.get_features_gradient();
+        BOOST_CHECK_EQUAL(gradients_fc.rows(), gradients_ref.rows());
+        BOOST_CHECK_EQUAL(gradients_fc.cols(), gradients_ref.cols());
+        // the spline is refined on the values and the curvature of f_c in
+        // the smoothing region makes its derivative less accurate
+        BOOST_CHECK_LE((gradients_fc - gradients_ref).cwiseAbs().maxCoeff(),
+                       1e-5);
+      }
+    }
+  }
+
+  /**
+   * Test that the splines loaded from the spline cache, within the process
+   * or from disk, and the splines refined with several threads give the same
+   * expansion as the ones computed
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(spline_cache_test, Fix, expansion_fixtures,
+                                   Fix) {
+    using Representation_t = typename Fix::Representation_t;
+    using Property_t = typename Fix::Property_t;
+    auto & managers = Fix::managers;
+    auto & hypers = Fix::representation_hypers;
+    auto manager = managers.front();
+
+    std::string directory{"spline_cache_test"};
+    auto & cache{SplineCache::get_instance()};
+    cache.clear_directory(directory);
+
+    auto compute = [&manager](const json & hyper) {
+      Representation_t representation{hyper};
+      representation.compute(manager);
+      auto & prop = *manager->template get_property<Property_t>(
+          representation.get_name(), true);
+      math::Matrix_t features = prop.get_features();
+      return features;
+    };
+
+    for (auto & hyper : hypers) {
+      json hyper_ref = hyper;
+      hyper_ref["radial_contribution"]["optimization"] = {
+          {"Spline", {{"accuracy", 1e-8}}}};
+      json hyper_cache = hyper_ref;
+      hyper_cache["radial_contribution"]["optimization"]["Spline"]
+                 ["cache_directory"] = directory;
+      math::Matrix_t features_ref = compute(hyper_ref);
+
+      // computed and stored
+      cache.clear();
+      size_t n_misses{cache.get_misses()};
+      math::Matrix_t features_computed = compute(hyper_cache);
+      BOOST_CHECK_EQUAL(cache.get_misses(), n_misses + 1);
+      // loaded from the process
+      size_t n_hits{cache.get_hits()};
+      math::Matrix_t features_process = compute(hyper_cache);
+      BOOST_CHECK_EQUAL(cache.get_hits(), n_hits + 1);
+      // loaded from the disk
+      cache.clear();
+      math::Matrix_t features_disk = compute(hyper_cache);
+      BOOST_CHECK_EQUAL(cache.get_hits(), n_hits + 2);
+      // the splines do not depend on the number of threads refining them
+      json hyper_threads = hyper_ref;
+      hyper_threads["radial_contribution"]["optimization"]["Spline"]
+                   ["n_threads"] = 2;
+      math::Matrix_t features_threads = compute(hyper_threads);
+      hyper_cache["radial_contribution"]["optimization"]["Spline"]
+                 ["n_threads"] = 2;
+      compute(hyper_cache);
+      BOOST_CHECK_EQUAL(cache.get_hits(), n_hits + 3);
+      // the segments of the splines are refined separately and stored
+      // together
+      json hyper_segments = hyper_cache;
+      hyper_segments["radial_contribution"]["optimization"]["Spline"]
+                    ["n_segments"] = 4;
+      math::Matrix_t features_segments = compute(hyper_segments);
+      cache.clear();
+      math::Matrix_t features_segments_disk = compute(hyper_segments);
+      BOOST_CHECK_EQUAL(cache.get_hits(), n_hits + 4);
+      BOOST_CHECK_LE(
+          (features_segments_disk - features_segments).cwiseAbs().maxCoeff(),
+          math::DBL_FTOL);
+      BOOST_CHECK_LE((features_segments - features_ref).cwiseAbs().maxCoeff(),
+                     1e-7);
+
+      for (const auto & features : {features_computed, features_process,
+                                    features_disk, features_threads}) {
+        BOOST_CHECK_EQUAL(features.rows(), features_ref.rows());
+        BOOST_CHECK_EQUAL(features.cols(), features_ref.cols());
+        BOOST_CHECK_LE((features - features_ref).cwiseAbs().maxCoeff(),
+                       math::DBL_FTOL);
+      }
+    }
+
+    // a table is only loaded for the key it has been stored with, even if
+    // its file has the name of another key
+    auto get_filename = [&directory](const std::string & key) {
+      std::stringstream filename{};
+      filename << directory << "/" << std::hex << std::setfill('0')
+               << std::setw(16) << internal::hash_bytes(key.data(), key.size())
+               << SplineCache::Extension;
+      return filename.str();
+    };
+    const std::vector<char> blob_ref{'a', 'b', 'c'};
+    std::vector<char> blob{};
+    cache.store("key a", blob_ref, directory);
+    cache.clear();
+    BOOST_CHECK(cache.load("key a", blob, directory));
+    BOOST_CHECK(blob == blob_ref);
+    cache.clear();
+    std::rename(get_filename("key a").c_str(), get_filename("key b").c_str());
+    BOOST_CHECK(not cache.load("key b", blob, directory));
+
+    cache.clear();
+    cache.clear_directory(directory);
+    std::remove(directory.c_str());
+  }
+
+  /**
+   * Test that the solid harmonics give the same expansion as the Legendre
+   * ones and that unknown methods are rejected
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(spherical_harmonics_method_test, Fix,
+                                   expansion_fixtures, Fix) {
+    using Representation_t = typename Fix::Representation_t;
+    using Property_t = typename Fix::Property_t;
+    auto & managers = Fix::managers;
+    auto & hypers = Fix::representation_hypers;
+    auto manager = managers.front();
+
+    auto compute = [&manager](const json & hyper) {
+      Representation_t representation{hyper};
+      representation.compute(manager);
+      auto & prop = *manager->template get_property<Property_t>(
+          representation.get_name(), true);
+      math::Matrix_t features = prop.get_features();
+      return features;
+    };
+
+    for (auto & hyper : hypers) {
+      json hyper_legendre = hyper;
+      hyper_legendre["spherical_harmonics_method"] = "Legendre";
+      json hyper_solid = hyper;
+      hyper_solid["spherical_harmonics_method"] = "Solid";
+      math::Matrix_t features_ref = compute(hyper);
+      math::Matrix_t features_legendre = compute(hyper_legendre);
+      math::Matrix_t features_solid = compute(hyper_solid);
+      BOOST_CHECK_EQUAL(features_solid.rows(), features_ref.rows());
+      BOOST_CHECK_EQUAL(features_solid.cols(), features_ref.cols());
+      BOOST_CHECK_EQUAL(
+          (features_legendre - features_ref).cwiseAbs().maxCoeff(), 0.);
+      BOOST_CHECK_LE((features_solid - features_ref).cwiseAbs().maxCoeff(),
+                     math::DBL_FTOL);
+
+      json hyper_unknown = hyper;
+      hyper_unknown["spherical_harmonics_method"] = "Cartesian";
+      BOOST_CHECK_THROW(Representation_t{hyper_unknown}, std::logic_error);
+    }
+  }
+
+  /**
+   * Test that the sparse real couplings give the same BiSpectrum and
+   * LambdaSpectrum as the Wigner 3j symbols applied to the complex
+   * coefficients and that the tables are shared through the cache
+   */
+  BOOST_AUTO_TEST_CASE(coupling_cache_test) {
+    using complex = std::complex<double>;
+    constexpr size_t MaxAngular{4};
+    const int n_lm{static_cast<int>(math::pow(MaxAngular + 1, 2_size_t))};
+    Eigen::VectorXd coef1{Eigen::VectorXd::Random(n_lm)};
+    Eigen::VectorXd coef2{Eigen::VectorXd::Random(n_lm)};
+    Eigen::VectorXd coef3{Eigen::VectorXd::Random(n_lm)};
+
+    // the complex coefficients as in src/math/spherical_harmonics.hh
+    auto to_complex = [](const Eigen::VectorXd & coef, int l, int m) {
+      const int lm{l * l + l + m}, lm_minus{l * l + l - m};
+      if (m > 0) {
+        return math::pow(-1.0, m) * complex{coef(lm), coef(lm_minus)} *
+               math::INV_SQRT_TWO;
+      } else if (m == 0) {
+        return complex{coef(lm), 0.};
+      }
+      return complex{coef(lm_minus), -coef(lm)} * math::INV_SQRT_TWO;
+    };
+    auto part = [](const complex & value, int l_sum) {
+      return (l_sum % 2 == 0) ? value.real() : value.imag();
+    };
+
+    auto & cache{CouplingCache::get_instance()};
+    // computing the tables resets the state of wigxjpf so they are all
+    // computed before the reference values
+    for (bool inversion_symmetry : {true, false}) {
+      cache.get_bispectrum_table(MaxAngular, inversion_symmetry);
+      for (size_t lambda{0}; lambda < 2 * MaxAngular + 1; ++lambda) {
+        cache.get_lambda_spectrum_table(MaxAngular, inversion_symmetry,
+                                        lambda);
+      }
+    }
+    wig_table_init(4 * (MaxAngular + 1), 3);
+    wig_temp_init(4 * (MaxAngular + 1));
+    for (bool inversion_symmetry : {true, false}) {
+      auto table{cache.get_bispectrum_table(MaxAngular, inversion_symmetry)};
+      size_t n_hits{cache.get_hits()};
+      BOOST_CHECK_EQUAL(
+          cache.get_bispectrum_table(MaxAngular, inversion_symmetry), table);
+      BOOST_CHECK_EQUAL(cache.get_hits(), n_hits + 1);
+
+      for (const auto & block : table->blocks) {
+        const int l1{static_cast<int>(block.l1)};
+        const int l2{static_cast<int>(block.l2)};
+        const int l3{static_cast<int>(block.l3)};
+        double feature_ref{0.};
+        for (int m1{-l1}; m1 < l1 + 1; ++m1) {
+          for (int m2{-l2}; m2 < l2 + 1; ++m2) {
+            const int m3{-m1 - m2};
+            if (std::abs(m3) > l3) {
+              continue;
+            }
+            feature_ref += wig3jj(2 * l1, 2 * l2, 2 * l3, 2 * m1, 2 * m2,
+                                  2 * m3) *
+                           part(to_complex(coef1, l1, m1) *
+                                    to_complex(coef2, l2, m2) *
+                                    to_complex(coef3, l3, m3),
+                                l1 + l2 + l3);
+          }
+        }
+        double feature{0.};
+        for (size_t i_c{block.begin}; i_c < block.end; ++i_c) {
+          const auto & coupling{table->couplings[i_c]};
+          feature += coupling.value * coef1(l1 * l1 + coupling.m1) *
+                     coef2(l2 * l2 + coupling.m2) *
+                     coef3(l3 * l3 + coupling.m3);
+        }
+        BOOST_CHECK_LE(std::abs(feature - feature_ref), math::DBL_FTOL);
+      }
+
+      for (size_t lambda{0}; lambda < 2 * MaxAngular + 1; ++lambda) {
+        auto lambda_table{cache.get_lambda_spectrum_table(
+            MaxAngular, inversion_symmetry, lambda)};
+        const int l3{static_cast<int>(lambda)};
+        for (const auto & block : lambda_table->blocks) {
+          const int l1{static_cast<int>(block.l1)};
+          const int l2{static_cast<int>(block.l2)};
+          Eigen::VectorXd features_ref{Eigen::VectorXd::Zero(2 * l3 + 1)};
+          for (int m3{-l3}; m3 < l3 + 1; ++m3) {
+            const complex phase{m3 < 0 ? complex{0., 1.} : complex{1., 0.}};
+            for (int m1{-l1}; m1 < l1 + 1; ++m1) {
+              for (int m2{-l2}; m2 < l2 + 1; ++m2) {
+                if (m1 + m2 + m3 != 0 and m1 + m2 - m3 != 0) {
+                  continue;
+                }
+                double w3j1{wig3jj(2 * l1, 2 * l2, 2 * l3, 2 * m1, 2 * m2,
+                                   2 * m3)};
+                double w3j2{wig3jj(2 * l1, 2 * l2, 2 * l3, 2 * m1, 2 * m2,
+                                   -2 * m3)};
+                double w3j{w3j1};
+                if (m3 > 0) {
+                  w3j = (w3j2 + math::pow(-1, m3) * w3j1) * math::INV_SQRT_TWO;
+                } else if (m3 < 0) {
+                  w3j = (w3j1 - math::pow(-1, m3) * w3j2) * math::INV_SQRT_TWO;
+                }
+                features_ref(m3 + l3) +=
+                    w3j * part(phase * to_complex(coef1, l1, m1) *
+                                   to_complex(coef2, l2, m2),
+                               l1 + l2 + l3);
+              }
+            }
+          }
+          Eigen::VectorXd features{Eigen::VectorXd::Zero(2 * l3 + 1)};
+          for (size_t i_c{block.begin}; i_c < block.end; ++i_c) {
+            const auto & coupling{lambda_table->couplings[i_c]};
+            features(coupling.m3) += coupling.value *
+                                     coef1(l1 * l1 + coupling.m1) *
+                                     coef2(l2 * l2 + coupling.m2);
+          }
+          BOOST_CHECK_LE((features - features_ref).cwiseAbs().maxCoeff(),
+                         math::DBL_FTOL);
+        }
+      }
+    }
+    wig_temp_free();
+    wig_table_free();
+
+    // the calculators share the tables
+    json hypers{{"max_radial", 2},
+                {"max_angular", 2},
+                {"soap_type", "BiSpectrum"},
+                {"inversion_symmetry", true},
+                {"normalize", true},
+                {"cutoff_function",
+                 {{"type", "ShiftedCosine"},
+                  {"cutoff", {{"value", 3.0}, {"unit", "AA"}}},
+                  {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}},
+                {"gaussian_density",
+                 {{"type", "Constant"},
+                  {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}}},
+                {"radial_contribution", {{"type", "GTO"}}}};
+    cache.clear();
+    size_t n_misses{cache.get_misses()};
+    CalculatorSphericalInvariants representation{hypers};
+    CalculatorSphericalInvariants representation_cached{hypers};
+    BOOST_CHECK_EQUAL(cache.get_misses(), n_misses + 1);
+    BOOST_CHECK_EQUAL(cache.size(), 1_size_t);
+    BOOST_CHECK(representation == representation_cached);
+    cache.clear();
+  }
+
+  /* ---------------------------------------------------------------------- */
+
   using grad_sparse_fixtures =
       boost::mpl::list<CalculatorFixture<ComplexHypersSphericalInvariants>>;
 
@@ -493,6 +1037,66 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that the sparse (CSR) export of the gradients matches the dense one
+   * and only stores the keys of each neighbor
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(sparse_grad_export_test, Fix,
+                                   grad_sparse_fixtures, Fix) {
+    using ManagerCollection_t =
+        typename TypeHolderInjector<ManagerCollection,
+                                    typename Fix::ManagerTypeList_t>::type;
+    auto & managers = Fix::managers;
+    auto & representations = Fix::representations;
+    auto & hypers = Fix::representation_hypers;
+
+    for (auto & manager : managers) {
+      for (auto & hyper : hypers) {
+        if (hyper["soap_type"] != "PowerSpectrum") {
+          continue;
+        }
+        representations.emplace_back(hyper);
+        auto & representation{representations.back()};
+        representation.compute(manager);
+        ManagerCollection_t collection{};
+        collection.add_structure(manager);
+        auto all_keys{collection.get_keys(representation)};
+        auto shape{
+            collection.get_features_gradient_shape(representation, all_keys)};
+        math::Matrix_t grad_dense(shape[0], shape[1]);
+        collection.fill_features_gradient(representation, all_keys,
+                                          grad_dense);
+        auto grad_sparse{
+            collection.get_features_gradient_sparse(representation, all_keys)};
+        BOOST_CHECK_EQUAL(grad_sparse.rows(), grad_dense.rows());
+        BOOST_CHECK_EQUAL(grad_sparse.cols(), grad_dense.cols());
+        BOOST_CHECK(grad_sparse.isCompressed());
+        math::Matrix_t grad_sparse_dense{grad_sparse.toDense()};
+        BOOST_CHECK(grad_sparse_dense == grad_dense);
+        if (not hyper["normalize"]) {
+          // the neighbors only have the keys containing their species
+          BOOST_CHECK_LT(grad_sparse.nonZeros(), grad_dense.size());
+        }
+
+        // keys missing from the properties are implicit zeros
+        auto some_keys{all_keys};
+        some_keys.erase(some_keys.begin());
+        some_keys.insert({1, 1});
+        auto some_shape{
+            collection.get_features_gradient_shape(representation, some_keys)};
+        math::Matrix_t some_grad_dense(some_shape[0], some_shape[1]);
+        collection.fill_features_gradient(representation, some_keys,
+                                          some_grad_dense);
+        math::Matrix_t some_grad_sparse{
+            collection
+                .get_features_gradient_sparse(representation, some_keys)
+                .toDense()};
+        BOOST_CHECK(some_grad_sparse == some_grad_dense);
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Test if the representation computed is equal to a reference from a file
@@ -657,6 +657,10 @@ namespace rascal {
         {{"type", "GTO"}, {"optimization", {}}},
         {{"type", "DVR"}, {"optimization", {}}},
         {{"type", "GTO"}, {"optimization", {{"Spline", {{"accuracy", 1e-8}}}}}},
+        {{"type", "GTO"},
+         {"optimization",
+          {{"Spline",
+            {{"accuracy", 1e-8}, {"include_cutoff_function", true}}}}}},
         {{"type", "GTO"},
          {"optimization", radial_dim_reduction_spline_hypers}}};
     // if new hypers are added or current ones changed there will be problems
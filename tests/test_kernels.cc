@@ -97,6 +97,45 @@ namespace rascal {
     }
   }
 
+  /**
+   * Tests that the structure kernels computed with several tiles and threads
+   * agree with the reference data.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(tiled_kernel_test, Fix,
+                                   multiple_ref_fixtures, Fix) {
+    auto & representations = Fix::representations;
+    auto & collections = Fix::collections;
+    auto & ref_data = Fix::ParentA::ref_data;
+    const double delta{1e-10};
+    for (size_t i_collection{0}; i_collection < ref_data.size();
+         ++i_collection) {
+      auto & collection = collections[i_collection];
+      for (size_t i_rep{0}; i_rep < ref_data[i_collection].size(); ++i_rep) {
+        auto ref_mat = ref_data[i_collection][i_rep]["kernel_matrix"]
+                           .template get<math::Matrix_t>();
+        json kernel_hypers = ref_data[i_collection][i_rep]["hypers_kernel"];
+        if (kernel_hypers["target_type"] != "Structure") {
+          continue;
+        }
+        auto & rep = representations[i_rep];
+        rep.compute(collection);
+        for (size_t tile_size : {1, 7, 1000}) {
+          kernel_hypers["tile_size"] = tile_size;
+          Kernel kernel{kernel_hypers};
+          for (size_t n_threads : {1, 3}) {
+            auto mat = kernel.compute(rep, collection, collection, n_threads);
+            auto diff_m{math::relative_error(ref_mat, mat, delta)};
+            BOOST_TEST(diff_m.maxCoeff() < delta);
+
+            auto mat_sym = kernel.compute(rep, collection, n_threads);
+            diff_m = math::relative_error(ref_mat, mat_sym, delta);
+            BOOST_TEST(diff_m.maxCoeff() < delta);
+          }
+        }
+      }
+    }
+  }
+
   /**
    * Tests that the Spherical invariant give the same kernel with different
    * expansion_by_species_method
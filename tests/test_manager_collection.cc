@@ -31,6 +31,8 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <fstream>
+
 namespace rascal {
 
   BOOST_AUTO_TEST_SUITE(manager_collection_test);
@@ -89,5 +91,129 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that a collection built from a StructureStore is identical to the
+   * one built from the original json file and that the positions are read
+   * from the mapping without copy.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(load_structure_store_test, Fix,
+                                   fixtures_test, Fix) {
+    auto & collections = Fix::collections;
+    auto & filename = Fix::filename;
+    auto & start = Fix::start;
+    auto & length = Fix::length;
+    std::string store_filename{"structure_store_test.rss"};
+
+    auto n_structures{convert_to_structure_store(filename, store_filename)};
+    auto store{std::make_shared<StructureStore>(store_filename)};
+    BOOST_CHECK_EQUAL(store->size(), n_structures);
+
+    for (auto & collection : collections) {
+      using ManagerCollection_t = std::remove_reference_t<decltype(collection)>;
+      ManagerCollection_t collection_mapped{
+          collection.get_adaptors_parameters()};
+      collection.add_structures(filename, start, length);
+      collection_mapped.add_structures(store, start, length);
+      BOOST_CHECK_EQUAL(collection.size(), collection_mapped.size());
+
+      // ranges outside of the store are rejected
+      int n_stored{static_cast<int>(n_structures)};
+      BOOST_CHECK_THROW(collection_mapped.add_structures(store, 0, -2),
+                        std::runtime_error);
+      BOOST_CHECK_THROW(collection_mapped.add_structures(store, 1, n_stored),
+                        std::runtime_error);
+      BOOST_CHECK_THROW(
+          collection_mapped.add_structures(store, n_stored + 1, 0),
+          std::runtime_error);
+
+      for (size_t i_manager{0}; i_manager < collection.size(); ++i_manager) {
+        auto manager = collection[i_manager];
+        auto manager_mapped = collection_mapped[i_manager];
+        auto root_mapped = extract_underlying_manager<0>(manager_mapped);
+        BOOST_CHECK(root_mapped->is_mapped());
+        const double * mapped_data{
+            store->get_positions_data(start + i_manager)};
+        BOOST_CHECK_EQUAL(root_mapped->get_positions().data(), mapped_data);
+
+        BOOST_CHECK_EQUAL(manager->size(), manager_mapped->size());
+        BOOST_CHECK_EQUAL(manager->get_nb_clusters(2),
+                          manager_mapped->get_nb_clusters(2));
+        auto root = extract_underlying_manager<0>(manager);
+        auto error{(root->get_positions() - root_mapped->get_positions())
+                       .array()
+                       .abs()
+                       .maxCoeff()};
+        BOOST_CHECK_EQUAL(error, 0.);
+        BOOST_CHECK((root->get_atom_types().array() ==
+                     root_mapped->get_atom_types().array())
+                        .all());
+
+        // the positions are copied when the full structure is requested
+        // and the manager keeps reading from the mapping
+        auto structure{root_mapped->get_atomic_structure()};
+        BOOST_CHECK(root_mapped->is_mapped());
+        BOOST_CHECK_EQUAL(root_mapped->get_positions().data(), mapped_data);
+        BOOST_CHECK_EQUAL(structure.positions.cols(),
+                          root->get_positions().cols());
+        auto structure_error{(structure.positions - root->get_positions())
+                                 .array()
+                                 .abs()
+                                 .maxCoeff()};
+        BOOST_CHECK_EQUAL(structure_error, 0.);
+      }
+    }
+    std::remove(store_filename.c_str());
+  }
+
+  /**
+   * Test that a StructureStore with corrupted atom offsets is rejected when
+   * opened instead of reading past the end of the file.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(corrupted_structure_store_test, Fix,
+                                   fixtures_test, Fix) {
+    using Header_t = internal::StructureStoreHeader;
+    auto & filename = Fix::filename;
+    std::string store_filename{"structure_store_corrupted_test.rss"};
+
+    auto n_structures{convert_to_structure_store(filename, store_filename)};
+    BOOST_REQUIRE_GE(n_structures, 2);
+    Header_t header{};
+    {
+      std::ifstream stream{store_filename, std::ios::binary};
+      stream.read(reinterpret_cast<char *>(&header), sizeof(Header_t));
+    }
+    std::vector<uint64_t> atom_offsets(n_structures + 1);
+    {
+      std::ifstream stream{store_filename, std::ios::binary};
+      stream.seekg(header.atom_offsets);
+      stream.read(reinterpret_cast<char *>(atom_offsets.data()),
+                  atom_offsets.size() * sizeof(uint64_t));
+    }
+    auto write_offsets = [&](const std::vector<uint64_t> & offsets) {
+      std::fstream stream{store_filename,
+                          std::ios::binary | std::ios::in | std::ios::out};
+      stream.seekp(header.atom_offsets);
+      stream.write(reinterpret_cast<const char *>(offsets.data()),
+                   offsets.size() * sizeof(uint64_t));
+    };
+
+    // offsets not starting at 0
+    auto corrupted_offsets{atom_offsets};
+    corrupted_offsets[0] = 1;
+    write_offsets(corrupted_offsets);
+    BOOST_CHECK_THROW(StructureStore{store_filename}, std::runtime_error);
+
+    // decreasing offsets that still end at the number of atoms
+    corrupted_offsets = atom_offsets;
+    corrupted_offsets[1] = header.n_atoms + 1;
+    write_offsets(corrupted_offsets);
+    BOOST_CHECK_THROW(StructureStore{store_filename}, std::runtime_error);
+
+    // the untouched offsets are accepted
+    write_offsets(atom_offsets);
+    BOOST_CHECK_NO_THROW(StructureStore{store_filename});
+    std::remove(store_filename.c_str());
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 }  // namespace rascal
@@ -167,8 +167,12 @@ namespace rascal {
    */
   template <size_t max_angular>
   struct SphericalHarmonicsGradientsCalculator {
-    SphericalHarmonicsGradientsCalculator()
-        : harmonics_calculator{math::SphericalHarmonics(true)} {}
+    explicit SphericalHarmonicsGradientsCalculator(
+        math::SphericalHarmonicsMethod method =
+            math::SphericalHarmonicsMethod::Legendre)
+        : harmonics_calculator{math::SphericalHarmonics(true)} {
+      this->harmonics_calculator.set_method(method);
+    }
 
     static const size_t n_arguments = 3;
     using Matrix_Ref = typename Eigen::Ref<const math::Matrix_t>;
@@ -125,6 +125,52 @@ namespace rascal {
     }
   }
 
+  /**
+   * Check that evaluating a batch of distances at once gives the same G and
+   * derivatives as evaluating the distances one at a time.
+   */
+  BOOST_FIXTURE_TEST_CASE(math_hyp1f1_spherical_expansion_batch_test,
+                          Hyp1f1SphericalExpansionFixture) {
+    for (size_t i_rc{0}; i_rc < this->rcs.size(); ++i_rc) {
+      auto & rc{this->rcs[i_rc]};
+      auto & fac_b{this->facs_b[i_rc]};
+      std::vector<double> r_ijs{};
+      for (auto & r_ij : this->r_ijs) {
+        if (r_ij < rc) {
+          r_ijs.push_back(r_ij);
+        }
+      }
+      Eigen::Map<const Eigen::VectorXd> distances(r_ijs.data(), r_ijs.size());
+      for (auto & fac_a : this->fac_as) {
+        for (size_t ii{0}; ii < this->hyp1f1.size(); ++ii) {
+          for (auto * calculator : {&hyp1f1[ii], &hyp1f1_recursion[ii]}) {
+            calculator->calc(distances, fac_a, fac_b[ii], true);
+            math::Matrix_t batch_values{}, batch_derivatives{};
+            for (int i_r{0}; i_r < distances.size(); ++i_r) {
+              calculator->set_from_batch(i_r);
+              batch_values = calculator->get_values();
+              batch_derivatives = calculator->get_derivatives();
+              calculator->calc(distances(i_r), fac_a, fac_b[ii], true);
+              auto values{calculator->get_values()};
+              auto derivatives{calculator->get_derivatives()};
+              auto diff_val{(values - batch_values).array().abs() /
+                            values.array().abs()};
+              auto diff_der{(derivatives - batch_derivatives).array().abs() /
+                            derivatives.array().abs()};
+              BOOST_CHECK_LE(diff_val.mean(), 3 * math::DBL_FTOL);
+              BOOST_CHECK_LE(diff_der.mean(), 3 * math::DBL_FTOL);
+              if (verbose) {
+                std::cout << "r_ij=" << distances(i_r)
+                          << " diff_val=" << diff_val.mean()
+                          << " diff_der=" << diff_der.mean() << std::endl;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
   BOOST_AUTO_TEST_CASE(hyp1f1_gradient_test) {
     const size_t max_radial = 4;
     const size_t max_angular = 2;
@@ -26,6 +26,8 @@
 
 #include "test_math_interpolator.hh"
 
+#include <atomic>
+
 namespace rascal {
 
   // TODO(all) not sure about the naming convention of tests, camelcase ...
@@ -44,13 +46,34 @@ namespace rascal {
       math::InterpolatorMatrixUniformCubicSpline<
           math::RefinementMethod_t::Exponential>;
 
+  using IntpScalarUniformCubicSplineSecant =
+      math::InterpolatorScalarUniformCubicSpline<
+          math::RefinementMethod_t::Secant>;
+
+  using IntpMatrixUniformCubicSplineSecant =
+      math::InterpolatorMatrixUniformCubicSpline<
+          math::RefinementMethod_t::Secant>;
+
+  using IntpMatrixPiecewiseUniformCubicSpline =
+      math::InterpolatorMatrixPiecewiseUniformCubicSpline<
+          math::RefinementMethod_t::Exponential>;
+
   using interpolator_fixtures = boost::mpl::list<
       InterpolatorFixture<IntpScalarUniformCubicSpline>,
       InterpolatorFixture<IntpScalarUniformCubicSplineRelativeError>,
       InterpolatorFixture<IntpMatrixUniformCubicSpline>>;
 
+  // the Secant refinement stops as soon as the error bound is reached so the
+  // derivative is not as accurate as with the other refinements
+  using refinement_fixtures = boost::mpl::list<
+      InterpolatorFixture<IntpScalarUniformCubicSpline>,
+      InterpolatorFixture<IntpScalarUniformCubicSplineRelativeError>,
+      InterpolatorFixture<IntpMatrixUniformCubicSpline>,
+      InterpolatorFixture<IntpScalarUniformCubicSplineSecant>,
+      InterpolatorFixture<IntpMatrixUniformCubicSplineSecant>>;
+
   BOOST_FIXTURE_TEST_CASE_TEMPLATE(interpolator_constructor_test, Fix,
-                                   interpolator_fixtures, Fix) {
+                                   refinement_fixtures, Fix) {
     auto intp{std::make_shared<typename Fix::Interpolator_t>(
         Fix::functions["identity"], Fix::x1, Fix::x2, Fix::error_bound)};
   }
@@ -59,7 +82,7 @@ namespace rascal {
    * Tests for scalar functions.
    */
   BOOST_FIXTURE_TEST_CASE_TEMPLATE(functions_interpolator_test, Fix,
-                                   interpolator_fixtures, Fix) {
+                                   refinement_fixtures, Fix) {
     bool verbose{false};
 
     Vector_t ref_points =
@@ -103,7 +126,7 @@ namespace rascal {
    * Hyp1f1
    */
   BOOST_FIXTURE_TEST_CASE_TEMPLATE(hyp1f1_interpolator_test, Fix,
-                                   interpolator_fixtures, Fix) {
+                                   refinement_fixtures, Fix) {
     Vector_t ref_points =
         Vector_t::LinSpaced(Fix::nb_ref_points, Fix::x1, Fix::x2);
     std::function<double(double)> func = [&](double x) {
@@ -264,6 +287,214 @@ namespace rascal {
     double error{
         (intp_val - intp_ref).array().abs().colwise().mean().maxCoeff()};
     BOOST_CHECK_LE(error, error_bound);
+
+    // the allocation free versions give the same results
+    Matrix_t intp_batch{};
+    intp->interpolate_batch(ref_points, intp_batch);
+    Matrix_t intp_derivative_batch{};
+    intp->interpolate_derivative_batch(ref_points, intp_derivative_batch);
+    BOOST_CHECK_EQUAL(intp_batch.rows(), ref_points.size());
+    BOOST_CHECK_EQUAL(intp_batch.cols(), matrix_size);
+    Matrix_t intp_into{};
+    Matrix_t intp_derivative_into{};
+    Matrix_t intp_fused{};
+    Matrix_t intp_derivative_fused{};
+    for (int i{0}; i < ref_points.size(); i++) {
+      intp->interpolate_into(ref_points(i), intp_into);
+      intp->interpolate_derivative_into(ref_points(i), intp_derivative_into);
+      intp->interpolate_with_derivative(ref_points(i), intp_fused,
+                                        intp_derivative_fused);
+      BOOST_CHECK_LE((intp_fused - intp_into).cwiseAbs().maxCoeff(),
+                     math::DBL_FTOL);
+      BOOST_CHECK_LE(
+          (intp_derivative_fused - intp_derivative_into).cwiseAbs().maxCoeff(),
+          math::DBL_FTOL);
+      BOOST_CHECK_EQUAL(intp_into.rows(), rows);
+      BOOST_CHECK_EQUAL(intp_into.cols(), cols);
+      Matrix_t intp_val_i{intp->interpolate(ref_points(i))};
+      Matrix_t intp_derivative_i{intp->interpolate_derivative(ref_points(i))};
+      BOOST_CHECK_LE((intp_into - intp_val_i).cwiseAbs().maxCoeff(),
+                     math::DBL_FTOL);
+      BOOST_CHECK_LE(
+          (intp_derivative_into - intp_derivative_i).cwiseAbs().maxCoeff(),
+          math::DBL_FTOL);
+      BOOST_CHECK_LE(
+          (intp_batch.row(i) -
+           Eigen::Map<const Vector_t>(intp_val_i.data(), matrix_size))
+              .cwiseAbs()
+              .maxCoeff(),
+          math::DBL_FTOL);
+      BOOST_CHECK_LE((intp_derivative_batch.row(i) -
+                      Eigen::Map<const Vector_t>(intp_derivative_i.data(),
+                                                 matrix_size))
+                         .cwiseAbs()
+                         .maxCoeff(),
+                     math::DBL_FTOL);
+    }
+  }
+
+  /**
+   * Giving the second derivatives at the boundaries improves the accuracy of
+   * the derivative close to them compared to the natural boundary conditions
+   */
+  BOOST_AUTO_TEST_CASE(matrix_interpolator_curvature_test) {
+    const double x1{0.5};
+    const double x2{1.5};
+    const double error_bound{1e-8};
+    std::function<Matrix_t(double)> func = [](double x) {
+      Matrix_t result(1, 2);
+      result << std::sin(3 * x), std::exp(x);
+      return result;
+    };
+    auto dfunc = [](double x) {
+      Matrix_t result(1, 2);
+      result << 3 * std::cos(3 * x), std::exp(x);
+      return result;
+    };
+    auto d2func = [](double x) {
+      Matrix_t result(1, 2);
+      result << -9 * std::sin(3 * x), std::exp(x);
+      return result;
+    };
+    IntpMatrixUniformCubicSpline intp_natural{func, x1, x2, error_bound, 2,
+                                              1};
+    IntpMatrixUniformCubicSpline intp_curvature{
+        func, x1, x2, error_bound, 2, 1, d2func(x1), d2func(x2)};
+    for (double x : {x1, x2}) {
+      double error_natural{
+          (intp_natural.interpolate_derivative(x) - dfunc(x)).norm()};
+      double error_curvature{
+          (intp_curvature.interpolate_derivative(x) - dfunc(x)).norm()};
+      BOOST_CHECK_LE(error_curvature, 0.1 * error_natural);
+      BOOST_CHECK_LE((intp_curvature.interpolate(x) - func(x)).norm(),
+                     math::DBL_FTOL);
+    }
+  }
+
+  /**
+   * The Secant refinement reaches a tight error bound with fewer evaluations
+   * of the function than the Exponential one, and evaluating the function
+   * with several threads gives the same spline.
+   */
+  BOOST_AUTO_TEST_CASE(matrix_interpolator_refinement_test) {
+    const double x1{0.};
+    const double x2{5.};
+    const double error_bound{1e-10};
+    bool verbose{false};
+    std::atomic<int> nb_evaluations{0};
+    std::function<Matrix_t(double)> func = [&nb_evaluations](double x) {
+      ++nb_evaluations;
+      Matrix_t result(1, 3);
+      result << std::sin(3 * x), std::exp(-x), std::cos(x) / (1 + x);
+      return result;
+    };
+    Vector_t ref_points{Vector_t::LinSpaced(1000, x1, x2)};
+    auto compute_error = [&](auto & intp) {
+      Matrix_t ref_values(ref_points.size(), 3);
+      for (int i{0}; i < ref_points.size(); ++i) {
+        ref_values.row(i) = func(ref_points(i));
+      }
+      return (intp.interpolate_to_vector(ref_points) - ref_values)
+          .cwiseAbs()
+          .mean();
+    };
+
+    IntpMatrixUniformCubicSpline intp_exponential{func, x1,          x2,
+                                                  error_bound, 3, 1};
+    int nb_evaluations_exponential{nb_evaluations};
+    nb_evaluations = 0;
+    IntpMatrixUniformCubicSplineSecant intp_secant{func,        x1, x2,
+                                                   error_bound, 3,  1};
+    int nb_evaluations_secant{nb_evaluations};
+    if (verbose) {
+      std::cout << "Exponential: " << intp_exponential.get_grid_size()
+                << " grid points, " << nb_evaluations_exponential
+                << " evaluations" << std::endl;
+      std::cout << "Secant: " << intp_secant.get_grid_size()
+                << " grid points, " << nb_evaluations_secant << " evaluations"
+                << std::endl;
+    }
+    BOOST_CHECK_LT(nb_evaluations_secant, nb_evaluations_exponential);
+    BOOST_CHECK_LE(compute_error(intp_secant), 2 * error_bound);
+
+    IntpMatrixUniformCubicSplineSecant intp_parallel{
+        func, x1, x2, error_bound, 3, 1, 100000, 5, false, 0., 0., 4};
+    BOOST_CHECK_EQUAL(intp_parallel.get_grid_size(),
+                      intp_secant.get_grid_size());
+    BOOST_CHECK_EQUAL((intp_parallel.get_evaluated_grid_ref() -
+                       intp_secant.get_evaluated_grid_ref())
+                          .cwiseAbs()
+                          .maxCoeff(),
+                      0.);
+  }
+
+  /**
+   * Test that splitting the range in segments refined separately reaches the
+   * error bound with fewer grid points than a single uniform grid when the
+   * function varies quickly only in part of the range, and that the spline
+   * can be rebuilt from its segments.
+   */
+  BOOST_AUTO_TEST_CASE(matrix_interpolator_piecewise_test) {
+    const double x1{0.};
+    const double x2{5.};
+    const double error_bound{1e-8};
+    bool verbose{false};
+    std::function<Matrix_t(double)> func = [](double x) {
+      Matrix_t result(1, 2);
+      result << std::exp(-20 * x), std::sin(x) * std::exp(-20 * x) + x;
+      return result;
+    };
+    Vector_t ref_points{Vector_t::LinSpaced(1000, x1, x2)};
+    Matrix_t ref_values(ref_points.size(), 2);
+    for (int i{0}; i < ref_points.size(); ++i) {
+      ref_values.row(i) = func(ref_points(i));
+    }
+
+    IntpMatrixUniformCubicSpline intp_uniform{func, x1, x2, error_bound, 2, 1};
+    IntpMatrixPiecewiseUniformCubicSpline intp_piecewise{
+        func, x1, x2, error_bound, 2, 1, 8};
+    if (verbose) {
+      std::cout << "uniform: " << intp_uniform.get_grid_size()
+                << " grid points, piecewise: "
+                << intp_piecewise.get_grid_size() << " grid points"
+                << std::endl;
+    }
+    BOOST_CHECK_EQUAL(intp_piecewise.get_nb_segments(), 8);
+    BOOST_CHECK_LT(intp_piecewise.get_grid_size(),
+                   intp_uniform.get_grid_size());
+    Matrix_t values{intp_piecewise.interpolate_to_vector(ref_points)};
+    BOOST_CHECK_LE((values - ref_values).cwiseAbs().mean(), error_bound);
+    for (int i{0}; i < ref_points.size(); i += 37) {
+      double x{ref_points(i)};
+      auto & segment{intp_piecewise.get_segment_at(x)};
+      BOOST_CHECK(segment.x1 <= x and x <= segment.x2);
+      Matrix_t value{intp_piecewise.interpolate(x)};
+      BOOST_CHECK_EQUAL((value - values.row(i)).cwiseAbs().maxCoeff(), 0.);
+    }
+
+    using Segment_t = IntpMatrixPiecewiseUniformCubicSpline::Segment_t;
+    std::vector<std::unique_ptr<Segment_t>> segments{};
+    for (int i_segment{0}; i_segment < intp_piecewise.get_nb_segments();
+         ++i_segment) {
+      auto & segment{intp_piecewise.get_segment(i_segment)};
+      segments.push_back(std::make_unique<Segment_t>(
+          segment.get_grid_ref(), segment.get_evaluated_grid_ref(), 2, 1,
+          segment.get_d2fx1_ref(), segment.get_d2fx2_ref()));
+    }
+    IntpMatrixPiecewiseUniformCubicSpline intp_copy{std::move(segments)};
+    BOOST_CHECK_EQUAL(intp_copy.get_grid_size(),
+                      intp_piecewise.get_grid_size());
+    BOOST_CHECK_EQUAL(
+        (intp_copy.interpolate_to_vector(ref_points) - values)
+            .cwiseAbs()
+            .maxCoeff(),
+        0.);
+
+    std::vector<std::unique_ptr<Segment_t>> gap{};
+    gap.push_back(std::make_unique<Segment_t>(func, 0., 1., error_bound, 2, 1));
+    gap.push_back(std::make_unique<Segment_t>(func, 2., 3., error_bound, 2, 1));
+    BOOST_CHECK_THROW(IntpMatrixPiecewiseUniformCubicSpline{std::move(gap)},
+                      std::logic_error);
   }
 
   BOOST_AUTO_TEST_SUITE_END();
@@ -100,6 +100,45 @@ namespace rascal {
     }
   }
 
+  /**
+   * Check that the values and gradients computed for a batch of distances
+   * match the ones computed one distance at a time, including the distances
+   * below SPHERICAL_BESSEL_FUNCTION_FTOL and unsorted distances
+   */
+  BOOST_AUTO_TEST_CASE(math_bessel_batch_test) {
+    std::vector<size_t> max_angulars{{0, 1, 9, 20}};
+    std::vector<double> alphas{{0.6, 3.5, 8.5, 20, 50}};
+    Eigen::VectorXd xs = Eigen::VectorXd::LinSpaced(12, 0.005, 10);
+    Eigen::VectorXd distances(8);
+    distances << 3.2, 0., 0.6, 5.5, 1e-7, 0.6, 2.1, 4.9;
+
+    for (const auto & max_angular : max_angulars) {
+      for (const auto & alpha : alphas) {
+        math::ModifiedSphericalBessel bessel{};
+        bessel.precompute(max_angular, xs, true);
+        bessel.calc(distances, alpha);
+        for (int i_r{0}; i_r < distances.size(); ++i_r) {
+          bessel.set_from_batch(i_r);
+          Eigen::ArrayXXd batch_values{bessel.get_values()};
+          Eigen::ArrayXXd batch_gradients{bessel.get_gradients()};
+          bessel.calc(distances(i_r), alpha);
+          auto values{bessel.get_values()};
+          auto gradients{bessel.get_gradients()};
+          double diff_val{((values - batch_values).abs() /
+                           (values.abs().maxCoeff() + 1e-300))
+                              .maxCoeff()};
+          double diff_grad{((gradients - batch_gradients).abs() /
+                            (gradients.abs().maxCoeff() + 1e-300))
+                               .maxCoeff()};
+          BOOST_CHECK_LE(diff_val, math::DBL_FTOL);
+          BOOST_CHECK_LE(diff_grad, math::DBL_FTOL);
+          // the values set to 0 in the batch are also 0 one at a time
+          BOOST_CHECK(((values == 0) == (batch_values == 0)).all());
+        }
+      }
+    }
+  }
+
   BOOST_AUTO_TEST_CASE(MBFs_gradient_test) {
     // use same range as in the reference test
     std::vector<size_t> max_angulars{{0, 20}};
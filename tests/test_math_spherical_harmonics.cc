@@ -106,6 +106,60 @@ namespace rascal {
     }
   }
 
+  /**
+   * Check the solid harmonics against the reference values and against the
+   * Legendre method for the values, the gradients and the conjugates,
+   * including the directions along the z-axis
+   */
+  BOOST_FIXTURE_TEST_CASE(math_solid_harmonics_test,
+                          SphericalHarmonicsClassRefFixture) {
+    size_t max_angular_l = this->ref_data[0]["max_angular_l"];
+    math::SphericalHarmonics solid_calculator{true};
+    solid_calculator.set_method(math::SphericalHarmonicsMethod::Solid);
+    solid_calculator.precompute(max_angular_l);
+    math::SphericalHarmonics legendre_calculator{true};
+    legendre_calculator.precompute(max_angular_l);
+
+    std::vector<Eigen::Vector3d> unit_vectors{};
+    for (auto & data : this->ref_data) {
+      std::vector<double> unit_vector_tmp = data["unit_vector"];
+      Eigen::Vector3d unit_vector(unit_vector_tmp.data());
+      auto harmonics_tmp = data["harmonics"].get<std::vector<double>>();
+      math::Vector_t harmonics_ref = Eigen::Map<math::Vector_t>(
+          harmonics_tmp.data(), harmonics_tmp.size());
+
+      solid_calculator.calc(unit_vector);
+      double error{(solid_calculator.get_harmonics() - harmonics_ref).norm()};
+      BOOST_CHECK_LE(error, 2 * math::DBL_FTOL);
+      unit_vectors.push_back(unit_vector);
+    }
+    unit_vectors.emplace_back(0., 0., 1.);
+    unit_vectors.emplace_back(0., 0., -1.);
+    unit_vectors.emplace_back(1., 0., 0.);
+
+    for (const auto & unit_vector : unit_vectors) {
+      for (bool conjugate : {false, true}) {
+        solid_calculator.calc(unit_vector, true, conjugate);
+        legendre_calculator.calc(unit_vector, true, conjugate);
+        double error{(solid_calculator.get_harmonics() -
+                      legendre_calculator.get_harmonics())
+                         .norm()};
+        BOOST_CHECK_LE(error, 2 * math::DBL_FTOL);
+        double gradient_error{
+            (solid_calculator.get_harmonics_derivatives() -
+             legendre_calculator.get_harmonics_derivatives())
+                .norm() /
+            legendre_calculator.get_harmonics_derivatives().norm()};
+        BOOST_CHECK_LE(gradient_error, 2 * math::DBL_FTOL);
+        if (verbose) {
+          std::cout << ">> unit_vector: " << unit_vector.transpose()
+                    << " conjugate: " << conjugate << " error: " << error
+                    << " gradient_error: " << gradient_error << std::endl;
+        }
+      }
+    }
+  }
+
   /* Rescued from `test_math_utils.cc`: Keep or refer to the script used to
    * generate reference values
    * ```python
@@ -227,6 +281,16 @@ namespace rascal {
     test_gradients(harmonics_grad_calc, fix);
   }
 
+  BOOST_AUTO_TEST_CASE(solid_harmonics_gradient_test) {
+    constexpr size_t test_max_angular = 30;
+    SphericalHarmonicsGradientsCalculator<test_max_angular>
+        harmonics_grad_calc{math::SphericalHarmonicsMethod::Solid};
+    harmonics_grad_calc.precompute();
+    GradientTestFixture fix{
+        "reference_data/tests_only/spherical_harmonics_gradient_test.json"};
+    test_gradients(harmonics_grad_calc, fix);
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
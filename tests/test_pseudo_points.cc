@@ -200,6 +200,41 @@ namespace rascal {
     BOOST_CHECK_THROW(
         j.template get<SparsePointsBlockSparse<CalculatorSphericalExpansion>>(),
         std::runtime_error);
+
+    // the former format stores the features per [sp][key] with the indices
+    // of the pseudo points that have this key
+    using Key_t = typename Fix::SparsePoints_t::Key_t;
+    std::map<int, std::map<Key_t, std::vector<double>>> legacy_values{};
+    std::map<int, std::map<Key_t, std::vector<size_t>>> legacy_indices{};
+    const auto inner_size{static_cast<Eigen::Index>(sparse_points.inner_size)};
+    for (const int & sp : sparse_points.species()) {
+      const auto T_sp{sparse_points.get_features_view(sp)};
+      for (const auto & key : sparse_points.keys_sp.at(sp)) {
+        const auto col{sparse_points.get_key_column(sp, key)};
+        auto & values_by_key = legacy_values[sp][key];
+        auto & indices_by_key = legacy_indices[sp][key];
+        for (Eigen::Index i_row{0}; i_row < T_sp.rows(); ++i_row) {
+          const auto block{T_sp.block(i_row, col, 1, inner_size)};
+          if (block.isZero(0.)) {
+            continue;
+          }
+          indices_by_key.push_back(i_row);
+          values_by_key.insert(values_by_key.end(), block.data(),
+                               block.data() + inner_size);
+        }
+      }
+    }
+    json j_legacy = j;
+    j_legacy["values"] = legacy_values;
+    j_legacy["indices"] = legacy_indices;
+    auto sparse_points_c =
+        j_legacy.template get<typename Fix::SparsePoints_t>();
+    BOOST_TEST((sparse_points.get_features() - sparse_points_c.get_features())
+                   .norm() == 0.);
+    for (const int & sp : sparse_points.species()) {
+      BOOST_TEST((sparse_points.self_dot(sp) - sparse_points_c.self_dot(sp))
+                     .norm() == 0.);
+    }
   }
 
   BOOST_AUTO_TEST_SUITE_END();
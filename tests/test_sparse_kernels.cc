@@ -31,6 +31,8 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+
 namespace rascal {
   BOOST_AUTO_TEST_SUITE(sparse_kernels_test);
 
@@ -44,6 +46,7 @@ namespace rascal {
   BOOST_FIXTURE_TEST_CASE_TEMPLATE(multiple_kernel_compute_test, Fix,
                                    multiple_fixtures, Fix) {
     using Calculator_t = typename Fix::Calculator_t;
+    using Property_t = typename Fix::Property_t;
     auto & kernels = Fix::kernels;
     auto & representations = Fix::representations;
     auto & collections = Fix::collections;
@@ -88,6 +91,29 @@ namespace rascal {
             }
             BOOST_CHECK_EQUAL(mat.size(), n_centers * sparse_points.size());
           }
+
+          // compare with the contraction done center by center
+          auto zeta{kernel.parameters.at("zeta").template get<size_t>()};
+          math::Matrix_t mat_ref = math::Matrix_t::Zero(mat.rows(), mat.cols());
+          int ii_A{0};
+          for (auto & manager : collection) {
+            auto && prop{*manager->template get_property<Property_t>(
+                representation.get_name(), true)};
+            for (auto center : manager) {
+              math::Matrix_t k_row{
+                  sparse_points.dot(center.get_atom_type(), prop[center])
+                      .transpose()};
+              mat_ref.row(ii_A) += internal::pow_zeta(std::move(k_row), zeta);
+              if (kernel.target_type == internal::TargetType::Atom) {
+                ++ii_A;
+              }
+            }
+            if (kernel.target_type == internal::TargetType::Structure) {
+              ++ii_A;
+            }
+          }
+          BOOST_CHECK_LE((mat - mat_ref).norm(),
+                         math::DBL_FTOL * mat_ref.norm());
         }
       }
     }
@@ -216,6 +242,86 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the prediction of the gradients agrees with the kernel
+   * gradients when the pseudo points miss some of the central species.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(missing_species_grad_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Kernel_t = typename Fix::Kernel_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+    // relative error threshold
+    const double delta{1e-10};
+    // range of zero
+    const double epsilon{1e-14};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      Kernel_t kernel{kernel_input};
+      ManagerCollection_t managers{adaptors_input};
+      Representation_t representation{calculator_input};
+      managers.add_structures(filename, 0,
+                              input.at("n_structures").template get<int>());
+      representation.compute(managers);
+
+      // only keep the pseudo points of the first selected species
+      const int kept_species{
+          extract_underlying_manager<0>(managers[0])->get_atom_types()(
+              selected_ids[0][0])};
+      bool has_other_species{false};
+      for (size_t i_structure{0}; i_structure < managers.size();
+           ++i_structure) {
+        const Eigen::VectorXi atom_types{
+            extract_underlying_manager<0>(managers[i_structure])
+                ->get_atom_types()};
+        has_other_species |= (atom_types.array() != kept_species).any();
+        auto & ids{selected_ids[i_structure]};
+        ids.erase(std::remove_if(ids.begin(), ids.end(),
+                                 [&atom_types, kept_species](int id) {
+                                   return atom_types(id) != kept_species;
+                                 }),
+                  ids.end());
+      }
+      if (not has_other_species) {
+        continue;
+      }
+      SparsePoints_t sparse_points{};
+      sparse_points.push_back(representation, managers, selected_ids);
+      BOOST_CHECK_EQUAL(sparse_points.species().size(), 1);
+
+      auto KNM_der{kernel.compute_derivative(representation, managers,
+                                             sparse_points, false)};
+      math::Vector_t weights{math::Vector_t::Random(sparse_points.size())};
+      math::Matrix_t gradients_k = KNM_der * weights.transpose();
+      std::string force_name = compute_sparse_kernel_gradients(
+          representation, kernel, managers, sparse_points, weights);
+      size_t i_center{0};
+      for (auto manager : managers) {
+        auto && gradients{*manager->template get_property<
+            Property<double, 1, Manager_t, 1, ThreeD>>(force_name, true)};
+        math::Matrix_t ff = Eigen::Map<const math::Matrix_t>(
+            gradients.view().data(), manager->size() * ThreeD, 1);
+        math::Matrix_t ff_r =
+            gradients_k.block(i_center, 0, manager->size() * ThreeD, 1);
+        math::Matrix_t force_diff =
+            math::relative_error(ff, ff_r, delta, epsilon);
+        BOOST_TEST(force_diff.maxCoeff() < delta);
+        i_center += manager->size() * ThreeD;
+      }
+    }
+  }
+
   /**
    * Test the analytical kernel stress against numerical kernel stress.
    */
@@ -267,6 +373,32 @@ namespace rascal {
       auto KNM_num_der{compute_numerical_kernel_gradients(
           kernel_num, representation_, managers, sparse_points,
           input.at("h").template get<double>(), compute_stress)};
+      // the displacements evaluated in parallel give the same result
+      math::Matrix_t KNM_num_der_parallel{compute_numerical_kernel_gradients(
+          kernel_num, representation_, managers, sparse_points,
+          input.at("h").template get<double>(), compute_stress, 3)};
+      BOOST_CHECK_LE((KNM_num_der_parallel - KNM_num_der).cwiseAbs().maxCoeff(),
+                     math::DBL_FTOL);
+
+      // the structures filled in parallel in a caller provided buffer give
+      // the same result
+      auto shape{kernel.get_derivative_shape(managers, sparse_points.size(),
+                                             compute_stress)};
+      BOOST_CHECK_EQUAL(shape[0], KNM_der.rows());
+      BOOST_CHECK_EQUAL(shape[1], KNM_der.cols());
+      math::Matrix_t KNM_der_buffer(shape[0] + 1, shape[1]);
+      KNM_der_buffer.setConstant(-1.);
+      const size_t n_threads{3};
+      auto KNM_der_view{KNM_der_buffer.bottomRows(shape[0])};
+      kernel.fill_derivative(representation, managers, sparse_points,
+                             compute_stress, KNM_der_view, n_threads);
+      BOOST_CHECK_EQUAL(KNM_der_buffer(0, 0), -1.);
+      math::Matrix_t KNM_der_diff{KNM_der_view - KNM_der};
+      BOOST_CHECK_LE(KNM_der_diff.cwiseAbs().maxCoeff(), math::DBL_FTOL);
+      BOOST_CHECK_THROW(kernel.fill_derivative(representation, managers,
+                                               sparse_points, compute_stress,
+                                               KNM_der_buffer, n_threads),
+                        std::runtime_error);
 
       int n_stress_rows{static_cast<int>(managers.size() * 6)};
       math::Matrix_t KNM_stress{KNM_der.block(KNM_der.rows() - n_stress_rows, 0,
@@ -321,6 +453,437 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the normal equations accumulated one structure at a time match
+   * the ones computed from the full K_NM.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(gpr_accumulator_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Kernel_t = typename Fix::Kernel_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      int n_structures{input.at("n_structures").template get<int>()};
+      Kernel_t kernel{kernel_input};
+      ManagerCollection_t managers{adaptors_input};
+      SparsePoints_t sparse_points{};
+      Representation_t representation{calculator_input};
+      managers.add_structures(filename, 0, n_structures);
+      representation.compute(managers);
+      sparse_points.push_back(representation, managers, selected_ids);
+      const size_t n_sparse{sparse_points.size()};
+
+      // reference normal equations from the full K_NM
+      math::Matrix_t KNM{kernel.compute(representation, managers,
+                                        sparse_points)};
+      math::Matrix_t KNM_der{kernel.compute_derivative(
+          representation, managers, sparse_points, false)};
+      math::Matrix_t Y{math::Matrix_t::Random(KNM.rows(), 2)};
+      math::Matrix_t Y_der{math::Matrix_t::Random(KNM_der.rows(), 2)};
+      math::Vector_t weights{math::Vector_t::Random(KNM.rows())};
+      math::Vector_t weights_der{math::Vector_t::Constant(KNM_der.rows(), 3.)};
+      math::Matrix_t KNM_w{weights.asDiagonal() * KNM};
+      math::Matrix_t KNM_der_w{weights_der.asDiagonal() * KNM_der};
+      math::Matrix_t KtK_ref{KNM_w.transpose() * KNM_w +
+                             KNM_der_w.transpose() * KNM_der_w};
+      math::Matrix_t KtY_ref{
+          KNM_w.transpose() * (weights.asDiagonal() * Y) +
+          KNM_der_w.transpose() * (weights_der.asDiagonal() * Y_der)};
+
+      // accumulate one structure at a time
+      SparseGPRAccumulator accumulator{n_sparse, 2};
+      int i_row_der{0};
+      for (int i_structure{0}; i_structure < n_structures; ++i_structure) {
+        ManagerCollection_t chunk{adaptors_input};
+        chunk.add_structures(filename, i_structure, 1);
+        representation.compute(chunk);
+        accumulator.accumulate_properties(
+            kernel, representation, chunk, sparse_points,
+            Y.middleRows(i_structure, 1), weights.segment(i_structure, 1));
+        int n_rows_der{static_cast<int>(
+            kernel.get_derivative_shape(chunk, n_sparse, false)[0])};
+        accumulator.accumulate_gradients(
+            kernel, representation, chunk, sparse_points,
+            Y_der.middleRows(i_row_der, n_rows_der),
+            weights_der.segment(i_row_der, n_rows_der), 2);
+        i_row_der += n_rows_der;
+      }
+      BOOST_CHECK_EQUAL(i_row_der, KNM_der.rows());
+      BOOST_CHECK_EQUAL(accumulator.get_nb_rows(),
+                        KNM.rows() + KNM_der.rows());
+      math::Matrix_t KtK_diff{accumulator.get_KtK() - KtK_ref};
+      math::Matrix_t KtY_diff{accumulator.get_KtY() - KtY_ref};
+      double scale{std::max(KtK_ref.cwiseAbs().maxCoeff(), 1.)};
+      BOOST_CHECK_LE(KtK_diff.cwiseAbs().maxCoeff() / scale, 1e-12);
+      scale = std::max(KtY_ref.cwiseAbs().maxCoeff(), 1.);
+      BOOST_CHECK_LE(KtY_diff.cwiseAbs().maxCoeff() / scale, 1e-12);
+
+      // mismatching shapes are rejected
+      BOOST_CHECK_THROW(accumulator.accumulate(KNM, Y_der, weights),
+                        std::runtime_error);
+      kernel_input.at("target_type") = "Atom";
+      Kernel_t kernel_atom{kernel_input};
+      BOOST_CHECK_THROW(
+          accumulator.accumulate_properties(kernel_atom, representation,
+                                            managers, sparse_points, Y,
+                                            weights),
+          std::runtime_error);
+    }
+  }
+
+  /**
+   * Test that the fused Potential gives the same energy, forces and stress
+   * as the sparse kernel and the prediction routines, also after the
+   * structure has been updated.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(potential_test, Fix, sparse_grad_fixtures,
+                                   Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Kernel_t = typename Fix::Kernel_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+    using Potential_t = Potential<Representation_t, ManagerCollection_t>;
+
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+    // relative error threshold
+    const double delta{1e-8};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      int n_structures{input.at("n_structures").template get<int>()};
+      Kernel_t kernel{kernel_input};
+      ManagerCollection_t managers{adaptors_input};
+      SparsePoints_t sparse_points{};
+      Representation_t representation{calculator_input};
+      managers.add_structures(filename, 0, n_structures);
+      representation.compute(managers);
+      sparse_points.push_back(representation, managers, selected_ids);
+
+      math::Vector_t weights{math::Vector_t::Random(sparse_points.size())};
+      std::map<int, double> self_contributions{};
+      for (const int & sp : sparse_points.species()) {
+        self_contributions[sp] = 0.1 * sp;
+      }
+      json potential_input{};
+      potential_input["representation"] = calculator_input;
+      potential_input["kernel"] = kernel_input;
+      potential_input["sparse_points"] = sparse_points;
+      potential_input["weights"] =
+          std::vector<double>(weights.data(), weights.data() + weights.size());
+      for (const auto & item : self_contributions) {
+        potential_input["self_contributions"][std::to_string(item.first)] =
+            item.second;
+      }
+      potential_input["adaptors"] = adaptors_input;
+
+      for (int i_structure{0}; i_structure < n_structures; ++i_structure) {
+        auto structure{extract_underlying_manager<0>(managers[i_structure])
+                           ->get_atomic_structure()};
+        Potential_t potential{potential_input};
+        for (int i_step{0}; i_step < 2; ++i_step) {
+          if (i_step == 1) {
+            // the persistent managers are updated
+            structure.displace_position(0, Eigen::Vector3d{0.01, -0.02, 0.});
+            structure.wrap();
+          }
+          potential.compute(structure.positions, structure.atom_types,
+                            structure.cell, structure.pbc);
+
+          // reference from the kernel and the prediction routines
+          ManagerCollection_t reference{adaptors_input};
+          json structure_json = structure;
+          reference.add_structure(structure_json);
+          representation.compute(reference);
+          math::Matrix_t KNM{
+              kernel.compute(representation, reference, sparse_points)};
+          double energy{(KNM * weights.transpose())(0, 0)};
+          for (int i_atom{0}; i_atom < structure.atom_types.size(); ++i_atom) {
+            energy += 0.1 * structure.atom_types(i_atom);
+          }
+          BOOST_CHECK_CLOSE(potential.get_energy(), energy, 100 * delta);
+
+          std::string force_name{compute_sparse_kernel_gradients(
+              representation, kernel, reference, sparse_points, weights)};
+          auto && gradients{*reference[0]->template get_property<
+              Property<double, 1, Manager_t, 1, ThreeD>>(force_name, true)};
+          math::Matrix_t forces{-gradients.view()};
+          math::Matrix_t forces_diff{potential.get_forces() - forces};
+          BOOST_CHECK_LE(forces_diff.cwiseAbs().maxCoeff(),
+                         delta * std::max(forces.cwiseAbs().maxCoeff(), 1.));
+
+          std::string neg_stress_name{compute_sparse_kernel_neg_stress(
+              representation, kernel, reference, sparse_points, weights)};
+          auto && neg_stress{
+              *reference[0]
+                   ->template get_property<Property<double, 0, Manager_t, 6>>(
+                       neg_stress_name, true)};
+          Eigen::Map<const math::Matrix_t> neg_stress_voigt{
+              neg_stress.view().data(), 1, 6};
+          const std::array<std::array<int, 2>, 6> voigt{
+              {{{0, 0}}, {{1, 1}}, {{2, 2}}, {{1, 2}}, {{0, 2}}, {{0, 1}}}};
+          const auto & stress{potential.get_stress()};
+          double stress_scale{std::max(stress.cwiseAbs().maxCoeff(), 1.)};
+          for (int i_voigt{0}; i_voigt < 6; ++i_voigt) {
+            BOOST_CHECK_SMALL(
+                stress(voigt[i_voigt][0], voigt[i_voigt][1]) +
+                    neg_stress_voigt(0, i_voigt),
+                delta * stress_scale);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Check that the predictions with the weights contracted with the sparse
+   * points agree with the ones going through the kernel for zeta 1 and 2.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(potential_precontract_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Representation_t = typename Fix::Representation_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+    using Potential_t = Potential<Representation_t, ManagerCollection_t>;
+
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+    // relative error threshold
+    const double delta{1e-10};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      int n_structures{input.at("n_structures").template get<int>()};
+      ManagerCollection_t managers{adaptors_input};
+      SparsePoints_t sparse_points{};
+      Representation_t representation{calculator_input};
+      managers.add_structures(filename, 0, n_structures);
+      representation.compute(managers);
+      sparse_points.push_back(representation, managers, selected_ids);
+
+      math::Vector_t weights{math::Vector_t::Random(sparse_points.size())};
+      json potential_input{};
+      potential_input["representation"] = calculator_input;
+      potential_input["sparse_points"] = sparse_points;
+      potential_input["weights"] =
+          std::vector<double>(weights.data(), weights.data() + weights.size());
+      for (const int & sp : sparse_points.species()) {
+        potential_input["self_contributions"][std::to_string(sp)] = 0.;
+      }
+      potential_input["adaptors"] = adaptors_input;
+
+      auto structure{extract_underlying_manager<0>(managers[0])
+                         ->get_atomic_structure()};
+      for (int zeta{1}; zeta < 3; ++zeta) {
+        kernel_input["zeta"] = zeta;
+        potential_input["kernel"] = kernel_input;
+        potential_input["precontract"] = true;
+        Potential_t contracted{potential_input};
+        potential_input["precontract"] = false;
+        Potential_t reference{potential_input};
+        contracted.compute(structure.positions, structure.atom_types,
+                           structure.cell, structure.pbc);
+        reference.compute(structure.positions, structure.atom_types,
+                          structure.cell, structure.pbc);
+
+        const double energy{reference.get_energy()};
+        BOOST_CHECK_SMALL(contracted.get_energy() - energy,
+                          delta * std::max(std::abs(energy), 1.));
+        const auto & forces{reference.get_forces()};
+        math::Matrix_t forces_diff{contracted.get_forces() - forces};
+        BOOST_CHECK_LE(forces_diff.cwiseAbs().maxCoeff(),
+                       delta * std::max(forces.cwiseAbs().maxCoeff(), 1.));
+        const auto & stress{reference.get_stress()};
+        math::Matrix_t stress_diff{contracted.get_stress() - stress};
+        BOOST_CHECK_LE(stress_diff.cwiseAbs().maxCoeff(),
+                       delta * std::max(stress.cwiseAbs().maxCoeff(), 1.));
+      }
+    }
+  }
+
+  /**
+   * Check the farthest point sampling on the block sparse features against
+   * a simple implementation using the dense feature matrix, for all the
+   * centers and per species.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(farthest_point_sampling_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Representation_t = typename Fix::Representation_t;
+
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+    const double delta{1e-10};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      int n_structures{input.at("n_structures").template get<int>()};
+      ManagerCollection_t managers{adaptors_input};
+      Representation_t representation{calculator_input};
+      managers.add_structures(filename, 0, n_structures);
+      representation.compute(managers);
+
+      math::Matrix_t features{managers.get_features(representation)};
+      std::vector<int> atom_types{};
+      for (const auto & manager : managers) {
+        for (auto center : manager) {
+          atom_types.push_back(center.get_atom_type());
+        }
+      }
+      std::vector<std::vector<int>> species_list{{}};
+      for (const int & sp : std::set<int>(atom_types.begin(),
+                                          atom_types.end())) {
+        species_list.push_back({sp});
+      }
+
+      for (const auto & species : species_list) {
+        std::vector<Eigen::Index> rows{};
+        for (size_t i_center{0}; i_center < atom_types.size(); ++i_center) {
+          if (species.empty() or atom_types[i_center] == species[0]) {
+            rows.push_back(i_center);
+          }
+        }
+        math::Matrix_t X(rows.size(), features.cols());
+        for (size_t i_row{0}; i_row < rows.size(); ++i_row) {
+          X.row(i_row) = features.row(rows[i_row]);
+        }
+        const size_t n_select{std::min(rows.size(), size_t{10})};
+        const size_t initial{rows.size() / 2};
+
+        std::vector<size_t> serial_ids{};
+        for (size_t n_threads : {1, 3}) {
+          auto selection{select_farthest_points(
+              representation, managers, n_select, species, initial,
+              n_threads)};
+          // the threads reduce to the same sample as the serial selection
+          if (n_threads == 1) {
+            serial_ids = selection.selected_ids;
+          }
+          BOOST_CHECK(selection.selected_ids == serial_ids);
+          BOOST_CHECK_EQUAL(selection.selected_ids.size(), n_select);
+          BOOST_CHECK_EQUAL(selection.selected_ids[0], initial);
+          BOOST_CHECK(std::isinf(selection.distances[0]));
+          // the environments can be degenerate so check that each selected
+          // sample is one of the farthest instead of comparing indices
+          math::Vector_t min_distances{math::Vector_t::Constant(
+              X.rows(), std::numeric_limits<double>::infinity())};
+          for (size_t i_select{1}; i_select < n_select; ++i_select) {
+            auto && last{X.row(selection.selected_ids[i_select - 1])};
+            for (Eigen::Index i_row{0}; i_row < X.rows(); ++i_row) {
+              min_distances(i_row) = std::min(
+                  min_distances(i_row), (X.row(i_row) - last).squaredNorm());
+            }
+            const double max_distance{min_distances.maxCoeff()};
+            const auto selected{selection.selected_ids[i_select]};
+            BOOST_CHECK_SMALL(min_distances(selected) - max_distance, delta);
+            BOOST_CHECK_SMALL(selection.distances[i_select] - max_distance,
+                              delta);
+          }
+        }
+      }
+      BOOST_CHECK_THROW(select_farthest_points(representation, managers,
+                                               atom_types.size() + 1),
+                        std::runtime_error);
+    }
+  }
+
+  /**
+   * Check the CUR selection against the greedy selection with the exact SVD
+   * of the dense feature matrix. The range finder covers the whole row
+   * space of the features so both should select items with the largest
+   * leverage scores.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(cur_selection_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Representation_t = typename Fix::Representation_t;
+
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+    const double delta{1e-6};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      int n_structures{input.at("n_structures").template get<int>()};
+      ManagerCollection_t managers{adaptors_input};
+      Representation_t representation{calculator_input};
+      managers.add_structures(filename, 0, n_structures);
+      representation.compute(managers);
+      const math::Matrix_t features{managers.get_features(representation)};
+
+      for (const std::string selection_type : {"sample", "feature"}) {
+        const bool is_sample{selection_type == "sample"};
+        // items are the columns of X
+        math::Matrix_t X{is_sample ? math::Matrix_t{features.transpose()}
+                                   : features};
+        const size_t n_select{5};
+        json hypers{{"selection_type", selection_type},
+                    {"n_select", n_select},
+                    {"n_oversampling", X.rows() + X.cols()},
+                    {"n_power_iterations", 0}};
+        for (size_t n_threads : {1, 3}) {
+          auto selected_ids{
+              select_cur(representation, managers, hypers, n_threads)};
+          BOOST_REQUIRE_EQUAL(selected_ids.size(), n_select);
+          BOOST_CHECK_EQUAL(
+              std::set<size_t>(selected_ids.begin(), selected_ids.end())
+                  .size(),
+              n_select);
+          math::Matrix_t X_current{X};
+          for (const auto & selected : selected_ids) {
+            Eigen::JacobiSVD<math::Matrix_t> svd{X_current,
+                                                 Eigen::ComputeThinV};
+            math::Vector_t leverage{
+                svd.matrixV().col(0).cwiseAbs2().transpose()};
+            BOOST_CHECK_GE(leverage(selected),
+                           leverage.maxCoeff() * (1. - delta));
+            Eigen::VectorXd v{X_current.col(selected).normalized()};
+            X_current -= v * (v.transpose() * X_current);
+          }
+        }
+      }
+
+      json hypers{{"selection_type", "row"}, {"n_select", 1}};
+      BOOST_CHECK_THROW(select_cur(representation, managers, hypers),
+                        std::runtime_error);
+      hypers = {{"selection_type", "sample"},
+                {"n_select", features.rows() + 1}};
+      BOOST_CHECK_THROW(select_cur(representation, managers, hypers),
+                        std::runtime_error);
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal